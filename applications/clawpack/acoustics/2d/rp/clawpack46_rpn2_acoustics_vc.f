@@ -47,6 +47,7 @@ c
       double precision dtcom, dxcom, dycom, tcom
       integer icom, jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
 c     local arrays
 c     ------------
@@ -84,6 +84,7 @@ c
 
       logical limit
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 c
       limit = .false.
       do 5 mw=1,mwaves
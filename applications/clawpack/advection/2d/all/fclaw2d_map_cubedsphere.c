@@ -74,6 +74,21 @@ fclaw2d_map_c2m_cubedsphere (fclaw2d_map_context_t * cont, int blockno,
 
 
 
+static void
+fclaw2d_map_c2m_batch_cubedsphere (fclaw2d_map_context_t * cont, int blockno,
+                                   int n, const double xc[], const double yc[],
+                                   double xp[], double yp[], double zp[])
+{
+    fclaw2d_map_batch_cubedsphere(blockno,n,xc,yc,xp,yp,zp);
+
+    if (cont->is_extruded == 0)
+    {
+        scale_map_batch(cont,n,xp,yp,zp);
+        rotate_map_batch(cont,n,xp,yp,zp);
+    }
+}
+
+
 fclaw2d_map_context_t *
     fclaw2d_map_new_cubedsphere(const double scale[],
                                 const double rotate[])
@@ -83,6 +98,7 @@ fclaw2d_map_context_t *
     cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
     cont->query = fclaw2d_map_query_cubedsphere;
     cont->mapc2m = fclaw2d_map_c2m_cubedsphere;
+    cont->mapc2m_batch = fclaw2d_map_c2m_batch_cubedsphere;
 
     set_rotate(cont,rotate);
     set_scale(cont,scale);
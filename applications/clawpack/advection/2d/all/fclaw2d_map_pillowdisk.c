@@ -76,6 +76,20 @@ fclaw2d_map_c2m_pillowdisk(fclaw2d_map_context_t * cont, int blockno,
     }
 }
 
+static void
+fclaw2d_map_c2m_batch_pillowdisk(fclaw2d_map_context_t * cont, int blockno,
+                                 int n, const double xc[], const double yc[],
+                                 double xp[], double yp[], double zp[])
+{
+    fclaw2d_map_batch_pillowdisk(blockno,n,xc,yc,xp,yp,zp);
+
+    if (cont->is_extruded == 0)
+    {
+        scale_map_batch(cont,n,xp,yp,zp);
+        shift_map_batch(cont,n,xp,yp,zp);
+    }
+}
+
 fclaw2d_map_context_t* fclaw2d_map_new_pillowdisk(const double scale[],
                                                   const double shift[],
                                                   const double rotate[])
@@ -85,6 +99,7 @@ fclaw2d_map_context_t* fclaw2d_map_new_pillowdisk(const double scale[],
     cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
     cont->query = fclaw2d_map_query_pillowdisk;
     cont->mapc2m = fclaw2d_map_c2m_pillowdisk;
+    cont->mapc2m_batch = fclaw2d_map_c2m_batch_pillowdisk;
 
     set_scale(cont, scale);
     set_shift(cont, shift);
@@ -76,6 +76,20 @@ fclaw2d_map_c2m_pillowsphere (fclaw2d_map_context_t * cont, int blockno,
     }
 }
 
+static void
+fclaw2d_map_c2m_batch_pillowsphere (fclaw2d_map_context_t * cont, int blockno,
+                                    int n, const double xc[], const double yc[],
+                                    double xp[], double yp[], double zp[])
+{
+    fclaw2d_map_batch_pillowsphere(blockno,n,xc,yc,xp,yp,zp);
+
+    if (cont->is_extruded == 0)
+    {
+        scale_map_batch(cont,n,xp,yp,zp);
+        rotate_map_batch(cont,n,xp,yp,zp);
+    }
+}
+
 fclaw2d_map_context_t *
     fclaw2d_map_new_pillowsphere(const double scale[],
                                  const double rotate[])
@@ -85,6 +99,7 @@ fclaw2d_map_context_t *
     cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
     cont->query = fclaw2d_map_query_pillowsphere;
     cont->mapc2m = fclaw2d_map_c2m_pillowsphere;
+    cont->mapc2m_batch = fclaw2d_map_c2m_batch_pillowsphere;
     
     set_scale(cont,scale); 
     set_rotate(cont, rotate);
@@ -80,6 +80,22 @@ fclaw2d_map_c2m_torus (fclaw2d_map_context_t * cont, int blockno,
     rotate_map(cont,xp,yp,zp);
 }
 
+static void
+fclaw2d_map_c2m_batch_torus (fclaw2d_map_context_t * cont, int blockno, int n,
+                             const double xc[], const double yc[],
+                             double xp[], double yp[], double zp[])
+{
+    /* Map to [0,1]x[0,1] and then to the torus in place */
+    fclaw2d_map_brick2c_batch(cont,blockno,n,xc,yc,xp,yp,zp);
+
+    double alpha = cont->user_double[0];
+    double beta = cont->user_double[1];
+    fclaw2d_map_batch_torus(n,xp,yp,xp,yp,zp,alpha,beta);
+
+    scale_map_batch(cont,n,xp,yp,zp);
+    rotate_map_batch(cont,n,xp,yp,zp);
+}
+
 fclaw2d_map_context_t *
     fclaw2d_map_new_torus (fclaw2d_map_context_t* brick,
                            const double scale[],
@@ -92,6 +108,7 @@ fclaw2d_map_context_t *
     cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
     cont->query = fclaw2d_map_query_torus;
     cont->mapc2m = fclaw2d_map_c2m_torus;
+    cont->mapc2m_batch = fclaw2d_map_c2m_batch_torus;
 
     cont->user_double[0] = alpha;
     cont->user_double[1] = beta;
@@ -25,6 +25,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "sphere_user.h"
 
+#include <fclaw2d_metric.h>
+
 static
 void sphere_problem_setup(fclaw2d_global_t* glob)
 {
@@ -61,6 +63,10 @@ void sphere_link_solvers(fclaw2d_global_t *glob)
     fclaw2d_patch_vtable_t *patch_vt = fclaw2d_patch_vt(glob);
     patch_vt->setup      = &sphere_patch_setup;  
 
+    /* Velocities are set from the node coordinates and area; don't store 
+       normals, tangents and curvature */
+    fclaw2d_metric_require_terms(glob,FCLAW2D_METRIC_MESH | FCLAW2D_METRIC_AREA);
+
     const user_options_t* user = sphere_get_options(glob);
     if (user->example == 1)
     {
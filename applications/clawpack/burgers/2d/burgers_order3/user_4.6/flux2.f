@@ -95,6 +95,7 @@ c
 
       logical limit
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
 
 c
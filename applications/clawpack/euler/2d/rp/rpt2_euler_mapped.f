@@ -67,6 +67,7 @@ c     # Problem parameters
 
       common /param/  gamma,gamma1
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       call get_aux_locations_t(ixy, mcapa, locrot,locarea)
 
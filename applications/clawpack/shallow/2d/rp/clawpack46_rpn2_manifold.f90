@@ -80,6 +80,7 @@ SUBROUTINE clawpack46_rpn2_manifold(ixy,maxm,meqn,mwaves,mbc, &
     double precision :: dtcom, dxcom, dycom, tcom
     integer :: icom, jcom
     common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+    !$omp threadprivate(/comxyt/)
 
     DOUBLE PRECISION :: grav
     COMMON /cparam/  grav
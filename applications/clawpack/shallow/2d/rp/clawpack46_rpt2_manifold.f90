@@ -35,6 +35,7 @@ SUBROUTINE clawpack46_rpt2_manifold(ixy,maxm,meqn,mwaves,mbc,mx, &
     double precision :: dtcom, dxcom, dycom, tcom
     integer :: icom, jcom
     common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+    !$omp threadprivate(/comxyt/)
 
     DOUBLE PRECISION :: grav
     COMMON /cparam/  grav
@@ -78,6 +78,7 @@ SUBROUTINE clawpack5_rpn2_manifold(ixy,maxm,meqn,mwaves,maux,mbc, &
     dimension u(1-mbc:maxm+mbc),v(1-mbc:maxm+mbc),a(1-mbc:maxm+mbc), &
     h(1-mbc:maxm+mbc)
     common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+    !$omp threadprivate(/comxyt/)
 
 !!    integer :: fc2d_clawpack46_get_block, blockno
 
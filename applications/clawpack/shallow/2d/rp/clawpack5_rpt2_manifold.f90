@@ -33,6 +33,7 @@ SUBROUTINE clawpack5_rpt2_manifold(ixy,imp,maxm,meqn,mwaves,maux,mbc,mx, &
 
     dimension delta(4)
     common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+    !$omp threadprivate(/comxyt/)
 
     DOUBLE PRECISION grav
     COMMON /cparam/  grav
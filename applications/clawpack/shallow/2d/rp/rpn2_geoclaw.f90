@@ -83,6 +83,7 @@ SUBROUTINE clawpack46_rpn2(ixy,maxm,meqn,mwaves,mbc,mx, &
     integer icom, jcom
     double precision dtcom, dxcom, dycom, tcom
     common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+    !$omp threadprivate(/comxyt/)
 
     integer i1, i2
 
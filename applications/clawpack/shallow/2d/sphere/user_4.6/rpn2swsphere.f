@@ -31,6 +31,7 @@ c     ------------
       common /sw/  g
       common /comroe/ u, v, a, h
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 c     common /dmetric/ dmetric(1-2:800+2, 1-2:400+2,7)
       common /xlyl/ xlow,ylow
 c
@@ -34,6 +34,7 @@ c
       dimension delta(4)
       common /sw/  g
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 c
 
       if (-1.gt.1-mbc .or. maxm2 .lt. maxm+mbc) then
@@ -17,6 +17,7 @@
       double precision dtcom,dxcom,dycom,tcom
       integer icom,jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       integer i, i1, idir
       double precision vrrot, vlrot, g, vhat
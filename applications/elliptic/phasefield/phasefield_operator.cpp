@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fc2d_thunderegg.h>
 #include <fc2d_thunderegg_vector.hpp>
+#include <fc2d_thunderegg_krylov.hpp>
 
 #include <fclaw2d_elliptic_solver.h>
 
@@ -224,23 +225,18 @@ void phasefield_solve(fclaw2d_global_t *glob)
         M = builder.getCycle();
     }
 
-#if 0
-    // Set starting conditions
-    Vector<2> u = fc2d_thunderegg_get_vector(glob,SOLN);
-#else
-    Vector<2> u = f.getZeroClone();
-#endif    
+    // solve in place in the elliptic work data;  this is zero, or the
+    // previous solution with --warm-start
+    Vector<2> u = fc2d_thunderegg_get_vector(glob,ELLIPTIC_WORK);
 
 
-    Iterative::BiCGStab<2> iter_solver;
-    iter_solver.setMaxIterations(mg_opt->max_it);
-    iter_solver.setTolerance(mg_opt->tol);    
+    unique_ptr<Iterative::Solver<2>> iter_solver = fc2d_thunderegg_krylov_solver_new(mg_opt);
     bool prt_output = glob->mpirank == 0;
-    int its = iter_solver.solve(op, u, f, M.get(), prt_output);
+    int its = iter_solver->solve(op, u, f, M.get(), prt_output);
 
     fclaw_global_productionf("Iterations: %i\n", its);    
 
-    /* Solution is copied to right hand side */
-    fc2d_thunderegg_store_vector(glob, RHS, u);
+    /* Solution is swapped into the right hand side */
+    fc2d_thunderegg_store_solution(glob);
 }
 
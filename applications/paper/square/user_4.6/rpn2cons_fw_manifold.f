@@ -20,6 +20,7 @@ c     !! Note additional parameter : maux
       integer :: icom,jcom
       double precision :: dtcom,dxcom,dycom,tcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
 
       integer i, idir
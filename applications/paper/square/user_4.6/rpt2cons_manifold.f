@@ -19,6 +19,7 @@ c     !! Note : rpt2fw requires maux as argument 5
       double precision dtcom,dxcom,dycom,tcom
       integer icom,jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       integer i, i1, idir
       double precision vrrot, vlrot, g, vhat
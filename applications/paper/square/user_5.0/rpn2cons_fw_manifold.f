@@ -16,6 +16,7 @@
       integer :: icom,jcom
       double precision :: dtcom,dxcom,dycom,tcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       integer i, idir
       double precision qll,qrr
@@ -0,0 +1,101 @@
+"""
+Read the data arrays of a ForestClaw .vtu file into numpy arrays.
+
+Handles the appended raw encoding written by fclaw2d_clawpatch_output_vtk,
+with or without --vtk-compress.  Compressed arrays use the layout of the
+vtkZLibDataCompressor : a UInt64 header with the number of blocks, the
+block size, the size of a partial last block and the compressed size of
+each block, followed by the zlib blocks.  ForestClaw writes one block per
+patch.
+
+Usage :
+
+    python read_vtu.py fort_frame_0004.vtu
+
+    import read_vtu
+    arrays = read_vtu.read_vtu('fort_frame_0004.vtu')
+    q = arrays['meqn']      # shape (cells, meqn), float32
+"""
+
+import re
+import sys
+import zlib
+
+import numpy as np
+
+_types = {'Int8'    : np.int8,
+          'UInt8'   : np.uint8,
+          'Int32'   : np.int32,
+          'UInt32'  : np.uint32,
+          'Int64'   : np.int64,
+          'UInt64'  : np.uint64,
+          'Float32' : np.float32,
+          'Float64' : np.float64}
+
+
+def _attributes(tag):
+    return dict(re.findall(r'(\w+)="([^"]*)"', tag))
+
+
+def _read_raw(data, pos, dtype):
+    nbytes = int(np.frombuffer(data, np.uint64, 1, pos)[0])
+    return np.frombuffer(data, dtype, nbytes // np.dtype(dtype).itemsize,
+                         pos + 8)
+
+
+def _read_compressed(data, pos, dtype):
+    nblocks, bsize, lastsize = np.frombuffer(data, np.uint64, 3, pos)
+    nblocks = int(nblocks)
+    zsize = np.frombuffer(data, np.uint64, nblocks, pos + 24).astype(np.int64)
+    pos += 8*(3 + nblocks)
+
+    chunks = []
+    for b in range(nblocks):
+        chunk = zlib.decompress(data[pos:pos + zsize[b]])
+        usize = lastsize if (b == nblocks - 1 and lastsize != 0) else bsize
+        if len(chunk) != int(usize):
+            raise ValueError('block %d has %d bytes, expected %d'
+                             % (b, len(chunk), usize))
+        chunks.append(chunk)
+        pos += zsize[b]
+    return np.frombuffer(b''.join(chunks), dtype)
+
+
+def read_vtu(filename):
+    """Return a dictionary of all data arrays in the file, by name."""
+    with open(filename, 'rb') as f:
+        content = f.read()
+
+    marker = content.index(b'<AppendedData')
+    start = content.index(b'_', marker) + 1
+    header = content[:marker].decode('ascii')
+    data = content[start:]
+
+    vtkfile = _attributes(re.search(r'<VTKFile[^>]*>', header).group(0))
+    if vtkfile.get('header_type', 'UInt32') != 'UInt64':
+        raise ValueError('only header_type="UInt64" is supported')
+    compressor = vtkfile.get('compressor')
+    if compressor not in (None, 'vtkZLibDataCompressor'):
+        raise ValueError('unsupported compressor %s' % compressor)
+
+    arrays = {}
+    for tag in re.findall(r'<DataArray[^>]*>', header):
+        a = _attributes(tag)
+        dtype = np.dtype(_types[a['type']]).newbyteorder('<')
+        pos = int(a['offset'])
+        if compressor is None:
+            v = _read_raw(data, pos, dtype)
+        else:
+            v = _read_compressed(data, pos, dtype)
+        ncomp = int(a.get('NumberOfComponents', 1))
+        if ncomp > 1:
+            v = v.reshape(-1, ncomp)
+        arrays[a['Name']] = v
+    return arrays
+
+
+if __name__ == '__main__':
+    for filename in sys.argv[1:]:
+        print(filename)
+        for name, v in read_vtu(filename).items():
+            print('    %-14s %-8s %s' % (name, v.dtype, v.shape))
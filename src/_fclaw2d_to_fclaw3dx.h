@@ -31,6 +31,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define fclaw2d_clawpatch_fort_time_sync_samesize_t fclaw3dx_clawpatch_fort_time_sync_samesize_t
 #define fclaw2d_clawpatch_time_sync_new fclaw3dx_clawpatch_time_sync_new
 #define fclaw2d_clawpatch_time_sync_delete fclaw3dx_clawpatch_time_sync_delete
+#define fclaw2d_clawpatch_time_sync_set_faces fclaw3dx_clawpatch_time_sync_set_faces
+#define fclaw2d_clawpatch_time_sync_work_size fclaw3dx_clawpatch_time_sync_work_size
+#define fclaw2d_clawpatch_time_sync_fill_faces fclaw3dx_clawpatch_time_sync_fill_faces
 #define fclaw2d_clawpatch_time_sync_setup fclaw3dx_clawpatch_time_sync_setup
 #define fclaw2d_clawpatch_time_sync_f2c fclaw3dx_clawpatch_time_sync_f2c
 #define fclaw2d_clawpatch_time_sync_samesize fclaw3dx_clawpatch_time_sync_samesize
@@ -84,11 +87,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define cb_clawpatch_output_ascii fclaw3dx_clawpatch_output_ascii_cb
 #define fclaw2d_clawpatch_output_ascii fclaw3dx_clawpatch_output_ascii
 #define fclaw2d_clawpatch_time_header_ascii fclaw3dx_clawpatch_time_header_ascii
+#define fclaw2d_clawpatch_ascii_frame fclaw3dx_clawpatch_ascii_frame
+#define fclaw2d_clawpatch_ascii_frame_t fclaw3dx_clawpatch_ascii_frame_t
+#define fclaw2d_clawpatch_output_ascii_fortran_e fclaw3dx_clawpatch_output_ascii_fortran_e
+#define fclaw2d_clawpatch_output_ascii_begin fclaw3dx_clawpatch_output_ascii_begin
+#define fclaw2d_clawpatch_output_ascii_patch fclaw3dx_clawpatch_output_ascii_patch
+#define fclaw2d_clawpatch_output_ascii_patches fclaw3dx_clawpatch_output_ascii_patches
+#define fclaw2d_clawpatch_output_ascii_end fclaw3dx_clawpatch_output_ascii_end
 
 //fclaw2d_clawpatch_output_vtk.h
 #define fclaw2d_vtk_patch_data_t fclaw3dx_vtk_patch_data_t
 #define fclaw2d_vtk_write_file fclaw3dx_vtk_write_file
+#define fclaw2d_vtk_round_mantissa fclaw3dx_vtk_round_mantissa
+#define fclaw2d_vtk_compress_blocks fclaw3dx_vtk_compress_blocks
 #define fclaw2d_clawpatch_output_vtk fclaw3dx_clawpatch_output_vtk
+#define fclaw2d_clawpatch_vtk_frame fclaw3dx_clawpatch_vtk_frame
+#define fclaw2d_clawpatch_vtk_frame_t fclaw3dx_clawpatch_vtk_frame_t
+#define fclaw2d_clawpatch_output_vtk_begin fclaw3dx_clawpatch_output_vtk_begin
+#define fclaw2d_clawpatch_output_vtk_patch fclaw3dx_clawpatch_output_vtk_patch
+#define fclaw2d_clawpatch_output_vtk_end fclaw3dx_clawpatch_output_vtk_end
 
 //fclaw2d_clawpatch_pillow.h
 #define fclaw2d_clawpatch_pillow_vtable_t fclaw3dx_clawpatch_pillow_vtable_t
@@ -140,6 +157,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define fclaw2d_clawpatch_rhs_data fclaw3dx_clawpatch_rhs_data
 #define fclaw2d_clawpatch_elliptic_error_data fclaw3dx_clawpatch_elliptic_error_data
 #define fclaw2d_clawpatch_elliptic_soln_data fclaw3dx_clawpatch_elliptic_soln_data
+#define fclaw2d_clawpatch_elliptic_work_data fclaw3dx_clawpatch_elliptic_work_data
+#define fclaw2d_clawpatch_elliptic_swap_rhs fclaw3dx_clawpatch_elliptic_swap_rhs
+#define fclaw2d_clawpatch_elliptic_work_delete fclaw3dx_clawpatch_elliptic_work_delete
 #define fclaw2d_clawpatch_get_q fclaw3dx_clawpatch_get_q
 #define fclaw2d_clawpatch_get_error fclaw3dx_clawpatch_get_error
 #define fclaw2d_clawpatch_get_exactsoln fclaw3dx_clawpatch_get_exactsoln
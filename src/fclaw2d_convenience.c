@@ -26,12 +26,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef P4_TO_P8
 #include <fclaw2d_convenience.h>
 #include <p4est_bits.h>
+#include <p4est_communication.h>
 #include <p4est_search.h>
 #include <p4est_vtk.h>
 #include <p4est_wrap.h>
 #else
 #include <fclaw3d_convenience.h>
 #include <p8est_bits.h>
+#include <p8est_communication.h>
 #include <p8est_search.h>
 #include <p8est_vtk.h>
 #include <p8est_wrap.h>
@@ -1013,14 +1015,48 @@ search_point_fn (p4est_t * p4est, p4est_topidx_t which_tree,
     return 1;
 }
 
-void
-fclaw2d_domain_search_points (fclaw2d_domain_t * domain,
-                              sc_array_t * block_offsets,
-                              sc_array_t * coordinates, sc_array_t * results)
+/** Find the process whose partition contains a point.
+ * We use the smallest possible quadrant whose lower corner is at or below
+ * the point.  It is owned by exactly one process, and the leaf containing it
+ * also contains the point.  This requires no communication.
+ */
+static int
+search_point_owner (p4est_t * p4est, int jb, const double *xyentry)
+{
+    int i;
+    double r;
+    p4est_qcoord_t c[P4EST_DIM];
+    p4est_quadrant_t q;
+    const p4est_qcoord_t qh = P4EST_QUADRANT_LEN (P4EST_QMAXLEVEL);
+
+    for (i = 0; i < P4EST_DIM; ++i)
+    {
+        r = SC_MAX (xyentry[i], 0.) * (double) P4EST_ROOT_LEN;
+        c[i] = r >= (double) (P4EST_ROOT_LEN - qh) ?
+            P4EST_ROOT_LEN - qh : (p4est_qcoord_t) r & ~(qh - 1);
+    }
+    P4EST_QUADRANT_INIT (&q);
+    q.x = c[0];
+    q.y = c[1];
+#ifdef P4_TO_P8
+    q.z = c[2];
+#endif
+    q.level = P4EST_QMAXLEVEL;
+
+    return p4est_comm_find_owner (p4est, (p4est_topidx_t) jb, &q,
+                                  p4est->mpirank);
+}
+
+static void
+search_points_internal (fclaw2d_domain_t * domain,
+                        sc_array_t * block_offsets,
+                        sc_array_t * coordinates, sc_array_t * results,
+                        int local)
 {
     int ip, jb, mpiret;
     int num_blocks;
     int num_points;
+    int num_searched;
     int pbegin, pend;
     int *pentry;
     int *found;
@@ -1060,8 +1096,14 @@ fclaw2d_domain_search_points (fclaw2d_domain_t * domain,
         *(int *) sc_array_index_int (results, ip) = -1;
     }
 
+    wrap = (p4est_wrap_t *) domain->pp;
+    FCLAW_ASSERT (wrap != NULL);
+    p4est = wrap->p4est;
+    FCLAW_ASSERT (p4est != NULL);
+
     /* construct input set for p4est search: block and point number */
     points = sc_array_new_size (2 * sizeof (int), num_points);
+    num_searched = 0;
     pbegin = 0;
     for (jb = 0; jb < num_blocks; ++jb)
     {
@@ -1071,13 +1113,21 @@ fclaw2d_domain_search_points (fclaw2d_domain_t * domain,
         /* managemant data used internal to the p4est search */
         for (ip = pbegin; ip < pend; ++ip)
         {
-            pentry = (int *) sc_array_index (points, ip);
+            if (local && search_point_owner
+                (p4est, jb, (double *) sc_array_index_int (coordinates, ip))
+                != domain->mpirank)
+            {
+                /* another process reports this point */
+                continue;
+            }
+            pentry = (int *) sc_array_index (points, num_searched++);
             pentry[0] = jb;
             pentry[1] = ip;
         }
         pbegin = pend;
     }
     FCLAW_ASSERT (pbegin == num_points);
+    sc_array_resize (points, num_searched);
 
     /* stash relevant information to pass to search */
     sd->domain = domain;
@@ -1085,10 +1135,6 @@ fclaw2d_domain_search_points (fclaw2d_domain_t * domain,
     sd->results = results;
 
     /* process-local search through p4est */
-    wrap = (p4est_wrap_t *) domain->pp;
-    FCLAW_ASSERT (wrap != NULL);
-    p4est = wrap->p4est;
-    FCLAW_ASSERT (p4est != NULL);
     FCLAW_ASSERT (p4est->connectivity != NULL);
     FCLAW_ASSERT (p4est->connectivity->num_trees ==
                   (p4est_topidx_t) num_blocks);
@@ -1097,6 +1143,13 @@ fclaw2d_domain_search_points (fclaw2d_domain_t * domain,
     p4est_search_local (p4est, 0, NULL, search_point_fn, points);
     p4est->user_pointer = user_save;
 
+    if (local)
+    {
+        /* every point has been searched on one process only */
+        sc_array_destroy (points);
+        return;
+    }
+
     /* synchronize results in parallel */
     found = FCLAW_ALLOC (int, num_points);
     for (ip = 0; ip < num_points; ++ip)
@@ -1123,6 +1176,23 @@ fclaw2d_domain_search_points (fclaw2d_domain_t * domain,
     sc_array_destroy (points);
 }
 
+void
+fclaw2d_domain_search_points (fclaw2d_domain_t * domain,
+                              sc_array_t * block_offsets,
+                              sc_array_t * coordinates, sc_array_t * results)
+{
+    search_points_internal (domain, block_offsets, coordinates, results, 0);
+}
+
+void
+fclaw2d_domain_search_points_local (fclaw2d_domain_t * domain,
+                                    sc_array_t * block_offsets,
+                                    sc_array_t * coordinates,
+                                    sc_array_t * results)
+{
+    search_points_internal (domain, block_offsets, coordinates, results, 1);
+}
+
 typedef struct fclaw2d_ray_integral
 {
     void *ray;
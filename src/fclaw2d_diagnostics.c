@@ -48,10 +48,12 @@ void diagnostics_vt_destroy(void* vt)
     Public interface
     ------------------------------------------------ */
 
+static int vt_slot = -1;
+
 fclaw2d_diagnostics_vtable_t* fclaw2d_diagnostics_vt(fclaw2d_global_t* glob)
 {
 	fclaw2d_diagnostics_vtable_t* diagnostics_vt = (fclaw2d_diagnostics_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fclaw2d_diagnostics");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(diagnostics_vt != NULL);
 	FCLAW_ASSERT(diagnostics_vt->is_set != 0);
     return diagnostics_vt;
@@ -86,6 +88,7 @@ void fclaw2d_diagnostics_vtable_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fclaw2d_diagnostics") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fclaw2d_diagnostics", diag_vt, diagnostics_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fclaw2d_diagnostics");
 }
 
 
@@ -133,6 +133,8 @@ void elliptic_vt_destroy(void* vt)
 }
 
 
+static int vt_slot = -1;
+
 void fclaw2d_elliptic_vtable_initialize(fclaw2d_global_t* glob)
 {
     fclaw2d_elliptic_vtable_t *elliptic_vt = elliptic_vt_new();
@@ -144,6 +146,7 @@ void fclaw2d_elliptic_vtable_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fclaw2d_elliptic") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fclaw2d_elliptic", elliptic_vt, elliptic_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fclaw2d_elliptic");
 }
 
 /*----------------------------------- Access functions -------------------------------- */
@@ -151,7 +154,7 @@ void fclaw2d_elliptic_vtable_initialize(fclaw2d_global_t* glob)
 fclaw2d_elliptic_vtable_t* fclaw2d_elliptic_vt(fclaw2d_global_t* glob)
 {
 	fclaw2d_elliptic_vtable_t* elliptic_vt = (fclaw2d_elliptic_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fclaw2d_elliptic");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(elliptic_vt != NULL);
 	FCLAW_ASSERT(elliptic_vt->is_set != 0);
 	return elliptic_vt;
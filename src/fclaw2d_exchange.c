@@ -75,7 +75,8 @@ void build_remote_ghost_patches(fclaw2d_global_t* glob)
     int blockno, patchno;
     fclaw2d_patch_t *ghost_patch;
     fclaw2d_build_mode_t build_mode;
-    if (gparms->ghost_patch_pack_area)
+    if (gparms->ghost_patch_pack_area ||
+        fclaw2d_patch_ghost_metric_packsize(glob) > 0)
     {
         build_mode = FCLAW2D_BUILD_FOR_GHOST_AREA_PACKED;
     }
@@ -117,6 +118,58 @@ void delete_remote_ghost_patches(fclaw2d_global_t* glob)
 }
 
 
+/* Metric data (e.g. area) for remote ghost patches is sent once, and is 
+   then kept with the ghost patches until the next regrid. */
+static
+void exchange_ghost_metric(fclaw2d_global_t* glob)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    size_t msize = fclaw2d_patch_ghost_metric_packsize(glob);
+    if (msize == 0)
+    {
+        return;
+    }
+
+    fclaw2d_domain_exchange_t *e = 
+        fclaw2d_domain_allocate_before_exchange (domain, msize);
+
+    int zz = 0;
+    int nb;
+    for (nb = 0; nb < domain->num_blocks; ++nb)
+    {
+        int np;
+        for (np = 0; np < domain->blocks[nb].num_patches; ++np)
+        {
+            fclaw2d_patch_t *this_patch = &domain->blocks[nb].patches[np];
+            if (this_patch->flags & FCLAW2D_PATCH_ON_PARALLEL_BOUNDARY)
+            {
+                e->patch_data[zz] = (void*) FCLAW_ALLOC(char,msize);
+                fclaw2d_patch_local_ghost_metric_pack(glob,this_patch,
+                                                      e->patch_data[zz]);
+                zz++;
+            }
+        }
+    }
+
+    fclaw2d_domain_ghost_exchange(domain, e, domain->global_minlevel,
+                                  domain->global_maxlevel);
+
+    int i;
+    for(i = 0; i < domain->num_ghost_patches; i++)
+    {
+        fclaw2d_patch_t* ghost_patch = &domain->ghost_patches[i];
+        int blockno = ghost_patch->u.blockno;
+        fclaw2d_patch_remote_ghost_metric_unpack(glob,ghost_patch,blockno,i,
+                                                 e->ghost_data[i]);
+    }
+
+    for (i = 0; i < zz; i++)
+    {
+        FCLAW_FREE(e->patch_data[i]);
+    }
+    fclaw2d_domain_free_after_exchange (domain, e);
+}
+
 static void
 unpack_remote_ghost_patches(fclaw2d_global_t* glob,
                             fclaw2d_domain_exchange_t *e,
@@ -239,6 +292,9 @@ void fclaw2d_exchange_setup(fclaw2d_global_t* glob,
 
     fclaw2d_timer_start (&glob->timers[FCLAW2D_TIMER_GHOSTPATCH_COMM]);
     fclaw2d_domain_indirect_end(domain,ind);
+
+    /* Send metric data for the ghost patches built above */
+    exchange_ghost_metric(glob);
     fclaw2d_timer_stop (&glob->timers[FCLAW2D_TIMER_GHOSTPATCH_COMM]);
 
     if (running != FCLAW2D_TIMER_NONE)
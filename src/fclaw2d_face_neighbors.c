@@ -370,10 +370,12 @@ void cb_face_fill(fclaw2d_domain_t *domain,
 					fclaw2d_patch_t *neighbor_patch = neighbor_patches[0];
 					transform_data.neighbor_patch = neighbor_patch;
 
-					if (time_sync_samesize)    // && is_block_face)
+					if (time_sync_samesize)
 					{
-						/* Correct for metric discontinuities at block boundaries */
-						if (!fclaw2d_patch_is_ghost(this_patch))
+						/* Correct for metric discontinuities at block boundaries.
+						   Inside a block, both patches see the same fluxes and
+						   no registers are kept for the face. */
+						if (is_block_face && !fclaw2d_patch_is_ghost(this_patch))
 						{							
 							fclaw2d_patch_time_sync_samesize(s->glob,this_patch,
 							                                 neighbor_patch,
@@ -396,13 +398,16 @@ void cb_face_fill(fclaw2d_domain_t *domain,
 						/* Create a new transform so we don't mess up the original one */
 						int this_iface = iface_neighbor;
 
-						if (time_sync_samesize) // && is_block_face)
+						if (time_sync_samesize)
 						{
 							/* Correct ghost patches, since these will be used to copy or
 							interpolate to local grids. */
-							fclaw2d_patch_time_sync_samesize(s->glob,neighbor_patch,this_patch,
-							                                 this_iface,idir,
-							                                 &transform_data_finegrid);                            
+							if (is_block_face)
+							{
+								fclaw2d_patch_time_sync_samesize(s->glob,neighbor_patch,this_patch,
+								                                 this_iface,idir,
+								                                 &transform_data_finegrid);
+							}
 						}
 						else
 						{
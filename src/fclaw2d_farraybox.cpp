@@ -28,6 +28,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw2d_farraybox.hpp>
 
+#include <new>
+#include <utility>
+
 /* Difference in nan values :
    The first one is not trapped; the second one is.
 
@@ -69,6 +72,20 @@ void fclaw2d_farraybox_set_to_nan(double& f)
     set_snan(f);
 }
 
+/* Data is aligned for SIMD loads;  see FCLAW2D_FARRAYBOX_ALIGNMENT */
+static
+double* data_alloc(int size)
+{
+    return static_cast<double*>(::operator new[](size*sizeof(double),
+                                std::align_val_t(FCLAW2D_FARRAYBOX_ALIGNMENT)));
+}
+
+static
+void data_free(double *data)
+{
+    ::operator delete[](data, std::align_val_t(FCLAW2D_FARRAYBOX_ALIGNMENT));
+}
+
 
 
 FArrayBox::FArrayBox()
@@ -83,18 +100,23 @@ FArrayBox::~FArrayBox()
 {
     if (m_data != NULL)
     {
-        delete [] m_data;
+        data_free(m_data);
         m_data = NULL;
     }
 }
 
 FArrayBox::FArrayBox(const FArrayBox& A)
 {
+    m_data = NULL;
+    m_size = 0;
+    set_dataPtr(A.m_size);
     m_box = A.m_box;
     m_size = A.m_size;
     m_fields = A.m_fields;
-    /* A re-allocation, but should hopefully, memory management should be okay */
-    set_dataPtr(A.m_size);
+    if (m_size > 0)
+    {
+        memcpy(m_data,A.m_data,m_size*sizeof(double));
+    }
 }
 
 void FArrayBox::set_dataPtr(int a_size)
@@ -108,7 +130,7 @@ void FArrayBox::set_dataPtr(int a_size)
     {
         if (m_data != NULL)
         {
-            delete [] m_data;
+            data_free(m_data);
         }
         m_data = NULL;
     }
@@ -118,10 +140,10 @@ void FArrayBox::set_dataPtr(int a_size)
         {
             if (m_data != NULL)
             {
-                delete [] m_data;
+                data_free(m_data);
                 m_data = NULL;
             }
-            m_data = new double[a_size];
+            m_data = data_alloc(a_size);
         }
         else
         {
@@ -238,6 +260,15 @@ void FArrayBox::operator=(const FArrayBox& fbox)
     }
 }
 
+// exchange data without copying
+void FArrayBox::swap(FArrayBox& fbox)
+{
+    std::swap(m_data,fbox.m_data);
+    std::swap(m_size,fbox.m_size);
+    std::swap(m_box,fbox.m_box);
+    std::swap(m_fields,fbox.m_fields);
+}
+
 double* FArrayBox::dataPtr()
 {
     return m_data;
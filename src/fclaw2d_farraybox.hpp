@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_defs.h>
 #include <vector>
 
+/** Alignment in bytes of FArrayBox data (one AVX-512 register) */
+#define FCLAW2D_FARRAYBOX_ALIGNMENT 64
+
 void fclaw2d_farraybox_set_to_nan(double& f);
 
 class Box
@@ -62,6 +65,7 @@ public:
     void set_to_big_number();
     int size();
     void operator=(const FArrayBox& fbox);
+    void swap(FArrayBox& fbox);
     void copyToMemory(double *data);
     void copyFromMemory(double *data);
 private:
@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw2d_farraybox.hpp>
+#include <test.hpp>
+#include <cstdint>
+
+namespace
+{
+    Box make_box(int mx, int my)
+    {
+        int ll[2] = {0, 0};
+        int ur[2] = {mx - 1, my - 1};
+        return Box(ll,ur,2);
+    }
+
+    bool is_aligned(double *q)
+    {
+        return reinterpret_cast<uintptr_t>(q) % FCLAW2D_FARRAYBOX_ALIGNMENT == 0;
+    }
+}
+
+TEST_CASE("FArrayBox data is aligned")
+{
+    for(int mx : {1, 3, 8, 13})
+    for(int fields : {1, 2, 5})
+    {
+        FArrayBox fab;
+        fab.define(make_box(mx,mx + 1),fields);
+
+        CHECK(fab.size() == mx*(mx + 1)*fields);
+        CHECK(is_aligned(fab.dataPtr()));
+    }
+}
+
+TEST_CASE("FArrayBox stays aligned when redefined")
+{
+    FArrayBox fab;
+    fab.define(make_box(4,4),1);
+    fab.define(make_box(7,3),3);
+
+    CHECK(fab.size() == 7*3*3);
+    CHECK(is_aligned(fab.dataPtr()));
+}
+
+TEST_CASE("FArrayBox copy constructor copies data")
+{
+    FArrayBox a;
+    a.define(make_box(5,3),2);
+    for(int i = 0; i < a.size(); i++)
+    {
+        a.dataPtr()[i] = i;
+    }
+
+    FArrayBox b(a);
+
+    CHECK(b.size() == a.size());
+    CHECK(b.fields() == a.fields());
+    CHECK(b.box().boxDim() == 2);
+    CHECK(b.box().bigEnd(0) == 4);
+    CHECK(b.box().bigEnd(1) == 2);
+    CHECK(b.dataPtr() != a.dataPtr());
+    CHECK(is_aligned(b.dataPtr()));
+    for(int i = 0; i < b.size(); i++)
+    {
+        CHECK(b.dataPtr()[i] == i);
+    }
+
+    /* The copy owns its data */
+    a.dataPtr()[0] = -1;
+    CHECK(b.dataPtr()[0] == 0);
+}
+
+TEST_CASE("FArrayBox copy constructor of an empty box")
+{
+    FArrayBox a;
+    FArrayBox b(a);
+
+    CHECK(b.size() == 0);
+    CHECK(b.dataPtr() == nullptr);
+}
+
+TEST_CASE("FArrayBox assignment of an empty box frees data")
+{
+    FArrayBox a;
+    a.define(make_box(4,4),1);
+
+    a = FArrayBox();
+
+    CHECK(a.size() == 0);
+    CHECK(a.dataPtr() == nullptr);
+}
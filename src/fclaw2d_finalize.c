@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_options.h>
 #include <fclaw2d_map.h>
 #include <fclaw2d_domain.h>
+#include <fclaw2d_output.h>
 #include <fclaw2d_forestclaw.h>
 
 /* ------------------------------------------------------------------
@@ -42,6 +43,7 @@ void fclaw2d_finalize(fclaw2d_global_t* glob)
 
     fclaw_global_essentialf("Finalizing run\n");
     fclaw2d_diagnostics_finalize(glob);
+    fclaw2d_output_flush(glob);
     fclaw2d_map_destroy(glob->cont);
     fclaw2d_domain_barrier (glob->domain);
 
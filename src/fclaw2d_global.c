@@ -82,6 +82,7 @@ fclaw2d_global_t* fclaw2d_global_new (void)
     glob->pkg_container = fclaw_package_container_new ();
     glob->vtables = fclaw_pointer_map_new ();
     glob->options = fclaw_pointer_map_new ();
+    glob->attributes = fclaw_pointer_map_new ();
 
     glob->count_amr_advance = 0;
     glob->count_ghost_exchange = 0;
@@ -94,6 +95,7 @@ fclaw2d_global_t* fclaw2d_global_new (void)
     glob->count_single_step = 0;
     glob->count_elliptic_grids = 0;
     glob->curr_time = 0;
+    glob->domain_revision = 0;
     glob->cont = NULL;
     glob->acc = FCLAW_ALLOC(fclaw2d_diagnostics_accumulator_t, 1);
 
@@ -103,6 +105,7 @@ void
 fclaw2d_global_store_domain (fclaw2d_global_t* glob, fclaw2d_domain_t* domain)
 {
     glob->domain = domain;
+    ++glob->domain_revision;
     glob->mpicomm = domain->mpicomm;
     glob->mpisize = domain->mpisize;
     glob->mpirank = domain->mpirank;
@@ -119,6 +122,7 @@ fclaw2d_global_destroy (fclaw2d_global_t * glob)
     fclaw_package_container_destroy ((fclaw_package_container_t *)glob->pkg_container);
     fclaw_pointer_map_destroy (glob->vtables);
     fclaw_pointer_map_destroy (glob->options);
+    fclaw_pointer_map_destroy (glob->attributes);
 
     FCLAW_FREE (glob->acc);
     FCLAW_FREE (glob);
@@ -79,9 +79,11 @@ struct fclaw2d_global
 
     struct fclaw_pointer_map *vtables;    /**< Vtables */
     struct fclaw_pointer_map *options;    /**< options */
+    struct fclaw_pointer_map *attributes; /**< State kept by modules between calls */
  
     struct fclaw2d_map_context* cont;
     struct fclaw2d_domain *domain;
+    int domain_revision;      /**< Incremented whenever domain is replaced */
 
     struct fclaw2d_diagnostics_accumulator *acc;
 
@@ -24,8 +24,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <fclaw2d_global.h>
+#include <fclaw_pointer_map.h>
 #include <test.hpp>
 
+TEST_CASE("fclaw2d_global_new attributes are separate for each glob")
+{
+	fclaw2d_global_t* glob1 = fclaw2d_global_new();
+	fclaw2d_global_t* glob2 = fclaw2d_global_new();
+
+	CHECK_EQ(glob1->domain_revision, 0);
+
+	static bool destroyed = false;
+	fclaw_pointer_map_insert(glob1->attributes, "attribute", (void*) 1, 
+	                         [](void* v){ destroyed = true; });
+	CHECK_EQ(fclaw_pointer_map_get(glob1->attributes, "attribute"), (void*) 1);
+	CHECK_EQ(fclaw_pointer_map_get(glob2->attributes, "attribute"), nullptr);
+
+	fclaw2d_global_destroy(glob2);
+	CHECK_UNARY_FALSE(destroyed);
+	fclaw2d_global_destroy(glob1);
+	CHECK_UNARY(destroyed);
+}
+
 TEST_CASE("fclaw2d_global_set_global")
 {
 	fclaw2d_global_t* glob = (fclaw2d_global_t*)123;
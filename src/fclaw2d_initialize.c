@@ -205,6 +205,7 @@ void fclaw2d_initialize(fclaw2d_global_t *glob)
                 /* free all memory associated with old domain */
                 fclaw2d_domain_reset(glob);
                 *domain = new_domain;
+                ++glob->domain_revision;
                 new_domain = NULL;
 
                 /* Repartition domain to new processors.    */
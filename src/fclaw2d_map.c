@@ -68,6 +68,38 @@ FCLAW2D_MAP_C2M (fclaw2d_map_context_t ** pcont, int *blockno,
 }
 
 
+void
+fclaw2d_map_c2m_batch (fclaw2d_map_context_t * cont, int blockno, int n,
+                       const double xc[], const double yc[],
+                       double xp[], double yp[], double zp[])
+{
+    int i;
+    if (cont->mapc2m_batch != NULL)
+    {
+        cont->mapc2m_batch (cont, blockno, n, xc, yc, xp, yp, zp);
+        return;
+    }
+
+    /* Fall back on the pointwise map */
+    FCLAW_ASSERT(cont->mapc2m != NULL);
+    for (i = 0; i < n; i++)
+    {
+        cont->mapc2m (cont, blockno, xc[i], yc[i], &xp[i], &yp[i], &zp[i]);
+    }
+}
+
+/* This function can be called from Fortran inside of ClawPatch. */
+
+void
+FCLAW2D_MAP_C2M_BATCH (fclaw2d_map_context_t ** pcont, int *blockno,
+                       const int *n,
+                       const double xc[], const double yc[],
+                       double xp[], double yp[], double zp[])
+{
+    fclaw2d_map_c2m_batch (*pcont, *blockno, *n, xc, yc, xp, yp, zp);
+}
+
+
 /* This function can be called from Fortran inside of ClawPatch. */
 
 void
@@ -136,6 +168,28 @@ void FCLAW2D_MAP_BRICK2C (fclaw2d_map_context_t ** pcont, int *blockno,
     }
 }
 
+void fclaw2d_map_brick2c_batch (fclaw2d_map_context_t * cont, int blockno,
+                                int n, const double xc[], const double yc[],
+                                double xp[], double yp[], double zp[])
+{
+    int i;
+    if (cont->brick != NULL)
+    {
+        fclaw2d_map_c2m_batch (cont->brick, blockno, n, xc, yc, xp, yp, zp);
+    }
+    else
+    {
+        /* We only have one tree */
+        FCLAW_ASSERT(blockno == 0);
+        for (i = 0; i < n; i++)
+        {
+            xp[i] = xc[i];
+            yp[i] = yc[i];
+            zp[i] = 0;
+        }
+    }
+}
+
 /* This function is expected to be called from C or C++. */
 void
 fclaw2d_map_destroy (fclaw2d_map_context_t * cont)
@@ -552,3 +606,51 @@ void rotate_map(fclaw2d_map_context_t* cont, double *xp, double *yp, double *zp)
     *zp = vrot[2];
 }
 
+void scale_map_batch(fclaw2d_map_context_t* cont, int n,
+                     double xp[], double yp[], double zp[])
+{
+    const double sx = cont->scale[0];
+    const double sy = cont->scale[1];
+    const double sz = cont->scale[2];
+    int i;
+    for(i = 0; i < n; i++)
+    {
+        xp[i] *= sx;
+        yp[i] *= sy;
+        zp[i] *= sz;
+    }
+}
+
+void shift_map_batch(fclaw2d_map_context_t* cont, int n,
+                     double xp[], double yp[], double zp[])
+{
+    const double sx = cont->shift[0];
+    const double sy = cont->shift[1];
+    const double sz = cont->shift[2];
+    int i;
+    for(i = 0; i < n; i++)
+    {
+        xp[i] += sx;
+        yp[i] += sy;
+        zp[i] += sz;
+    }
+}
+
+void rotate_map_batch(fclaw2d_map_context_t* cont, int n,
+                      double xp[], double yp[], double zp[])
+{
+    /* Copy the matrix so the compiler knows it isn't aliased by xp,yp,zp */
+    double r[9];
+    int i;
+    memcpy(r,cont->rotate,9*sizeof(double));
+
+    for(i = 0; i < n; i++)
+    {
+        const double x = xp[i];
+        const double y = yp[i];
+        const double z = zp[i];
+        xp[i] = r[0]*x + r[3]*y + r[6]*z;
+        yp[i] = r[1]*x + r[4]*y + r[7]*z;
+        zp[i] = r[2]*x + r[5]*y + r[8]*z;
+    }
+}
@@ -76,6 +76,23 @@ typedef void (*fclaw2d_map_c2m_t) (fclaw2d_map_context_t * cont, int blockno,
                                    double xc, double yc,
                                    double *xp, double *yp, double *zp);
 
+/** This function performs the coordinate transformation for an array
+ * of points in a single block.
+ * \param [in] cont     Matching mapping context.
+ * \param [in] blockno  Number of the block to be transformed.
+ * \param [in] n        Number of points.
+ * \param [in] xc       X-coordinates in [block->xlower, block->xupper].
+ * \param [in] yc       Y-coordinates in [block->ylower, block->yupper].
+ * \param [out] xp      Transformed x-coordinates, length n.
+ * \param [out] yp      Transformed y-coordinates, length n.
+ * \param [out] zp      Transformed z-coordinates, length n.
+ */
+typedef void (*fclaw2d_map_c2m_batch_t) (fclaw2d_map_context_t * cont,
+                                         int blockno, int n,
+                                         const double xc[], const double yc[],
+                                         double xp[], double yp[],
+                                         double zp[]);
+
 
 
 /* Covariant and contravariant basis vectors needed for exact solution */
@@ -108,6 +125,7 @@ struct fclaw2d_map_context
     fclaw2d_map_query_t       query;
 
     fclaw2d_map_c2m_t         mapc2m;
+    fclaw2d_map_c2m_batch_t   mapc2m_batch;   /* Optional; see fclaw2d_map_c2m_batch */
     fclaw2d_map_c2m_basis_t   basis;
 
     fclaw3dx_map_c2m_t         mapc2m_3dx;   /* Takes a 2d context */
@@ -146,6 +164,14 @@ void shift_map(fclaw2d_map_context_t* cont,
 void rotate_map(fclaw2d_map_context_t* cont,
                 double *xp, double *yp, double *zp);
 
+/* Array versions of the transforms above */
+void scale_map_batch(fclaw2d_map_context_t* cont, int n,
+                     double xp[], double yp[], double zp[]);
+void shift_map_batch(fclaw2d_map_context_t* cont, int n,
+                     double xp[], double yp[], double zp[]);
+void rotate_map_batch(fclaw2d_map_context_t* cont, int n,
+                      double xp[], double yp[], double zp[]);
+
 #define SET_ROTATION_MATRIX FCLAW_F77_FUNC (set_rotation_matrix,SET_ROTATION_MATRIX)
 void SET_ROTATION_MATRIX (const double rot_angles[],double rrot[]);
 
@@ -180,6 +206,30 @@ void FCLAW2D_MAP_C2M (fclaw2d_map_context_t ** cont, int *blockno,
                       double *xp, double *yp, double *zp);
 
 
+/** Map an array of points in a single block.
+ * Uses the \a mapc2m_batch member of the context if it is set and
+ * otherwise calls \a mapc2m once for each point.
+ * \param [in] cont     Mapping context with matching callback functions.
+ * \param [in] blockno  Number of the block to be transformed.
+ * \param [in] n        Number of points.
+ * \param [in] xc, yc   Coordinates of the points in the block.
+ * \param [out] xp, yp, zp      Transformed coordinates, each of length n.
+ */
+void fclaw2d_map_c2m_batch (fclaw2d_map_context_t * cont, int blockno, int n,
+                            const double xc[], const double yc[],
+                            double xp[], double yp[], double zp[]);
+
+/** Batch mapping function that can be called from Fortran.
+ * See fclaw2d_map_c2m_batch.
+ */
+#define FCLAW2D_MAP_C2M_BATCH FCLAW_F77_FUNC_(fclaw2d_map_c2m_batch, \
+                                              FCLAW2D_MAP_C2M_BATCH)
+void FCLAW2D_MAP_C2M_BATCH (fclaw2d_map_context_t ** cont, int *blockno,
+                            const int *n,
+                            const double xc[], const double yc[],
+                            double xp[], double yp[], double zp[]);
+
+
 #define FCLAW2D_MAP_C2M_BASIS FCLAW_F77_FUNC_(fclaw2d_map_c2m_basis, \
                                               FCLAW2D_MAP_C2M_BASIS)
 
@@ -220,6 +270,12 @@ void FCLAW2D_MAP_BRICK2C (fclaw2d_map_context_t ** cont, int *blockno,
                           const double *xc, const double *yc,
                           double *xp, double *yp, double *zp);
 
+/** Array version of FCLAW2D_MAP_BRICK2C.  The z-coordinates are set to 0.
+ */
+void fclaw2d_map_brick2c_batch (fclaw2d_map_context_t * cont, int blockno,
+                                int n, const double xc[], const double yc[],
+                                double xp[], double yp[], double zp[]);
+
 
 /** Deallocate a mapping context.
  * If the \a destroy member is not NULL, it is called on the context.
@@ -390,6 +446,34 @@ void MAPC2M_ANNULUS (int* blockno, double *xc, double *yc,
                      double *xp, double *yp, double *zp, double *alpha,
                      double *theta);
 
+/* ----------------------------------------------------------------------------------
+   Array versions of the generic mappings above, written in C so that the loops
+   over points can be vectorized.  These compute the same geometry as the Fortran
+   routines (unit radius, no scaling, shift or rotation).  Use them to set the
+   'mapc2m_batch' member of a mapping context.
+   ---------------------------------------------------------------------------------- */
+
+/** Cubed sphere; see MAPC2M_CUBEDSPHERE. */
+void fclaw2d_map_batch_cubedsphere (int blockno, int n,
+                                    const double xc[], const double yc[],
+                                    double xp[], double yp[], double zp[]);
+
+/** Pillow sphere; see MAPC2M_PILLOWSPHERE.  Block 1 is the lower hemisphere. */
+void fclaw2d_map_batch_pillowsphere (int blockno, int n,
+                                     const double xc[], const double yc[],
+                                     double xp[], double yp[], double zp[]);
+
+/** Pillow disk; see MAPC2M_PILLOWDISK. */
+void fclaw2d_map_batch_pillowdisk (int blockno, int n,
+                                   const double xc[], const double yc[],
+                                   double xp[], double yp[], double zp[]);
+
+/** Torus; see MAPC2M_TORUS.  Coordinates are expected in [0,1]x[0,1].
+ * The inputs may be the same arrays as xp and yp. */
+void fclaw2d_map_batch_torus (int n, const double xc[], const double yc[],
+                              double xp[], double yp[], double zp[],
+                              double alpha, double beta);
+
 /* ---------------------------------------------------------------------------------- */
 
 #ifdef __cplusplus
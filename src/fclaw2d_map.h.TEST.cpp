@@ -0,0 +1,129 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw2d_map.h>
+#include <test.hpp>
+
+static void
+test_c2m (fclaw2d_map_context_t * cont, int blockno,
+          double xc, double yc,
+          double *xp, double *yp, double *zp)
+{
+	*xp = xc*xc + blockno;
+	*yp = xc*yc;
+	*zp = yc - xc;
+}
+
+TEST_CASE("fclaw2d_map_c2m_batch falls back on mapc2m")
+{
+	fclaw2d_map_context_t* cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
+	cont->mapc2m = test_c2m;
+
+	const int n = 7;
+	double xc[n], yc[n], xp[n], yp[n], zp[n];
+	for(int i = 0; i < n; i++)
+	{
+		xc[i] = 0.1*i;
+		yc[i] = 1.0 - 0.05*i;
+	}
+
+	fclaw2d_map_c2m_batch(cont, 3, n, xc, yc, xp, yp, zp);
+
+	for(int i = 0; i < n; i++)
+	{
+		double x, y, z;
+		test_c2m(cont, 3, xc[i], yc[i], &x, &y, &z);
+		CHECK_EQ(xp[i], x);
+		CHECK_EQ(yp[i], y);
+		CHECK_EQ(zp[i], z);
+	}
+
+	fclaw2d_map_destroy(cont);
+}
+
+TEST_CASE("fclaw2d_map scale, shift and rotate batch match pointwise versions")
+{
+	fclaw2d_map_context_t* cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
+	const double scale[3] = {2.0, 0.5, 3.0};
+	const double shift[3] = {1.0, -1.0, 0.25};
+	for(int k = 0; k < 9; k++)
+	{
+		cont->rotate[k] = 0.1*(k + 1);
+	}
+	set_scale(cont, scale);
+	set_shift(cont, shift);
+
+	const int n = 5;
+	double xp[n], yp[n], zp[n];
+	for(int i = 0; i < n; i++)
+	{
+		xp[i] = 0.3*i;
+		yp[i] = 1.0 - 0.2*i;
+		zp[i] = 0.1*i*i;
+	}
+	double x[n], y[n], z[n];
+	for(int i = 0; i < n; i++)
+	{
+		x[i] = xp[i];
+		y[i] = yp[i];
+		z[i] = zp[i];
+		scale_map(cont, &x[i], &y[i], &z[i]);
+		shift_map(cont, &x[i], &y[i], &z[i]);
+		rotate_map(cont, &x[i], &y[i], &z[i]);
+	}
+
+	scale_map_batch(cont, n, xp, yp, zp);
+	shift_map_batch(cont, n, xp, yp, zp);
+	rotate_map_batch(cont, n, xp, yp, zp);
+
+	for(int i = 0; i < n; i++)
+	{
+		CHECK_EQ(xp[i], doctest::Approx(x[i]));
+		CHECK_EQ(yp[i], doctest::Approx(y[i]));
+		CHECK_EQ(zp[i], doctest::Approx(z[i]));
+	}
+
+	fclaw2d_map_destroy(cont);
+}
+
+TEST_CASE("fclaw2d_map_brick2c_batch without brick is the identity")
+{
+	fclaw2d_map_context_t* cont = fclaw2d_map_new_nomap_brick(NULL);
+
+	const int n = 3;
+	double xc[n] = {0.0, 0.5, 1.0};
+	double yc[n] = {1.0, 0.25, 0.0};
+	double xp[n], yp[n], zp[n];
+	fclaw2d_map_c2m_batch(cont, 0, n, xc, yc, xp, yp, zp);
+
+	for(int i = 0; i < n; i++)
+	{
+		CHECK_EQ(xp[i], xc[i]);
+		CHECK_EQ(yp[i], yc[i]);
+		CHECK_EQ(zp[i], 0.0);
+	}
+
+	fclaw2d_map_destroy(cont);
+}
@@ -78,6 +78,25 @@ fclaw2d_map_c2m_brick(fclaw2d_map_context_t * cont, int blockno,
     *zp = 0;
 }
 
+static void
+fclaw2d_map_c2m_batch_brick(fclaw2d_map_context_t * cont, int blockno, int n,
+                            const double xc[], const double yc[],
+                            double xp[], double yp[], double zp[])
+{
+    fclaw2d_block_ll_t *bv = (fclaw2d_block_ll_t *) cont->user_data;
+    const double xv = bv->xv[blockno];
+    const double yv = bv->yv[blockno];
+    const double mi = bv->mi;
+    const double mj = bv->mj;
+    int i;
+    for (i = 0; i < n; i++)
+    {
+        xp[i] = (xv + xc[i])/mi;
+        yp[i] = (yv + yc[i])/mj;
+        zp[i] = 0;
+    }
+}
+
 void fclaw2d_map_destroy_brick(fclaw2d_map_context_t *cont)
 {
     fclaw2d_block_ll_t *bv = (fclaw2d_block_ll_t *) cont->user_data;
@@ -100,6 +119,7 @@ fclaw2d_map_context_t* fclaw2d_map_new_brick(p4est_connectivity_t *conn,
     cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
     cont->query = fclaw2d_map_query_brick;
     cont->mapc2m = fclaw2d_map_c2m_brick;
+    cont->mapc2m_batch = fclaw2d_map_c2m_batch_brick;
     cont->destroy = fclaw2d_map_destroy_brick;
 
     nb = (int) conn->num_trees;
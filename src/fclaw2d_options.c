@@ -32,16 +32,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
    Public interface to ForestClaw options
    --------------------------------------------------------- */
 
+static int options_slot = -1;
+
 void fclaw2d_options_store (fclaw2d_global_t *glob, fclaw_options_t* gparms)
 {
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->options,"fclaw2d") == NULL);
 	fclaw_pointer_map_insert(glob->options, "fclaw2d", gparms, NULL);
+	options_slot = fclaw_pointer_map_slot("fclaw2d");
 }
 
 fclaw_options_t* fclaw2d_get_options(fclaw2d_global_t* glob)
 {
     fclaw_options_t* gparms = (fclaw_options_t*) 
-	   							fclaw_pointer_map_get(glob->options, "fclaw2d");
+	   							fclaw_pointer_map_get_slot(glob->options, options_slot);
 	FCLAW_ASSERT(gparms != NULL);
 	return gparms;
 }
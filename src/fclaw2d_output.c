@@ -27,6 +27,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_global.h>
 #include <fclaw2d_options.h>
 #include <fclaw2d_vtable.h>
+#include <fclaw_async_writer.h>
+#include <fclaw_pointer_map.h>
+
+#define OUTPUT_WRITER_NAME "fclaw2d_output_writer"
+
+static void
+output_writer_destroy (void *writer)
+{
+    fclaw_async_writer_destroy ((fclaw_async_writer_t *) writer);
+}
 
 /* -----------------------------------------------------------------------
     Public interface
@@ -71,6 +81,47 @@ fclaw2d_output_frame (fclaw2d_global_t * glob, int iframe)
     }
 }
 
+fclaw_async_writer_t *
+fclaw2d_output_writer (fclaw2d_global_t * glob)
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    if (!fclaw_opt->output_async)
+    {
+        return NULL;
+    }
+
+    fclaw_async_writer_t *writer = (fclaw_async_writer_t *)
+        fclaw_pointer_map_get (glob->attributes, OUTPUT_WRITER_NAME);
+    if (writer == NULL)
+    {
+        size_t max_staged = (size_t) fclaw_opt->output_async_buffer << 20;
+        writer = fclaw_async_writer_new (max_staged);
+        fclaw_pointer_map_insert (glob->attributes, OUTPUT_WRITER_NAME,
+                                  writer, output_writer_destroy);
+    }
+    return writer;
+}
+
+void
+fclaw2d_output_flush (fclaw2d_global_t * glob)
+{
+    fclaw_async_writer_t *writer = (fclaw_async_writer_t *)
+        fclaw_pointer_map_get (glob->attributes, OUTPUT_WRITER_NAME);
+    if (writer == NULL)
+    {
+        return;
+    }
+
+    fclaw2d_timer_start (&glob->timers[FCLAW2D_TIMER_OUTPUT]);
+    int errors = fclaw_async_writer_flush (writer);
+    fclaw2d_timer_stop (&glob->timers[FCLAW2D_TIMER_OUTPUT]);
+
+    if (errors > 0)
+    {
+        fclaw_errorf ("Asynchronous output : %d writes failed\n", errors);
+    }
+}
+
 
 
 
@@ -35,9 +35,30 @@ extern "C"
 #endif
 
 struct fclaw2d_global;  /* This is a hack !! */
+struct fclaw_async_writer;
 
 void fclaw2d_output_frame(struct fclaw2d_global * glob, int iframe);
 
+/**
+ * @brief Get the writer for asynchronous output
+ *
+ * The writer is created on the first call and written out and destroyed 
+ * with the global context.
+ *
+ * @param glob the global context
+ * @return the writer, or NULL if output-async is not set
+ */
+struct fclaw_async_writer* fclaw2d_output_writer(struct fclaw2d_global* glob);
+
+/**
+ * @brief Wait until all asynchronous output is written
+ *
+ * Reports failed writes.  Does nothing if output-async is not set.
+ *
+ * @param glob the global context
+ */
+void fclaw2d_output_flush(struct fclaw2d_global* glob);
+
 void fclaw2d_output_frame_tikz(struct fclaw2d_global* glob, int iframe);
 
 #ifdef __cplusplus
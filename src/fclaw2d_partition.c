@@ -179,6 +179,7 @@ void fclaw2d_partition_domain(fclaw2d_global_t* glob,
         /* then the old domain is no longer necessary */
         fclaw2d_domain_reset(glob);
         *domain = domain_partitioned;
+        ++glob->domain_revision;
         domain_partitioned = NULL;
 
         /* internal clean up */
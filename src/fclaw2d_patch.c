@@ -670,6 +670,36 @@ void fclaw2d_patch_remote_ghost_unpack(fclaw2d_global_t* glob,
 								  this_patch_idx, qdata, time_interp);
 }
 
+size_t fclaw2d_patch_ghost_metric_packsize(fclaw2d_global_t* glob)
+{
+	fclaw2d_patch_vtable_t *patch_vt = fclaw2d_patch_vt(glob);
+	if (patch_vt->ghost_metric_packsize == NULL)
+	{
+		return 0;
+	}
+	return patch_vt->ghost_metric_packsize(glob);
+}
+
+void fclaw2d_patch_local_ghost_metric_pack(fclaw2d_global_t *glob,
+										   fclaw2d_patch_t *this_patch,
+										   void *patch_data)
+{
+	fclaw2d_patch_vtable_t *patch_vt = fclaw2d_patch_vt(glob);
+	FCLAW_ASSERT(patch_vt->local_ghost_metric_pack != NULL);
+	patch_vt->local_ghost_metric_pack(glob,this_patch,patch_data);
+}
+
+void fclaw2d_patch_remote_ghost_metric_unpack(fclaw2d_global_t* glob,
+											  fclaw2d_patch_t* this_patch,
+											  int this_block_idx,
+											  int this_patch_idx,
+											  void *mdata)
+{
+	fclaw2d_patch_vtable_t *patch_vt = fclaw2d_patch_vt(glob);
+	FCLAW_ASSERT(patch_vt->remote_ghost_metric_unpack != NULL);
+	patch_vt->remote_ghost_metric_unpack(glob, this_patch, this_block_idx,
+										 this_patch_idx, mdata);
+}
 
 /* ----------------------------------- Partitioning ----------------------------------- */
 
@@ -789,6 +819,8 @@ void patch_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 void fclaw2d_patch_vtable_initialize(fclaw2d_global_t* glob)
 {
 	fclaw2d_patch_vtable_t *patch_vt = patch_vt_new();
@@ -797,6 +829,7 @@ void fclaw2d_patch_vtable_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fclaw2d_patch") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fclaw2d_patch", patch_vt, patch_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fclaw2d_patch");
 }
 
 /* ------------------------------ User access functions ------------------------------- */
@@ -804,7 +837,7 @@ void fclaw2d_patch_vtable_initialize(fclaw2d_global_t* glob)
 fclaw2d_patch_vtable_t* fclaw2d_patch_vt(fclaw2d_global_t* glob)
 {
 	fclaw2d_patch_vtable_t* patch_vt = (fclaw2d_patch_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fclaw2d_patch");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(patch_vt != NULL);
 	FCLAW_ASSERT(patch_vt->is_set != 0);
 	return patch_vt;
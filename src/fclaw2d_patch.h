@@ -701,6 +701,42 @@ void fclaw2d_patch_remote_ghost_unpack(struct fclaw2d_global* glob,
 void fclaw2d_patch_remote_ghost_delete(struct fclaw2d_global *glob,
                                        struct fclaw2d_patch *ghost_patch);
 
+/** 
+ * @brief Get the buffer size needed to pack a single patch's ghost metric data 
+ * 
+ * Metric data (e.g. the area) is sent once, when the ghost patches are
+ * built, and not with every ghost exchange.
+ * 
+ * @param[in] glob the global context
+ * @return the buffer size (in bytes), or 0 if no metric data is sent
+ */
+size_t fclaw2d_patch_ghost_metric_packsize(struct fclaw2d_global* glob);
+
+/**
+ * @brief Packs the patch ghost metric data into a buffer
+ * 
+ * @param[in] glob the global context
+ * @param[in] this_patch the patch context
+ * @param[in,out] patch_data the buffer
+ */
+void fclaw2d_patch_local_ghost_metric_pack(struct fclaw2d_global *glob,
+                                           struct fclaw2d_patch *this_patch,
+                                           void *patch_data);
+
+/**
+ * @brief Unpacks ghost metric data into a ghost patch
+ * 
+ * @param[in] glob the global context
+ * @param[in,out] this_patch the patch context
+ * @param[in] blockno the block number 
+ * @param[in] patchno the patch number
+ * @param[in] mdata the buffer to unpack from
+ */
+void fclaw2d_patch_remote_ghost_metric_unpack(struct fclaw2d_global* glob,
+                                              struct fclaw2d_patch* this_patch,
+                                              int blockno, int patchno,
+                                              void *mdata);
+
 ///@}
 /* ------------------------------------------------------------------------------------ */
 ///                          @name Parallel Partitioning
@@ -1306,6 +1342,20 @@ typedef void (*fclaw2d_patch_remote_ghost_unpack_t)(struct fclaw2d_global *glob,
 /** @copydoc fclaw2d_patch_remote_ghost_delete() */
 typedef void (*fclaw2d_patch_remote_ghost_delete_t)(void *user_patch);
 
+/** @copydoc fclaw2d_patch_ghost_metric_packsize() */
+typedef size_t (*fclaw2d_patch_ghost_metric_packsize_t)(struct fclaw2d_global* glob);
+
+/** @copydoc fclaw2d_patch_local_ghost_metric_pack() */
+typedef void (*fclaw2d_patch_local_ghost_metric_pack_t)(struct fclaw2d_global *glob,
+                                                        struct fclaw2d_patch *this_patch,
+                                                        void *patch_data);
+
+/** @copydoc fclaw2d_patch_remote_ghost_metric_unpack() */
+typedef void (*fclaw2d_patch_remote_ghost_metric_unpack_t)(struct fclaw2d_global *glob,
+                                                           struct fclaw2d_patch* this_patch,
+                                                           int blockno, int patchno,
+                                                           void *mdata);
+
 
 ///@}
 /* ------------------------------------------------------------------------------------ */
@@ -1447,6 +1497,10 @@ struct fclaw2d_patch_vtable
     fclaw2d_patch_physical_bc_t           physical_bc;
     /** @copybrief ::fclaw2d_patch_single_step_update_t */
     fclaw2d_patch_single_step_update_t    single_step_update;
+    /** True if single_step_update collects patches in the 
+        ::fclaw2d_single_step_buffer_data buffer.  Patches are then visited 
+        one at a time, in order, and the solver threads within a batch. */
+    int                                   single_step_buffered;
     /** @copybrief ::fclaw2d_patch_rhs_t */
     fclaw2d_patch_rhs_t                   rhs;
 
@@ -1552,6 +1606,13 @@ struct fclaw2d_patch_vtable
     /** @copybrief ::fclaw2d_patch_remote_ghost_delete_t */
     fclaw2d_patch_remote_ghost_delete_t   remote_ghost_delete;
 
+    /** @copybrief ::fclaw2d_patch_ghost_metric_packsize_t */
+    fclaw2d_patch_ghost_metric_packsize_t      ghost_metric_packsize;
+    /** @copybrief ::fclaw2d_patch_local_ghost_metric_pack_t */
+    fclaw2d_patch_local_ghost_metric_pack_t    local_ghost_metric_pack;
+    /** @copybrief ::fclaw2d_patch_remote_ghost_metric_unpack_t */
+    fclaw2d_patch_remote_ghost_metric_unpack_t remote_ghost_metric_unpack;
+
     /** @} */
 
     /** @{ @name Parallel Load Balancing (partitioning) */
@@ -1783,6 +1844,14 @@ void fclaw2d_patch_neighbors_set(struct fclaw2d_patch* patch);
  */
 void fclaw2d_patch_neighbors_reset(struct fclaw2d_patch* patch);
 
+/**
+ * @brief Returns true if the neighbor relation data for a patch is set
+ * 
+ * @param patch the patch context
+ * @return true if the neighbor types are set
+ */
+int fclaw2d_patch_neighbor_type_set(struct fclaw2d_patch* patch);
+
 /**
  * @brief Returns true if a patch has finer neighbors
  * 
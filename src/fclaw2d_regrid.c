@@ -283,6 +283,7 @@ void fclaw2d_regrid(fclaw2d_global_t *glob)
         /* free memory associated with old domain */
         fclaw2d_domain_reset(glob);
         *domain = new_domain;
+        ++glob->domain_revision;
         new_domain = NULL;
 
         /* Repartition for load balancing.  Second arg (mode) for vtk output */
@@ -80,6 +80,98 @@ void save_time_step(fclaw2d_global_t *glob)
     fclaw2d_global_iterate_patches(glob,cb_save_time_step,(void *) NULL);
 }
 
+/*  -----------------------------------------------------------------
+    Speculative steps
+    -- Steps are batched in pairs with the same dt.  The maximum cfl 
+       of the first step is reduced while the second step is taken. 
+       Patches only save one step, so the pair is retaken if either 
+       cfl is too large, and the reduction of the second step is 
+       waited for before the next save.  This halves the number of 
+       blocking reductions;  it does not take them off the critical 
+       path, since the second one still waits on the slowest 
+       processor.
+    ----------------------------------------------------------------- */
+
+typedef struct cfl_reduce
+{
+    double local;
+    double global;
+#ifdef FCLAW_ENABLE_MPI
+    MPI_Request request;
+#endif
+} cfl_reduce_t;
+
+static
+void cfl_reduce_begin(fclaw2d_global_t *glob, cfl_reduce_t *r, double maxcfl)
+{
+    r->local = maxcfl;
+#ifdef FCLAW_ENABLE_MPI
+    int mpiret = MPI_Iallreduce(&r->local,&r->global,1,MPI_DOUBLE,MPI_MAX,
+                                glob->mpicomm,&r->request);
+    SC_CHECK_MPI(mpiret);
+#else
+    r->global = maxcfl;
+#endif
+}
+
+static
+double cfl_reduce_end(fclaw2d_global_t *glob, cfl_reduce_t *r)
+{
+#ifdef FCLAW_ENABLE_MPI
+    fclaw2d_timer_start (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);
+    int mpiret = MPI_Wait(&r->request,MPI_STATUS_IGNORE);
+    SC_CHECK_MPI(mpiret);
+    fclaw2d_timer_stop (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);
+#endif
+    return r->global;
+}
+
+/* Advance nsteps (1 or 2) steps of size dt_step.  Returns the maximum cfl 
+   of each step, reduced over all processors if reduce_cfl is set. */
+static
+void advance_steps(fclaw2d_global_t *glob, double t_curr, double dt_step,
+                   int nsteps, double maxcfl[])
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    cfl_reduce_t r[2];
+    int k;
+
+    FCLAW_ASSERT(nsteps == 1 || nsteps == 2);
+
+    glob->curr_dt = dt_step;
+    for(k = 0; k < nsteps; k++)
+    {
+        /* Callbacks (boundary conditions, sources) read the time of 
+           the step from glob */
+        glob->curr_time = t_curr + k*dt_step;
+        maxcfl[k] = fclaw2d_advance_all_levels(glob, t_curr + k*dt_step, dt_step);
+        if (nsteps > 1)
+        {
+            cfl_reduce_begin(glob,&r[k],maxcfl[k]);
+        }
+        else if (fclaw_opt->reduce_cfl)
+        {
+            /* This is a collective communication - everybody needs to wait here.
+               If we are taking a variable time step, we have to reduce the 
+               maxcfl so that every processor takes the same size dt */
+            fclaw2d_timer_start (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);
+            maxcfl[k] = fclaw2d_domain_global_maximum (glob->domain, maxcfl[k]);
+            fclaw2d_timer_stop (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);
+        }
+    }
+    for(k = 0; k < nsteps && nsteps > 1; k++)
+    {
+        maxcfl[k] = cfl_reduce_end(glob,&r[k]);
+    }
+}
+
+static
+int use_speculative_step(const fclaw_options_t *fclaw_opt)
+{
+    return fclaw_opt->speculative_cfl && fclaw_opt->reduce_cfl &&
+           !fclaw_opt->use_fixed_dt;
+}
+
 
 /* -------------------------------------------------------------------------------
    Output style 1
@@ -175,7 +267,18 @@ void outstyle_1(fclaw2d_global_t *glob)
             int took_small_step = 0;
             int took_big_step = 0;
             double dt_step_desired = dt_step;
-            if (!fclaw_opt->use_fixed_dt)
+
+            /* Take a second step with the same dt if neither step has to 
+               hit 'tend' and there is no regrid or diagnostics in between */
+            int nsteps = 1;
+            if (use_speculative_step(fclaw_opt) && !fclaw_opt->advance_one_step &&
+                tend - (t_curr + 2*dt_step) >= tol &&
+                (fclaw_opt->regrid_interval <= 0 ||
+                 (n_inner + 1) % fclaw_opt->regrid_interval != 0))
+            {
+                nsteps = 2;
+            }
+            else if (!fclaw_opt->use_fixed_dt)
             {
                 double small_step = tend-(t_curr+dt_step);
                 if (small_step  < tol)
@@ -195,28 +298,24 @@ void outstyle_1(fclaw2d_global_t *glob)
                     }
                 }
             }
-            glob->curr_dt = dt_step;  
-            double maxcfl_step = fclaw2d_advance_all_levels(glob, t_curr,dt_step);
+            double maxcfl[2];
+            advance_steps(glob, t_curr, dt_step, nsteps, maxcfl);
 
-            if (fclaw_opt->reduce_cfl)
+            double maxcfl_step = 0;
+            int k;
+            for(k = 0; k < nsteps; k++)
             {
-                /* If we are taking a variable time step, we have to reduce the 
-                   maxcfl so that every processor takes the same size dt */
-                fclaw2d_timer_start (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);
-                maxcfl_step = fclaw2d_domain_global_maximum (*domain, maxcfl_step);
-                fclaw2d_timer_stop (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);                
+                double tc = t_curr + (k+1)*dt_step;
+                fclaw_global_productionf("Level %d (%d-%d) step %5d : dt = %12.3e; maxcfl (step) = " \
+                                         "%8.3f; Final time = %12.4f\n",
+                                         fclaw_opt->minlevel,
+                                         (*domain)->global_minlevel,
+                                         (*domain)->global_maxlevel,
+                                         n_inner+k+1,dt_step,
+                                         maxcfl[k], tc);
+                maxcfl_step = SC_MAX(maxcfl_step,maxcfl[k]);
             }
 
-
-            double tc = t_curr + dt_step;
-            fclaw_global_productionf("Level %d (%d-%d) step %5d : dt = %12.3e; maxcfl (step) = " \
-                                     "%8.3f; Final time = %12.4f\n",
-                                     fclaw_opt->minlevel,
-                                     (*domain)->global_minlevel,
-                                     (*domain)->global_maxlevel,
-                                     n_inner+1,dt_step,
-                                     maxcfl_step, tc);
-
             if ((maxcfl_step > fclaw_opt->max_cfl) & fclaw_opt->reduce_cfl)
             {
                 fclaw_global_essentialf("   WARNING : Maximum CFL exceeded; "    \
@@ -225,6 +324,7 @@ void outstyle_1(fclaw2d_global_t *glob)
                 if (!fclaw_opt->use_fixed_dt)
                 {
                     restore_time_step(glob);
+                    glob->curr_time = t_curr;
 
                     /* Modify dt_level0 from step used. */
                     dt_minlevel = dt_minlevel*fclaw_opt->desired_cfl/maxcfl_step;
@@ -236,8 +336,8 @@ void outstyle_1(fclaw2d_global_t *glob)
             }
 
             /* We are happy with this step */
-            n_inner++;
-            t_curr += dt_step;
+            n_inner += nsteps;
+            t_curr += nsteps*dt_step;
 
 
             /* Update this step, if necessary */
@@ -260,7 +360,7 @@ void outstyle_1(fclaw2d_global_t *glob)
 
                 /* New time step, which should give a cfl close to the
                    desired cfl. */
-                double dt_new = dt_minlevel*fclaw_opt->desired_cfl/maxcfl_step;
+                double dt_new = dt_minlevel*fclaw_opt->desired_cfl/maxcfl[nsteps-1];
                 if (!took_small_step)
                 {
                     dt_minlevel = dt_new;
@@ -366,30 +466,36 @@ void outstyle_3(fclaw2d_global_t *glob)
             save_time_step(glob);
         }
 
-        /* Get current domain data since it may change during regrid */
-        glob->curr_dt = dt_step;
-        double maxcfl_step = fclaw2d_advance_all_levels(glob, t_curr,dt_step);
-
-        /* This is a collective communication - everybody needs to wait here. */
-        if (fclaw_opt->reduce_cfl)
+        /* Take a second step with the same dt if there is no regrid or 
+           output in between */
+        int nsteps = 1;
+        if (use_speculative_step(fclaw_opt) && n + 2 <= nstep_outer &&
+            (n + 1) % nstep_inner != 0 &&
+            (nregrid_interval <= 0 || (n + 1) % nregrid_interval != 0))
         {
-            /* If we are taking a variable time step, we have to reduce the 
-               maxcfl so that every processor takes the same size dt */
-            fclaw2d_timer_start (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);
-            maxcfl_step = fclaw2d_domain_global_maximum (*domain, maxcfl_step);
-            fclaw2d_timer_stop (&glob->timers[FCLAW2D_TIMER_CFL_COMM]);     
+            nsteps = 2;
         }
 
-        double tc = t_curr + dt_step;
+        double maxcfl[2];
+        advance_steps(glob, t_curr, dt_step, nsteps, maxcfl);
+
+        double tc = t_curr + nsteps*dt_step;
         int level2print = (fclaw_opt->advance_one_step && fclaw_opt->outstyle_uses_maxlevel) ?
                           fclaw_opt->maxlevel : fclaw_opt->minlevel;
 
-        fclaw_global_productionf("Level %d (%d-%d) step %5d : dt = %12.3e; maxcfl (step) = " \
-                                 "%12.6f; Final time = %12.4f\n",
-                                 level2print,
-                                 (*domain)->global_minlevel,
-                                 (*domain)->global_maxlevel,
-                                 n+1,dt_step,maxcfl_step, tc);
+        double maxcfl_step = 0;
+        int k;
+        for(k = 0; k < nsteps; k++)
+        {
+            fclaw_global_productionf("Level %d (%d-%d) step %5d : dt = %12.3e; maxcfl (step) = " \
+                                     "%12.6f; Final time = %12.4f\n",
+                                     level2print,
+                                     (*domain)->global_minlevel,
+                                     (*domain)->global_maxlevel,
+                                     n+k+1,dt_step,maxcfl[k], 
+                                     t_curr + (k+1)*dt_step);
+            maxcfl_step = SC_MAX(maxcfl_step,maxcfl[k]);
+        }
 
         if (fclaw_opt->reduce_cfl & (maxcfl_step > fclaw_opt->max_cfl))
         {
@@ -397,6 +503,7 @@ void outstyle_3(fclaw2d_global_t *glob)
             {
                 fclaw_global_productionf("   WARNING : Maximum CFL exceeded; retaking time step\n");
                 restore_time_step(glob);
+                glob->curr_time = t_curr;
 
                 dt_minlevel = dt_minlevel*fclaw_opt->desired_cfl/maxcfl_step;
 
@@ -417,10 +524,10 @@ void outstyle_3(fclaw2d_global_t *glob)
         /* New time step, which should give a cfl close to the desired cfl. */
         if (!fclaw_opt->use_fixed_dt)
         {
-            dt_minlevel = dt_minlevel*fclaw_opt->desired_cfl/maxcfl_step;
+            dt_minlevel = dt_minlevel*fclaw_opt->desired_cfl/maxcfl[nsteps-1];
         }
 
-        n++;  /* Increment outer counter */
+        n += nsteps;  /* Increment outer counter */
 
         if (fclaw_opt->regrid_interval > 0)
         {
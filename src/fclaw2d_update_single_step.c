@@ -82,22 +82,26 @@ double fclaw2d_update_single_step(fclaw2d_global_t *glob,
     ss_data.maxcfl = 0;
     ss_data.buffer_data.total_count = 0;
     ss_data.buffer_data.iter = 0;
+    ss_data.buffer_data.user = NULL;
 
     /* If there are not grids at this level, we return CFL = 0 */
 #if defined(_OPENMP)        
-    fclaw2d_global_iterate_level_mthread(glob, level, 
-                                         cb_single_step,(void *) &ss_data);
-#else
-    /* Count number of grids to be updated in this call;  not sure how this
-       works in OpenMP.  */
+    fclaw2d_patch_vtable_t *patch_vt = fclaw2d_patch_vt(glob);
+    if (!patch_vt->single_step_buffered)
+    {
+        fclaw2d_global_iterate_level_mthread(glob, level, 
+                                             cb_single_step,(void *) &ss_data);
+        return ss_data.maxcfl;
+    }
+#endif
+    /* Count number of grids to be updated in this call.  Buffered solvers 
+       use this to flush the last, partially filled buffer. */
     int count = 0;
     fclaw2d_global_iterate_level(glob, level, cb_single_step_count,&count);
     ss_data.buffer_data.total_count = count;
 
     fclaw2d_global_iterate_level(glob, level, 
                                  cb_single_step,(void *) &ss_data);
-#endif   
- 
 
     return ss_data.maxcfl;
 }
@@ -42,10 +42,12 @@ void vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 fclaw2d_vtable_t* fclaw2d_vt(fclaw2d_global_t *glob)
 {
 	fclaw2d_vtable_t* vt = (fclaw2d_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fclaw2d");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(vt != NULL);
 	FCLAW_ASSERT(vt->is_set != 0);
 	return vt;
@@ -71,4 +73,5 @@ void fclaw2d_vtable_initialize(fclaw2d_global_t *glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fclaw2d") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fclaw2d", vt, vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fclaw2d");
 }
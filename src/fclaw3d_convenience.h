@@ -191,6 +191,28 @@ void fclaw3d_domain_search_points (fclaw3d_domain_t * domain,
                                    sc_array_t * coordinates,
                                    sc_array_t * results);
 
+/** Search a set of points without communication.
+ * The parameters and the results are as in \ref fclaw3d_domain_search_points.
+ * Each point is assigned to the one process whose partition contains its
+ * position, which is computed locally from the partition boundaries.
+ * Only the points assigned to this process are searched, so the work
+ * per process is proportional to its share of the points.
+ * A point on a patch boundary may be reported by another process than in
+ * \ref fclaw3d_domain_search_points, but it is still found exactly once.
+ *
+ * \param [in] domain           Must be valid domain structure.  Will not be changed.
+ * \param [in] block_offsets    As in \ref fclaw3d_domain_search_points.
+ * \param [in] coordinates      As in \ref fclaw3d_domain_search_points.
+ * \param [in,out] results      On output, an entry will be -1 if the point
+ *                              is not assigned to this process or has not
+ *                              been found, or the patch number within its
+ *                              block otherwise.
+ */
+void fclaw3d_domain_search_points_local (fclaw3d_domain_t * domain,
+                                         sc_array_t * block_offsets,
+                                         sc_array_t * coordinates,
+                                         sc_array_t * results);
+
 /** Callback function to compute the integral of a "ray" within a patch.
  *
  * This function can be passed to \ref fclaw3d_domain_integrate_rays to
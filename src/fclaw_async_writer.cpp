@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw_async_writer.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+    struct job
+    {
+        std::string filename;
+        int64_t offset;
+        char* buffer;
+        size_t size;
+    };
+
+    /* Returns true if all bytes were written */
+    bool write_job(const job& j)
+    {
+        bool append = j.offset == FCLAW_ASYNC_WRITER_APPEND;
+        bool replace = j.offset == FCLAW_ASYNC_WRITER_REPLACE;
+        int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : 0)
+                  | (replace ? O_TRUNC : 0);
+        int fd = open(j.filename.c_str(), flags, 0644);
+        if(fd < 0){
+            return false;
+        }
+        int64_t offset = replace ? 0 : j.offset;
+        size_t done = 0;
+        while(done < j.size){
+            ssize_t n = append 
+                      ? write(fd, j.buffer + done, j.size - done)
+                      : pwrite(fd, j.buffer + done, j.size - done, 
+                               (off_t) (offset + done));
+            if(n <= 0){
+                break;
+            }
+            done += n;
+        }
+        return close(fd) == 0 && done == j.size;
+    }
+}
+
+struct fclaw_async_writer
+{
+    size_t max_staged;
+    size_t staged = 0;   /* bytes of buffers handed out and not yet written */
+    std::deque<job> jobs;
+    bool busy = false;   /* the thread is writing a job */
+    bool stop = false;
+    int errors = 0;
+
+    std::mutex mutex;
+    std::condition_variable queued;   /* a job was queued, or stop was set */
+    std::condition_variable written;  /* a job was written */
+    std::thread thread;
+};
+
+static void writer_main(fclaw_async_writer_t* w)
+{
+    std::unique_lock<std::mutex> lock(w->mutex);
+    for(;;){
+        w->queued.wait(lock, [w]{ return w->stop || !w->jobs.empty(); });
+        if(w->jobs.empty()){
+            return;
+        }
+        job j = w->jobs.front();
+        w->jobs.pop_front();
+        w->busy = true;
+        lock.unlock();
+
+        bool ok = write_job(j);
+        delete[] j.buffer;
+
+        lock.lock();
+        w->busy = false;
+        w->staged -= j.size;
+        if(!ok){
+            ++w->errors;
+        }
+        w->written.notify_all();
+    }
+}
+
+fclaw_async_writer_t* fclaw_async_writer_new(size_t max_staged)
+{
+    fclaw_async_writer_t* w = new fclaw_async_writer();
+    w->max_staged = max_staged;
+    w->thread = std::thread(writer_main, w);
+    return w;
+}
+
+void fclaw_async_writer_destroy(fclaw_async_writer_t* w)
+{
+    {
+        std::lock_guard<std::mutex> lock(w->mutex);
+        w->stop = true;
+    }
+    w->queued.notify_one();
+    w->thread.join();
+    delete w;
+}
+
+char* fclaw_async_writer_buffer(fclaw_async_writer_t* w, size_t size)
+{
+    std::unique_lock<std::mutex> lock(w->mutex);
+    w->written.wait(lock, [w, size]{ 
+        return w->staged == 0 || w->staged + size <= w->max_staged; 
+    });
+    w->staged += size;
+    lock.unlock();
+    return new char[size];
+}
+
+void fclaw_async_writer_write(fclaw_async_writer_t* w, 
+                              const char* filename, int64_t offset,
+                              char* buffer, size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(w->mutex);
+        w->jobs.push_back(job{filename, offset, buffer, size});
+    }
+    w->queued.notify_one();
+}
+
+int fclaw_async_writer_flush(fclaw_async_writer_t* w)
+{
+    std::unique_lock<std::mutex> lock(w->mutex);
+    w->written.wait(lock, [w]{ return w->jobs.empty() && !w->busy; });
+    int errors = w->errors;
+    w->errors = 0;
+    return errors;
+}
@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * @file
+ * 
+ * @brief Writes files in a background thread
+ * 
+ * Output routines copy their data into staging buffers obtained from the 
+ * writer and queue them.  A background thread writes the buffers to disk 
+ * while the computation continues.  The memory used by staged buffers is 
+ * bounded;  a request for a buffer waits until enough queued data is written.
+ *
+ * The background thread makes only POSIX I/O calls, never MPI calls.
+ */
+#ifndef FCLAW_ASYNC_WRITER_H
+#define FCLAW_ASYNC_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#if 0
+}
+#endif
+#endif
+
+/** Offset for ::fclaw_async_writer_write to append to the file */
+#define FCLAW_ASYNC_WRITER_APPEND  -1
+/** Offset for ::fclaw_async_writer_write to replace the file */
+#define FCLAW_ASYNC_WRITER_REPLACE -2
+
+/**
+ * @brief Asynchronous writer structure
+ */
+typedef struct fclaw_async_writer fclaw_async_writer_t;
+
+/**
+ * @brief create a writer and start its thread
+ * 
+ * @param max_staged bytes that may be staged at the same time.  A single 
+ *                   buffer larger than this is allowed when nothing else 
+ *                   is staged.
+ * @return fclaw_async_writer_t* the new writer
+ */
+fclaw_async_writer_t* fclaw_async_writer_new(size_t max_staged);
+
+/**
+ * @brief write all queued data, stop the thread and destroy the writer
+ * 
+ * @param writer the writer
+ */
+void fclaw_async_writer_destroy(fclaw_async_writer_t* writer);
+
+/**
+ * @brief get a staging buffer
+ * 
+ * Waits until size bytes fit into the staging memory.  The buffer must be 
+ * passed to ::fclaw_async_writer_write before the next buffer is requested.
+ * 
+ * @param writer the writer
+ * @param size the size of the buffer in bytes
+ * @return char* the buffer
+ */
+char* fclaw_async_writer_buffer(fclaw_async_writer_t* writer, size_t size);
+
+/**
+ * @brief queue a staging buffer for writing
+ * 
+ * The file is created if it does not exist.  It is only truncated with 
+ * ::FCLAW_ASYNC_WRITER_REPLACE.  Buffers are written in the order they 
+ * are queued.
+ * 
+ * @param writer the writer
+ * @param filename the file to write to
+ * @param offset the position in bytes in the file, 
+ *               ::FCLAW_ASYNC_WRITER_APPEND or ::FCLAW_ASYNC_WRITER_REPLACE
+ * @param buffer a buffer from ::fclaw_async_writer_buffer;  the writer 
+ *               takes ownership
+ * @param size the number of bytes to write
+ */
+void fclaw_async_writer_write(fclaw_async_writer_t* writer, 
+                              const char* filename, int64_t offset,
+                              char* buffer, size_t size);
+
+/**
+ * @brief wait until all queued data is written
+ * 
+ * @param writer the writer
+ * @return int the number of writes that failed since the last flush
+ */
+int fclaw_async_writer_flush(fclaw_async_writer_t* writer);
+
+#ifdef __cplusplus
+#if 0
+{
+#endif
+}
+#endif
+
+#endif /* !FCLAW_ASYNC_WRITER_H */
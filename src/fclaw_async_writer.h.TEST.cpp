@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw_async_writer.h>
+#include <test.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    std::string read_file(const char* filename)
+    {
+        std::string contents;
+        FILE* file = fopen(filename, "rb");
+        if(file != nullptr){
+            char c[256];
+            size_t n;
+            while((n = fread(c, 1, sizeof(c), file)) > 0){
+                contents.append(c, n);
+            }
+            fclose(file);
+        }
+        return contents;
+    }
+
+    void queue(fclaw_async_writer_t* writer, const char* filename, 
+               int64_t offset, const char* text)
+    {
+        size_t size = strlen(text);
+        char* buffer = fclaw_async_writer_buffer(writer, size);
+        memcpy(buffer, text, size);
+        fclaw_async_writer_write(writer, filename, offset, buffer, size);
+    }
+}
+
+TEST_CASE("fclaw_async_writer writes at offsets")
+{
+    const char* filename = "fclaw_async_writer_offsets.TEST.out";
+    remove(filename);
+
+    fclaw_async_writer_t* writer = fclaw_async_writer_new(1 << 20);
+    queue(writer, filename, 6, "world");
+    queue(writer, filename, 0, "hello ");
+    CHECK_EQ(fclaw_async_writer_flush(writer), 0);
+    CHECK_EQ(read_file(filename), "hello world");
+    fclaw_async_writer_destroy(writer);
+
+    remove(filename);
+}
+
+TEST_CASE("fclaw_async_writer appends and writes everything on destroy")
+{
+    const char* filename = "fclaw_async_writer_append.TEST.out";
+    remove(filename);
+
+    /* smaller than the data, so that buffers have to wait */
+    fclaw_async_writer_t* writer = fclaw_async_writer_new(4);
+    std::string expected;
+    for(int i = 0; i < 100; i++){
+        std::string line = std::to_string(i) + "\n";
+        queue(writer, filename, FCLAW_ASYNC_WRITER_APPEND, line.c_str());
+        expected += line;
+    }
+    fclaw_async_writer_destroy(writer);
+    CHECK_EQ(read_file(filename), expected);
+
+    remove(filename);
+}
+
+TEST_CASE("fclaw_async_writer replaces files")
+{
+    const char* filename = "fclaw_async_writer_replace.TEST.out";
+    remove(filename);
+
+    fclaw_async_writer_t* writer = fclaw_async_writer_new(1 << 20);
+    queue(writer, filename, 0, "a longer first version");
+    queue(writer, filename, FCLAW_ASYNC_WRITER_REPLACE, "second");
+    CHECK_EQ(fclaw_async_writer_flush(writer), 0);
+    CHECK_EQ(read_file(filename), "second");
+    fclaw_async_writer_destroy(writer);
+
+    remove(filename);
+}
+
+TEST_CASE("fclaw_async_writer flush counts failed writes")
+{
+    fclaw_async_writer_t* writer = fclaw_async_writer_new(1 << 20);
+    queue(writer, "no_such_directory/fclaw_async_writer.TEST.out", 0, "x");
+    CHECK_EQ(fclaw_async_writer_flush(writer), 1);
+    CHECK_EQ(fclaw_async_writer_flush(writer), 0);
+    fclaw_async_writer_destroy(writer);
+}
@@ -31,6 +31,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_global.h>
 #include <fclaw2d_convenience.h>  /* Needed to get search function for gauges */
 #include <fclaw2d_diagnostics.h>
+#include <fclaw2d_output.h>
+#include <fclaw_async_writer.h>
+#include <limits.h>
 
 /* Some mapping functions */
 #include <fclaw2d_map_brick.h>
@@ -47,11 +50,32 @@ extern "C"
 
 /* -------------------------------------------------------------------------------------*/
 
+/* All gauges are written to this file when option gauge-binary is set.
+   Every value is a double.  The file starts with an index of the gauges
+
+       num_gauges, record_length,
+       num, xc, yc, t1, t2      (once for each gauge)
+
+   followed by records of (1 + record_length) values
+
+       gauge index, values set by pack_gauge_entry
+
+   where the gauge index is the position of the gauge in the index.  Records
+   of all processes are appended collectively when the buffers are flushed. */
+#define GAUGE_BINARY_FILE "gauges.bin"
+
 typedef struct fclaw_gauge_acc
 {
     int num_gauges;
     int is_latest_domain;
     struct fclaw_gauge *gauges;
+
+    /* binary output */
+    int updates_since_flush;
+    long file_end;
+#ifdef P4EST_ENABLE_MPIIO
+    MPI_File mpifile;
+#endif
 } fclaw_gauge_acc_t;
 
 
@@ -64,6 +88,226 @@ typedef struct fclaw_gauge_info
 
 static fclaw_gauge_info_t gauge_info;
 
+static
+void gauge_binary_create(fclaw2d_global_t *glob, fclaw_gauge_acc_t *gauge_acc)
+{
+    int i, num_gauges;
+    double *index;
+    size_t index_len;
+    FILE *fp;
+    fclaw_gauge_t *g;
+    const fclaw_gauges_vtable_t* gauge_vt = fclaw_gauges_vt(glob);
+
+    SC_CHECK_ABORT(gauge_vt->pack_gauge_entry != NULL && 
+                   gauge_vt->record_length > 0,
+                   "Option gauge-binary needs pack_gauge_entry in the gauges vtable");
+
+    num_gauges = gauge_acc->num_gauges;
+    index_len = 2 + 5*(size_t) num_gauges;
+
+    if (glob->mpirank == 0)
+    {
+        index = FCLAW_ALLOC(double,index_len);
+        index[0] = num_gauges;
+        index[1] = gauge_vt->record_length;
+        for(i = 0; i < num_gauges; i++)
+        {
+            g = &gauge_acc->gauges[i];
+            index[2 + 5*i] = g->num;
+            index[3 + 5*i] = g->xc;
+            index[4 + 5*i] = g->yc;
+            index[5 + 5*i] = g->t1;
+            index[6 + 5*i] = g->t2;
+        }
+        fp = fopen(GAUGE_BINARY_FILE, "wb");
+        SC_CHECK_ABORT(fp != NULL, "Gauge file open failed");
+        SC_CHECK_ABORT(fwrite(index,sizeof(double),index_len,fp) == index_len &&
+                       fclose(fp) == 0, "Gauge file write failed");
+        FCLAW_FREE(index);
+    }
+    gauge_acc->file_end = (long) (index_len*sizeof(double));
+    gauge_acc->updates_since_flush = 0;
+
+    /* No process opens or writes the file before the first process has
+       created it and written the index */
+    int mpiret = sc_MPI_Barrier(glob->mpicomm);
+    SC_CHECK_MPI(mpiret);
+
+#ifdef P4EST_ENABLE_MPIIO
+    if (fclaw2d_output_writer(glob) == NULL)
+    {
+        mpiret = MPI_File_open(glob->mpicomm, GAUGE_BINARY_FILE, MPI_MODE_WRONLY,
+                                   MPI_INFO_NULL, &gauge_acc->mpifile);
+        SC_CHECK_MPI(mpiret);
+    }
+#endif
+}
+
+/* Collective : append the buffers of all local gauges to the binary file */
+static
+void gauge_binary_flush(fclaw2d_global_t *glob, fclaw_gauge_acc_t *gauge_acc)
+{
+    int i, k, kmax, mpiret;
+    long count, offset, total, maxcount;
+    long *counts;
+    void **entries;
+    double *record;
+    char *buf;
+    fclaw_gauge_t *g;
+
+    const fclaw_gauges_vtable_t* gauge_vt = fclaw_gauges_vt(glob);
+    fclaw_async_writer_t *writer = fclaw2d_output_writer(glob);
+    const size_t record_size = (1 + gauge_vt->record_length)*sizeof(double);
+
+    count = 0;
+    for(i = 0; i < gauge_acc->num_gauges; i++)
+    {
+        count += gauge_acc->gauges[i].next_buffer_location;
+    }
+
+    /* Records are ordered by process */
+    counts = FCLAW_ALLOC(long,glob->mpisize);
+    mpiret = sc_MPI_Allgather(&count, 1, sc_MPI_LONG, counts, 1, sc_MPI_LONG,
+                              glob->mpicomm);
+    SC_CHECK_MPI(mpiret);
+    offset = total = maxcount = 0;
+    for(i = 0; i < glob->mpisize; i++)
+    {
+        offset += i < glob->mpirank ? counts[i] : 0;
+        total += counts[i];
+        maxcount = SC_MAX(maxcount,counts[i]);
+    }
+    gauge_acc->updates_since_flush = 0;
+    if (total == 0)
+    {
+        FCLAW_FREE(counts);
+        return;
+    }
+
+    if (writer != NULL && count > 0)
+    {
+        buf = fclaw_async_writer_buffer(writer, count*record_size);
+    }
+    else
+    {
+        buf = FCLAW_ALLOC(char, count*record_size);
+    }
+
+    record = (double*) buf;
+    for(i = 0; i < gauge_acc->num_gauges; i++)
+    {
+        g = &gauge_acc->gauges[i];
+        fclaw_gauge_get_buffer(glob,g,&kmax,&entries);
+        for(k = 0; k < kmax; k++)
+        {
+            record[0] = i;
+            fclaw_pack_gauge_entry(glob,g,entries[k],&record[1]);
+            record += 1 + gauge_vt->record_length;
+        }
+        g->next_buffer_location = 0;
+    }
+
+    const long file_start = gauge_acc->file_end;
+    offset = file_start + offset*(long) record_size;
+    gauge_acc->file_end += total*(long) record_size;
+
+    if (writer != NULL)
+    {
+        if (count > 0)
+        {
+            fclaw_async_writer_write(writer, GAUGE_BINARY_FILE, offset, 
+                                     buf, count*record_size);
+        }
+        else
+        {
+            FCLAW_FREE(buf);
+        }
+        FCLAW_FREE(counts);
+        return;
+    }
+
+#ifdef P4EST_ENABLE_MPIIO
+    {
+        /* One collective write, in pieces that fit the int count */
+        const long chunk = INT_MAX/(long) record_size;
+        const long nchunks = (maxcount + chunk - 1)/chunk;
+        MPI_Status mpistatus;
+        for(k = 0; k < nchunks; k++)
+        {
+            const long pos = SC_MIN(k*chunk,count);
+            const long n = SC_MIN(chunk,count - pos);
+            mpiret = MPI_File_write_at_all(gauge_acc->mpifile, 
+                                           (MPI_Offset) (offset + pos*(long) record_size),
+                                           buf + pos*record_size, 
+                                           (int) (n*record_size), MPI_BYTE, 
+                                           &mpistatus);
+            SC_CHECK_MPI(mpiret);
+        }
+    }
+#else
+    {
+        /* Without MPI I/O, the first process writes all records.  They
+           are gathered in rounds so that all byte counts fit in an int. */
+        const long chunk = SC_MAX(INT_MAX/((long) record_size*glob->mpisize),1);
+        int *recvcounts = NULL, *displs = NULL;
+        char *all = NULL;
+        FILE *fp = NULL;
+        if (glob->mpirank == 0)
+        {
+            recvcounts = FCLAW_ALLOC(int,glob->mpisize);
+            displs = FCLAW_ALLOC(int,glob->mpisize);
+            all = FCLAW_ALLOC(char, SC_MIN(chunk*glob->mpisize,total)*record_size);
+            fp = fopen(GAUGE_BINARY_FILE, "r+b");
+            SC_CHECK_ABORT(fp != NULL, "Gauge file open failed");
+        }
+        for(long pos = 0; pos < maxcount; pos += chunk)
+        {
+            const long n = SC_MAX(SC_MIN(chunk,count - pos),0);
+            int bytes = (int) (n*record_size);
+            mpiret = sc_MPI_Gather(&bytes, 1, sc_MPI_INT, recvcounts, 1, sc_MPI_INT, 
+                                   0, glob->mpicomm);
+            SC_CHECK_MPI(mpiret);
+            if (glob->mpirank == 0)
+            {
+                displs[0] = 0;
+                for(i = 1; i < glob->mpisize; i++)
+                {
+                    displs[i] = displs[i-1] + recvcounts[i-1];
+                }
+            }
+            mpiret = sc_MPI_Gatherv(buf + (n > 0 ? pos*record_size : 0), bytes, 
+                                    sc_MPI_BYTE, all, recvcounts, displs,
+                                    sc_MPI_BYTE, 0, glob->mpicomm);
+            SC_CHECK_MPI(mpiret);
+            if (glob->mpirank == 0)
+            {
+                /* Records of process i start after those of lower ranks */
+                long start = 0;
+                for(i = 0; i < glob->mpisize; i++)
+                {
+                    long file_pos = file_start + (start + pos)*(long) record_size;
+                    SC_CHECK_ABORT(recvcounts[i] == 0 ||
+                                   (fseek(fp, file_pos, SEEK_SET) == 0 &&
+                                    fwrite(all + displs[i], 1, recvcounts[i], fp) == 
+                                    (size_t) recvcounts[i]),
+                                   "Gauge file write failed");
+                    start += counts[i];
+                }
+            }
+        }
+        if (glob->mpirank == 0)
+        {
+            SC_CHECK_ABORT(fclose(fp) == 0, "Gauge file write failed");
+            FCLAW_FREE(all);
+            FCLAW_FREE(recvcounts);
+            FCLAW_FREE(displs);
+        }
+    }
+#endif
+    FCLAW_FREE(counts);
+    FCLAW_FREE(buf);
+}
+
 static
 void gauge_initialize(fclaw2d_global_t* glob, void** acc)
 {
@@ -75,10 +319,9 @@ void gauge_initialize(fclaw2d_global_t* glob, void** acc)
 
     int nb,mi,mj,ng;
     double x,y;
-    double z;
     double xll,yll;
     double xur,yur;
-    int number_of_gauges_set, buffer_len;
+    int number_of_gauges_set;
     int is_brick, num_blocks;
 
     double x0,y0,x1,y1;
@@ -111,21 +354,29 @@ void gauge_initialize(fclaw2d_global_t* glob, void** acc)
 
     if (num_gauges > 0)
     {
-        fclaw_create_gauge_files(glob,gauges,num_gauges);    
+        if (fclaw_opt->gauge_binary)
+        {
+            gauge_binary_create(glob,gauge_acc);
+        }
+        else
+        {
+            fclaw_create_gauge_files(glob,gauges,num_gauges);    
+        }
 
         /* ------------------------------------------------------------------
            Finish setting gauges with ForestClaw specific info 
            For  q_gauges, users must still allocate space for variables to be
-           stored in the print buffer.
+           stored in the print buffer.  Buffers are allocated when a gauge is
+           located on this processor.
            ---------------------------------------------------------------- */
-        buffer_len = fclaw_opt->gauge_buffer_length;
         for(i = 0; i < num_gauges; i++)
         {
             gauges[i].last_time = gauges[i].t1;
             gauges[i].patchno = -1;
             gauges[i].blockno = -1;
             gauges[i].location_in_results = -1;
-            gauges[i].buffer = FCLAW_ALLOC(void*,buffer_len);  /* Array of generic ptrs */
+            gauges[i].is_local = 0;
+            gauges[i].buffer = NULL;
             gauges[i].next_buffer_location = 0;
         }       
 
@@ -189,8 +440,14 @@ void gauge_initialize(fclaw2d_global_t* glob, void** acc)
                 (easily) how the blocks are numbered in the 
                 brick grid */ 
 
-                fclaw2d_map_c2m_nomap_brick(cont,nb,x0,y0,&xll,&yll,&z);
-                fclaw2d_map_c2m_nomap_brick(cont,nb,x1,y1,&xur,&yur,&z);                
+                const double xcb[2] = {x0, x1};
+                const double ycb[2] = {y0, y1};
+                double xpb[2], ypb[2], zpb[2];
+                fclaw2d_map_brick2c_batch(cont,nb,2,xcb,ycb,xpb,ypb,zpb);
+                xll = xpb[0];
+                yll = ypb[0];
+                xur = xpb[1];
+                yur = ypb[1];
             }
             else
             {
@@ -275,7 +532,8 @@ void gauge_update(fclaw2d_global_t *glob, void* acc)
 
                 g->next_buffer_location++;
                 
-                if (g->next_buffer_location == buffer_len)
+                if (g->next_buffer_location == buffer_len && 
+                    !fclaw_opt->gauge_binary)
                 {
                     fclaw_print_gauge_buffer(glob,g);
                     g->next_buffer_location = 0;
@@ -289,6 +547,14 @@ void gauge_update(fclaw2d_global_t *glob, void* acc)
             }
         }
     }
+
+    /* Each call adds at most one entry to each buffer, so all processes
+       can decide without communication when the buffers have to be written */
+    if (fclaw_opt->gauge_binary && num_gauges > 0 && 
+        ++gauge_acc->updates_since_flush == buffer_len)
+    {
+        gauge_binary_flush(glob,gauge_acc);
+    }
 }
 
 
@@ -297,6 +563,8 @@ void fclaw_locate_gauges(fclaw2d_global_t *glob)
     int i,index,num;
     fclaw_gauge_t *g;
 
+    const fclaw_options_t * fclaw_opt = fclaw2d_get_options(glob);
+
     fclaw_gauge_acc_t* gauge_acc = 
               (fclaw_gauge_acc_t*) glob->acc->gauge_accumulator;
 
@@ -308,11 +576,18 @@ void fclaw_locate_gauges(fclaw2d_global_t *glob)
         return;
     }
 
+    if (fclaw_opt->gauge_binary)
+    {
+        /* Write buffers before gauges move to other processors */
+        gauge_binary_flush(glob,gauge_acc);
+    }
+
+    /* Only gauges in the local partition are searched */
     sc_array_t *results = sc_array_new_size(sizeof(int), num);
 
-    fclaw2d_domain_search_points(glob->domain, 
-                                 gauge_info.block_offsets,
-                                 gauge_info.coordinates, results);
+    fclaw2d_domain_search_points_local(glob->domain, 
+                                       gauge_info.block_offsets,
+                                       gauge_info.coordinates, results);
 
     for (i = 0; i < gauge_acc->num_gauges; ++i)
     {
@@ -335,6 +610,17 @@ void fclaw_locate_gauges(fclaw2d_global_t *glob)
             fclaw_print_gauge_buffer(glob,g);
             g->next_buffer_location = 0;
         }
+
+        /* Only gauges on this processor have buffers */
+        if (g->is_local && g->buffer == NULL)
+        {
+            g->buffer = FCLAW_ALLOC(void*,fclaw_opt->gauge_buffer_length);
+        }
+        else if (!g->is_local && g->buffer != NULL)
+        {
+            FCLAW_FREE(g->buffer);
+            g->buffer = NULL;
+        }
     }
     sc_array_destroy(results);
 }
@@ -349,18 +635,34 @@ void gauge_finalize(fclaw2d_global_t *glob, void** acc)
     fclaw_gauge_acc_t* gauge_acc = *((fclaw_gauge_acc_t**) acc);
     fclaw_gauge_t *gauges = gauge_acc->gauges;
 
+    const fclaw_options_t * fclaw_opt = fclaw2d_get_options(glob);
+
+    if (fclaw_opt->gauge_binary && gauge_acc->num_gauges > 0)
+    {
+        gauge_binary_flush(glob,gauge_acc);
+#ifdef P4EST_ENABLE_MPIIO
+        if (fclaw2d_output_writer(glob) == NULL)
+        {
+            int mpiret = MPI_File_close(&gauge_acc->mpifile);
+            SC_CHECK_MPI(mpiret);
+        }
+#endif
+    }
+
     for(i = 0; i < gauge_acc->num_gauges; i++)
     {
         g = &gauges[i];
 
-        /* Every processor owns every gauge (which will scale up to a few 
-        hundred gauges).  But we only want to print those gauge buffers that 
-        for gauges that are on the local processor */        
-        if (g->is_local)
+        /* Every processor knows every gauge, but only the gauges on the 
+           local processor have buffers to print */        
+        if (g->is_local && !fclaw_opt->gauge_binary)
         {
             fclaw_print_gauge_buffer(glob,g);
         }
-        FCLAW_FREE(g->buffer);               
+        if (g->buffer != NULL)
+        {
+            FCLAW_FREE(g->buffer);               
+        }
     }
 
     if (gauge_acc->gauges != NULL)
@@ -395,10 +697,12 @@ void fclaw_gauges_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 fclaw_gauges_vtable_t* fclaw_gauges_vt(fclaw2d_global_t* glob)
 {
 	fclaw_gauges_vtable_t* gauges_vt = (fclaw_gauges_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fclaw_gauges");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(gauges_vt != NULL);
 	FCLAW_ASSERT(gauges_vt->is_set != 0);
 
@@ -419,6 +723,7 @@ void fclaw_gauges_vtable_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fclaw_gauges") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fclaw_gauges", gauges_vt, fclaw_gauges_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fclaw_gauges");
 }
 /* ---------------------------- Virtualized Functions --------------------------------- */
 
@@ -480,6 +785,15 @@ void fclaw_print_gauge_buffer(fclaw2d_global_t* glob, fclaw_gauge_t *g)
     gauge_vt->print_gauge_buffer(glob,g);
 }
 
+void fclaw_pack_gauge_entry(fclaw2d_global_t* glob, fclaw_gauge_t *g,
+                            void *entry, double *record)
+{
+    const fclaw_gauges_vtable_t* gauge_vt = fclaw_gauges_vt(glob);
+    FCLAW_ASSERT(gauge_vt->pack_gauge_entry != NULL);
+
+    gauge_vt->pack_gauge_entry(glob,g,entry,record);
+}
+
 /* ---------------------------- Get Access Functions ---------------------------------- */
 
 void fclaw_gauge_allocate(fclaw2d_global_t *glob, int num_gauges,
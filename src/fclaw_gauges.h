@@ -154,6 +154,21 @@ typedef void (*fclaw_gauge_update_t)(struct fclaw2d_global* glob,
 typedef void (*fclaw_gauge_print_t)(struct fclaw2d_global *glob, 
                                     struct fclaw_gauge *gauge);
 
+/**
+ * @brief Packs one buffer entry into a record of the binary gauge file
+ * 
+ * This replaces print_gauge_buffer when option gauge-binary is set.  As
+ * in print_gauge_buffer, the entry is released here.
+ * 
+ * @param[in] glob the global context
+ * @param[in] g the gauge
+ * @param[in] entry the buffer entry set in update_gauge
+ * @param[out] record array of record_length values
+ */
+typedef void (*fclaw_gauge_pack_t)(struct fclaw2d_global *glob, 
+                                   struct fclaw_gauge *gauge,
+                                   void *entry, double *record);
+
 /**
  * @brief vtable for gauges
  */
@@ -167,6 +182,10 @@ typedef struct fclaw_gauges_vtable
     fclaw_gauge_update_t        update_gauge;
     /** @brief Prints the buffer to a file */
     fclaw_gauge_print_t         print_gauge_buffer;
+    /** @brief Packs a buffer entry for the binary gauge file */
+    fclaw_gauge_pack_t          pack_gauge_entry;
+    /** @brief Number of values written by pack_gauge_entry */
+    int                         record_length;
 
     /** @brief Maps gauge to normalized coordinates in a global [0,1]x[0,1]  domain. */
     fclaw_gauge_normalize_t     normalize_coordinates;
@@ -178,6 +197,10 @@ typedef struct fclaw_gauges_vtable
 /**
  * @brief Locate the gauges in the mesh
  * 
+ * Each gauge is assigned to the process whose partition contains it, which
+ * is computed without communication.  Only the assigned gauges are searched
+ * and have buffers.  This is collective when option gauge-binary is set.
+ * 
  * @param glob the global context
  */
 void fclaw_locate_gauges(struct fclaw2d_global *glob);
@@ -264,6 +287,18 @@ void  fclaw_update_gauge(struct fclaw2d_global* glob,
 void fclaw_print_gauge_buffer(struct fclaw2d_global* glob, 
                               struct fclaw_gauge *g);
 
+/**
+ * @brief Pack one buffer entry into a record of the binary gauge file
+ * 
+ * @param[in] glob the global context
+ * @param[in] g the gauge
+ * @param[in] entry the buffer entry
+ * @param[out] record array of record_length values
+ */
+void fclaw_pack_gauge_entry(struct fclaw2d_global* glob, 
+                            struct fclaw_gauge *g,
+                            void *entry, double *record);
+
 
 /* ---------------------------------- Gauges ------------------------------------------ */
 
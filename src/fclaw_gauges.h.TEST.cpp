@@ -26,7 +26,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw_gauges.h>
 #include <fclaw2d_global.h>
 #include <fclaw2d_diagnostics.h>
+#include <fclaw2d_domain.h>
+#include <fclaw2d_options.h>
 #include <test.hpp>
+#include <test/test.hpp>
+#include <cstdio>
+#include <vector>
 
 TEST_CASE("fclaw_gauges_vtable_initialize stores two seperate vtables in two seperate globs")
 {
@@ -57,6 +62,167 @@ TEST_CASE("fclaw_gauges_vtable_initialize sets is_set flag")
 	fclaw2d_global_destroy(glob);
 }
 
+TEST_CASE("fclaw_gauges_vtable_initialize leaves binary output to the solver")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_diagnostics_vtable_initialize(glob);
+	fclaw_gauges_vtable_initialize(glob);
+
+	CHECK_EQ(fclaw_gauges_vt(glob)->pack_gauge_entry, nullptr);
+	CHECK_EQ(fclaw_gauges_vt(glob)->record_length, 0);
+
+	fclaw2d_global_destroy(glob);
+}
+
+namespace{
+/* Three gauges in a 2x1 brick, given in global [0,1]x[0,1] coordinates */
+const int test_num_gauges = 3;
+const double test_gauge_xy[3][2] = {{0.1,0.3},{0.7,0.8},{0.3,0.6}};
+int test_updates[3];
+
+void test_set_gauge_data(fclaw2d_global_t *glob, fclaw_gauge_t **gauges, int *num)
+{
+	*num = test_num_gauges;
+	fclaw_gauge_allocate(glob,test_num_gauges,gauges);
+	for(int i = 0; i < test_num_gauges; i++)
+	{
+		fclaw_gauge_set_data(glob,&(*gauges)[i],10 + i,
+		                     test_gauge_xy[i][0],test_gauge_xy[i][1],0,1,0);
+	}
+}
+
+void test_normalize(fclaw2d_global_t *glob, fclaw2d_block_t *block, int blockno,
+                    fclaw_gauge_t *g, double *xc, double *yc)
+{
+	*xc = g->xc;
+	*yc = g->yc;
+}
+
+void test_update_gauge(fclaw2d_global_t* glob, fclaw2d_block_t* block,
+                       fclaw2d_patch_t* patch, int blockno, int patchno,
+                       double tcurr, fclaw_gauge_t *g)
+{
+	/* The located patch contains the gauge (block coordinates are [0,1]) */
+	double xb = 2*g->xc - blockno;
+	double yb = g->yc;
+	CHECK_EQ(blockno, (int) (2*g->xc));
+	CHECK_LE(patch->xlower, xb);
+	CHECK_GE(patch->xupper, xb);
+	CHECK_LE(patch->ylower, yb);
+	CHECK_GE(patch->yupper, yb);
+	test_updates[g->num - 10]++;
+
+	double *entry = FCLAW_ALLOC(double,2);
+	entry[0] = tcurr;
+	entry[1] = g->num;
+	fclaw_gauge_set_buffer_entry(glob,g,entry);
+}
+
+void test_pack_gauge_entry(fclaw2d_global_t *glob, fclaw_gauge_t *g,
+                           void *entry, double *record)
+{
+	double *e = (double*) entry;
+	record[0] = e[0];
+	record[1] = e[1];
+	FCLAW_FREE(e);
+}
+}
+
+TEST_CASE("fclaw_gauges binary file has the index and a record for every update")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_diagnostics_vtable_initialize(glob);
+	fclaw_gauges_vtable_initialize(glob);
+
+	fclaw_gauges_vtable_t* gauges_vt = fclaw_gauges_vt(glob);
+	gauges_vt->set_gauge_data = test_set_gauge_data;
+	gauges_vt->normalize_coordinates = test_normalize;
+	gauges_vt->update_gauge = test_update_gauge;
+	gauges_vt->pack_gauge_entry = test_pack_gauge_entry;
+	gauges_vt->record_length = 2;
+
+	fclaw_options_t fopts;
+	memset(&fopts, 0, sizeof(fopts));
+	fopts.mi = 2;
+	fopts.mj = 1;
+	fopts.minlevel = 2;
+	fopts.maxlevel = 2;
+	fopts.output_gauges = 1;
+	fopts.gauge_binary = 1;
+	fopts.gauge_buffer_length = 2;
+
+	fclaw2d_domain_t *domain = create_test_domain(sc_MPI_COMM_WORLD,&fopts);
+	fclaw2d_global_store_domain(glob, domain);
+	fclaw2d_options_store(glob, &fopts);
+
+	fclaw2d_diagnostics_vtable_t *diag_vt = fclaw2d_diagnostics_vt(glob);
+	void **acc = &glob->acc->gauge_accumulator;
+	diag_vt->gauges_init_diagnostics(glob,acc);
+
+	/* Every gauge is found on exactly one process */
+	for(int i = 0; i < test_num_gauges; i++)
+		test_updates[i] = 0;
+	fclaw_locate_gauges(glob);
+	const double times[3] = {0, 0.25, 0.5};
+	for(double t : times)
+	{
+		glob->curr_time = t;
+		diag_vt->gauges_compute_diagnostics(glob,*acc);
+	}
+	int updates[3];
+	int mpiret = sc_MPI_Allreduce(test_updates, updates, 3, sc_MPI_INT, 
+	                              sc_MPI_SUM, glob->mpicomm);
+	SC_CHECK_MPI(mpiret);
+	for(int i = 0; i < test_num_gauges; i++)
+		CHECK_EQ(updates[i], 3);
+
+	/* Writes the records that are still buffered */
+	diag_vt->gauges_finalize_diagnostics(glob,acc);
+
+	if (glob->mpirank == 0)
+	{
+		const size_t index_len = 2 + 5*test_num_gauges;
+		const size_t num_records = 3*test_num_gauges;
+		std::vector<double> data(index_len + 3*num_records + 1);
+		FILE *fp = fopen("gauges.bin","rb");
+		REQUIRE_NE(fp, nullptr);
+		CHECK_EQ(fread(data.data(),sizeof(double),data.size(),fp), 
+		         index_len + 3*num_records);
+		fclose(fp);
+		remove("gauges.bin");
+
+		CHECK_EQ(data[0], test_num_gauges);
+		CHECK_EQ(data[1], 2);
+		for(int i = 0; i < test_num_gauges; i++)
+		{
+			CHECK_EQ(data[2 + 5*i], 10 + i);
+			CHECK_EQ(data[3 + 5*i], test_gauge_xy[i][0]);
+			CHECK_EQ(data[4 + 5*i], test_gauge_xy[i][1]);
+			CHECK_EQ(data[5 + 5*i], 0);
+			CHECK_EQ(data[6 + 5*i], 1);
+		}
+
+		/* Each record is gauge index, time, gauge number;  the records of
+		   a gauge are in time order */
+		int next[3] = {0, 0, 0};
+		for(size_t k = 0; k < num_records; k++)
+		{
+			const double *record = &data[index_len + 3*k];
+			int i = (int) record[0];
+			REQUIRE_GE(i, 0);
+			REQUIRE_LT(i, test_num_gauges);
+			CHECK_EQ(record[2], 10 + i);
+			REQUIRE_LT(next[i], 3);
+			CHECK_EQ(record[1], times[next[i]]);
+			next[i]++;
+		}
+	}
+
+	fclaw2d_global_destroy(glob);
+}
+
 #ifdef FCLAW_ENABLE_DEBUG
 
 TEST_CASE("fclaw_guages_vtable_initialize fails if called twice on a glob")
@@ -65,6 +65,16 @@ fclaw_register (fclaw_options_t* fclaw_opt, sc_options_t * opt)
     sc_options_add_bool (opt, 0, "reduce-cfl", &fclaw_opt->reduce_cfl, 1,
                            "Get maximum CFL over all processors [T]");
 
+    sc_options_add_bool (opt, 0, "speculative-cfl", &fclaw_opt->speculative_cfl, 0,
+                         "Take steps in pairs with the same dt, reducing the " \
+                         "CFL of the first step during the second, and " \
+                         "retake both steps if either CFL was too large.  " \
+                         "This halves the number of blocking reductions; " \
+                         "the second one still waits.  The second " \
+                         "step starts from a step that may exceed max_cfl; " \
+                         "a solver abort in it (e.g. a negative depth) " \
+                         "cannot be recovered by retaking [F]");
+
     sc_options_add_bool (opt, 0, "use_fixed_dt", &fclaw_opt->use_fixed_dt, 0,
                          "Use fixed coarse grid time step [F]");
 
@@ -116,6 +126,13 @@ fclaw_register (fclaw_options_t* fclaw_opt, sc_options_t * opt)
     sc_options_add_bool (opt, 0, "output", &fclaw_opt->output, 0,
                             "Enable output [F]");
 
+    sc_options_add_bool (opt, 0, "output-async", &fclaw_opt->output_async, 0,
+                            "Write output files in a background thread [F]");
+
+    sc_options_add_int (opt, 0, "output-async-buffer",
+                        &fclaw_opt->output_async_buffer, 256,
+                        "Memory in MB for output waiting to be written [256]");
+
 
     /* -------------------------------------- Gauges  --------------------------------- */
     /* Gauge options */
@@ -126,6 +143,9 @@ fclaw_register (fclaw_options_t* fclaw_opt, sc_options_t * opt)
                        &fclaw_opt->gauge_buffer_length, 1,
                        "Number of lines of gauge output to buffer before printing [1]");
 
+    sc_options_add_bool (opt, 0, "gauge-binary", &fclaw_opt->gauge_binary, 0,
+                         "Write all gauges to the single binary file gauges.bin [F]");
+
     /* -------------------------------- tikz output ----------------------------------- */
     sc_options_add_bool (opt, 0, "tikz-out", &fclaw_opt->tikz_out, 0,
                          "Enable tikz output for gridlines [F]");
@@ -246,7 +266,8 @@ fclaw_register (fclaw_options_t* fclaw_opt, sc_options_t * opt)
 
     sc_options_add_bool (opt, 0, "ghost-patch-pack-area", 
                          &fclaw_opt->ghost_patch_pack_area,0,
-                         "Pack area for parallel comm. of ghost patches [F]");
+                         "Pack area with each parallel comm. of ghost patches. " \
+                         "Clawpatch sends the area once per regrid instead [F]");
 
     sc_options_add_bool (opt, 0, "ghost-patch-pack-extra", 
                          &fclaw_opt->ghost_patch_pack_extra,
@@ -288,6 +309,13 @@ fclaw_register (fclaw_options_t* fclaw_opt, sc_options_t * opt)
     sc_options_add_bool (opt, 0, "manifold", &fclaw_opt->manifold, 0,
                          "Solution is on manifold [F]");
 
+    sc_options_add_int (opt, 0, "metric-area-cache-size", 
+                        &fclaw_opt->metric_area_cache_size, 0,
+                        "Number of patch areas kept for non-affine maps, so " \
+                        "that regridding doesn't redo the quadrature.  Each " \
+                        "area takes (mx+2*mbc+2)*(my+2*mbc+2) doubles; " \
+                        "0 disables the cache [0]");
+
     sc_options_add_int (opt, 0, "mi", &fclaw_opt->mi, 1,
                         "Number of blocks in x direction [1]");
 
@@ -366,6 +394,12 @@ fclaw_options_check (fclaw_options_t * fclaw_opt)
         return FCLAW_EXIT_ERROR;
     }
 
+    if (fclaw_opt->output_async && fclaw_opt->output_async_buffer < 1)
+    {
+        fclaw_global_essentialf("output-async-buffer must be at least 1 MB\n");
+        return FCLAW_EXIT_ERROR;
+    }
+
     /* TODO: move these blocks to the beginning of forestclaw's control flow */
     if (fclaw_opt->mpi_debug)
     {
@@ -130,6 +130,7 @@ struct fclaw_options
     double max_cfl;
     double desired_cfl;
     int reduce_cfl;   /* Do an all-reduce to get max. cfl */
+    int speculative_cfl;   /* Take steps in pairs, with one blocking all-reduce per pair */
     double *tout;
 
     /* Refinement parameters */
@@ -147,9 +148,11 @@ struct fclaw_options
     /* Gauges */
     int output_gauges;
     int gauge_buffer_length;       
+    int gauge_binary;
 
     /* Mapping functions */
     int manifold;
+    int metric_area_cache_size;
     int mi;
     int mj;
     int periodic_x;
@@ -214,6 +217,8 @@ struct fclaw_options
     int verbosity;              /**< TODO: Do we have guidelines here? */
 
     int output;                    
+    int output_async;           /**< Write output files in a background thread */
+    int output_async_buffer;    /**< Staging memory for asynchronous output, in MB */
     int tikz_out;      /* Boolean */
 
     const char *tikz_figsize_string;
@@ -25,7 +25,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw_pointer_map.h>
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -34,11 +36,19 @@ namespace
         void* pointer = nullptr;
         fclaw_pointer_map_value_destroy_t destroy = nullptr;
     };
+
+    /* Slots of all keys seen so far, shared by all maps */
+    std::mutex slots_mutex;
+    std::map<std::string, int>& slots()
+    {
+        static std::map<std::string, int> slots;
+        return slots;
+    }
 }
 
 struct fclaw_pointer_map
 {
-    std::map<std::string, value> map;
+    std::vector<value> values;
 };
 
 fclaw_pointer_map_t* fclaw_pointer_map_new()
@@ -48,21 +58,34 @@ fclaw_pointer_map_t* fclaw_pointer_map_new()
 
 void fclaw_pointer_map_destroy(fclaw_pointer_map_t* map)
 {
-    std::map<std::string, value>::iterator it = map->map.begin();
-    while(it != map->map.end()){
-        if(it->second.destroy != nullptr)
-            it->second.destroy(it->second.pointer);
-        ++it;
+    for(value& v : map->values){
+        if(v.destroy != nullptr)
+            v.destroy(v.pointer);
     }
     delete map;
 }
 
+int fclaw_pointer_map_slot(const char* key)
+{
+    std::lock_guard<std::mutex> lock(slots_mutex);
+    std::map<std::string, int>& s = slots();
+    std::map<std::string, int>::iterator it = s.find(key);
+    if(it == s.end()){
+        it = s.insert(std::make_pair(std::string(key), (int) s.size())).first;
+    }
+    return it->second;
+}
+
 void fclaw_pointer_map_insert(fclaw_pointer_map_t* map, 
                               const char* key, 
                               void* pointer, 
                               fclaw_pointer_map_value_destroy_t destroy)
 {
-    value& v = map->map[key];
+    int slot = fclaw_pointer_map_slot(key);
+    if((int) map->values.size() <= slot){
+        map->values.resize(slot + 1);
+    }
+    value& v = map->values[slot];
     if(v.destroy){
         v.destroy(v.pointer);
     }
@@ -72,6 +95,13 @@ void fclaw_pointer_map_insert(fclaw_pointer_map_t* map,
 
 void* fclaw_pointer_map_get(fclaw_pointer_map_t* map, const char* key)
 {
-    return map->map[key].pointer;
+    return fclaw_pointer_map_get_slot(map, fclaw_pointer_map_slot(key));
 }
 
+void* fclaw_pointer_map_get_slot(fclaw_pointer_map_t* map, int slot)
+{
+    if(slot < 0 || slot >= (int) map->values.size()){
+        return nullptr;
+    }
+    return map->values[slot].pointer;
+}
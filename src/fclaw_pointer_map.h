@@ -42,6 +42,12 @@ extern "C"
 
 /**
  * @brief Pointer map structure
+ *
+ * Every key is assigned a slot, an integer that is the same for all maps 
+ * in the process.  Values are stored in an array indexed by slot, so that 
+ * ::fclaw_pointer_map_get_slot is an array access.  Accessors that are 
+ * called often, e.g. per patch, resolve the slot of their key when the 
+ * value is registered instead of comparing strings.
  */
 typedef struct fclaw_pointer_map fclaw_pointer_map_t;
 
@@ -85,6 +91,42 @@ void fclaw_pointer_map_insert(fclaw_pointer_map_t* map, const char* key, void* v
  */
 void* fclaw_pointer_map_get(fclaw_pointer_map_t* map, const char* key);
 
+/**
+ * @brief get the slot of a key
+ * 
+ * Creates a new slot the first time a key is seen.  The slot of a key 
+ * does not change and is shared by all maps.
+ * 
+ * @param key the key
+ * @return int the slot
+ */
+int fclaw_pointer_map_slot(const char* key);
+
+/**
+ * @brief get a value from the map by slot
+ * 
+ * Accessors that are called from threads keep the slot in a static 
+ * that is only written when the value is registered, e.g.
+ *
+ *     static int vt_slot = -1;
+ *
+ *     void initialize(fclaw2d_global_t* glob)
+ *     {
+ *         fclaw_pointer_map_insert(glob->vtables, "name", vt, destroy);
+ *         vt_slot = fclaw_pointer_map_slot("name");
+ *     }
+ *
+ *     vtable_t* vt(fclaw2d_global_t* glob)
+ *     {
+ *         return fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
+ *     }
+ * 
+ * @param map the map
+ * @param slot the slot, from ::fclaw_pointer_map_slot, or -1
+ * @return void* the value, or nullptr if not found
+ */
+void* fclaw_pointer_map_get_slot(fclaw_pointer_map_t* map, int slot);
+
 #ifdef __cplusplus
 #if 0
 {
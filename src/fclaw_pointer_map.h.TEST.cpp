@@ -25,6 +25,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw_pointer_map.h>
 #include <test.hpp>
+#include <string>
+#include <vector>
 
 TEST_CASE("fclaw_pointer_map empty map get is nullptr")
 {
@@ -133,4 +135,63 @@ TEST_CASE("fclaw_pointer_map set twice and get with null destory")
 	CHECK_EQ(fclaw_pointer_map_get(map, "key"), value2);
 
 	fclaw_pointer_map_destroy(map);
-}
\ No newline at end of file
+}
+
+TEST_CASE("fclaw_pointer_map slot is the same for every map")
+{
+	int slot = fclaw_pointer_map_slot("slot_key");
+	CHECK_EQ(fclaw_pointer_map_slot("slot_key"), slot);
+	CHECK_NE(fclaw_pointer_map_slot("slot_key2"), slot);
+
+	fclaw_pointer_map_t* map = fclaw_pointer_map_new();
+	fclaw_pointer_map_t* map2 = fclaw_pointer_map_new();
+
+	void* value = (void*) 1;
+	void* value2 = (void*) 2;
+
+	CHECK_EQ(fclaw_pointer_map_get_slot(map, slot), nullptr);
+
+	fclaw_pointer_map_insert(map, "slot_key", value, nullptr);
+	fclaw_pointer_map_insert(map2, "slot_key2", nullptr, nullptr);
+	fclaw_pointer_map_insert(map2, "slot_key", value2, nullptr);
+
+	CHECK_EQ(fclaw_pointer_map_get_slot(map, slot), value);
+	CHECK_EQ(fclaw_pointer_map_get_slot(map2, slot), value2);
+
+	fclaw_pointer_map_destroy(map);
+	fclaw_pointer_map_destroy(map2);
+}
+
+TEST_CASE("fclaw_pointer_map get with an unresolved slot")
+{
+	fclaw_pointer_map_t* map = fclaw_pointer_map_new();
+	fclaw_pointer_map_insert(map, "unresolved_key", (void*) 1, nullptr);
+
+	CHECK_EQ(fclaw_pointer_map_get_slot(map, -1), nullptr);
+
+	fclaw_pointer_map_destroy(map);
+}
+
+TEST_CASE("fclaw_pointer_map slots are resolved once from several threads")
+{
+	const int n = 64;
+	std::vector<int> first(n), second(n);
+
+#pragma omp parallel for
+	for(int i = 0; i < 2*n; i++)
+	{
+		std::string key = "thread_key_" + std::to_string(i % n);
+		(i < n ? first[i] : second[i - n]) = fclaw_pointer_map_slot(key.c_str());
+	}
+
+	for(int i = 0; i < n; i++)
+	{
+		std::string key = "thread_key_" + std::to_string(i);
+		CHECK_EQ(first[i], second[i]);
+		CHECK_EQ(fclaw_pointer_map_slot(key.c_str()), first[i]);
+		for(int j = 0; j < i; j++)
+		{
+			CHECK_NE(first[j], first[i]);
+		}
+	}
+}
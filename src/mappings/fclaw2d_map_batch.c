@@ -0,0 +1,198 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Array versions of the generic Fortran mappings in src/mappings.
+
+   Each routine maps n points in a single block.  The block dependent choices
+   are made once outside of the loop over points, and the loops themselves
+   contain only arithmetic and min/max/select operations so that they can be
+   vectorized by the compiler.
+*/
+
+#include <fclaw2d_map.h>
+
+/* ---------------------------------------------------------------------------------- */
+
+void fclaw2d_map_batch_cubedsphere (int blockno, int n,
+                                    const double xc[], const double yc[],
+                                    double xp[], double yp[], double zp[])
+{
+    /* csphere_basic computes (a,b,c) = c*(tan_xi, tan_eta, 1) on the unit sphere.
+       The block number only decides which of (xp,yp,zp) receives a, b and c,
+       and whether c changes sign.  See mapc2m_cubedsphere.f */
+    double *pa, *pb, *pc;
+    double sc = 1.0;
+    int i;
+
+    switch (blockno)
+    {
+    case 0:
+        pa = yp;  pb = xp;  pc = zp;  sc = -1.0;
+        break;
+    case 1:
+        pa = zp;  pb = xp;  pc = yp;
+        break;
+    case 2:
+        pa = zp;  pb = yp;  pc = xp;  sc = -1.0;
+        break;
+    case 3:
+        pa = xp;  pb = yp;  pc = zp;
+        break;
+    case 4:
+        pa = xp;  pb = zp;  pc = yp;  sc = -1.0;
+        break;
+    case 5:
+        pa = yp;  pb = zp;  pc = xp;
+        break;
+    default:
+        SC_ABORT_NOT_REACHED ();
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        const double tan_xi = tan (0.5 * M_PI * (xc[i] - 0.5));
+        const double tan_eta = tan (0.5 * M_PI * (yc[i] - 0.5));
+        const double c = 1.0 / sqrt (tan_xi * tan_xi + tan_eta * tan_eta + 1.0);
+        pa[i] = c * tan_xi;
+        pb[i] = c * tan_eta;
+        pc[i] = sc * c;
+    }
+}
+
+/* ---------------------------------------------------------------------------------- */
+
+void fclaw2d_map_batch_pillowsphere (int blockno, int n,
+                                     const double xc[], const double yc[],
+                                     double xp[], double yp[], double zp[])
+{
+    const double s2 = sqrt (2.0);
+    const double zsign = (blockno == 1) ? -1.0 : 1.0;   /* lower hemisphere */
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        /* Map to [-1,1]x[-1,1] */
+        const double x = 2.0 * xc[i] - 1.0;
+        const double y = 2.0 * yc[i] - 1.0;
+
+        /* Map x and y from ghost cells to interior */
+        double d = fmax (x - 1.0, 0.0) + fmax (-1.0 - x, 0.0);
+        double x1 = ((1.0 - d) / (1.0 + d)) * x;
+        d = fmax (y - 1.0, 0.0) + fmax (-1.0 - y, 0.0);
+        const double y1 = ((1.0 - d) / (1.0 + d)) * y;
+
+        if (x1 < -1.0)
+        {
+            x1 = -(x1 + 2.0);
+        }
+
+        /* Circle of radius sqrt(2), clustered towards the boundary.  See
+           mapc2p_circle_sp in mapc2m_pillowsphere.f */
+        const double ax = fabs (x1);
+        const double ay = fabs (y1);
+        const double xi = fmin (ax, ay);
+        const double eta = fmax (fmax (ax, ay), 1.0e-10);
+        const double dd = sin (M_PI * eta / 2.0);
+        const double xit = (xi / eta) * dd;
+        const double ys = sqrt (2.0 - xit * xit) - sqrt (2.0 - dd * dd) + dd;
+        const double minxy = fmin (fabs (xit), fabs (ys));
+        const double maxxy = fmax (fabs (xit), fabs (ys));
+
+        const int ns = ax <= ay;
+        const double px = copysign (ns ? minxy : maxxy, x1);
+        const double py = copysign (ns ? maxxy : minxy, y1);
+
+        /* Values outside of [-1,1]x[-1,1] go to the other hemisphere */
+        const double rp2 = px * px + py * py;
+        double pz = fabs (rp2 - 2.0) < 1.0e-10 ? 0.0 : sqrt (2.0 - rp2);
+        if ((fabs (x) > 1.0) != (fabs (y) > 1.0))
+        {
+            pz = -pz;
+        }
+
+        /* Map everything to the unit sphere */
+        xp[i] = px / s2;
+        yp[i] = py / s2;
+        zp[i] = zsign * pz / s2;
+    }
+}
+
+/* ---------------------------------------------------------------------------------- */
+
+void fclaw2d_map_batch_pillowdisk (int blockno, int n,
+                                   const double xc[], const double yc[],
+                                   double xp[], double yp[], double zp[])
+{
+    const double s2 = sqrt (2.0);
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        /* Map to [-1,1]x[-1,1] */
+        const double x = 2.0 * xc[i] - 1.0;
+        const double y = 2.0 * yc[i] - 1.0;
+
+        /* Circle of radius sqrt(2).  See mapc2p_disk_circle in
+           mapc2m_pillowdisk.f */
+        const double ax = fabs (x);
+        const double ay = fabs (y);
+        const double xi = fmin (ax, ay);
+        const double eta = fmax (fmax (ax, ay), 1.0e-10);
+        const double ys = sqrt (2.0 - xi * xi) - sqrt (2.0 - eta * eta) + eta;
+        const double minxy = fmin (xi, fabs (ys));
+        const double maxxy = fmax (xi, fabs (ys));
+
+        const int ns = ax <= ay;
+
+        /* Scale to get the unit circle */
+        xp[i] = copysign (ns ? minxy : maxxy, x) / s2;
+        yp[i] = copysign (ns ? maxxy : minxy, y) / s2;
+        zp[i] = 0;
+    }
+}
+
+/* ---------------------------------------------------------------------------------- */
+
+void fclaw2d_map_batch_torus (int n, const double xc[], const double yc[],
+                              double xp[], double yp[], double zp[],
+                              double alpha, double beta)
+{
+    const double pi2 = 2.0 * M_PI;
+    int i;
+
+    /* Inputs are read before outputs are written, so that (xc,yc) may be
+       the same arrays as (xp,yp) */
+    for (i = 0; i < n; i++)
+    {
+        const double x = xc[i];
+        const double y = yc[i];
+        const double r1 = alpha * (1.0 + beta * sin (pi2 * x));
+        const double R = 1.0 + r1 * cos (pi2 * y);
+
+        xp[i] = R * cos (pi2 * x);
+        yp[i] = R * sin (pi2 * x);
+        zp[i] = r1 * sin (pi2 * y);
+    }
+}
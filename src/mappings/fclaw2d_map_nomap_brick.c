@@ -71,6 +71,15 @@ void
 }
 
 
+static void
+fclaw2d_map_c2m_batch_nomap_brick(fclaw2d_map_context_t * cont, int blockno,
+                                  int n, const double xc[], const double yc[],
+                                  double xp[], double yp[], double zp[])
+{
+    fclaw2d_map_brick2c_batch(cont,blockno,n,xc,yc,xp,yp,zp);
+}
+
+
 /* This shouldn't be called */
 static void
 fclaw3dx_map_c2m_nomap_brick(fclaw2d_map_context_t * cont, int blockno,
@@ -96,6 +105,7 @@ fclaw2d_map_context_t* fclaw2d_map_new_nomap_brick(fclaw2d_map_context_t* brick)
     cont = FCLAW_ALLOC_ZERO (fclaw2d_map_context_t, 1);
     cont->query = fclaw2d_map_query_nomap_brick;
     cont->mapc2m = fclaw2d_map_c2m_nomap_brick;
+    cont->mapc2m_batch = fclaw2d_map_c2m_batch_nomap_brick;
 
     cont->mapc2m_3dx = fclaw3dx_map_c2m_nomap_brick;
 
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_clawpatch_pillow.h>  
 
 #include <fclaw2d_clawpatch46_fort.h>
+#include <fclaw2d_clawpatch46_kernels.h>
 #include <fclaw2d_clawpatch5_fort.h>
 
 #include <fclaw2d_metric.h>
@@ -142,13 +143,19 @@ fclaw2d_metric_patch_t* get_metric_patch(fclaw2d_patch_t *patch)
 	return (fclaw2d_metric_patch_t*) clawpatch_get_metric_patch(patch);
 }
 
-/* Return a pointer to either time interpolated data or regular grid data */
+/* Return a pointer to either time interpolated data or regular grid data.  
+   Time interpolated data is only allocated for patches that use it, i.e. 
+   coarse patches next to finer patches and their remote ghost patches. */
 static 
 double* q_time_sync(fclaw2d_patch_t* patch, int time_interp)
 {
 	fclaw2d_clawpatch_t* cp = get_clawpatch(patch);
 	if (time_interp)
+	{
+		if (cp->griddata_time_interpolated.size() == 0)
+			cp->griddata_time_interpolated.define(cp->griddata.box(), cp->meqn);
 		return cp->griddata_time_interpolated.dataPtr();
+	}
 	else
 		return cp->griddata.dataPtr();
 }
@@ -161,6 +168,101 @@ double* clawpatch_get_area(struct fclaw2d_global* glob,
 }
 
 
+/* ------------------------------- Time interpolation ring ---------------------------- */
+
+/* True if only the ring of the last time step is stored */
+static
+int clawpatch_use_ring(fclaw2d_global_t *glob)
+{
+	const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+	const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+	return fclaw_opt->subcycle && clawpatch_opt->time_interp_ring;
+}
+
+/* Number of interior layers that are time interpolated */
+static
+int clawpatch_timeinterp_mint(const fclaw2d_clawpatch_options_t *clawpatch_opt)
+{
+	return clawpatch_opt->interp_stencil_width/2+1;
+}
+
+/* Number of values in the ring of width mint just inside the patch boundary */
+static
+int clawpatch_timeinterp_size(const fclaw2d_clawpatch_options_t *clawpatch_opt)
+{
+	int mx = clawpatch_opt->mx;
+	int my = clawpatch_opt->my;
+	int mint = clawpatch_timeinterp_mint(clawpatch_opt);
+
+	int hole = (mx - 2*mint)*(my - 2*mint);  /* Hole in center */
+	int wg = mx*my;  /* Whole grid but no ghost cells.  
+						Ghost cells will be averaged from finer level. */
+#if PATCH_DIM == 3
+	int mz = clawpatch_opt->mz;
+	hole *= mz;
+	wg *= mz;
+#endif
+	FCLAW_ASSERT(hole >= 0);
+
+	return (wg - hole)*clawpatch_opt->meqn;
+}
+
+/* Visit the ring cells in the order in which they are stored in 
+   griddata_last_ring.  The ring is traversed as in the timeinterp 
+   kernels : faces 0, 2, 1 and 3, with the corners assigned so that 
+   each cell is visited once.  If qinterp is NULL, qcurr is copied into
+   the ring;  otherwise the ring is used as the last time step. */
+static
+void clawpatch_ring_timeinterp(const fclaw2d_clawpatch_t *cp, int mint,
+                               const double *qcurr, double *qring, 
+                               double *qinterp, double alpha)
+{
+	int mx = cp->mx;
+	int my = cp->my;
+	int mbc = cp->mbc;
+	int mz = 1;
+	int kstride = 0;  /* No z-direction in 2d */
+#if PATCH_DIM == 3
+	mz = cp->mz;
+	kstride = (mx + 2*mbc)*(my + 2*mbc);
+#endif
+	int jstride = mx + 2*mbc;
+	int mstride = (mx + 2*mbc)*(my + 2*mbc);
+#if PATCH_DIM == 3
+	mstride *= (mz + 2*mbc);
+#endif
+
+	/* Index ranges [i0,i1] x [j0,j1] of faces 0, 2, 1, 3 */
+	int range[4][4] = {{1,         mint, 1,         my-mint},
+	                   {mint+1,    mx,   1,         mint},
+	                   {mx-mint+1, mx,   mint+1,    my},
+	                   {1,         mx-mint, my-mint+1, my}};
+
+	size_t r = 0;
+	for (int m = 0; m < cp->meqn; m++)
+	{
+		for (int k = 1; k <= mz; k++)
+		{
+			for (int f = 0; f < 4; f++)
+			{
+				for (int j = range[f][2]; j <= range[f][3]; j++)
+				{
+					size_t ij = m*mstride + (k - 1 + mbc)*kstride
+					            + (j - 1 + mbc)*jstride + (mbc - 1);
+					for (int i = range[f][0]; i <= range[f][1]; i++, r++)
+					{
+						if (qinterp == NULL)
+							qring[r] = qcurr[ij + i];
+						else
+							qinterp[ij + i] = qring[r] + alpha*(qcurr[ij + i] - qring[r]);
+					}
+				}
+			}
+		}
+	}
+	FCLAW_ASSERT(r == cp->griddata_last_ring.size());
+}
+
 /* ----------------------------- Creating/deleting patches ---------------------------- */
 
 static
@@ -318,8 +420,6 @@ void clawpatch_define(fclaw2d_global_t* glob,
 
 	// This will destroy any existing memory n griddata.
 	cp->griddata.define(box, cp->meqn);
-	if (fclaw_opt->subcycle)
-		cp->griddata_time_interpolated.define(box, cp->meqn);
 
 	if (fclaw_opt->compute_error)
 	{
@@ -377,7 +477,10 @@ void clawpatch_define(fclaw2d_global_t* glob,
 		/* If we are building ghost patches, we don't need all the patch memory */
 		return;
 
-	cp->griddata_last.define(box, cp->meqn);
+	if (clawpatch_use_ring(glob))
+		cp->griddata_last_ring.resize(clawpatch_timeinterp_size(clawpatch_opt));
+	else
+		cp->griddata_last.define(box, cp->meqn);
 	cp->griddata_save.define(box, cp->meqn);
 
 }
@@ -484,27 +587,30 @@ void clawpatch_setup_timeinterp(fclaw2d_global_t *glob,
 	int my = clawpatch_opt->my;
 	int meqn = clawpatch_opt->meqn;
 	int mbc = clawpatch_opt->mbc;
-	int mint = clawpatch_opt->interp_stencil_width/2+1;  
-
-	int hole = (mx - 2*mint)*(my - 2*mint);  /* Hole in center */
-	int wg = mx*my;  /* Whole grid but no ghost cells.  
-						Ghost cells will be averaged from finer level. */
 #if PATCH_DIM == 3
 	int mz = clawpatch_opt->mz;
-	hole *= mz;
-	wg *= mz;
 #endif
-	FCLAW_ASSERT(hole >= 0);
 
-	int psize = (wg - hole)*meqn;
+	int psize = clawpatch_timeinterp_size(clawpatch_opt);
 	FCLAW_ASSERT(psize > 0);
 
 	/* Store time interpolated data that will be use in coarse grid
 	   exchanges */
 	fclaw2d_clawpatch_t *cp = get_clawpatch(patch);
-	double *qlast = cp->griddata_last.dataPtr();
 	double *qcurr = cp->griddata.dataPtr();
-	double *qinterp = cp->griddata_time_interpolated.dataPtr();
+	double *qinterp = q_time_sync(patch, 1);
+
+	if (clawpatch_use_ring(glob))
+	{
+		/* Only the ring of the last time step was saved */
+		FCLAW_ASSERT((int) cp->griddata_last_ring.size() == psize);
+		clawpatch_ring_timeinterp(cp, clawpatch_timeinterp_mint(clawpatch_opt),
+		                          qcurr, cp->griddata_last_ring.data(),
+		                          qinterp, alpha);
+		return;
+	}
+
+	double *qlast = cp->griddata_last.dataPtr();
 
 	int ierror;
 
@@ -1030,17 +1136,18 @@ size_t clawpatch_ghost_pack_elems(fclaw2d_global_t* glob)
 	const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
 	int refratio = fclaw_opt->refratio;
 	int packextra = fclaw_opt->ghost_patch_pack_numextrafields;
-	int packarea = fclaw_opt->ghost_patch_pack_area && fclaw_opt->manifold;
+	int packarea = 0;   /* Area is sent once;  see clawpatch_ghost_metric_comm */
 	int packregisters = fclaw_opt->time_sync;
 
 	int mint = refratio*mbc;
 	int nghost = mbc;
 
-	/* Include size of conservation registers.  Save fluxes on each size, 
-	   even though only one or two sides may be used. */
+	/* Include size of conservation registers.  Leave room for fluxes on each 
+	   side, even though only faces at coarse/fine or block interfaces are 
+	   sent. */
 	// int frsize = 12*meqn*(mx + my); 
 
-	int frsize = packregisters ? 2*(4*meqn+2)*(mx + my) : 0;
+	int frsize = packregisters ? 1 + 2*(4*meqn+2)*(mx + my) : 0;
 #if PATCH_DIM == 3
 	int mz = clawpatch_opt->mz;
 	if (packregisters)
@@ -1090,8 +1197,9 @@ void clawpatch_ghost_comm(fclaw2d_global_t* glob,
 	int mint = refratio*mbc;   /* # interior cells needed for averaging */
 	int nghost = mbc;          /* # ghost values needed for interpolation */
 
-	/* Include size of conservation registers.  Save fluxes on each size, 
-	   even though only one or two sides may be used.
+	/* Include size of conservation registers.  Leave room for fluxes on each 
+	   side, even though only faces at coarse/fine or block interfaces are 
+	   sent.  The first value is the mask of faces that are sent.
 
 	   y-face : gp,gm,f(qfront),f(qback) + edge-length + area : 4*meqn + 2
 	   x-face : fp,fm,f(ql),f(qr) + edge-length + area        : 4*meqn + 2
@@ -1100,7 +1208,7 @@ void clawpatch_ghost_comm(fclaw2d_global_t* glob,
 	   (Time sync not yet implemented in 3d, though). 
 
 	   */
-	int frsize = packregisters ? 2*(4*meqn+2)*(mx + my) : 0;
+	int frsize = packregisters ? 1 + 2*(4*meqn+2)*(mx + my) : 0;
 
 #if PATCH_DIM == 3
 	int mz = clawpatch_opt->mz;
@@ -1204,10 +1312,7 @@ void clawpatch_local_ghost_pack(fclaw2d_global_t *glob,
 								void *patch_data,
 								int time_interp)
 {
-	const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
-	int packarea = fclaw_opt->ghost_patch_pack_area && fclaw_opt->manifold;
-	int packmode = 2*packarea;  // 0 or 2  (for pack)
-
+	int packmode = 0;  /* pack q only */
 	clawpatch_ghost_comm(glob,patch,patch_data, time_interp,packmode);
 }
 
@@ -1217,12 +1322,107 @@ void clawpatch_remote_ghost_unpack(fclaw2d_global_t* glob,
 								   int blockno,
 								   int patchno,
 								   void *qdata, int time_interp)
+{
+	int packmode = 1;  /* unpack q only */
+	clawpatch_ghost_comm(glob,patch,qdata,time_interp,packmode);
+}
+
+/* The area (volume in 3d) of remote ghost patches doesn't change between 
+   regrids.  It is sent once when the ghost patches are built, instead 
+   of with every exchange. */
+static
+size_t clawpatch_ghost_metric_pack_elems(fclaw2d_global_t* glob)
 {
 	const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
-	int packarea = fclaw_opt->ghost_patch_pack_area && fclaw_opt->manifold;
-	int packmode = 2*packarea + 1;  // 1 or 3  (for unpack)
+	if (!fclaw_opt->manifold)
+	{
+		return 0;
+	}
 
-	clawpatch_ghost_comm(glob,patch,qdata,time_interp,packmode);
+	const fclaw2d_clawpatch_options_t *clawpatch_opt = 
+					     	fclaw2d_clawpatch_get_options(glob);
+	int mx = clawpatch_opt->mx;
+	int my = clawpatch_opt->my;
+	int mbc = clawpatch_opt->mbc;
+	int mint = fclaw_opt->refratio*mbc;
+	int nghost = mbc;
+
+	int wg = (2*nghost + mx)*(2*nghost + my);  /* Whole grid     */
+	int hole = (mx - 2*mint)*(my - 2*mint);    /* Hole in center */
+#if PATCH_DIM == 3	
+	int mz = clawpatch_opt->mz;
+	wg *= (mz + 2*nghost);
+	hole *= (mz + 2*nghost); 
+#endif
+	FCLAW_ASSERT(hole >= 0);
+
+	return wg - hole;
+}
+
+static size_t clawpatch_ghost_metric_packsize(fclaw2d_global_t* glob)
+{
+	size_t esize = clawpatch_ghost_metric_pack_elems(glob);
+	return esize*sizeof(double);
+}
+
+static
+void clawpatch_ghost_metric_comm(fclaw2d_global_t* glob,
+								 fclaw2d_patch_t* patch,
+								 void *mdata, int packmode)
+{
+	const fclaw2d_clawpatch_options_t *clawpatch_opt = 
+	                        fclaw2d_clawpatch_get_options(glob);
+	int mx = clawpatch_opt->mx;
+	int my = clawpatch_opt->my;
+	int mbc = clawpatch_opt->mbc;
+
+	const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+	int mint = fclaw_opt->refratio*mbc;
+
+	/* With meqn = 0, the Fortran pack routine only packs the area */
+	int meqn = 0;
+	int areasize = clawpatch_ghost_metric_pack_elems(glob);
+
+	int ierror;
+	fclaw2d_clawpatch_vtable_t* clawpatch_vt = fclaw2d_clawpatch_vt(glob);
+	double *q = get_clawpatch(patch)->griddata.dataPtr();
+	double *mpack = (double*) mdata;
+#if PATCH_DIM == 2
+	double *area = clawpatch_get_area(glob, patch);	
+	clawpatch_vt->fort_local_ghost_pack(&mx,&my,&mbc,&meqn,&mint,q,area,
+										mpack,&areasize,&packmode,&ierror);
+#elif PATCH_DIM == 3
+	int mz = clawpatch_opt->mz;
+	double *vol = clawpatch_get_volume(glob, patch);	
+	clawpatch_vt->fort_local_ghost_pack(&mx,&my,&mz,&mbc,&meqn,&mint,q,vol,
+										mpack,&areasize,&packmode,&ierror);
+#endif
+	if (ierror > 0)
+	{
+		fclaw_global_essentialf("clawpatch_ghost_metric_comm  : ierror = %d\n",
+		                        ierror);
+		exit(0);
+	}
+}
+
+static
+void clawpatch_local_ghost_metric_pack(fclaw2d_global_t *glob,
+									   fclaw2d_patch_t *patch,
+									   void *patch_data)
+{
+	int packmode = 2;  /* pack area */
+	clawpatch_ghost_metric_comm(glob,patch,patch_data,packmode);
+}
+
+static
+void clawpatch_remote_ghost_metric_unpack(fclaw2d_global_t* glob,
+										  fclaw2d_patch_t* patch,
+										  int blockno,
+										  int patchno,
+										  void *mdata)
+{
+	int packmode = 3;  /* unpack area */
+	clawpatch_ghost_metric_comm(glob,patch,mdata,packmode);
 }
 
 static
@@ -1241,7 +1441,8 @@ void clawpatch_remote_ghost_build(fclaw2d_global_t *glob,
 		if (build_mode != FCLAW2D_BUILD_FOR_GHOST_AREA_PACKED)
 		{
 			/* Cell areas/volumes are not sent as MPI messages and so must
-			   be recomputed
+			   be recomputed.  Otherwise, these are sent once by
+			   clawpatch_local_ghost_metric_pack.
 			*/
 			//fclaw2d_metric_patch_build(glob,patch,blockno,patchno);
 			fclaw2d_metric_patch_compute_area(glob,patch,blockno,patchno);
@@ -1325,6 +1526,8 @@ void clawpatch_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 void fclaw2d_clawpatch_vtable_initialize(fclaw2d_global_t* glob, 
                                          int claw_version)
 {
@@ -1383,6 +1586,10 @@ void fclaw2d_clawpatch_vtable_initialize(fclaw2d_global_t* glob,
 	patch_vt->remote_ghost_unpack  = clawpatch_remote_ghost_unpack;
 	patch_vt->remote_ghost_delete  = clawpatch_remote_ghost_delete;
 
+	patch_vt->ghost_metric_packsize      = clawpatch_ghost_metric_packsize;
+	patch_vt->local_ghost_metric_pack    = clawpatch_local_ghost_metric_pack;
+	patch_vt->remote_ghost_metric_unpack = clawpatch_remote_ghost_metric_unpack;
+
 
 	/* partitioning */
 	patch_vt->partition_packsize   = clawpatch_partition_packsize;
@@ -1407,9 +1614,10 @@ void fclaw2d_clawpatch_vtable_initialize(fclaw2d_global_t* glob,
 #if PATCH_DIM == 2
 	if (claw_version == 4)
 	{
-		/* Clawpatch settings functions */
-		clawpatch_vt->fort_average2coarse        = FCLAW2D_CLAWPATCH46_FORT_AVERAGE2COARSE;
-		clawpatch_vt->fort_interpolate2fine      = FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE2FINE;
+		/* Kernels specialized for common patch sizes.  These call the Fortran 
+		   routines for other sizes. */
+		clawpatch_vt->fort_average2coarse        = fclaw2d_clawpatch46_average2coarse;
+		clawpatch_vt->fort_interpolate2fine      = fclaw2d_clawpatch46_interpolate2fine;
 
 		clawpatch_vt->fort_tag4refinement        = FCLAW2D_CLAWPATCH46_FORT_TAG4REFINEMENT;
 		clawpatch_vt->fort_tag4coarsening        = FCLAW2D_CLAWPATCH46_FORT_TAG4COARSENING;
@@ -1427,13 +1635,13 @@ void fclaw2d_clawpatch_vtable_initialize(fclaw2d_global_t* glob,
 		clawpatch_vt->fort_conservation_check    = FCLAW2D_CLAWPATCH46_FORT_CONSERVATION_CHECK;
 
 		/* Ghost cell exchange functions */
-		clawpatch_vt->fort_copy_face             = FCLAW2D_CLAWPATCH46_FORT_COPY_FACE;
-		clawpatch_vt->fort_average_face          = FCLAW2D_CLAWPATCH46_FORT_AVERAGE_FACE;
-		clawpatch_vt->fort_interpolate_face      = FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE_FACE;
+		clawpatch_vt->fort_copy_face             = fclaw2d_clawpatch46_copy_face;
+		clawpatch_vt->fort_average_face          = fclaw2d_clawpatch46_average_face;
+		clawpatch_vt->fort_interpolate_face      = fclaw2d_clawpatch46_interpolate_face;
 
-		clawpatch_vt->fort_copy_corner           = FCLAW2D_CLAWPATCH46_FORT_COPY_CORNER;
-		clawpatch_vt->fort_average_corner        = FCLAW2D_CLAWPATCH46_FORT_AVERAGE_CORNER;
-		clawpatch_vt->fort_interpolate_corner    = FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE_CORNER;
+		clawpatch_vt->fort_copy_corner           = fclaw2d_clawpatch46_copy_corner;
+		clawpatch_vt->fort_average_corner        = fclaw2d_clawpatch46_average_corner;
+		clawpatch_vt->fort_interpolate_corner    = fclaw2d_clawpatch46_interpolate_corner;
 
 		clawpatch_vt->local_ghost_pack_aux       = NULL;
 		clawpatch_vt->fort_local_ghost_pack      = FCLAW2D_CLAWPATCH46_FORT_LOCAL_GHOST_PACK;
@@ -1520,10 +1728,12 @@ void fclaw2d_clawpatch_vtable_initialize(fclaw2d_global_t* glob,
 	/* Set the virtual table, even if it isn't used */
 	fclaw2d_clawpatch_pillow_vtable_initialize(glob, claw_version);
 
+	clawpatch_vt->claw_version = claw_version;
 	clawpatch_vt->is_set = 1;
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables, CLAWPATCH_VTABLE_NAME) == NULL);
 	fclaw_pointer_map_insert(glob->vtables, CLAWPATCH_VTABLE_NAME, clawpatch_vt, clawpatch_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot(CLAWPATCH_VTABLE_NAME);
 }
 
 
@@ -1534,9 +1744,8 @@ void fclaw2d_clawpatch_vtable_initialize(fclaw2d_global_t* glob,
 
 fclaw2d_clawpatch_vtable_t* fclaw2d_clawpatch_vt(fclaw2d_global_t* glob)
 {
-
 	fclaw2d_clawpatch_vtable_t* clawpatch_vt = (fclaw2d_clawpatch_vtable_t*) 
-	   											fclaw_pointer_map_get(glob->vtables, CLAWPATCH_VTABLE_NAME);
+	   											fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(clawpatch_vt != nullptr);
 	FCLAW_ASSERT(clawpatch_vt->is_set != 0);
 	return clawpatch_vt;
@@ -1547,7 +1756,13 @@ void fclaw2d_clawpatch_save_current_step(fclaw2d_global_t* glob,
 										 fclaw2d_patch_t* patch)
 {
 	fclaw2d_clawpatch_t *cp = get_clawpatch(patch);
-	cp->griddata_last = cp->griddata;
+	const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+	if (clawpatch_use_ring(glob))
+		clawpatch_ring_timeinterp(cp, clawpatch_timeinterp_mint(clawpatch_opt),
+		                          cp->griddata.dataPtr(), 
+		                          cp->griddata_last_ring.data(), NULL, 0);
+	else
+		cp->griddata_last = cp->griddata;
 }
 
 
@@ -1664,6 +1879,45 @@ void fclaw2d_clawpatch_elliptic_soln_data(fclaw2d_global_t* glob,
 	*mfields = cp->mfields;
 }
 
+void fclaw2d_clawpatch_elliptic_work_data(fclaw2d_global_t* glob,
+                                          fclaw2d_patch_t* patch,
+                                          double **work, int *mfields)
+{
+	fclaw2d_clawpatch_t *cp = get_clawpatch(patch);
+	if (cp->elliptic_work.size() == 0)
+	{
+		/* Same layout as the rhs */
+		FCLAW_ASSERT(cp->rhs.size() > 0);
+		double zero = 0;
+		cp->elliptic_work.define(cp->rhs.box(),cp->mfields);
+		cp->elliptic_work.set_to_value(zero);
+	}
+	*work = cp->elliptic_work.dataPtr();
+	*mfields = cp->mfields;
+}
+
+void fclaw2d_clawpatch_elliptic_swap_rhs(fclaw2d_global_t* glob,
+                                         fclaw2d_patch_t* patch)
+{
+	fclaw2d_clawpatch_t *cp = get_clawpatch(patch);
+	if (cp->elliptic_work.size() == 0)
+	{
+		/* Nothing to exchange yet */
+		double *work;
+		int mfields;
+		fclaw2d_clawpatch_elliptic_work_data(glob,patch,&work,&mfields);
+		return;
+	}
+	cp->rhs.swap(cp->elliptic_work);
+}
+
+void fclaw2d_clawpatch_elliptic_work_delete(fclaw2d_global_t* glob,
+                                            fclaw2d_patch_t* patch)
+{
+	fclaw2d_clawpatch_t *cp = get_clawpatch(patch);
+	cp->elliptic_work = FArrayBox();
+}
+
 
 double *fclaw2d_clawpatch_get_q(fclaw2d_global_t* glob,
 								fclaw2d_patch_t* patch)
@@ -1677,6 +1931,8 @@ fclaw2d_clawpatch_get_registers(fclaw2d_global_t* glob,
                                   fclaw2d_patch_t* patch)
 {
 	fclaw2d_clawpatch_t *cp = get_clawpatch(patch);
+	/* Registers follow the neighbor types, which change with regridding */
+	fclaw2d_clawpatch_time_sync_set_faces(glob,patch,cp->registers);
 	return cp->registers;
 }
 
@@ -85,6 +85,33 @@ TEST_CASE("fclaw3dx_clawpatch_vtable_initialize sets is_set flag")
 	fclaw2d_global_destroy(glob);
 }
 
+TEST_CASE("fclaw2d_clawpatch_vtable_initialize sets claw_version")
+{
+	for(int claw_version : {4, 5})
+	{
+		fclaw2d_global_t* glob = fclaw2d_global_new();
+
+		fclaw2d_vtables_initialize(glob);
+		fclaw2d_clawpatch_vtable_initialize(glob, claw_version);
+
+		CHECK(fclaw2d_clawpatch_vt(glob)->claw_version == claw_version);
+
+		fclaw2d_global_destroy(glob);
+	}
+}
+
+TEST_CASE("fclaw3dx_clawpatch_vtable_initialize sets claw_version")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_vtables_initialize(glob);
+	fclaw3dx_clawpatch_vtable_initialize(glob, 4);
+
+	CHECK(fclaw3dx_clawpatch_vt(glob)->claw_version == 4);
+
+	fclaw2d_global_destroy(glob);
+}
+
 
 
 #ifdef FCLAW_ENABLE_DEBUG
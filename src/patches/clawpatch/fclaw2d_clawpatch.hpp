@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include <fclaw2d_farraybox.hpp>  /* Needed for FArray boxes */
 
+#include <vector>
+
 struct fclaw2d_patch;
 struct fclaw2d_global;
 struct  fclaw2d_metric_patch_t;
@@ -46,9 +48,14 @@ public :
     int meqn; /**< number of equations */                   
     FArrayBox griddata; /**< the current solution */
     FArrayBox griddata_last; /**< the solution at the last timestep */
+    /** Interior ring of the last time step (used with time-interp-ring) */
+    std::vector<double> griddata_last_ring;
     FArrayBox griddata_save; /**< the saved solution */
     FArrayBox griddata_time_interpolated; /**< the time interpolated solution */
     FArrayBox griderror; /**< the error */
+    /** The solution in a layout other than the native one, see
+        fclaw2d_clawpatch_soln_view */
+    FArrayBox griddata_layout;
 
     /** Exact solution for diagnostics */
     FArrayBox exactsolution;
@@ -58,6 +65,7 @@ public :
 
     FArrayBox elliptic_error;  /**< Error for elliptic problems */
     FArrayBox elliptic_soln;  /**< Solution for elliptic problems */
+    FArrayBox elliptic_work;  /**< Iterate for elliptic solvers, only allocated during a solve */
 
     /** Registers for accumulating mismatches at coarse/fine interfaces */
     struct fclaw2d_clawpatch_registers *registers;
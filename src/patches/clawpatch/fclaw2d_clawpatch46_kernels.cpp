@@ -0,0 +1,730 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw2d_clawpatch46_kernels.h>
+
+#include <fclaw_base.h>
+
+#include <fclaw2d_clawpatch46_fort.h>
+#include <fclaw2d_clawpatch_transform.h>
+
+#include <cmath>
+
+/* The kernels below follow the Fortran routines in fort_4.6 line by line.  
+   Making the patch size and the number of equations template parameters
+   lets the compiler unroll and vectorize the short ghost cell loops. */
+
+namespace {
+
+/* ------------------------------------ Index maps ------------------------------------ */
+
+/* Same as fclaw2d_clawpatch_build_transform_samesize */
+void kernel_transform_samesize(fclaw2d_patch_transform_data** transform_ptr,
+                               int corner, int a[2][2], int f[2])
+{
+    const int i1[3] = {0,1,0};
+    const int j1[3] = {0,0,1};
+    int i2[3], j2[3];
+    for(int m = 0; m < 3; m++)
+    {
+        if (corner)
+        {
+            FCLAW2D_CLAWPATCH_TRANSFORM_CORNER(&i1[m],&j1[m],&i2[m],&j2[m],
+                                               transform_ptr);
+        }
+        else
+        {
+            FCLAW2D_CLAWPATCH_TRANSFORM_FACE(&i1[m],&j1[m],&i2[m],&j2[m],
+                                             transform_ptr);
+        }
+    }
+    f[0] = i2[0];
+    f[1] = j2[0];
+    a[0][0] = i2[1] - f[0];
+    a[1][0] = j2[1] - f[1];
+    a[0][1] = i2[2] - f[0];
+    a[1][1] = j2[2] - f[1];
+}
+
+/* Same as fclaw2d_clawpatch_build_transform_children */
+void kernel_transform_children(fclaw2d_patch_transform_data** transform_ptr,
+                               int corner, int a[2][2], int f[2][4])
+{
+    const int i1[3] = {0,1,0};
+    const int j1[3] = {0,0,1};
+    int mi[3][4], mj[3][4];
+    for(int k = 0; k < 3; k++)
+    {
+        if (corner)
+        {
+            FCLAW2D_CLAWPATCH_TRANSFORM_CORNER_HALF(&i1[k],&j1[k],mi[k],mj[k],
+                                                    transform_ptr);
+        }
+        else
+        {
+            FCLAW2D_CLAWPATCH_TRANSFORM_FACE_HALF(&i1[k],&j1[k],mi[k],mj[k],
+                                                  transform_ptr);
+        }
+    }
+    for(int m = 0; m < 4; m++)
+    {
+        f[0][m] = mi[0][m];
+        f[1][m] = mj[0][m];
+    }
+    a[0][0] = mi[1][0] - f[0][0];
+    a[1][0] = mj[1][0] - f[1][0];
+    a[0][1] = mi[2][0] - f[0][0];
+    a[1][1] = mj[2][0] - f[1][0];
+}
+
+/* Same as fclaw2d_clawpatch_compute_slopes with mth = 5 (AMRClaw slopes) */
+inline double kernel_compute_slopes(double sl, double sr)
+{
+    double sc = (sl + sr)/2.0;
+    double s = std::fmin(std::fmin(2*std::fabs(sl),2*std::fabs(sr)),std::fabs(sc));
+    return s*std::fmax(0.0,std::copysign(1.0,sl*sr))*std::copysign(1.0,sc);
+}
+
+/* ------------------------------------ Kernels --------------------------------------- */
+
+template<int MX, int MBC, int MEQN>
+struct clawpatch46_kernels
+{
+    /* q(1-mbc:mx+mbc,1-mbc:my+mbc,meqn) */
+    static constexpr int NX = MX + 2*MBC;
+    static constexpr int NQ = NX*NX;
+
+    /* area(-mbc:mx+mbc+1,-mbc:my+mbc+1) */
+    static constexpr int NA = MX + 2*MBC + 2;
+
+    static inline int q_index(int i, int j)
+    {
+        return (i + MBC - 1) + (j + MBC - 1)*NX;
+    }
+
+    static inline int area_index(int i, int j)
+    {
+        return (i + MBC) + (j + MBC)*NA;
+    }
+
+    static void copy_face(double qthis[], double qneighbor[], int iface,
+                          fclaw2d_patch_transform_data** transform_ptr)
+    {
+        int a[2][2], f[2];
+        kernel_transform_samesize(transform_ptr,0,a,f);
+
+        /* Ghost cell range of this patch */
+        int ilo = (iface == 0) ? 1-MBC : ((iface == 1) ? MX+1 : 1);
+        int ihi = (iface == 0) ? 0     : ((iface == 1) ? MX+MBC : MX);
+        int jlo = (iface == 2) ? 1-MBC : ((iface == 3) ? MX+1 : 1);
+        int jhi = (iface == 2) ? 0     : ((iface == 3) ? MX+MBC : MX);
+
+        if (a[0][0] == 1 && a[1][1] == 1 && a[0][1] == 0 && a[1][0] == 0)
+        {
+            /* Neighbor is only shifted */
+            int shift = f[0] + f[1]*NX;
+            for(int mq = 0; mq < MEQN; mq++)
+                for(int j = jlo; j <= jhi; j++)
+                    for(int i = ilo; i <= ihi; i++)
+                    {
+                        int k = q_index(i,j) + mq*NQ;
+                        qthis[k] = qneighbor[k + shift];
+                    }
+            return;
+        }
+
+        for(int mq = 0; mq < MEQN; mq++)
+            for(int j = jlo; j <= jhi; j++)
+                for(int i = ilo; i <= ihi; i++)
+                {
+                    int i2 = a[0][0]*i + a[0][1]*j + f[0];
+                    int j2 = a[1][0]*i + a[1][1]*j + f[1];
+                    qthis[q_index(i,j) + mq*NQ] = qneighbor[q_index(i2,j2) + mq*NQ];
+                }
+    }
+
+    static void copy_corner(double qthis[], double qneighbor[], int icorner,
+                            fclaw2d_patch_transform_data** transform_ptr)
+    {
+        int a[2][2], f[2];
+        kernel_transform_samesize(transform_ptr,1,a,f);
+
+        int ilo = (icorner % 2 == 0) ? 1-MBC : MX+1;
+        int jlo = (icorner / 2 == 0) ? 1-MBC : MX+1;
+        for(int mq = 0; mq < MEQN; mq++)
+            for(int j = jlo; j < jlo + MBC; j++)
+                for(int i = ilo; i < ilo + MBC; i++)
+                {
+                    int i2 = a[0][0]*i + a[0][1]*j + f[0];
+                    int j2 = a[1][0]*i + a[1][1]*j + f[1];
+                    qthis[q_index(i,j) + mq*NQ] = qneighbor[q_index(i2,j2) + mq*NQ];
+                }
+    }
+
+    static void average_face(double qcoarse[], double qfine[], double areafine[],
+                             int idir, int iface_coarse, int manifold,
+                             fclaw2d_patch_transform_data** transform_ptr)
+    {
+        int a[2][2], f[2][4];
+        kernel_transform_children(transform_ptr,0,a,f);
+
+        int ilo, ihi, jlo, jhi;
+        if (idir == 0)
+        {
+            ilo = (iface_coarse == 0) ? 1-MBC : MX+1;
+            ihi = ilo + MBC - 1;
+            jlo = 1;
+            jhi = MX;
+        }
+        else
+        {
+            ilo = 1;
+            ihi = MX;
+            jlo = (iface_coarse == 2) ? 1-MBC : MX+1;
+            jhi = jlo + MBC - 1;
+        }
+
+        for(int jc = jlo; jc <= jhi; jc++)
+            for(int ic = ilo; ic <= ihi; ic++)
+            {
+                int kf[4];
+                bool skip_this_grid = false;
+                for(int m = 0; m < 4; m++)
+                {
+                    int i2 = a[0][0]*ic + a[0][1]*jc + f[0][m];
+                    int j2 = a[1][0]*ic + a[1][1]*jc + f[1][m];
+                    /* Only half of the coarse ghost cells are filled by 
+                       this fine grid */
+                    if (i2 < 1 || i2 > MX || j2 < 1 || j2 > MX)
+                    {
+                        skip_this_grid = true;
+                        break;
+                    }
+                    kf[m] = q_index(i2,j2);
+                }
+                if (skip_this_grid)
+                {
+                    continue;
+                }
+
+                int kc = q_index(ic,jc);
+                if (manifold)
+                {
+                    double af[4];
+                    double af_sum = 0;
+                    for(int m = 0; m < 4; m++)
+                    {
+                        int i2 = a[0][0]*ic + a[0][1]*jc + f[0][m];
+                        int j2 = a[1][0]*ic + a[1][1]*jc + f[1][m];
+                        af[m] = areafine[area_index(i2,j2)];
+                        af_sum += af[m];
+                    }
+                    for(int mq = 0; mq < MEQN; mq++)
+                    {
+                        double sum = 0;
+                        for(int m = 0; m < 4; m++)
+                            sum += qfine[kf[m] + mq*NQ]*af[m];
+                        qcoarse[kc + mq*NQ] = sum/af_sum;
+                    }
+                }
+                else
+                {
+                    for(int mq = 0; mq < MEQN; mq++)
+                    {
+                        double sum = 0;
+                        for(int m = 0; m < 4; m++)
+                            sum += qfine[kf[m] + mq*NQ];
+                        qcoarse[kc + mq*NQ] = sum/4.0;
+                    }
+                }
+            }
+    }
+
+    static void average_corner(double qcoarse[], double qfine[], double areafine[],
+                               int icorner_coarse, int manifold,
+                               fclaw2d_patch_transform_data** transform_ptr)
+    {
+        int a[2][2], f[2][4];
+        kernel_transform_children(transform_ptr,1,a,f);
+
+        int ilo = (icorner_coarse % 2 == 0) ? 1-MBC : MX+1;
+        int jlo = (icorner_coarse / 2 == 0) ? 1-MBC : MX+1;
+        for(int jc = jlo; jc < jlo + MBC; jc++)
+            for(int ic = ilo; ic < ilo + MBC; ic++)
+            {
+                int kf[4];
+                double af[4];
+                double af_sum = 0;
+                for(int m = 0; m < 4; m++)
+                {
+                    int i2 = a[0][0]*ic + a[0][1]*jc + f[0][m];
+                    int j2 = a[1][0]*ic + a[1][1]*jc + f[1][m];
+                    kf[m] = q_index(i2,j2);
+                    if (manifold)
+                    {
+                        af[m] = areafine[area_index(i2,j2)];
+                        af_sum += af[m];
+                    }
+                }
+
+                int kc = q_index(ic,jc);
+                for(int mq = 0; mq < MEQN; mq++)
+                {
+                    double sum = 0;
+                    if (manifold)
+                    {
+                        for(int m = 0; m < 4; m++)
+                            sum += af[m]*qfine[kf[m] + mq*NQ];
+                        qcoarse[kc + mq*NQ] = sum/af_sum;
+                    }
+                    else
+                    {
+                        for(int m = 0; m < 4; m++)
+                            sum += qfine[kf[m] + mq*NQ];
+                        qcoarse[kc + mq*NQ] = sum/4.0;
+                    }
+                }
+            }
+    }
+
+    /* Limited linear reconstruction of coarse cell (ic,jc) into the four fine 
+       cells starting at fine index kf0.  df holds the fine grid offsets of the 
+       children in the order of the coarse grid directions. */
+    static inline void interpolate_cell(double qcoarse[], double qfine[],
+                                        int ic, int jc, int kf0, const int df[4])
+    {
+        const double shiftx[4] = {-0.25, 0.25, -0.25, 0.25};
+        const double shifty[4] = {-0.25, -0.25, 0.25, 0.25};
+        for(int mq = 0; mq < MEQN; mq++)
+        {
+            const double *q = &qcoarse[q_index(ic,jc) + mq*NQ];
+            double qc = q[0];
+
+            double gradx = kernel_compute_slopes(qc - q[-1], q[1] - qc);
+            double grady = kernel_compute_slopes(qc - q[-NX], q[NX] - qc);
+
+            for(int m = 0; m < 4; m++)
+                qfine[kf0 + df[m] + mq*NQ] = qc + gradx*shiftx[m] + grady*shifty[m];
+        }
+    }
+
+    /* Offsets of the four children in the fine grid, given the face 
+       transform of the first child */
+    static void interpolate_offsets(const int a[2][2], int df[4])
+    {
+        int m = 0;
+        for(int jj = 0; jj < 2; jj++)
+            for(int ii = 0; ii < 2; ii++)
+            {
+                int di = (a[0][0]*ii + a[0][1]*jj)/2;
+                int dj = (a[1][0]*ii + a[1][1]*jj)/2;
+                df[m++] = di + dj*NX;
+            }
+    }
+
+    static void interpolate_face(double qcoarse[], double qfine[],
+                                 int idir, int iface_coarse,
+                                 fclaw2d_patch_transform_data** transform_ptr)
+    {
+        int a[2][2], f[2][4];
+        kernel_transform_children(transform_ptr,0,a,f);
+
+        int df[4];
+        interpolate_offsets(a,df);
+
+        /* Interior coarse cells next to the face;  only MBC/2 layers are 
+           needed to fill the fine grid ghost cells */
+        int ilo, ihi, jlo, jhi;
+        if (idir == 0)
+        {
+            ilo = (iface_coarse == 0) ? 1 : MX - MBC/2 + 1;
+            ihi = ilo + MBC/2 - 1;
+            jlo = 1;
+            jhi = MX;
+        }
+        else
+        {
+            ilo = 1;
+            ihi = MX;
+            jlo = (iface_coarse == 2) ? 1 : MX - MBC/2 + 1;
+            jhi = jlo + MBC/2 - 1;
+        }
+
+        for(int jc = jlo; jc <= jhi; jc++)
+            for(int ic = ilo; ic <= ihi; ic++)
+            {
+                bool skip_this_grid = false;
+                for(int m = 0; m < 4; m++)
+                {
+                    int i2 = a[0][0]*ic + a[0][1]*jc + f[0][m];
+                    int j2 = a[1][0]*ic + a[1][1]*jc + f[1][m];
+                    /* The other half size neighbor fills these */
+                    if (i2 < 1-MBC || i2 > MX+MBC || j2 < 1-MBC || j2 > MX+MBC)
+                    {
+                        skip_this_grid = true;
+                        break;
+                    }
+                }
+                if (skip_this_grid)
+                {
+                    continue;
+                }
+                int i2 = a[0][0]*ic + a[0][1]*jc + f[0][0];
+                int j2 = a[1][0]*ic + a[1][1]*jc + f[1][0];
+                interpolate_cell(qcoarse,qfine,ic,jc,q_index(i2,j2),df);
+            }
+    }
+
+    static void interpolate_corner(double qcoarse[], double qfine[],
+                                   int icorner_coarse,
+                                   fclaw2d_patch_transform_data** transform_ptr)
+    {
+        int a[2][2], f[2][4];
+        kernel_transform_children(transform_ptr,1,a,f);
+
+        /* As in the Fortran, the offsets come from the face transform */
+        int aface[2][2], fface[2][4];
+        kernel_transform_children(transform_ptr,0,aface,fface);
+
+        int df[4];
+        interpolate_offsets(aface,df);
+
+        int ilo = (icorner_coarse % 2 == 0) ? 1 : MX - MBC/2 + 1;
+        int jlo = (icorner_coarse / 2 == 0) ? 1 : MX - MBC/2 + 1;
+        for(int jc = jlo; jc < jlo + MBC/2; jc++)
+            for(int ic = ilo; ic < ilo + MBC/2; ic++)
+            {
+                int i2 = a[0][0]*ic + a[0][1]*jc + f[0][0];
+                int j2 = a[1][0]*ic + a[1][1]*jc + f[1][0];
+                interpolate_cell(qcoarse,qfine,ic,jc,q_index(i2,j2),df);
+            }
+    }
+
+    static void average2coarse(double qcoarse[], double qfine[],
+                               double areacoarse[], double areafine[],
+                               int igrid, int manifold)
+    {
+        int ig = igrid % 2;
+        int jg = (igrid - ig)/2;
+        int ic_add = ig*MX/2;
+        int jc_add = jg*MX/2;
+
+        for(int mq = 0; mq < MEQN; mq++)
+            for(int j = 1; j <= MX/2; j++)
+                for(int i = 1; i <= MX/2; i++)
+                {
+                    int i1 = i + ic_add;
+                    int j1 = j + jc_add;
+                    int if1 = 2*i - 1;
+                    int jf1 = 2*j - 1;
+                    double *qf = &qfine[q_index(if1,jf1) + mq*NQ];
+                    double sum;
+                    if (manifold)
+                    {
+                        const double *kf = &areafine[area_index(if1,jf1)];
+                        sum = 0;
+                        sum += kf[0]*qf[0];
+                        sum += kf[1]*qf[1];
+                        sum += kf[NA]*qf[NX];
+                        sum += kf[NA+1]*qf[NX+1];
+                        qcoarse[q_index(i1,j1) + mq*NQ] = sum/areacoarse[area_index(i1,j1)];
+                    }
+                    else
+                    {
+                        sum = 0;
+                        sum += qf[0];
+                        sum += qf[1];
+                        sum += qf[NX];
+                        sum += qf[NX+1];
+                        qcoarse[q_index(i1,j1) + mq*NQ] = sum/4;
+                    }
+                }
+    }
+
+    static void interpolate2fine(double qcoarse[], double qfine[], int igrid)
+    {
+        int ig = igrid % 2;
+        int jg = (igrid - ig)/2;
+
+        int i1 = 1 - ig;
+        int i2 = MX/2 + (1 - ig);
+        int ic_add = ig*MX/2;
+
+        int j1 = 1 - jg;
+        int j2 = MX/2 + (1 - jg);
+        int jc_add = jg*MX/2;
+
+        for(int mq = 0; mq < MEQN; mq++)
+            for(int j = j1; j <= j2; j++)
+                for(int i = i1; i <= i2; i++)
+                {
+                    const double *q = &qcoarse[q_index(i + ic_add,j + jc_add) + mq*NQ];
+                    double qc = q[0];
+
+                    double gradx = kernel_compute_slopes(qc - q[-1], q[1] - qc);
+                    double grady = kernel_compute_slopes(qc - q[-NX], q[NX] - qc);
+
+                    double *qf = &qfine[q_index(2*i - 1,2*j - 1) + mq*NQ];
+                    qf[0]    = qc - 0.25*gradx - 0.25*grady;
+                    qf[1]    = qc + 0.25*gradx - 0.25*grady;
+                    qf[NX]   = qc - 0.25*gradx + 0.25*grady;
+                    qf[NX+1] = qc + 0.25*gradx + 0.25*grady;
+                }
+    }
+};
+
+/* ---------------------------------- Dispatch table ---------------------------------- */
+
+typedef void (*kernel_copy_t)(double qthis[], double qneighbor[], int iface,
+                              fclaw2d_patch_transform_data** transform_ptr);
+
+typedef void (*kernel_average_face_t)(double qcoarse[], double qfine[], 
+                                      double areafine[],
+                                      int idir, int iface_coarse, int manifold,
+                                      fclaw2d_patch_transform_data** transform_ptr);
+
+typedef void (*kernel_average_corner_t)(double qcoarse[], double qfine[], 
+                                        double areafine[],
+                                        int icorner_coarse, int manifold,
+                                        fclaw2d_patch_transform_data** transform_ptr);
+
+typedef void (*kernel_interpolate_face_t)(double qcoarse[], double qfine[],
+                                          int idir, int iface_coarse,
+                                          fclaw2d_patch_transform_data** transform_ptr);
+
+typedef void (*kernel_interpolate_corner_t)(double qcoarse[], double qfine[],
+                                            int icorner_coarse,
+                                            fclaw2d_patch_transform_data** transform_ptr);
+
+typedef void (*kernel_average2coarse_t)(double qcoarse[], double qfine[],
+                                        double areacoarse[], double areafine[],
+                                        int igrid, int manifold);
+
+typedef void (*kernel_interpolate2fine_t)(double qcoarse[], double qfine[], int igrid);
+
+struct kernel_table_entry
+{
+    kernel_copy_t copy_face;
+    kernel_copy_t copy_corner;
+    kernel_average_face_t average_face;
+    kernel_interpolate_face_t interpolate_face;
+    kernel_average_corner_t average_corner;
+    kernel_interpolate_corner_t interpolate_corner;
+    kernel_average2coarse_t average2coarse;
+    kernel_interpolate2fine_t interpolate2fine;
+};
+
+#define KERNEL_ENTRY(MX,MBC,MEQN) \
+    { clawpatch46_kernels<MX,MBC,MEQN>::copy_face,        \
+      clawpatch46_kernels<MX,MBC,MEQN>::copy_corner,      \
+      clawpatch46_kernels<MX,MBC,MEQN>::average_face,     \
+      clawpatch46_kernels<MX,MBC,MEQN>::interpolate_face, \
+      clawpatch46_kernels<MX,MBC,MEQN>::average_corner,   \
+      clawpatch46_kernels<MX,MBC,MEQN>::interpolate_corner, \
+      clawpatch46_kernels<MX,MBC,MEQN>::average2coarse,   \
+      clawpatch46_kernels<MX,MBC,MEQN>::interpolate2fine }
+
+#define KERNEL_ENTRIES(MX,MBC) \
+    KERNEL_ENTRY(MX,MBC,1), KERNEL_ENTRY(MX,MBC,2), KERNEL_ENTRY(MX,MBC,3), \
+    KERNEL_ENTRY(MX,MBC,4), KERNEL_ENTRY(MX,MBC,5)
+
+/* Ordered by mx, then mbc, then meqn */
+const kernel_table_entry kernel_table[] =
+{
+    KERNEL_ENTRIES(8,2),  KERNEL_ENTRIES(8,4),
+    KERNEL_ENTRIES(16,2), KERNEL_ENTRIES(16,4),
+    KERNEL_ENTRIES(32,2), KERNEL_ENTRIES(32,4)
+};
+
+const kernel_table_entry* kernel_find(int mx, int my, int mbc, int meqn)
+{
+    if (mx != my || meqn < 1 || meqn > 5)
+    {
+        return nullptr;
+    }
+    int imx = (mx == 8) ? 0 : ((mx == 16) ? 1 : ((mx == 32) ? 2 : -1));
+    int imbc = (mbc == 2) ? 0 : ((mbc == 4) ? 1 : -1);
+    if (imx < 0 || imbc < 0)
+    {
+        return nullptr;
+    }
+    return &kernel_table[(imx*2 + imbc)*5 + (meqn - 1)];
+}
+
+} /* namespace */
+
+/* ---------------------------------- Public interface -------------------------------- */
+
+int fclaw2d_clawpatch46_kernels_specialized(int mx, int my, int mbc, int meqn)
+{
+    return kernel_find(mx,my,mbc,meqn) != nullptr;
+}
+
+void fclaw2d_clawpatch46_copy_face(const int* mx, const int* my, const int* mbc,
+                                   const int* meqn,
+                                   double qthis[],double qneighbor[],
+                                   const int* iface,
+                                   fclaw2d_patch_transform_data** transform_ptr)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_COPY_FACE(mx,my,mbc,meqn,qthis,qneighbor,
+                                           iface,transform_ptr);
+        return;
+    }
+    k->copy_face(qthis,qneighbor,*iface,transform_ptr);
+}
+
+void fclaw2d_clawpatch46_copy_corner(const int* mx, const int* my, const int* mbc,
+                                     const int* meqn,
+                                     double qthis[],double qneighbor[],
+                                     const int* icorner,
+                                     fclaw2d_patch_transform_data** transform_ptr)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_COPY_CORNER(mx,my,mbc,meqn,qthis,qneighbor,
+                                             icorner,transform_ptr);
+        return;
+    }
+    k->copy_corner(qthis,qneighbor,*icorner,transform_ptr);
+}
+
+void fclaw2d_clawpatch46_average_face(const int* mx, const int* my, const int* mbc,
+                                      const int* meqn,
+                                      double qcoarse[],double qfine[],
+                                      double areacoarse[], double areafine[],
+                                      const int* idir, const int* iface_coarse,
+                                      const int* num_neighbors,
+                                      const int* refratio, const int* igrid,
+                                      const int* manifold,
+                                      fclaw2d_patch_transform_data** transform_ptr)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr || *refratio != 2)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_AVERAGE_FACE(mx,my,mbc,meqn,qcoarse,qfine,
+                                              areacoarse,areafine,idir,
+                                              iface_coarse,num_neighbors,
+                                              refratio,igrid,manifold,
+                                              transform_ptr);
+        return;
+    }
+    k->average_face(qcoarse,qfine,areafine,*idir,*iface_coarse,
+                    *manifold == 1,transform_ptr);
+}
+
+void fclaw2d_clawpatch46_interpolate_face(const int* mx, const int* my, 
+                                          const int* mbc, const int* meqn,
+                                          double qcoarse[],double qfine[],
+                                          const int* idir, const int* iface_coarse,
+                                          const int* num_neighbors,
+                                          const int* refratio, const int* igrid,
+                                          fclaw2d_patch_transform_data** transform_ptr)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr || *refratio != 2)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE_FACE(mx,my,mbc,meqn,qcoarse,qfine,
+                                                  idir,iface_coarse,num_neighbors,
+                                                  refratio,igrid,transform_ptr);
+        return;
+    }
+    k->interpolate_face(qcoarse,qfine,*idir,*iface_coarse,transform_ptr);
+}
+
+void fclaw2d_clawpatch46_average_corner(const int* mx, const int* my, const int* mbc,
+                                        const int* meqn, const int* refratio,
+                                        double qcoarse[], double qfine[],
+                                        double areacoarse[], double areafine[],
+                                        const int* manifold, const int* icorner_coarse,
+                                        fclaw2d_patch_transform_data** transform_ptr)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr || *refratio != 2)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_AVERAGE_CORNER(mx,my,mbc,meqn,refratio,
+                                                qcoarse,qfine,areacoarse,areafine,
+                                                manifold,icorner_coarse,
+                                                transform_ptr);
+        return;
+    }
+    k->average_corner(qcoarse,qfine,areafine,*icorner_coarse,
+                      *manifold == 1,transform_ptr);
+}
+
+void fclaw2d_clawpatch46_interpolate_corner(const int* mx, const int* my, 
+                                            const int* mbc, const int* meqn, 
+                                            const int* refratio,
+                                            double qcoarse[], double qfine[],
+                                            const int* icorner_coarse,
+                                            fclaw2d_patch_transform_data** transform_ptr)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr || *refratio != 2)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE_CORNER(mx,my,mbc,meqn,refratio,
+                                                    qcoarse,qfine,icorner_coarse,
+                                                    transform_ptr);
+        return;
+    }
+    k->interpolate_corner(qcoarse,qfine,*icorner_coarse,transform_ptr);
+}
+
+void fclaw2d_clawpatch46_average2coarse(const int* mx, const int* my,
+                                        const int* mbc, const int* meqn,
+                                        double qcoarse[],double qfine[],
+                                        double areacoarse[],double areafine[],
+                                        const int* igrid, const int* manifold)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_AVERAGE2COARSE(mx,my,mbc,meqn,qcoarse,qfine,
+                                                areacoarse,areafine,
+                                                igrid,manifold);
+        return;
+    }
+    k->average2coarse(qcoarse,qfine,areacoarse,areafine,*igrid,*manifold == 1);
+}
+
+void fclaw2d_clawpatch46_interpolate2fine(const int* mx, const int* my,
+                                          const int* mbc, const int* meqn,
+                                          double qcoarse[], double qfine[],
+                                          double areacoarse[], double areafine[],
+                                          const int* igrid, const int* manifold)
+{
+    const kernel_table_entry *k = kernel_find(*mx,*my,*mbc,*meqn);
+    if (k == nullptr || *manifold != 0)
+    {
+        FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE2FINE(mx,my,mbc,meqn,qcoarse,qfine,
+                                                  areacoarse,areafine,
+                                                  igrid,manifold);
+        return;
+    }
+    k->interpolate2fine(qcoarse,qfine,*igrid);
+}
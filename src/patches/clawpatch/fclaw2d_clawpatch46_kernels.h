@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FCLAW2D_CLAWPATCH46_KERNELS_H
+#define FCLAW2D_CLAWPATCH46_KERNELS_H
+
+/**
+ * @file
+ * C++ versions of the clawpatch 4.6 ghost filling and regridding kernels,
+ * specialized at compile time for common patch sizes.
+ *
+ * Each function has the signature of the Fortran routine it replaces and can
+ * be stored in the clawpatch vtable.  The specialized kernel is looked up in a
+ * table using (mx,my,mbc,meqn).  For other sizes, the Fortran routine is
+ * called.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if 0
+/* Fix syntax highlighting */
+#endif
+
+struct fclaw2d_patch_transform_data;
+
+/**
+ * @brief Check if specialized kernels exist for a patch size
+ *
+ * Kernels are instantiated for mx = my = 8, 16 or 32, mbc = 2 or 4, and
+ * meqn = 1 .. 5.
+ *
+ * @param mx, my the number of cells in the x and y directions
+ * @param mbc the number of ghost cells
+ * @param meqn the number of equations
+ * @return 1 if specialized kernels will be used, 0 otherwise
+ */
+int fclaw2d_clawpatch46_kernels_specialized(int mx, int my, int mbc, int meqn);
+
+/** @copydoc clawpatch_fort_copy_face_t */
+void fclaw2d_clawpatch46_copy_face(const int* mx, const int* my, const int* mbc,
+                                   const int* meqn,
+                                   double qthis[],double qneighbor[],
+                                   const int* iface,
+                                   struct fclaw2d_patch_transform_data** transform_ptr);
+
+/** @copydoc clawpatch_fort_copy_corner_t */
+void fclaw2d_clawpatch46_copy_corner(const int* mx, const int* my, const int* mbc,
+                                     const int* meqn,
+                                     double qthis[],double qneighbor[],
+                                     const int* icorner,
+                                     struct fclaw2d_patch_transform_data** transform_ptr);
+
+/** @copydoc clawpatch_fort_average_face_t */
+void fclaw2d_clawpatch46_average_face(const int* mx, const int* my, const int* mbc,
+                                      const int* meqn,
+                                      double qcoarse[],double qfine[],
+                                      double areacoarse[], double areafine[],
+                                      const int* idir, const int* iface_coarse,
+                                      const int* num_neighbors,
+                                      const int* refratio, const int* igrid,
+                                      const int* manifold,
+                                      struct fclaw2d_patch_transform_data** transform_ptr);
+
+/** @copydoc clawpatch_fort_interpolate_face_t */
+void fclaw2d_clawpatch46_interpolate_face(const int* mx, const int* my, 
+                                          const int* mbc, const int* meqn,
+                                          double qcoarse[],double qfine[],
+                                          const int* idir, const int* iface_coarse,
+                                          const int* num_neighbors,
+                                          const int* refratio, const int* igrid,
+                                          struct fclaw2d_patch_transform_data** transform_ptr);
+
+/** @copydoc clawpatch_fort_average_corner_t */
+void fclaw2d_clawpatch46_average_corner(const int* mx, const int* my, const int* mbc,
+                                        const int* meqn, const int* refratio,
+                                        double qcoarse[], double qfine[],
+                                        double areacoarse[], double areafine[],
+                                        const int* manifold, const int* icorner_coarse,
+                                        struct fclaw2d_patch_transform_data** transform_ptr);
+
+/** @copydoc clawpatch_fort_interpolate_corner_t */
+void fclaw2d_clawpatch46_interpolate_corner(const int* mx, const int* my, 
+                                            const int* mbc, const int* meqn, 
+                                            const int* refratio,
+                                            double qcoarse[], double qfine[],
+                                            const int* icorner_coarse,
+                                            struct fclaw2d_patch_transform_data** transform_ptr);
+
+/** @copydoc clawpatch_fort_average2coarse_t */
+void fclaw2d_clawpatch46_average2coarse(const int* mx, const int* my,
+                                        const int* mbc, const int* meqn,
+                                        double qcoarse[],double qfine[],
+                                        double areacoarse[],double areafine[],
+                                        const int* igrid, const int* manifold);
+
+/** 
+ * @copydoc clawpatch_fort_interpolate2fine_t 
+ * 
+ * Mapped grids always use the Fortran routine, which also corrects the 
+ * interpolated values for conservation.
+ */
+void fclaw2d_clawpatch46_interpolate2fine(const int* mx, const int* my,
+                                          const int* mbc, const int* meqn,
+                                          double qcoarse[], double qfine[],
+                                          double areacoarse[], double areafine[],
+                                          const int* igrid, const int* manifold);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
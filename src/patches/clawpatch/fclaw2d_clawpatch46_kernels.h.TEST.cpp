@@ -0,0 +1,369 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <test.hpp>
+
+#include <fclaw_base.h>
+
+#include <fclaw2d_clawpatch46_kernels.h>
+#include <fclaw2d_clawpatch46_fort.h>
+#include <fclaw2d_clawpatch_options.h>
+#include <fclaw2d_global.h>
+#include <fclaw2d_patch.h>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    /* Smooth data with some variation in slopes, so that the limiter does 
+       something */
+    std::vector<double> patch_data(int mx, int mbc, int meqn, double scale)
+    {
+        int n = mx + 2*mbc;
+        std::vector<double> q(n*n*meqn);
+        for(int k = 0; k < (int) q.size(); k++)
+        {
+            q[k] = scale*((k*37) % 101) + 0.01*k;
+        }
+        return q;
+    }
+
+    std::vector<double> area_data(int mx, int mbc, double scale)
+    {
+        int na = mx + 2*mbc + 2;
+        std::vector<double> area(na*na);
+        for(int k = 0; k < na*na; k++)
+        {
+            area[k] = scale*(1.0 + 0.1*(k % 7));
+        }
+        return area;
+    }
+
+    /* Transform data between two patches with the given lower left corners
+       and levels.  The transforms only need the clawpatch options. */
+    struct TransformData
+    {
+        fclaw2d_global_t* glob;
+        fclaw2d_clawpatch_options_t opts;
+        fclaw2d_patch_t this_patch;
+        fclaw2d_patch_t neighbor_patch;
+        fclaw2d_patch_transform_data_t tdata;
+        fclaw2d_patch_transform_data_t *tdata_ptr;
+
+        TransformData(int mx, int mbc,
+                      int this_level, double xlower, double ylower,
+                      int neighbor_level, double nxlower, double nylower)
+        {
+            glob = fclaw2d_global_new();
+
+            memset(&opts, 0, sizeof(opts));
+            opts.mx = mx;
+            opts.my = mx;
+            opts.mbc = mbc;
+            fclaw2d_clawpatch_options_store(glob, &opts);
+
+            memset(&this_patch, 0, sizeof(this_patch));
+            this_patch.level = this_level;
+            this_patch.xlower = xlower;
+            this_patch.ylower = ylower;
+
+            memset(&neighbor_patch, 0, sizeof(neighbor_patch));
+            neighbor_patch.level = neighbor_level;
+            neighbor_patch.xlower = nxlower;
+            neighbor_patch.ylower = nylower;
+
+            memset(&tdata, 0, sizeof(tdata));
+            tdata.this_patch = &this_patch;
+            tdata.neighbor_patch = &neighbor_patch;
+            tdata.glob = glob;
+            tdata.based = 1;
+            tdata.block_iface = -1;
+            fclaw2d_patch_face_transformation_intra(tdata.transform);
+            tdata_ptr = &tdata;
+        }
+
+        /* Neighbor in another block, mirrored across the right face (x' = 2-x, 
+           y' = 1-y) */
+        void mirror_across_face_1()
+        {
+            const int ftransform[9] = {1, 0, 0, 1, 0, 0, 1, 0, 3};
+            memcpy(tdata.transform, ftransform, sizeof(ftransform));
+            tdata.block_iface = 1;
+        }
+
+        ~TransformData()
+        {
+            fclaw2d_global_destroy(glob);
+        }
+    };
+
+    void check_equal(const std::vector<double>& q1, const std::vector<double>& q2)
+    {
+        REQUIRE_EQ(q1.size(), q2.size());
+        for(size_t k = 0; k < q1.size(); k++)
+        {
+            CHECK_EQ(q1[k], doctest::Approx(q2[k]));
+        }
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch46_kernels_specialized")
+{
+    CHECK(fclaw2d_clawpatch46_kernels_specialized(8,8,2,1));
+    CHECK(fclaw2d_clawpatch46_kernels_specialized(16,16,4,5));
+    CHECK(fclaw2d_clawpatch46_kernels_specialized(32,32,2,3));
+
+    CHECK_FALSE(fclaw2d_clawpatch46_kernels_specialized(8,16,2,1));
+    CHECK_FALSE(fclaw2d_clawpatch46_kernels_specialized(10,10,2,1));
+    CHECK_FALSE(fclaw2d_clawpatch46_kernels_specialized(8,8,3,1));
+    CHECK_FALSE(fclaw2d_clawpatch46_kernels_specialized(8,8,2,6));
+}
+
+TEST_CASE("fclaw2d_clawpatch46_average2coarse matches Fortran")
+{
+    for(int manifold : {0, 1})
+    for(int igrid = 0; igrid < 4; igrid++)
+    {
+        int mx = 8, my = 8, mbc = 2, meqn = 3;
+        std::vector<double> qfine = patch_data(mx,mbc,meqn,1.0);
+        std::vector<double> qc1 = patch_data(mx,mbc,meqn,0.5);
+        std::vector<double> qc2 = qc1;
+
+        int na = mx + 2*mbc + 2;
+        std::vector<double> areacoarse(na*na), areafine(na*na);
+        for(int k = 0; k < na*na; k++)
+        {
+            areacoarse[k] = 1.0 + 0.1*(k % 7);
+            areafine[k] = 0.25 + 0.05*(k % 5);
+        }
+
+        fclaw2d_clawpatch46_average2coarse(&mx,&my,&mbc,&meqn,qc1.data(),
+                                           qfine.data(),areacoarse.data(),
+                                           areafine.data(),&igrid,&manifold);
+        FCLAW2D_CLAWPATCH46_FORT_AVERAGE2COARSE(&mx,&my,&mbc,&meqn,qc2.data(),
+                                                qfine.data(),areacoarse.data(),
+                                                areafine.data(),&igrid,&manifold);
+        for(size_t k = 0; k < qc1.size(); k++)
+        {
+            CHECK_EQ(qc1[k], doctest::Approx(qc2[k]));
+        }
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch46_interpolate2fine matches Fortran")
+{
+    for(int igrid = 0; igrid < 4; igrid++)
+    {
+        int mx = 16, my = 16, mbc = 4, meqn = 2, manifold = 0;
+        std::vector<double> qcoarse = patch_data(mx,mbc,meqn,1.0);
+        std::vector<double> qf1 = patch_data(mx,mbc,meqn,0.5);
+        std::vector<double> qf2 = qf1;
+
+        fclaw2d_clawpatch46_interpolate2fine(&mx,&my,&mbc,&meqn,qcoarse.data(),
+                                             qf1.data(),NULL,NULL,
+                                             &igrid,&manifold);
+        FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE2FINE(&mx,&my,&mbc,&meqn,qcoarse.data(),
+                                                  qf2.data(),NULL,NULL,
+                                                  &igrid,&manifold);
+        for(size_t k = 0; k < qf1.size(); k++)
+        {
+            CHECK_EQ(qf1[k], doctest::Approx(qf2[k]));
+        }
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch46_copy_face matches Fortran for a shifted neighbor")
+{
+    int mx = 8, my = 8, mbc = 2, meqn = 3, iface = 1;
+
+    /* Neighbor to the right, in the same block */
+    TransformData t(mx,mbc,1,0.0,0.0,1,0.5,0.0);
+
+    std::vector<double> qneighbor = patch_data(mx,mbc,meqn,1.0);
+    std::vector<double> q1 = patch_data(mx,mbc,meqn,0.5);
+    std::vector<double> q2 = q1;
+
+    fclaw2d_clawpatch46_copy_face(&mx,&my,&mbc,&meqn,q1.data(),qneighbor.data(),
+                                  &iface,&t.tdata_ptr);
+    FCLAW2D_CLAWPATCH46_FORT_COPY_FACE(&mx,&my,&mbc,&meqn,q2.data(),qneighbor.data(),
+                                       &iface,&t.tdata_ptr);
+    check_equal(q1,q2);
+}
+
+TEST_CASE("fclaw2d_clawpatch46_copy_face matches Fortran for a transformed neighbor")
+{
+    int mx = 16, my = 16, mbc = 4, meqn = 2, iface = 1;
+
+    TransformData t(mx,mbc,1,0.5,0.5,1,0.5,0.0);
+    t.mirror_across_face_1();
+
+    std::vector<double> qneighbor = patch_data(mx,mbc,meqn,1.0);
+    std::vector<double> q1 = patch_data(mx,mbc,meqn,0.5);
+    std::vector<double> q2 = q1;
+
+    fclaw2d_clawpatch46_copy_face(&mx,&my,&mbc,&meqn,q1.data(),qneighbor.data(),
+                                  &iface,&t.tdata_ptr);
+    FCLAW2D_CLAWPATCH46_FORT_COPY_FACE(&mx,&my,&mbc,&meqn,q2.data(),qneighbor.data(),
+                                       &iface,&t.tdata_ptr);
+    check_equal(q1,q2);
+}
+
+TEST_CASE("fclaw2d_clawpatch46_copy_corner matches Fortran")
+{
+    for(int block_face : {0, 1})
+    {
+        int mx = 8, my = 8, mbc = 2, meqn = 1;
+        int icorner = block_face ? 1 : 3;
+
+        /* Upper right neighbor in the same block, or lower right neighbor 
+           across a block face */
+        TransformData t(mx,mbc,1,block_face ? 0.5 : 0.0,block_face ? 0.5 : 0.0,
+                        1,0.5,0.5);
+        t.tdata.icorner = icorner;
+        if (block_face)
+        {
+            t.mirror_across_face_1();
+        }
+
+        std::vector<double> qneighbor = patch_data(mx,mbc,meqn,1.0);
+        std::vector<double> q1 = patch_data(mx,mbc,meqn,0.5);
+        std::vector<double> q2 = q1;
+
+        fclaw2d_clawpatch46_copy_corner(&mx,&my,&mbc,&meqn,q1.data(),qneighbor.data(),
+                                        &icorner,&t.tdata_ptr);
+        FCLAW2D_CLAWPATCH46_FORT_COPY_CORNER(&mx,&my,&mbc,&meqn,q2.data(),qneighbor.data(),
+                                             &icorner,&t.tdata_ptr);
+        check_equal(q1,q2);
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch46_average_face matches Fortran")
+{
+    for(int manifold : {0, 1})
+    for(int igrid = 0; igrid < 2; igrid++)
+    {
+        int mx = 8, my = 8, mbc = 2, meqn = 2;
+        int idir = 0, iface_coarse = 1, num_neighbors = 2, refratio = 2;
+
+        /* Each of the two fine neighbors fills half of the coarse ghost cells;
+           the rest are skipped */
+        TransformData t(mx,mbc,1,0.0,0.0,2,0.5,0.25*igrid);
+
+        std::vector<double> qfine = patch_data(mx,mbc,meqn,1.0);
+        std::vector<double> areacoarse = area_data(mx,mbc,1.0);
+        std::vector<double> areafine = area_data(mx,mbc,0.25);
+        std::vector<double> qc1 = patch_data(mx,mbc,meqn,0.5);
+        std::vector<double> qc2 = qc1;
+
+        fclaw2d_clawpatch46_average_face(&mx,&my,&mbc,&meqn,qc1.data(),qfine.data(),
+                                         areacoarse.data(),areafine.data(),
+                                         &idir,&iface_coarse,&num_neighbors,
+                                         &refratio,&igrid,&manifold,&t.tdata_ptr);
+        FCLAW2D_CLAWPATCH46_FORT_AVERAGE_FACE(&mx,&my,&mbc,&meqn,qc2.data(),qfine.data(),
+                                              areacoarse.data(),areafine.data(),
+                                              &idir,&iface_coarse,&num_neighbors,
+                                              &refratio,&igrid,&manifold,&t.tdata_ptr);
+        check_equal(qc1,qc2);
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch46_average_corner matches Fortran")
+{
+    for(int manifold : {0, 1})
+    {
+        int mx = 8, my = 8, mbc = 2, meqn = 4;
+        int icorner = 3, refratio = 2;
+
+        TransformData t(mx,mbc,1,0.0,0.0,2,0.5,0.5);
+        t.tdata.icorner = icorner;
+
+        std::vector<double> qfine = patch_data(mx,mbc,meqn,1.0);
+        std::vector<double> areacoarse = area_data(mx,mbc,1.0);
+        std::vector<double> areafine = area_data(mx,mbc,0.25);
+        std::vector<double> qc1 = patch_data(mx,mbc,meqn,0.5);
+        std::vector<double> qc2 = qc1;
+
+        fclaw2d_clawpatch46_average_corner(&mx,&my,&mbc,&meqn,&refratio,
+                                           qc1.data(),qfine.data(),
+                                           areacoarse.data(),areafine.data(),
+                                           &manifold,&icorner,&t.tdata_ptr);
+        FCLAW2D_CLAWPATCH46_FORT_AVERAGE_CORNER(&mx,&my,&mbc,&meqn,&refratio,
+                                                qc2.data(),qfine.data(),
+                                                areacoarse.data(),areafine.data(),
+                                                &manifold,&icorner,&t.tdata_ptr);
+        check_equal(qc1,qc2);
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch46_interpolate_face matches Fortran")
+{
+    for(int mbc : {2, 4})
+    for(int igrid = 0; igrid < 2; igrid++)
+    {
+        int mx = 16, my = 16, meqn = 2;
+        int idir = 0, iface_coarse = 1, num_neighbors = 2, refratio = 2;
+
+        TransformData t(mx,mbc,1,0.0,0.0,2,0.5,0.25*igrid);
+
+        std::vector<double> qcoarse = patch_data(mx,mbc,meqn,1.0);
+        std::vector<double> qf1 = patch_data(mx,mbc,meqn,0.5);
+        std::vector<double> qf2 = qf1;
+
+        fclaw2d_clawpatch46_interpolate_face(&mx,&my,&mbc,&meqn,qcoarse.data(),
+                                             qf1.data(),&idir,&iface_coarse,
+                                             &num_neighbors,&refratio,&igrid,
+                                             &t.tdata_ptr);
+        FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE_FACE(&mx,&my,&mbc,&meqn,qcoarse.data(),
+                                                  qf2.data(),&idir,&iface_coarse,
+                                                  &num_neighbors,&refratio,&igrid,
+                                                  &t.tdata_ptr);
+        check_equal(qf1,qf2);
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch46_interpolate_corner matches Fortran")
+{
+    for(int mbc : {2, 4})
+    {
+        int mx = 8, my = 8, meqn = 3;
+        int icorner = 3, refratio = 2;
+
+        TransformData t(mx,mbc,1,0.0,0.0,2,0.5,0.5);
+        t.tdata.icorner = icorner;
+
+        std::vector<double> qcoarse = patch_data(mx,mbc,meqn,1.0);
+        std::vector<double> qf1 = patch_data(mx,mbc,meqn,0.5);
+        std::vector<double> qf2 = qf1;
+
+        fclaw2d_clawpatch46_interpolate_corner(&mx,&my,&mbc,&meqn,&refratio,
+                                               qcoarse.data(),qf1.data(),
+                                               &icorner,&t.tdata_ptr);
+        FCLAW2D_CLAWPATCH46_FORT_INTERPOLATE_CORNER(&mx,&my,&mbc,&meqn,&refratio,
+                                                    qcoarse.data(),qf2.data(),
+                                                    &icorner,&t.tdata_ptr);
+        check_equal(qf1,qf2);
+    }
+}
@@ -39,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw2d_global.h>
 #include <fclaw_math.h>
+#include <fclaw_pointer_map.h>
 
 #if REFINE_DIM == 2 && PATCH_DIM == 2
 
@@ -71,6 +72,69 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 
+/* Registers of face k are kept in one array of 4*n*meqn values, with n = my 
+   for faces 0,1 and n = mx for faces 2,3 : 
+       [fp or gp (n*meqn) | fm or gm (n*meqn) | edge_fluxes (2*n*meqn)] */
+static
+void face_set_pointers(fclaw2d_clawpatch_registers_t *cr, int k, 
+                       double *face, int n, int meqn)
+{
+	double *plus = face;
+	double *minus = face == NULL ? NULL : face + n*meqn;
+	double *ef = face == NULL ? NULL : face + 2*n*meqn;
+	if (k < 2)
+	{
+		cr->fp[k] = plus;
+		cr->fm[k] = minus;
+	}
+	else
+	{
+		cr->gp[k-2] = plus;
+		cr->gm[k-2] = minus;
+	}
+	cr->edge_fluxes[k] = ef;
+}
+
+static
+void face_alloc(fclaw2d_clawpatch_registers_t *cr, int k, 
+                int mx, int my, int meqn)
+{
+	int n = k < 2 ? my : mx;
+	FCLAW_ASSERT(cr->edge_fluxes[k] == NULL);
+	face_set_pointers(cr,k,FCLAW_ALLOC_ZERO(double,4*n*meqn),n,meqn);
+	cr->face_mask |= 1 << k;
+}
+
+static
+void face_free(fclaw2d_clawpatch_registers_t *cr, int k)
+{
+	/* The first pointer is the start of the array */
+	double *face = k < 2 ? cr->fp[k] : cr->gp[k-2];
+	FCLAW_FREE(face);
+	face_set_pointers(cr,k,NULL,0,0);
+	cr->face_mask &= ~(1 << k);
+}
+
+/* Faces without registers are read from a zero array.  The Fortran time 
+   sync routines only read registers, so one array is shared by all 
+   patches of a glob. */
+#define TIME_SYNC_ZERO_FACES "fclaw2d_clawpatch_time_sync_zero_faces"
+
+static
+void zero_faces_destroy(void *zero_faces)
+{
+	FCLAW_FREE(zero_faces);
+}
+
+static
+double* time_sync_zero_faces(fclaw2d_global_t *glob)
+{
+	double *zero_faces = (double*) 
+		fclaw_pointer_map_get(glob->attributes,TIME_SYNC_ZERO_FACES);
+	FCLAW_ASSERT(zero_faces != NULL);
+	return zero_faces;
+}
+
 void fclaw2d_clawpatch_time_sync_new (fclaw2d_global_t* glob,
                                       fclaw2d_patch_t* this_patch,
                                       int blockno,int patchno,
@@ -82,26 +146,23 @@ void fclaw2d_clawpatch_time_sync_new (fclaw2d_global_t* glob,
 
 	int mx = clawpatch_opt->mx;
 	int my = clawpatch_opt->my;
-	int meqn = clawpatch_opt->meqn;
 
 	fclaw2d_clawpatch_registers_t *cr = *registers;  /* cr = clawpatch registers */
 
 	cr = FCLAW_ALLOC(fclaw2d_clawpatch_registers_t,1);
 	*registers = cr;
 
+	/* Accumulators are allocated by fclaw2d_clawpatch_time_sync_set_faces, 
+	   once we know which faces are at coarse/fine or block interfaces. */
+	cr->face_mask = 0;
+	for(k = 0; k < 4; k++)
+	{
+		face_set_pointers(cr,k,NULL,0,0);
+	}
+
 	/* Iterate over sides 0,1,3,4 */
 	for(k = 0; k < 2; k++)
 	{
-		/* Accumulators */
-		cr->fp[k]     = FCLAW_ALLOC_ZERO(double,my*meqn);
-		cr->fm[k]     = FCLAW_ALLOC_ZERO(double,my*meqn);
-
-		cr->gp[k]     = FCLAW_ALLOC_ZERO(double,mx*meqn);
-		cr->gm[k]     = FCLAW_ALLOC_ZERO(double,mx*meqn);
-
-		cr->edge_fluxes[k]   = FCLAW_ALLOC_ZERO(double,2*my*meqn);
-		cr->edge_fluxes[k+2] = FCLAW_ALLOC_ZERO(double,2*mx*meqn);
-
 		cr->edgelengths[k]   = FCLAW_ALLOC(double,my);
 		cr->edgelengths[k+2] = FCLAW_ALLOC(double,mx);
 		cr->area[k]          = FCLAW_ALLOC(double,my);
@@ -109,6 +170,86 @@ void fclaw2d_clawpatch_time_sync_new (fclaw2d_global_t* glob,
 	}
 }
 
+void fclaw2d_clawpatch_time_sync_set_faces(fclaw2d_global_t *glob,
+                                           fclaw2d_patch_t *this_patch,
+                                           fclaw2d_clawpatch_registers_t *cr)
+{
+	const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+	if (!fclaw_opt->time_sync || fclaw2d_patch_is_ghost(this_patch) ||
+	    !fclaw2d_patch_neighbor_type_set(this_patch))
+	{
+		/* Ghost patches get their faces from the owner in 
+		   fclaw2d_clawpatch_time_sync_pack_registers */
+		return;
+	}
+
+	fclaw2d_clawpatch_options_t* clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+	fclaw2d_patch_data_t* pdata = fclaw2d_patch_get_patch_data(this_patch);
+
+	/* Allocated here, since faces are set outside of threaded ghost 
+	   filling */
+	if (fclaw_pointer_map_get(glob->attributes,TIME_SYNC_ZERO_FACES) == NULL)
+	{
+		int wsize = fclaw2d_clawpatch_time_sync_work_size(glob);
+		fclaw_pointer_map_insert(glob->attributes,TIME_SYNC_ZERO_FACES,
+		                         FCLAW_ALLOC_ZERO(double,wsize),
+		                         zero_faces_destroy);
+	}
+
+	for(int k = 0; k < 4; k++)
+	{
+		/* Same size neighbors in the same block compute the same fluxes 
+		   at the shared face, so no correction is needed there. */
+		fclaw2d_patch_relation_t nt = pdata->face_neighbors[k];
+		int on_block_face = (this_patch->flags & 
+		                     (FCLAW2D_PATCH_ON_BLOCK_FACE_0 << k)) != 0;
+		int need = nt == FCLAW2D_PATCH_HALFSIZE || 
+		           nt == FCLAW2D_PATCH_DOUBLESIZE ||
+		           (nt == FCLAW2D_PATCH_SAMESIZE && on_block_face);
+		int have = (cr->face_mask & (1 << k)) != 0;
+		if (need && !have)
+		{
+			face_alloc(cr,k,clawpatch_opt->mx,clawpatch_opt->my,
+			           clawpatch_opt->meqn);
+		}
+		else if (!need && have)
+		{
+			face_free(cr,k);
+		}
+	}
+}
+
+int fclaw2d_clawpatch_time_sync_work_size(fclaw2d_global_t *glob)
+{
+	fclaw2d_clawpatch_options_t* clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+	int nmax = SC_MAX(clawpatch_opt->mx,clawpatch_opt->my);
+	return 16*nmax*clawpatch_opt->meqn;
+}
+
+void fclaw2d_clawpatch_time_sync_fill_faces(fclaw2d_global_t *glob,
+                                            const fclaw2d_clawpatch_registers_t *cr,
+                                            double *work,
+                                            fclaw2d_clawpatch_registers_t *filled)
+{
+	fclaw2d_clawpatch_options_t* clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+
+	int mx = clawpatch_opt->mx;
+	int my = clawpatch_opt->my;
+	int meqn = clawpatch_opt->meqn;
+	int nmax = SC_MAX(mx,my);
+
+	*filled = *cr;
+	for(int k = 0; k < 4; k++)
+	{
+		if ((cr->face_mask & (1 << k)) == 0)
+		{
+			face_set_pointers(filled,k,work + 4*k*nmax*meqn,
+			                  k < 2 ? my : mx,meqn);
+		}
+	}
+	filled->face_mask = 0xf;
+}
+
 void fclaw2d_clawpatch_time_sync_pack_registers(fclaw2d_global_t *glob,
                                                 fclaw2d_patch_t *this_patch,
                                                 double *qpack,
@@ -125,9 +266,38 @@ void fclaw2d_clawpatch_time_sync_pack_registers(fclaw2d_global_t *glob,
 	fclaw2d_clawpatch_registers_t* cr = fclaw2d_clawpatch_get_registers(glob,this_patch);
 
 	int cnt = 0;
+
+	/* Only faces with registers are sent.  The face mask goes first, so 
+	   that the receiver knows which faces follow. */
+	if (packmode == CLAWPATCH_REGISTER_PACK)
+	{
+		qpack[cnt++] = cr->face_mask;
+	}
+	else
+	{
+		int face_mask = (int) qpack[cnt++];
+		for(int k = 0; k < 4; k++)
+		{
+			int need = (face_mask & (1 << k)) != 0;
+			int have = (cr->face_mask & (1 << k)) != 0;
+			if (need && !have)
+			{
+				face_alloc(cr,k,mx,my,meqn);
+			}
+			else if (!need && have)
+			{
+				face_free(cr,k);
+			}
+		}
+	}
+
     /* Cycle over four edges */
 	for(int k = 0; k < 4; k++)
 	{
+		if ((cr->face_mask & (1 << k)) == 0)
+		{
+			continue;
+		}
 		int idir = k/2;
 		if (idir == 0)
 		{
@@ -198,8 +368,8 @@ void fclaw2d_clawpatch_time_sync_pack_registers(fclaw2d_global_t *glob,
 			}
 		}
 	}
-	/* Check that we packed exactly the right number of elements */
-	*ierror = (cnt == frsize) ? 0 : 1;
+	/* The buffer has room for all four faces */
+	*ierror = (cnt <= frsize) ? 0 : 1;
 }
 
 
@@ -251,7 +421,7 @@ void fclaw2d_clawpatch_time_sync_reset(fclaw2d_global_t *glob,
 			reset_flux = pdata->face_neighbors[k] == FCLAW2D_PATCH_BOUNDARY;
 		}
 
-		if (reset_flux)
+		if (reset_flux && cr->edge_fluxes[k] != NULL)
 		{
 			if (idir == 0)
 			{
@@ -286,19 +456,17 @@ void fclaw2d_clawpatch_time_sync_delete (fclaw2d_clawpatch_registers_t **registe
 
 	fclaw2d_clawpatch_registers_t *cr = *registers;
 
-	for(k = 0; k < 2; k++)
+	for(k = 0; k < 4; k++)
 	{
-		/* Accumulators */
-		FCLAW_FREE(cr->fp[k]);
-		FCLAW_FREE(cr->fm[k]);    
-
-		FCLAW_FREE(cr->gp[k]);    
-		FCLAW_FREE(cr->gm[k]);  
-
-		/* COARSE GRID information */
-		FCLAW_FREE(cr->edge_fluxes[k]); 
-		FCLAW_FREE(cr->edge_fluxes[k+2]); 
+		/* Accumulators and COARSE GRID information */
+		if (cr->face_mask & (1 << k))
+		{
+			face_free(cr,k);
+		}
+	}
 
+	for(k = 0; k < 2; k++)
+	{
 		FCLAW_FREE(cr->edgelengths[k]);
 		FCLAW_FREE(cr->area[k]);
 		FCLAW_FREE(cr->edgelengths[k+2]);
@@ -379,11 +547,20 @@ void fclaw2d_clawpatch_time_sync_f2c(fclaw2d_global_t* glob,
 	fclaw2d_clawpatch_grid_data(glob,coarse_patch,&mx,&my,&mbc,
 	                            &xlower,&ylower,&dx,&dy);
 
-	fclaw2d_clawpatch_registers_t* crcoarse = 
-	           fclaw2d_clawpatch_get_registers(glob,coarse_patch);
+	/* The Fortran routine is passed all four faces, but only reads the 
+	   faces at the interface;  missing faces are taken from a zero array. */
+	double *zero_faces = time_sync_zero_faces(glob);
 
-	fclaw2d_clawpatch_registers_t* crfine = 
-	           fclaw2d_clawpatch_get_registers(glob,fine_patch);
+	fclaw2d_clawpatch_registers_t crcoarse_all, crfine_all;
+	fclaw2d_clawpatch_time_sync_fill_faces(glob,
+	           fclaw2d_clawpatch_get_registers(glob,coarse_patch),
+	           zero_faces,&crcoarse_all);
+	fclaw2d_clawpatch_time_sync_fill_faces(glob,
+	           fclaw2d_clawpatch_get_registers(glob,fine_patch),
+	           zero_faces,&crfine_all);
+
+	fclaw2d_clawpatch_registers_t* crcoarse = &crcoarse_all;
+	fclaw2d_clawpatch_registers_t* crfine = &crfine_all;
 
 
   	/* create dummy fine grid to handle indexing between blocks */
@@ -448,11 +625,19 @@ void fclaw2d_clawpatch_time_sync_samesize (struct fclaw2d_global* glob,
 	fclaw2d_clawpatch_grid_data(glob,this_patch,&mx,&my,&mbc,
 	                            &xlower,&ylower,&dx,&dy);
 
-	fclaw2d_clawpatch_registers_t* crthis = 
-	fclaw2d_clawpatch_get_registers(glob,this_patch);
+	/* Missing faces are taken from a zero array;  see time_sync_f2c */
+	double *zero_faces = time_sync_zero_faces(glob);
+
+	fclaw2d_clawpatch_registers_t crthis_all, crneighbor_all;
+	fclaw2d_clawpatch_time_sync_fill_faces(glob,
+	           fclaw2d_clawpatch_get_registers(glob,this_patch),
+	           zero_faces,&crthis_all);
+	fclaw2d_clawpatch_time_sync_fill_faces(glob,
+	           fclaw2d_clawpatch_get_registers(glob,neighbor_patch),
+	           zero_faces,&crneighbor_all);
 
-	fclaw2d_clawpatch_registers_t* crneighbor = 
-	fclaw2d_clawpatch_get_registers(glob,neighbor_patch);
+	fclaw2d_clawpatch_registers_t* crthis = &crthis_all;
+	fclaw2d_clawpatch_registers_t* crneighbor = &crneighbor_all;
 
 	/* create dummy fine grid to handle indexing between blocks */
 	double *qneighbor_dummy = FCLAW_ALLOC_ZERO(double,meqn*(mx+2*mbc)*(my+2*mbc));
@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw2d_clawpatch_layout.h>
+
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_clawpatch.hpp>
+
+#include <fclaw2d_global.h>
+#include <fclaw2d_patch.h>
+
+#include <cstring>
+
+int fclaw2d_clawpatch_layout_row_length(fclaw2d_clawpatch_layout_t layout,
+                                        int mx, int mbc)
+{
+	int row = mx + 2*mbc;
+	if (layout == FCLAW2D_CLAWPATCH_LAYOUT_PADDED)
+	{
+		const int w = FCLAW2D_CLAWPATCH_SIMD_WIDTH;
+		row = ((row + w - 1)/w)*w;
+	}
+	return row;
+}
+
+int fclaw2d_clawpatch_layout_size(fclaw2d_clawpatch_layout_t layout,
+                                  int mx, int my, int mbc, int meqn)
+{
+	return fclaw2d_clawpatch_layout_row_length(layout,mx,mbc)*(my + 2*mbc)*meqn;
+}
+
+void fclaw2d_clawpatch_layout_view_init(fclaw2d_clawpatch_layout_t layout,
+                                        int mx, int my, int mbc, int meqn,
+                                        double q[],
+                                        fclaw2d_clawpatch_view_t *view)
+{
+	const int row = fclaw2d_clawpatch_layout_row_length(layout,mx,mbc);
+
+	view->layout = layout;
+	view->q = q;
+	view->mx = mx;
+	view->my = my;
+	view->mbc = mbc;
+	view->meqn = meqn;
+	if (layout == FCLAW2D_CLAWPATCH_LAYOUT_MIJ)
+	{
+		view->stride_m = 1;
+		view->stride_i = meqn;
+		view->stride_j = meqn*row;
+	}
+	else
+	{
+		view->stride_i = 1;
+		view->stride_j = row;
+		view->stride_m = row*(my + 2*mbc);
+	}
+}
+
+void fclaw2d_clawpatch_layout_copy(const fclaw2d_clawpatch_view_t *src,
+                                   fclaw2d_clawpatch_view_t *dst)
+{
+	FCLAW_ASSERT(src->mx == dst->mx && src->my == dst->my);
+	FCLAW_ASSERT(src->mbc == dst->mbc && src->meqn == dst->meqn);
+
+	const int ni = src->mx + 2*src->mbc;
+	const int nj = src->my + 2*src->mbc;
+	const int meqn = src->meqn;
+
+	if (src->stride_i == 1 && dst->stride_i == 1)
+	{
+		/* Both layouts store rows contiguously */
+		for (int m = 0; m < meqn; m++)
+			for (int j = 0; j < nj; j++)
+				memcpy(dst->q + m*dst->stride_m + j*dst->stride_j,
+				       src->q + m*src->stride_m + j*src->stride_j,
+				       ni*sizeof(double));
+		return;
+	}
+
+	/* Transpose;  loop over the equations innermost, since one of the two 
+	   layouts stores them contiguously */
+	for (int j = 0; j < nj; j++)
+		for (int i = 0; i < ni; i++)
+		{
+			const double *s = src->q + i*src->stride_i + j*src->stride_j;
+			double *d = dst->q + i*dst->stride_i + j*dst->stride_j;
+			for (int m = 0; m < meqn; m++)
+				d[m*dst->stride_m] = s[m*src->stride_m];
+		}
+}
+
+fclaw2d_clawpatch_layout_t fclaw2d_clawpatch_soln_layout(fclaw2d_global_t *glob)
+{
+	fclaw2d_clawpatch_vtable_t *clawpatch_vt = fclaw2d_clawpatch_vt(glob);
+	return clawpatch_vt->claw_version == 5 ? FCLAW2D_CLAWPATCH_LAYOUT_MIJ
+	                                       : FCLAW2D_CLAWPATCH_LAYOUT_IJM;
+}
+
+void fclaw2d_clawpatch_soln_view(fclaw2d_global_t *glob,
+                                 fclaw2d_patch_t *patch,
+                                 fclaw2d_clawpatch_layout_t layout,
+                                 fclaw2d_clawpatch_view_t *view)
+{
+	int mx,my,mbc;
+	double xlower,ylower,dx,dy;
+	fclaw2d_clawpatch_grid_data(glob,patch,&mx,&my,&mbc,
+	                            &xlower,&ylower,&dx,&dy);
+
+	double *q;
+	int meqn;
+	fclaw2d_clawpatch_soln_data(glob,patch,&q,&meqn);
+
+	fclaw2d_clawpatch_layout_t native = fclaw2d_clawpatch_soln_layout(glob);
+	if (layout == native)
+	{
+		fclaw2d_clawpatch_layout_view_init(layout,mx,my,mbc,meqn,q,view);
+		return;
+	}
+
+	fclaw2d_clawpatch_t *cp = fclaw2d_clawpatch_get_clawpatch(patch);
+	int size = fclaw2d_clawpatch_layout_size(layout,mx,my,mbc,meqn);
+	int ll[1] = {0};
+	int ur[1] = {size - 1};
+	Box box(ll,ur,1);
+	cp->griddata_layout.define(box,1);
+
+	fclaw2d_clawpatch_view_t soln;
+	fclaw2d_clawpatch_layout_view_init(native,mx,my,mbc,meqn,q,&soln);
+	fclaw2d_clawpatch_layout_view_init(layout,mx,my,mbc,meqn,
+	                                   cp->griddata_layout.dataPtr(),view);
+	fclaw2d_clawpatch_layout_copy(&soln,view);
+}
+
+void fclaw2d_clawpatch_soln_view_release(fclaw2d_global_t *glob,
+                                         fclaw2d_patch_t *patch,
+                                         fclaw2d_clawpatch_view_t *view,
+                                         int modified)
+{
+	double *q;
+	int meqn;
+	fclaw2d_clawpatch_soln_data(glob,patch,&q,&meqn);
+
+	if (view->q == q)
+	{
+		/* The view is the solution itself */
+		return;
+	}
+
+	if (modified)
+	{
+		fclaw2d_clawpatch_view_t soln;
+		fclaw2d_clawpatch_layout_view_init(fclaw2d_clawpatch_soln_layout(glob),
+		                                   view->mx,view->my,view->mbc,meqn,
+		                                   q,&soln);
+		fclaw2d_clawpatch_layout_copy(view,&soln);
+	}
+
+	/* Free the buffer until the next view */
+	fclaw2d_clawpatch_t *cp = fclaw2d_clawpatch_get_clawpatch(patch);
+	cp->griddata_layout = FArrayBox();
+	view->q = NULL;
+}
@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FCLAW2D_CLAWPATCH_LAYOUT_H
+#define FCLAW2D_CLAWPATCH_LAYOUT_H
+
+/**
+ * @file
+ * Memory layouts for the clawpatch solution and adapters between them.
+ *
+ * The solution is stored as q(i,j,m) for Clawpack 4.6 and as q(m,i,j) for 
+ * Clawpack 5.  A solver or kernel that vectorizes better on a different 
+ * layout requests a view of the solution in that layout.  If the layout 
+ * matches the storage, the view points to the solution itself.  Otherwise 
+ * the solution is copied to a buffer owned by the patch, and copied back 
+ * when the view is released.
+ *
+ * The padded layout is q(i,j,m) with rows padded to a multiple of 
+ * ::FCLAW2D_CLAWPATCH_SIMD_WIDTH doubles.  Every row starts on a 
+ * ::FCLAW2D_FARRAYBOX_ALIGNMENT boundary, so that row loops need no peeling.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if 0
+/* Fix syntax highlighting */
+#endif
+
+struct fclaw2d_global;
+struct fclaw2d_patch;
+
+/** Number of doubles the rows of the padded layout are padded to */
+#define FCLAW2D_CLAWPATCH_SIMD_WIDTH 8
+
+/**
+ * @brief Memory layouts of patch data
+ */
+typedef enum fclaw2d_clawpatch_layout
+{
+    /** q(i,j,m), used by Clawpack 4.6 */
+    FCLAW2D_CLAWPATCH_LAYOUT_IJM = 0,
+    /** q(m,i,j), used by Clawpack 5 */
+    FCLAW2D_CLAWPATCH_LAYOUT_MIJ,
+    /** q(i,j,m) with SIMD padded, aligned rows */
+    FCLAW2D_CLAWPATCH_LAYOUT_PADDED
+} fclaw2d_clawpatch_layout_t;
+
+/**
+ * @brief A view of patch data in a given layout
+ *
+ * Entry (i,j,m), with 1-mbc <= i <= mx+mbc, 1-mbc <= j <= my+mbc and 
+ * 1 <= m <= meqn, is at 
+ *   q[(i-1+mbc)*stride_i + (j-1+mbc)*stride_j + (m-1)*stride_m]
+ */
+typedef struct fclaw2d_clawpatch_view
+{
+    fclaw2d_clawpatch_layout_t layout;  /**< the layout of q */
+    double *q;      /**< the first entry, (1-mbc,1-mbc,1) */
+    int mx;         /**< number of cells in the x direction */
+    int my;         /**< number of cells in the y direction */
+    int mbc;        /**< number of ghost cells */
+    int meqn;       /**< number of equations */
+    int stride_i;   /**< distance between (i,j,m) and (i+1,j,m) */
+    int stride_j;   /**< distance between (i,j,m) and (i,j+1,m) */
+    int stride_m;   /**< distance between (i,j,m) and (i,j,m+1) */
+} fclaw2d_clawpatch_view_t;
+
+/**
+ * @brief Row length of a layout, including ghost cells and padding
+ *
+ * @param layout the layout
+ * @param mx the number of cells in the x direction
+ * @param mbc the number of ghost cells
+ * @return mx + 2*mbc, rounded up to ::FCLAW2D_CLAWPATCH_SIMD_WIDTH for the 
+ *         padded layout
+ */
+int fclaw2d_clawpatch_layout_row_length(fclaw2d_clawpatch_layout_t layout,
+                                        int mx, int mbc);
+
+/**
+ * @brief Number of doubles needed to store data in a layout
+ */
+int fclaw2d_clawpatch_layout_size(fclaw2d_clawpatch_layout_t layout,
+                                  int mx, int my, int mbc, int meqn);
+
+/**
+ * @brief Set up a view of the memory q in a layout
+ *
+ * @param[in] layout the layout
+ * @param[in] mx, my, mbc, meqn the patch dimensions
+ * @param[in] q memory of size ::fclaw2d_clawpatch_layout_size
+ * @param[out] view the view
+ */
+void fclaw2d_clawpatch_layout_view_init(fclaw2d_clawpatch_layout_t layout,
+                                        int mx, int my, int mbc, int meqn,
+                                        double q[],
+                                        fclaw2d_clawpatch_view_t *view);
+
+/**
+ * @brief Copy data between two views of the same dimensions
+ *
+ * Padding entries of dst are not changed.
+ */
+void fclaw2d_clawpatch_layout_copy(const fclaw2d_clawpatch_view_t *src,
+                                   fclaw2d_clawpatch_view_t *dst);
+
+/**
+ * @brief Layout the clawpatch solution is stored in
+ *
+ * @param glob the global context
+ * @return ::FCLAW2D_CLAWPATCH_LAYOUT_IJM for Clawpack 4.6, 
+ *         ::FCLAW2D_CLAWPATCH_LAYOUT_MIJ for Clawpack 5
+ */
+fclaw2d_clawpatch_layout_t fclaw2d_clawpatch_soln_layout(struct fclaw2d_global *glob);
+
+/**
+ * @brief Get a view of the solution in a given layout
+ *
+ * Copies the solution, including ghost cells, to a patch owned buffer if 
+ * the layout differs from the storage layout.  Each view must be released 
+ * with ::fclaw2d_clawpatch_soln_view_release before the solution is used 
+ * directly again.
+ *
+ * @param[in] glob the global context
+ * @param[in] patch the patch
+ * @param[in] layout the requested layout
+ * @param[out] view the view
+ */
+void fclaw2d_clawpatch_soln_view(struct fclaw2d_global *glob,
+                                 struct fclaw2d_patch *patch,
+                                 fclaw2d_clawpatch_layout_t layout,
+                                 fclaw2d_clawpatch_view_t *view);
+
+/**
+ * @brief Release a view of the solution
+ *
+ * If the view is a copy, the patch owned buffer is freed.
+ *
+ * @param[in] glob the global context
+ * @param[in] patch the patch
+ * @param[in] view the view
+ * @param[in] modified true if the view was written to;  the data is then 
+ *            copied back to the solution if the view is a copy
+ */
+void fclaw2d_clawpatch_soln_view_release(struct fclaw2d_global *glob,
+                                         struct fclaw2d_patch *patch,
+                                         fclaw2d_clawpatch_view_t *view,
+                                         int modified);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <test.hpp>
+#include <test/test.hpp>
+
+#include <fclaw2d_global.h>
+#include <fclaw2d_domain.h>
+#include <fclaw2d_forestclaw.h>
+#include <fclaw2d_options.h>
+#include <fclaw2d_patch.h>
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_clawpatch.hpp>
+#include <fclaw2d_clawpatch_options.h>
+#include <fclaw2d_clawpatch_layout.h>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    double entry(const fclaw2d_clawpatch_view_t& v, int i, int j, int m)
+    {
+        return v.q[(i-1+v.mbc)*v.stride_i + (j-1+v.mbc)*v.stride_j 
+                   + (m-1)*v.stride_m];
+    }
+
+    /* A single level one patch */
+    struct LayoutPatch {
+        fclaw2d_global_t* glob;
+        fclaw_options_t fopts;
+        fclaw2d_domain_t *domain;
+        fclaw2d_clawpatch_options_t opts;
+        fclaw2d_patch_t* patch;
+
+        LayoutPatch(){
+            glob = fclaw2d_global_new();
+
+            fclaw2d_vtables_initialize(glob);
+            fclaw2d_clawpatch_vtable_initialize(glob, 4);
+
+            memset(&fopts, 0, sizeof(fopts));
+            fopts.mi = 1;
+            fopts.mj = 1;
+            fopts.minlevel = 1;
+            fopts.maxlevel = 1;
+            fopts.refratio = 2;
+
+            domain = create_test_domain(sc_MPI_COMM_WORLD,&fopts);
+            fclaw2d_global_store_domain(glob, domain);
+            fclaw2d_options_store(glob, &fopts);
+
+            memset(&opts, 0, sizeof(opts));
+            opts.mx   = 7;
+            opts.my   = 5;
+            opts.mbc  = 2;
+            opts.meqn = 3;
+            fclaw2d_clawpatch_options_store(glob, &opts);
+
+            fclaw2d_domain_data_new(glob->domain);
+
+            patch = &domain->blocks[0].patches[0];
+            fclaw2d_build_mode_t build_mode = FCLAW2D_BUILD_FOR_UPDATE;
+            fclaw2d_patch_build(glob, patch, 0, 0, &build_mode);
+        }
+        ~LayoutPatch(){
+            fclaw2d_patch_data_delete(glob, patch);
+            fclaw2d_global_destroy(glob);
+        }
+    };
+}
+
+TEST_CASE("fclaw2d_clawpatch_layout_row_length")
+{
+    CHECK(fclaw2d_clawpatch_layout_row_length(FCLAW2D_CLAWPATCH_LAYOUT_IJM,8,2) == 12);
+    CHECK(fclaw2d_clawpatch_layout_row_length(FCLAW2D_CLAWPATCH_LAYOUT_MIJ,8,2) == 12);
+    CHECK(fclaw2d_clawpatch_layout_row_length(FCLAW2D_CLAWPATCH_LAYOUT_PADDED,8,2) == 16);
+    CHECK(fclaw2d_clawpatch_layout_row_length(FCLAW2D_CLAWPATCH_LAYOUT_PADDED,12,2) == 16);
+    CHECK(fclaw2d_clawpatch_layout_row_length(FCLAW2D_CLAWPATCH_LAYOUT_PADDED,13,2) == 24);
+
+    CHECK(fclaw2d_clawpatch_layout_size(FCLAW2D_CLAWPATCH_LAYOUT_IJM,8,6,2,3) == 12*10*3);
+    CHECK(fclaw2d_clawpatch_layout_size(FCLAW2D_CLAWPATCH_LAYOUT_PADDED,8,6,2,3) == 16*10*3);
+}
+
+TEST_CASE("fclaw2d_clawpatch_layout_copy round trips between layouts")
+{
+    fclaw2d_clawpatch_layout_t layouts[3] = {FCLAW2D_CLAWPATCH_LAYOUT_IJM,
+                                             FCLAW2D_CLAWPATCH_LAYOUT_MIJ,
+                                             FCLAW2D_CLAWPATCH_LAYOUT_PADDED};
+    int mx = 7, my = 5, mbc = 2, meqn = 3;
+    for(fclaw2d_clawpatch_layout_t from : layouts)
+    for(fclaw2d_clawpatch_layout_t to : layouts)
+    {
+        std::vector<double> a(fclaw2d_clawpatch_layout_size(from,mx,my,mbc,meqn));
+        std::vector<double> b(fclaw2d_clawpatch_layout_size(to,mx,my,mbc,meqn),-1);
+        std::vector<double> c(a.size(),-2);
+
+        fclaw2d_clawpatch_view_t va, vb, vc;
+        fclaw2d_clawpatch_layout_view_init(from,mx,my,mbc,meqn,a.data(),&va);
+        fclaw2d_clawpatch_layout_view_init(to,mx,my,mbc,meqn,b.data(),&vb);
+        fclaw2d_clawpatch_layout_view_init(from,mx,my,mbc,meqn,c.data(),&vc);
+
+        for(int m = 1; m <= meqn; m++)
+        for(int j = 1-mbc; j <= my+mbc; j++)
+        for(int i = 1-mbc; i <= mx+mbc; i++)
+        {
+            va.q[(i-1+mbc)*va.stride_i + (j-1+mbc)*va.stride_j 
+                 + (m-1)*va.stride_m] = 100*m + 10*j + i;
+        }
+
+        fclaw2d_clawpatch_layout_copy(&va,&vb);
+        fclaw2d_clawpatch_layout_copy(&vb,&vc);
+
+        for(int m = 1; m <= meqn; m++)
+        for(int j = 1-mbc; j <= my+mbc; j++)
+        for(int i = 1-mbc; i <= mx+mbc; i++)
+        {
+            CHECK(entry(vb,i,j,m) == 100*m + 10*j + i);
+            CHECK(entry(vc,i,j,m) == 100*m + 10*j + i);
+        }
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch_soln_view of the storage layout is the solution")
+{
+    LayoutPatch test;
+
+    double *q;
+    int meqn;
+    fclaw2d_clawpatch_soln_data(test.glob,test.patch,&q,&meqn);
+
+    fclaw2d_clawpatch_view_t view;
+    fclaw2d_clawpatch_soln_view(test.glob,test.patch,
+                                FCLAW2D_CLAWPATCH_LAYOUT_IJM,&view);
+    CHECK(view.q == q);
+    fclaw2d_clawpatch_soln_view_release(test.glob,test.patch,&view,1);
+}
+
+TEST_CASE("fclaw2d_clawpatch_soln_view_release copies back and frees the buffer")
+{
+    LayoutPatch test;
+    fclaw2d_clawpatch_t *cp = fclaw2d_clawpatch_get_clawpatch(test.patch);
+
+    double *q;
+    int meqn;
+    fclaw2d_clawpatch_soln_data(test.glob,test.patch,&q,&meqn);
+    fclaw2d_clawpatch_view_t soln;
+    fclaw2d_clawpatch_layout_view_init(FCLAW2D_CLAWPATCH_LAYOUT_IJM,
+                                       7,5,2,meqn,q,&soln);
+    for(int m = 1; m <= meqn; m++)
+    for(int j = -1; j <= 5+2; j++)
+    for(int i = -1; i <= 7+2; i++)
+    {
+        soln.q[(i+1)*soln.stride_i + (j+1)*soln.stride_j 
+               + (m-1)*soln.stride_m] = 100*m + 10*j + i;
+    }
+
+    fclaw2d_clawpatch_view_t view;
+    fclaw2d_clawpatch_soln_view(test.glob,test.patch,
+                                FCLAW2D_CLAWPATCH_LAYOUT_PADDED,&view);
+    CHECK(view.q != q);
+    CHECK(view.q == cp->griddata_layout.dataPtr());
+    CHECK(entry(view,3,2,2) == 200 + 20 + 3);
+
+    view.q[(3+1)*view.stride_i + (2+1)*view.stride_j + view.stride_m] = -5;
+    fclaw2d_clawpatch_soln_view_release(test.glob,test.patch,&view,1);
+
+    CHECK(entry(soln,3,2,2) == -5);
+    CHECK(cp->griddata_layout.size() == 0);
+    CHECK(cp->griddata_layout.dataPtr() == nullptr);
+
+    /* An unmodified view is freed without copying back */
+    fclaw2d_clawpatch_soln_view(test.glob,test.patch,
+                                FCLAW2D_CLAWPATCH_LAYOUT_MIJ,&view);
+    view.q[0] = -7;
+    fclaw2d_clawpatch_soln_view_release(test.glob,test.patch,&view,0);
+
+    CHECK(entry(soln,-1,-1,1) == 100 - 10 - 1);
+    CHECK(cp->griddata_layout.size() == 0);
+}
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 #include <fclaw2d_global.h>
 #include <fclaw_pointer_map.h>
+#include <fclaw_options.h>
 
 static void *
 clawpatch_register(fclaw2d_clawpatch_options_t *clawpatch_options,
@@ -88,6 +89,61 @@ clawpatch_register(fclaw2d_clawpatch_options_t *clawpatch_options,
                          &clawpatch_options->save_aux,0,
                          "Save aux variables when re-taking a time step [F]");
 
+    sc_options_add_bool (opt, 0, "time-interp-ring", 
+                         &clawpatch_options->time_interp_ring,0,
+                         "Store only the interior ring of the last time step " \
+                         "needed for time interpolation [F]");
+
+    sc_options_add_bool (opt, 0, "vtk-amr", 
+                         &clawpatch_options->vtk_amr,0,
+                         "Write VTK output as vtkOverlappingAMR with one image " \
+                         "data file per patch [F]");
+
+    sc_options_add_bool (opt, 0, "vtk-cache-geometry", 
+                         &clawpatch_options->vtk_cache_geometry,0,
+                         "Keep the VTK mesh arrays in memory between frames " \
+                         "until the domain changes.  Each file still " \
+                         "contains the full mesh [F]");
+
+    sc_options_add_bool (opt, 0, "vtk-compress", 
+                         &clawpatch_options->vtk_compress,0,
+                         "Compress VTK data arrays with zlib, one block " \
+                         "per patch [F]");
+
+    sc_options_add_int (opt, 0, "vtk-mantissa-bits", 
+                        &clawpatch_options->vtk_mantissa_bits,23,
+                        "Mantissa bits of the VTK solution to keep.  Fewer " \
+                        "than 23 bits round values to a relative error of " \
+                        "at most 2^-(bits+1) [23]");
+
+    /* Filters for small preview frames */
+    sc_options_add_int (opt, 0, "output-filter-interval", 
+                        &clawpatch_options->output_filter_interval,0,
+                        "Frames that are a multiple of this are written " \
+                        "without filters; 0 filters every frame [0]");
+
+    fclaw_options_add_double_array (opt, 0, "output-box", 
+                                    &clawpatch_options->output_box_string,
+                                    NULL,&clawpatch_options->output_box,4,
+                                    "Only write patches intersecting the box " \
+                                    "'xlow xhigh ylow yhigh' [all]");
+
+    clawpatch_options->output_blocks = NULL;
+    sc_options_add_string (opt, 0, "output-blocks", 
+                           &clawpatch_options->output_blocks_string, NULL,
+                           "Only write patches in these blocks [all]");
+
+    sc_options_add_int (opt, 0, "output-maxlevel", 
+                        &clawpatch_options->output_maxlevel,-1,
+                        "Average patches finer than this level down " \
+                        "to it and write one patch per family; -1 for " \
+                        "no cap [-1]");
+
+    sc_options_add_int (opt, 0, "output-stride", 
+                        &clawpatch_options->output_stride,1,
+                        "Write every stride-th cell, so patches have " \
+                        "mx/stride by my/stride cells [1]");
+
     /* Set verbosity level for reporting timing */
     sc_keyvalue_t *kv = clawpatch_options->kv_refinement_criteria = sc_keyvalue_new ();
     sc_keyvalue_set_int (kv, "value",        FCLAW_REFINE_CRITERIA_VALUE);
@@ -107,7 +163,33 @@ clawpatch_register(fclaw2d_clawpatch_options_t *clawpatch_options,
 static fclaw_exit_type_t
 clawpatch_postprocess(fclaw2d_clawpatch_options_t *clawpatch_opt)
 {
-    /* Convert strings to arrays (no strings to process here) */
+    /* Convert strings to arrays */
+    if (clawpatch_opt->output_box_string != NULL)
+    {
+        fclaw_options_convert_double_array (clawpatch_opt->output_box_string,
+                                            &clawpatch_opt->output_box, 4);
+    }
+
+    clawpatch_opt->output_num_blocks = 0;
+    if (clawpatch_opt->output_blocks_string != NULL)
+    {
+        /* count the entries */
+        const char *b = clawpatch_opt->output_blocks_string;
+        char *e;
+        for (;;)
+        {
+            (void) strtol (b, &e, 10);
+            if (e == b)
+            {
+                break;
+            }
+            clawpatch_opt->output_num_blocks++;
+            b = e;
+        }
+        fclaw_options_convert_int_array (clawpatch_opt->output_blocks_string,
+                                         &clawpatch_opt->output_blocks,
+                                         clawpatch_opt->output_num_blocks);
+    }
     return FCLAW_NOEXIT;
 }
 
@@ -144,6 +226,40 @@ clawpatch_check(fclaw2d_clawpatch_options_t *clawpatch_opt)
         return FCLAW_EXIT_ERROR;            
     }
 
+    if (clawpatch_opt->vtk_mantissa_bits < 1 || clawpatch_opt->vtk_mantissa_bits > 23)
+    {
+        fclaw_global_essentialf("Clawpatch error : vtk-mantissa-bits must be " \
+                                "between 1 and 23\n");
+        return FCLAW_EXIT_ERROR;
+    }
+
+    if (clawpatch_opt->output_stride < 1 || 
+        clawpatch_opt->mx % clawpatch_opt->output_stride != 0 ||
+        clawpatch_opt->my % clawpatch_opt->output_stride != 0)
+    {
+        fclaw_global_essentialf("Clawpatch error : output-stride must " \
+                                "divide mx and my\n");
+        return FCLAW_EXIT_ERROR;
+    }
+
+    if (clawpatch_opt->output_maxlevel < -1 || 
+        clawpatch_opt->output_filter_interval < 0)
+    {
+        fclaw_global_essentialf("Clawpatch error : output-maxlevel must be " \
+                                "at least -1 and output-filter-interval " \
+                                "at least 0\n");
+        return FCLAW_EXIT_ERROR;
+    }
+
+#ifndef SC_HAVE_ZLIB
+    if (clawpatch_opt->vtk_compress)
+    {
+        fclaw_global_essentialf("Clawpatch error : vtk-compress requires " \
+                                "zlib\n");
+        return FCLAW_EXIT_ERROR;
+    }
+#endif
+
     return FCLAW_NOEXIT;
 }
 
@@ -152,6 +268,8 @@ clawpatch_destroy (fclaw2d_clawpatch_options_t *clawpatch_opt)
 {
     FCLAW_ASSERT (clawpatch_opt->kv_refinement_criteria != NULL);
     sc_keyvalue_destroy (clawpatch_opt->kv_refinement_criteria);
+    FCLAW_FREE (clawpatch_opt->output_box);
+    FCLAW_FREE (clawpatch_opt->output_blocks);
 }
 
 /* ------------------------------------------------------------------------
@@ -252,19 +370,22 @@ fclaw2d_clawpatch_options_register(fclaw_app_t* app, const char* name, const cha
     return clawpatch_options;
 }
 
+static int options_slot = -1;
+
 void 
 fclaw2d_clawpatch_options_store (fclaw2d_global_t *glob, 
                                  fclaw2d_clawpatch_options_t* clawpatch_options)
 {
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->options,CLAWPATCH_OPTION_NAME) == NULL);
 	fclaw_pointer_map_insert(glob->options, CLAWPATCH_OPTION_NAME, clawpatch_options, NULL);
+	options_slot = fclaw_pointer_map_slot(CLAWPATCH_OPTION_NAME);
 }
 
 fclaw2d_clawpatch_options_t* 
 fclaw2d_clawpatch_get_options(fclaw2d_global_t* glob)
 {
     fclaw2d_clawpatch_options_t* clawptch_options = (fclaw2d_clawpatch_options_t*) 
-	   							fclaw_pointer_map_get(glob->options, CLAWPATCH_OPTION_NAME);
+	   							fclaw_pointer_map_get_slot(glob->options, options_slot);
 	FCLAW_ASSERT(clawptch_options != NULL);
 	return clawptch_options;
 }
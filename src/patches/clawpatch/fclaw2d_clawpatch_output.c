@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2012-2022 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw2d_clawpatch_output.h>
+
+#include <fclaw2d_clawpatch_output_ascii.h>
+#include <fclaw2d_clawpatch_output_filter.h>
+#include <fclaw2d_clawpatch_output_vtk.h>
+
+#include <fclaw2d_global.h>
+#include <fclaw2d_patch.h>
+
+void fclaw2d_clawpatch_output_frame(fclaw2d_global_t* glob, int iframe,
+                                    int formats)
+{
+    fclaw2d_clawpatch_ascii_frame_t *ascii = NULL;
+    fclaw2d_clawpatch_vtk_frame_t *vtk = NULL;
+
+    if (formats & FCLAW2D_CLAWPATCH_OUTPUT_ASCII)
+    {
+        ascii = fclaw2d_clawpatch_output_ascii_begin(glob,iframe);
+        if (ascii == NULL)
+        {
+            fclaw2d_clawpatch_output_ascii(glob,iframe);
+        }
+    }
+    if (formats & FCLAW2D_CLAWPATCH_OUTPUT_VTK)
+    {
+        vtk = fclaw2d_clawpatch_output_vtk_begin(glob,iframe);
+        if (vtk == NULL)
+        {
+            fclaw2d_clawpatch_output_vtk(glob,iframe);
+        }
+    }
+
+    if (ascii == NULL && vtk == NULL)
+    {
+        return;
+    }
+
+    fclaw2d_domain_t *domain = glob->domain;
+    const int n = domain->local_num_patches;
+    int *blocknos = FCLAW_ALLOC(int,n);
+    int *patchnos = FCLAW_ALLOC(int,n);
+    for(int blockno = 0; blockno < domain->num_blocks; blockno++)
+    {
+        fclaw2d_block_t *block = &domain->blocks[blockno];
+        for(int patchno = 0; patchno < block->num_patches; patchno++)
+        {
+            blocknos[block->num_patches_before + patchno] = blockno;
+            patchnos[block->num_patches_before + patchno] = patchno;
+        }
+    }
+
+    /* One pass over the patches for all formats.  Filtered patches are 
+       reduced in buffers allocated with FCLAW_ALLOC, which is not thread 
+       safe;  the filter was set up by the begin routines. */
+#pragma omp parallel for schedule(dynamic) \
+    if(fclaw2d_clawpatch_output_filter_get(glob,iframe) == NULL)
+    for(int k = 0; k < n; k++)
+    {
+        fclaw2d_patch_t *patch = &domain->blocks[blocknos[k]].patches[patchnos[k]];
+        if (ascii != NULL)
+        {
+            fclaw2d_clawpatch_output_ascii_patch(glob,ascii,patch,
+                                                 blocknos[k],patchnos[k]);
+        }
+        if (vtk != NULL)
+        {
+            /* The VTK frame packs one patch at a time */
+#pragma omp critical (fclaw2d_clawpatch_output_vtk)
+            fclaw2d_clawpatch_output_vtk_patch(glob,vtk,patch,
+                                               blocknos[k],patchnos[k]);
+        }
+    }
+
+    FCLAW_FREE(blocknos);
+    FCLAW_FREE(patchnos);
+
+    if (ascii != NULL)
+    {
+        fclaw2d_clawpatch_output_ascii_end(glob,ascii);
+    }
+    if (vtk != NULL)
+    {
+        (void) fclaw2d_clawpatch_output_vtk_end(glob,vtk);
+    }
+}
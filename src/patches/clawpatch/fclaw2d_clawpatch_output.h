@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FCLAW2D_CLAWPATCH_OUTPUT_H
+#define FCLAW2D_CLAWPATCH_OUTPUT_H
+
+/**
+ * @file
+ * Output of several formats in one pass over the patches.
+ *
+ * Each patch is visited once and converted to all requested formats.  The 
+ * pass is threaded with OpenMP for unfiltered frames;  ascii patches are 
+ * formatted in parallel, and VTK patches are packed one at a time.  The 
+ * converted data is kept in memory and written when all patches are done.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if 0
+/* Fix syntax highlighting */
+#endif
+
+struct fclaw2d_global;
+
+/**
+ * @brief Formats written by ::fclaw2d_clawpatch_output_frame
+ */
+typedef enum fclaw2d_clawpatch_output_format
+{
+    /** fort.qXXXX and fort.tXXXX files */
+    FCLAW2D_CLAWPATCH_OUTPUT_ASCII = 1,
+    /** vtu file, or vtkOverlappingAMR files with vtk-amr */
+    FCLAW2D_CLAWPATCH_OUTPUT_VTK = 2
+} fclaw2d_clawpatch_output_format_t;
+
+/**
+ * @brief Write a frame in several formats
+ * 
+ * Formats that cannot be filled patch by patch (user defined ascii output, 
+ * vtk-amr) are written by their own routines.  Collective.
+ * 
+ * @param glob the global context
+ * @param iframe the frame index
+ * @param formats bitwise or of ::fclaw2d_clawpatch_output_format_t values
+ */
+void fclaw2d_clawpatch_output_frame(struct fclaw2d_global* glob, int iframe,
+                                    int formats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -52,6 +52,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_global.h>
 #include <fclaw2d_options.h>
 
+#if PATCH_DIM == 2
+#include <fclaw2d_clawpatch46_fort.h>
+#include <fclaw2d_clawpatch5_fort.h>
+#include <fclaw2d_clawpatch_layout.h>
+#include <fclaw2d_clawpatch_output_filter.h>
+#include <fclaw2d_output.h>
+#include <fclaw_async_writer.h>
+
+#include <limits.h>
+#endif
+
 
 void cb_clawpatch_output_ascii (fclaw2d_domain_t * domain,
                                 fclaw2d_patch_t * patch,
@@ -121,7 +132,11 @@ void fclaw2d_clawpatch_time_header_ascii(fclaw2d_global_t* glob, int iframe)
 
     double time = glob->curr_time;
 
+#if PATCH_DIM == 2
+    int ngrids = (int) fclaw2d_clawpatch_output_filter_num_patches(glob,iframe);
+#else
     int ngrids = glob->domain->global_num_patches;
+#endif
 
     int meqn = clawpatch_opt->meqn;
     int maux = clawpatch_opt->maux;
@@ -136,11 +151,59 @@ void fclaw2d_clawpatch_time_header_ascii(fclaw2d_global_t* glob, int iframe)
            vt->output_frame = &fclaw2d_clawpatch_output_ascii;
     -------------------------------------------------------------------- */
 
+#if PATCH_DIM == 2
+
+typedef struct ascii_filter_user
+{
+    const fclaw2d_clawpatch_output_filter_t *filter;
+    fclaw2d_patch_callback_t cb;
+    int iframe;
+} ascii_filter_user_t;
+
+/* Only the patches are filtered for user defined output routines */
+static
+void cb_ascii_filter(fclaw2d_domain_t * domain,
+                     fclaw2d_patch_t * patch,
+                     int blockno, int patchno,
+                     void *user)
+{
+    fclaw2d_global_iterate_t* g = (fclaw2d_global_iterate_t*) user;
+    ascii_filter_user_t *f = (ascii_filter_user_t*) g->user;
+
+    if (fclaw2d_clawpatch_output_filter_index(f->filter,domain,
+                                              blockno,patchno) >= 0)
+    {
+        fclaw2d_global_iterate_t s;
+        s.glob = g->glob;
+        s.user = &f->iframe;
+        f->cb(domain,patch,blockno,patchno,&s);
+    }
+}
+
+#endif
+
 void fclaw2d_clawpatch_output_ascii(fclaw2d_global_t* glob,int iframe)
 {
     fclaw2d_domain_t *domain = glob->domain;
     fclaw2d_clawpatch_vtable_t *clawpatch_vt = fclaw2d_clawpatch_vt(glob);
 
+#if PATCH_DIM == 2
+    /* The default routines are formatted in C and written by all ranks */
+    fclaw2d_clawpatch_ascii_frame_t *frame = 
+        fclaw2d_clawpatch_output_ascii_begin(glob,iframe);
+    if (frame != NULL)
+    {
+        fclaw2d_clawpatch_output_ascii_patches(glob,frame);
+        fclaw2d_clawpatch_output_ascii_end(glob,frame);
+        return;
+    }
+
+    ascii_filter_user_t f;
+    f.filter = fclaw2d_clawpatch_output_filter_get(glob,iframe);
+    f.cb = clawpatch_vt->cb_output_ascii;
+    f.iframe = iframe;
+#endif
+
     /* BEGIN NON-SCALABLE CODE */
     /* Write the file contents in serial.
        Use only for small numbers of processors. */
@@ -152,9 +215,432 @@ void fclaw2d_clawpatch_output_ascii(fclaw2d_global_t* glob,int iframe)
     }
 
     /* Write out each patch to fort.qXXXX */
-    fclaw2d_global_iterate_patches (glob, clawpatch_vt->cb_output_ascii, &iframe);
+#if PATCH_DIM == 2
+    if (f.filter != NULL)
+    {
+        fclaw2d_global_iterate_patches (glob, cb_ascii_filter, &f);
+    }
+    else
+#endif
+    {
+        fclaw2d_global_iterate_patches (glob, clawpatch_vt->cb_output_ascii, &iframe);
+    }
 
     fclaw2d_domain_serialization_leave (domain);
     /* END OF NON-SCALABLE CODE */
 }
 
+#if PATCH_DIM == 2
+
+/* --------------------------------------------------------------------
+   Patch by patch output, used by fclaw2d_clawpatch_output_frame.  The 
+   patches are formatted in C, as the Fortran routines above would write 
+   them, and each rank writes its part of fort.qXXXX at once.
+   -------------------------------------------------------------------- */
+
+struct fclaw2d_clawpatch_ascii_frame
+{
+    char filename[BUFSIZ];
+    const fclaw2d_clawpatch_output_filter_t *filter;
+    /* Formatted local patches, so that patches can be formatted in 
+       parallel */
+    int num_patches;
+    char **patch_buf;
+    size_t *patch_size;
+};
+
+int fclaw2d_clawpatch_output_ascii_fortran_e(char *s, double value,
+                                             int width, int digits)
+{
+    char body[64];
+    char exponent[8];
+    int e = 0;
+
+    FCLAW_ASSERT(0 < digits && digits < 32);
+
+    if (isnan(value))
+    {
+        return sprintf(s,"%*s",width,"NaN");
+    }
+    if (isinf(value))
+    {
+        return sprintf(s,"%*s",width,value < 0 ? "-Infinity" : "Infinity");
+    }
+
+    /* Mantissa 0.ddd...d, rounded to digits significant digits */
+    char *b = body;
+    if (value < 0)
+    {
+        *b++ = '-';
+    }
+    *b++ = '0';
+    *b++ = '.';
+    if (value == 0)
+    {
+        memset(b,'0',digits);
+    }
+    else
+    {
+        char c[64];
+        snprintf(c,64,"%.*e",digits-1,fabs(value));
+        b[0] = c[0];
+        memcpy(b + 1,c + 2,digits-1);
+        e = atoi(strchr(c,'e') + 1) + 1;
+    }
+    b += digits;
+
+    /* The 'E' is dropped for three digit exponents */
+    if (abs(e) <= 99)
+    {
+        snprintf(exponent,8,"E%c%02d",e < 0 ? '-' : '+',abs(e));
+    }
+    else
+    {
+        snprintf(exponent,8,"%c%03d",e < 0 ? '-' : '+',abs(e));
+    }
+    strcpy(b,exponent);
+
+    return sprintf(s,"%*s",width,body);
+}
+
+/* The formatted patches are only identical to the Fortran output for the
+   default routines */
+static
+int ascii_buffered(fclaw2d_global_t *glob)
+{
+    fclaw2d_clawpatch_vtable_t *clawpatch_vt = fclaw2d_clawpatch_vt(glob);
+
+    if (clawpatch_vt->cb_output_ascii != cb_clawpatch_output_ascii)
+    {
+        return 0;
+    }
+    if (clawpatch_vt->claw_version == 4)
+    {
+        return clawpatch_vt->fort_output_ascii == FCLAW2D_CLAWPATCH46_FORT_OUTPUT_ASCII;
+    }
+    if (clawpatch_vt->claw_version == 5)
+    {
+        return clawpatch_vt->fort_output_ascii == FCLAW2D_CLAWPATCH5_FORT_OUTPUT_ASCII;
+    }
+    return 0;
+}
+
+/* The time header of fclaw2d_clawpatch_time_header_ascii, written to the 
+   prefixed file name.  The Fortran routines only take fort.tXXXX. */
+static
+void ascii_write_time_header(fclaw2d_global_t *glob, int iframe)
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = 
+        fclaw2d_clawpatch_get_options(glob);
+
+    char fname[BUFSIZ];
+    snprintf(fname,BUFSIZ,"%s.t%04d",fclaw_opt->prefix,iframe);
+    FILE *file = fopen(fname,"w");
+    if (file == NULL)
+    {
+        fclaw_errorf("Could not write %s\n",fname);
+        return;
+    }
+
+    /* See fclaw2d_clawpatch46_fort_header_ascii */
+    char time[64];
+    fclaw2d_clawpatch_output_ascii_fortran_e(time,glob->curr_time,30,20);
+    fprintf(file,"%s    time\n",time);
+    fprintf(file,"%5d                 meqn\n",clawpatch_opt->meqn);
+    fprintf(file,"%5d                 ngrids\n",
+            (int) fclaw2d_clawpatch_output_filter_num_patches(glob,iframe));
+    fprintf(file,"%5d                 num_aux\n",clawpatch_opt->maux);
+    fprintf(file,"%5d                 num_dim\n",2);
+    fclose(file);
+}
+
+fclaw2d_clawpatch_ascii_frame_t*
+fclaw2d_clawpatch_output_ascii_begin(fclaw2d_global_t* glob, int iframe)
+{
+    if (!ascii_buffered(glob))
+    {
+        return NULL;
+    }
+
+    fclaw2d_clawpatch_vtable_t *clawpatch_vt = fclaw2d_clawpatch_vt(glob);
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+
+    /* Collective; the header needs the number of written patches */
+    const fclaw2d_clawpatch_output_filter_t *filter = 
+        fclaw2d_clawpatch_output_filter_get(glob,iframe);
+
+    fclaw2d_clawpatch_ascii_frame_t *frame = 
+        FCLAW_ALLOC_ZERO(fclaw2d_clawpatch_ascii_frame_t,1);
+    snprintf(frame->filename,BUFSIZ,"%s.q%04d",fclaw_opt->prefix,iframe);
+
+    if (glob->mpirank == 0)
+    {
+        if (clawpatch_vt->time_header_ascii == fclaw2d_clawpatch_time_header_ascii)
+        {
+            ascii_write_time_header(glob,iframe);
+        }
+        else
+        {
+            clawpatch_vt->time_header_ascii(glob,iframe);
+        }
+
+        /* Empty the data file, so that no bytes of an older, longer frame 
+           remain.  Ranks only write after the scan in 
+           fclaw2d_clawpatch_output_ascii_end, which waits for rank 0. */
+        FILE *file = fopen(frame->filename,"w");
+        if (file == NULL)
+        {
+            fclaw_errorf("Could not write %s\n",frame->filename);
+        }
+        else
+        {
+            fclose(file);
+        }
+    }
+    frame->filter = filter;
+    frame->num_patches = glob->domain->local_num_patches;
+    frame->patch_buf = FCLAW_ALLOC_ZERO(char*,frame->num_patches);
+    frame->patch_size = FCLAW_ALLOC_ZERO(size_t,frame->num_patches);
+    return frame;
+}
+
+void fclaw2d_clawpatch_output_ascii_patch(fclaw2d_global_t* glob,
+                                          fclaw2d_clawpatch_ascii_frame_t* frame,
+                                          fclaw2d_patch_t* patch,
+                                          int blockno, int patchno)
+{
+    if (fclaw2d_clawpatch_output_filter_index(frame->filter,glob->domain,
+                                              blockno,patchno) < 0)
+    {
+        return;
+    }
+
+    int global_num, local_num, level;
+    fclaw2d_patch_get_info(glob->domain,patch,
+                           blockno,patchno,
+                           &global_num,&local_num, &level);
+
+    int mx,my,mbc;
+    double xlower,ylower,dx,dy;
+    fclaw2d_clawpatch_grid_data(glob,patch,&mx,&my,&mbc,
+                                &xlower,&ylower,&dx,&dy);
+
+    fclaw2d_clawpatch_view_t v;
+    if (frame->filter != NULL)
+    {
+        /* Reduced cells, without ghost cells */
+        fclaw2d_clawpatch_output_filter_soln(glob,frame->filter,blockno,patchno,
+                                             &v,&dx,&dy);
+        level -= fclaw2d_clawpatch_output_filter_levels(frame->filter,glob->domain,
+                                                        blockno,patchno);
+        mx = v.mx;
+        my = v.my;
+        mbc = 0;
+    }
+    else
+    {
+        fclaw2d_clawpatch_soln_view(glob,patch,fclaw2d_clawpatch_soln_layout(glob),&v);
+    }
+
+    /* Header lines, and E26.16 values */
+    FCLAW_ASSERT(0 <= local_num && local_num < frame->num_patches);
+    FCLAW_ASSERT(frame->patch_buf[local_num] == NULL);
+    size_t bound = 1024 + (size_t) my*((size_t) mx*(26*v.meqn + 1) + 3);
+    /* Not FCLAW_ALLOC;  the allocation counters of libsc are not thread 
+       safe */
+    char *buf = (char*) malloc(bound);
+    SC_CHECK_ABORT(buf != NULL,"Could not allocate ascii patch buffer");
+    char *b = buf;
+
+    /* See fclaw2d_clawpatch46_fort_write_grid_header */
+    b += sprintf(b,"%5d                 grid_number\n",global_num);
+    b += sprintf(b,"%5d                 AMR_level\n",level);
+    b += sprintf(b,"%5d                 block_number\n",blockno);
+    b += sprintf(b,"%5d                 mpi_rank\n",glob->mpirank);
+    b += sprintf(b,"%5d                 mx\n",mx);
+    b += sprintf(b,"%5d                 my\n",my);
+    b += fclaw2d_clawpatch_output_ascii_fortran_e(b,xlower,24,16);
+    b += sprintf(b,"    xlow\n");
+    b += fclaw2d_clawpatch_output_ascii_fortran_e(b,ylower,24,16);
+    b += sprintf(b,"    ylow\n");
+    b += fclaw2d_clawpatch_output_ascii_fortran_e(b,dx,24,16);
+    b += sprintf(b,"    dx\n");
+    b += fclaw2d_clawpatch_output_ascii_fortran_e(b,dy,24,16);
+    b += sprintf(b,"    dy\n\n");
+
+    for(int j = 1; j <= my; j++)
+    {
+        for(int i = 1; i <= mx; i++)
+        {
+            const double *qij = v.q + (i-1+mbc)*v.stride_i + (j-1+mbc)*v.stride_j;
+            for(int m = 0; m < v.meqn; m++)
+            {
+                double value = qij[m*v.stride_m];
+                if (fabs(value) < 1e-99)
+                {
+                    value = 0;
+                }
+                b += fclaw2d_clawpatch_output_ascii_fortran_e(b,value,26,16);
+            }
+            *b++ = '\n';
+        }
+        /* list directed write of ' ' */
+        memcpy(b,"  \n",3);
+        b += 3;
+    }
+
+    if (frame->filter != NULL)
+    {
+        fclaw2d_clawpatch_output_filter_soln_release(&v);
+    }
+    else
+    {
+        fclaw2d_clawpatch_soln_view_release(glob,patch,&v,0);
+    }
+    frame->patch_buf[local_num] = buf;
+    frame->patch_size[local_num] = b - buf;
+}
+
+void fclaw2d_clawpatch_output_ascii_patches(fclaw2d_global_t* glob,
+                                            fclaw2d_clawpatch_ascii_frame_t* frame)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    const int n = domain->local_num_patches;
+    int *blocknos = FCLAW_ALLOC(int,n);
+    int *patchnos = FCLAW_ALLOC(int,n);
+    for(int blockno = 0; blockno < domain->num_blocks; blockno++)
+    {
+        fclaw2d_block_t *block = &domain->blocks[blockno];
+        for(int patchno = 0; patchno < block->num_patches; patchno++)
+        {
+            blocknos[block->num_patches_before + patchno] = blockno;
+            patchnos[block->num_patches_before + patchno] = patchno;
+        }
+    }
+
+    /* Filtered patches are reduced in buffers allocated with FCLAW_ALLOC, 
+       which is not thread safe, so only unfiltered frames are formatted 
+       in parallel */
+#pragma omp parallel for schedule(dynamic) if(frame->filter == NULL)
+    for(int k = 0; k < n; k++)
+    {
+        fclaw2d_block_t *block = &domain->blocks[blocknos[k]];
+        fclaw2d_clawpatch_output_ascii_patch(glob,frame,
+                                             &block->patches[patchnos[k]],
+                                             blocknos[k],patchnos[k]);
+    }
+
+    FCLAW_FREE(blocknos);
+    FCLAW_FREE(patchnos);
+}
+
+void fclaw2d_clawpatch_output_ascii_end(fclaw2d_global_t* glob,
+                                        fclaw2d_clawpatch_ascii_frame_t* frame)
+{
+    fclaw_async_writer_t *writer = fclaw2d_output_writer(glob);
+
+    size_t total = 0;
+    for(int k = 0; k < frame->num_patches; k++)
+    {
+        total += frame->patch_size[k];
+    }
+
+    /* The patches in order, in the buffer of the writer if there is one */
+    char *buf = NULL;
+    if (writer != NULL)
+    {
+        buf = total > 0 ? fclaw_async_writer_buffer(writer,total) : NULL;
+    }
+    else
+    {
+        buf = FCLAW_ALLOC(char,SC_MAX(total,1));
+    }
+    char *b = buf;
+    for(int k = 0; k < frame->num_patches; k++)
+    {
+        if (frame->patch_buf[k] != NULL)
+        {
+            memcpy(b,frame->patch_buf[k],frame->patch_size[k]);
+            b += frame->patch_size[k];
+            free(frame->patch_buf[k]);
+        }
+    }
+
+    /* Ranks write at offsets in rank order.  The scan also ensures that 
+       rank 0 has emptied the file in fclaw2d_clawpatch_output_ascii_begin 
+       before any other rank writes to it. */
+    long long size = (long long) total;
+    long long offset = 0;
+    int mpiret = sc_MPI_Exscan(&size, &offset, 1, sc_MPI_LONG_LONG_INT,
+                               sc_MPI_SUM, glob->mpicomm);
+    SC_CHECK_MPI(mpiret);
+    if (glob->mpirank == 0)
+    {
+        /* the result of the scan is undefined on rank 0 */
+        offset = 0;
+    }
+
+    if (writer != NULL)
+    {
+        if (total > 0)
+        {
+            fclaw_async_writer_write(writer,frame->filename,offset,
+                                     buf,total);
+        }
+    }
+    else
+    {
+#ifdef P4EST_ENABLE_MPIIO
+        /* One collective write, in pieces that fit the int count */
+        const long long chunk = INT_MAX;
+        long long nchunks = (size + chunk - 1)/chunk;
+        long long maxchunks;
+        mpiret = sc_MPI_Allreduce(&nchunks, &maxchunks, 1, sc_MPI_LONG_LONG_INT,
+                                  sc_MPI_MAX, glob->mpicomm);
+        SC_CHECK_MPI(mpiret);
+
+        MPI_File mpifile;
+        MPI_Status mpistatus;
+        mpiret = MPI_File_open(glob->mpicomm, frame->filename,
+                               MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                               MPI_INFO_NULL, &mpifile);
+        SC_CHECK_MPI(mpiret);
+        for(long long c = 0; c < maxchunks; c++)
+        {
+            const long long pos = SC_MIN(c*chunk,size);
+            const int count = (int) SC_MIN(chunk,size - pos);
+            mpiret = MPI_File_write_at_all(mpifile, (MPI_Offset) (offset + pos),
+                                           buf + pos, count, MPI_BYTE,
+                                           &mpistatus);
+            SC_CHECK_MPI(mpiret);
+        }
+        mpiret = MPI_File_close(&mpifile);
+        SC_CHECK_MPI(mpiret);
+#else
+        /* One append per rank, in rank order */
+        fclaw2d_domain_serialization_enter (glob->domain);
+        if (total > 0)
+        {
+            FILE *file = fopen(frame->filename,"ab");
+            if (file == NULL || 
+                fwrite(buf,total,1,file) != 1)
+            {
+                fclaw_errorf("Could not write %s\n",frame->filename);
+            }
+            if (file != NULL)
+            {
+                fclose(file);
+            }
+        }
+        fclaw2d_domain_serialization_leave (glob->domain);
+#endif
+        FCLAW_FREE(buf);
+    }
+
+    FCLAW_FREE(frame->patch_buf);
+    FCLAW_FREE(frame->patch_size);
+    FCLAW_FREE(frame);
+}
+
+#endif
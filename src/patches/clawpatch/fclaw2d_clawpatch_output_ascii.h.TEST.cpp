@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <test.hpp>
+#include <test/test.hpp>
+
+#include <fclaw2d_global.h>
+#include <fclaw2d_domain.h>
+#include <fclaw2d_forestclaw.h>
+#include <fclaw2d_options.h>
+#include <fclaw2d_patch.h>
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_clawpatch_options.h>
+#include <fclaw2d_clawpatch_output_ascii.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    std::string fortran_e(double value, int width, int digits)
+    {
+        char s[64];
+        int n = fclaw2d_clawpatch_output_ascii_fortran_e(s,value,width,digits);
+        CHECK(n == (int) std::string(s).size());
+        return s;
+    }
+
+    std::string read_file(const char* name)
+    {
+        std::ifstream file(name);
+        std::stringstream s;
+        s << file.rdbuf();
+        return s.str();
+    }
+
+    /* Four level one patches, written to files in the working directory */
+    struct AsciiFrame {
+        fclaw2d_global_t* glob;
+        fclaw_options_t fopts;
+        fclaw2d_domain_t *domain;
+        fclaw2d_clawpatch_options_t opts;
+
+        AsciiFrame(){
+            glob = fclaw2d_global_new();
+
+            fclaw2d_vtables_initialize(glob);
+            fclaw2d_clawpatch_vtable_initialize(glob, 4);
+
+            memset(&fopts, 0, sizeof(fopts));
+            fopts.mi = 1;
+            fopts.mj = 1;
+            fopts.minlevel = 1;
+            fopts.maxlevel = 1;
+            fopts.refratio = 2;
+            fopts.prefix = "fclaw2d_ascii_test";
+
+            domain = create_test_domain(sc_MPI_COMM_WORLD,&fopts);
+            fclaw2d_global_store_domain(glob, domain);
+            fclaw2d_options_store(glob, &fopts);
+
+            memset(&opts, 0, sizeof(opts));
+            opts.mx   = 2;
+            opts.my   = 2;
+            opts.mbc  = 2;
+            opts.meqn = 1;
+            opts.output_maxlevel = -1;
+            opts.output_stride = 1;
+            fclaw2d_clawpatch_options_store(glob, &opts);
+
+            fclaw2d_domain_data_new(glob->domain);
+
+            for(int i = 0; i < domain->blocks[0].num_patches; i++)
+            {
+                fclaw2d_build_mode_t build_mode = FCLAW2D_BUILD_FOR_UPDATE;
+                fclaw2d_patch_build(glob, &domain->blocks[0].patches[i], 0, i, &build_mode);
+
+                double *q;
+                int meqn;
+                fclaw2d_clawpatch_soln_data(glob, &domain->blocks[0].patches[i], &q, &meqn);
+                for(int k = 0; k < (opts.mx + 2*opts.mbc)*(opts.my + 2*opts.mbc); k++)
+                    q[k] = 1;
+            }
+        }
+        ~AsciiFrame(){
+            for(int i = 0; i < domain->blocks[0].num_patches; i++)
+            {
+                fclaw2d_patch_data_delete(glob, &domain->blocks[0].patches[i]);
+            }
+            fclaw2d_global_destroy(glob);
+        }
+    };
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_ascii_fortran_e matches E26.16")
+{
+    /* Reference strings written by gfortran */
+    CHECK(fortran_e(1.5,26,16) == "    0.1500000000000000E+01");
+    CHECK(fortran_e(-2.345678901234567891e-5,26,16) == "   -0.2345678901234568E-04");
+    CHECK(fortran_e(0.0,26,16) == "    0.0000000000000000E+00");
+    CHECK(fortran_e(1e-100,26,16) == "    0.1000000000000000E-99");
+    CHECK(fortran_e(1e200,26,16) == "    0.1000000000000000+201");
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_ascii_fortran_e header widths")
+{
+    CHECK(fortran_e(1.5,24,16) == "  0.1500000000000000E+01");
+    CHECK(fortran_e(3.0,30,20) == "    0.30000000000000000000E+01");
+    CHECK(fortran_e(0.999999999999999999,26,16) == "    0.1000000000000000E+01");
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_ascii_fortran_e has a fixed width")
+{
+    /* Values are padded to the field width, as Fortran writes them */
+    const double values[] = {-1.7976931348623157e308, -1e-300, -0.0,
+                             4.9e-324, 1e99, 1.0/0.0, -1.0/0.0, 0.0/0.0};
+    for(double value : values)
+    {
+        CHECK(fortran_e(value,26,16).size() == 26);
+    }
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_ascii_begin writes prefixed files and empties old data")
+{
+    AsciiFrame test;
+    test.glob->curr_time = 1.5;
+
+    /* A longer frame written before */
+    {
+        std::ofstream old("fclaw2d_ascii_test.q0002");
+        old << std::string(100000,'x');
+    }
+
+    fclaw2d_clawpatch_ascii_frame_t* frame = 
+        fclaw2d_clawpatch_output_ascii_begin(test.glob,2);
+    REQUIRE(frame != NULL);
+    fclaw2d_clawpatch_output_ascii_patches(test.glob,frame);
+    fclaw2d_clawpatch_output_ascii_end(test.glob,frame);
+
+    std::string t = read_file("fclaw2d_ascii_test.t0002");
+    CHECK(t == "    0.15000000000000000000E+01    time\n"
+               "    1                 meqn\n"
+               "    4                 ngrids\n"
+               "    0                 num_aux\n"
+               "    2                 num_dim\n");
+
+    std::string q = read_file("fclaw2d_ascii_test.q0002");
+    CHECK(q.find('x') == std::string::npos);
+    CHECK(q.compare(0,34,"    0                 grid_number\n") == 0);
+    CHECK(q.find("    3                 grid_number\n") != std::string::npos);
+
+    std::remove("fclaw2d_ascii_test.t0002");
+    std::remove("fclaw2d_ascii_test.q0002");
+}
@@ -0,0 +1,444 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw2d_clawpatch_output_filter.h>
+
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_clawpatch_options.h>
+
+#include <fclaw2d_global.h>
+#include <fclaw2d_options.h>
+#include <fclaw2d_patch.h>
+#include <fclaw_pointer_map.h>
+
+#include <math.h>
+
+#define OUTPUT_FILTER_NAME "fclaw2d_clawpatch_output_filter"
+
+/* True if the frame is filtered */
+static
+int filter_frame(const fclaw2d_clawpatch_options_t *clawpatch_opt, int iframe)
+{
+    if (clawpatch_opt->output_filter_interval > 0 &&
+        iframe % clawpatch_opt->output_filter_interval == 0)
+    {
+        /* full frame */
+        return 0;
+    }
+    return clawpatch_opt->output_box != NULL ||
+           clawpatch_opt->output_num_blocks > 0 ||
+           clawpatch_opt->output_maxlevel >= 0 ||
+           clawpatch_opt->output_stride > 1;
+}
+
+static
+int filter_select(fclaw2d_global_t *glob,
+                  const fclaw2d_clawpatch_options_t *clawpatch_opt,
+                  fclaw2d_patch_t *patch, int blockno)
+{
+    if (clawpatch_opt->output_num_blocks > 0)
+    {
+        int found = 0;
+        for(int k = 0; k < clawpatch_opt->output_num_blocks; k++)
+        {
+            found = found || clawpatch_opt->output_blocks[k] == blockno;
+        }
+        if (!found)
+        {
+            return 0;
+        }
+    }
+
+    if (clawpatch_opt->output_box != NULL)
+    {
+        const double *box = clawpatch_opt->output_box;
+        int mx,my,mbc;
+        double xlower,ylower,dx,dy;
+        fclaw2d_clawpatch_grid_data(glob,patch,&mx,&my,&mbc,
+                                    &xlower,&ylower,&dx,&dy);
+        if (xlower + mx*dx <= box[0] || xlower >= box[1] ||
+            ylower + my*dy <= box[2] || ylower >= box[3])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static
+void filter_destroy(void *value)
+{
+    fclaw2d_clawpatch_output_filter_t *filter = 
+        (fclaw2d_clawpatch_output_filter_t*) value;
+    FCLAW_FREE(filter->index);
+    FCLAW_FREE(filter->count);
+    FCLAW_FREE(filter);
+}
+
+/* Number of consecutive patches, starting at patchno, that are the local 
+   leaves of the same ancestor on level maxlevel.  Sets *complete if they 
+   cover the ancestor and can all be averaged down to it. */
+static
+int filter_family(const fclaw2d_clawpatch_options_t *clawpatch_opt,
+                  fclaw2d_block_t *block, int patchno, int maxlevel,
+                  int *complete)
+{
+    const double n = (double) (1 << maxlevel);
+    const fclaw2d_patch_t *first = &block->patches[patchno];
+    const double ax = floor(first->xlower*n);
+    const double ay = floor(first->ylower*n);
+
+    int count = 0;
+    double cover = 0;
+    int divides = 1;
+    for(int k = patchno; k < block->num_patches; k++)
+    {
+        const fclaw2d_patch_t *patch = &block->patches[k];
+        if (patch->level <= maxlevel ||
+            floor(patch->xlower*n) != ax || floor(patch->ylower*n) != ay)
+        {
+            break;
+        }
+        const int levels = patch->level - maxlevel;
+        cover += 1.0/(double) (1 << 2*levels);
+        divides = divides && clawpatch_opt->mx % (1 << levels) == 0 &&
+                             clawpatch_opt->my % (1 << levels) == 0;
+        count++;
+    }
+
+    /* Leaves of a subtree are consecutive, so the family is complete unless 
+       it is split between ranks */
+    *complete = divides && cover == 1.0;
+    return count;
+}
+
+fclaw2d_clawpatch_output_filter_t*
+fclaw2d_clawpatch_output_filter_get(fclaw2d_global_t* glob, int iframe)
+{
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+    fclaw2d_domain_t *domain = glob->domain;
+
+    if (!filter_frame(clawpatch_opt,iframe))
+    {
+        return NULL;
+    }
+
+    fclaw2d_clawpatch_output_filter_t *filter = (fclaw2d_clawpatch_output_filter_t*)
+        fclaw_pointer_map_get(glob->attributes,OUTPUT_FILTER_NAME);
+    if (filter != NULL && filter->iframe == iframe &&
+        filter->domain_revision == glob->domain_revision)
+    {
+        return filter;
+    }
+    if (filter == NULL)
+    {
+        filter = FCLAW_ALLOC_ZERO(fclaw2d_clawpatch_output_filter_t,1);
+        fclaw_pointer_map_insert(glob->attributes,OUTPUT_FILTER_NAME,filter,
+                                 filter_destroy);
+    }
+
+    filter->iframe = iframe;
+    filter->domain_revision = glob->domain_revision;
+    filter->stride = clawpatch_opt->output_stride;
+    filter->maxlevel = clawpatch_opt->output_maxlevel;
+    filter->index = FCLAW_REALLOC(filter->index,int,domain->local_num_patches);
+    filter->count = FCLAW_REALLOC(filter->count,int,domain->local_num_patches);
+
+    int n = 0;
+    for(int blockno = 0; blockno < domain->num_blocks; blockno++)
+    {
+        fclaw2d_block_t *block = &domain->blocks[blockno];
+        int patchno = 0;
+        while (patchno < block->num_patches)
+        {
+            const int local = block->num_patches_before + patchno;
+            int count = 1, complete = 0;
+            if (filter->maxlevel >= 0 && 
+                block->patches[patchno].level > filter->maxlevel)
+            {
+                count = filter_family(clawpatch_opt,block,patchno,
+                                      filter->maxlevel,&complete);
+            }
+
+            if (complete)
+            {
+                /* One patch on level maxlevel, written by the first leaf */
+                int selected = 0;
+                for(int k = 0; k < count; k++)
+                {
+                    selected = selected || 
+                        filter_select(glob,clawpatch_opt,
+                                      &block->patches[patchno + k],blockno);
+                    filter->index[local + k] = -1;
+                    filter->count[local + k] = 0;
+                }
+                filter->index[local] = selected ? n++ : -1;
+                filter->count[local] = count;
+            }
+            else
+            {
+                /* Families split between ranks are written at their own 
+                   level */
+                for(int k = 0; k < count; k++)
+                {
+                    filter->index[local + k] = 
+                        filter_select(glob,clawpatch_opt,
+                                      &block->patches[patchno + k],blockno) ?
+                        n++ : -1;
+                    filter->count[local + k] = 1;
+                }
+            }
+            patchno += count;
+        }
+    }
+    filter->local_num_patches = n;
+
+    /* Written patches of all ranks */
+    long count = (long) n;
+    long *counts = FCLAW_ALLOC(long,domain->mpisize);
+    int mpiret = sc_MPI_Allgather(&count, 1, sc_MPI_LONG, counts, 1,
+                                  sc_MPI_LONG, domain->mpicomm);
+    SC_CHECK_MPI(mpiret);
+    filter->global_num_patches = 0;
+    filter->global_num_patches_before = 0;
+    for(int p = 0; p < domain->mpisize; p++)
+    {
+        if (p < domain->mpirank)
+        {
+            filter->global_num_patches_before += counts[p];
+        }
+        filter->global_num_patches += counts[p];
+    }
+    FCLAW_FREE(counts);
+
+    return filter;
+}
+
+int64_t fclaw2d_clawpatch_output_filter_num_patches(fclaw2d_global_t* glob,
+                                                    int iframe)
+{
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+
+    if (filter_frame(clawpatch_opt,iframe))
+    {
+        const fclaw2d_clawpatch_output_filter_t *filter = 
+            (const fclaw2d_clawpatch_output_filter_t*)
+            fclaw_pointer_map_get(glob->attributes,OUTPUT_FILTER_NAME);
+        if (filter != NULL && filter->iframe == iframe &&
+            filter->domain_revision == glob->domain_revision)
+        {
+            return filter->global_num_patches;
+        }
+    }
+    return glob->domain->global_num_patches;
+}
+
+int fclaw2d_clawpatch_output_filter_index(const fclaw2d_clawpatch_output_filter_t* filter,
+                                          fclaw2d_domain_t* domain,
+                                          int blockno, int patchno)
+{
+    const int local = domain->blocks[blockno].num_patches_before + patchno;
+    return filter != NULL ? filter->index[local] : local;
+}
+
+int fclaw2d_clawpatch_output_filter_levels(const fclaw2d_clawpatch_output_filter_t* filter,
+                                           fclaw2d_domain_t* domain,
+                                           int blockno, int patchno)
+{
+    const int local = domain->blocks[blockno].num_patches_before + patchno;
+    if (filter == NULL || filter->count == NULL || filter->count[local] <= 1)
+    {
+        return 0;
+    }
+    return domain->blocks[blockno].patches[patchno].level - filter->maxlevel;
+}
+
+/* Average the solution of a patch down levels times and copy the averaged 
+   cells to a, an array of amx x amy cells in the IJM layout, starting at 
+   cell (oi,oj) */
+static
+void filter_average(fclaw2d_global_t* glob, fclaw2d_patch_t* patch, int levels,
+                    double *a, int amx, int amy, int oi, int oj)
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    fclaw2d_clawpatch_vtable_t *clawpatch_vt = fclaw2d_clawpatch_vt(glob);
+    const fclaw2d_clawpatch_layout_t layout = fclaw2d_clawpatch_soln_layout(glob);
+
+    fclaw2d_clawpatch_view_t v;
+    fclaw2d_clawpatch_soln_view(glob,patch,layout,&v);
+    int mx = v.mx;
+    int my = v.my;
+    int mbc = v.mbc;
+    int meqn = v.meqn;
+
+    /* The averaged cells are in the lower left corner of qfine */
+    fclaw2d_clawpatch_view_t src = v;
+    double *qfine = NULL, *qcoarse = NULL;
+    double *areafine = NULL, *areacoarse = NULL;
+    if (levels > 0)
+    {
+        const int size = fclaw2d_clawpatch_layout_size(layout,mx,my,mbc,meqn);
+        const int na = mx + 2*mbc + 2;
+        const int asize = na*(my + 2*mbc + 2);
+        const int igrid = 0;
+        int nx = mx, ny = my;
+
+        qfine = FCLAW_ALLOC(double,size);
+        qcoarse = FCLAW_ALLOC_ZERO(double,size);
+        memcpy(qfine,v.q,size*sizeof(double));
+        if (fclaw_opt->manifold)
+        {
+            areafine = FCLAW_ALLOC(double,asize);
+            areacoarse = FCLAW_ALLOC(double,asize);
+            memcpy(areafine,fclaw2d_clawpatch_get_area(glob,patch),
+                   asize*sizeof(double));
+        }
+
+        for(int l = 0; l < levels; l++)
+        {
+            nx /= 2;
+            ny /= 2;
+            if (fclaw_opt->manifold)
+            {
+                /* Coarse cells not computed are never divided by zero */
+                for(int k = 0; k < asize; k++)
+                {
+                    areacoarse[k] = 1;
+                }
+                for(int j = 1; j <= ny; j++)
+                {
+                    for(int i = 1; i <= nx; i++)
+                    {
+                        const double *af = &areafine[(2*i - 1 + mbc) + (2*j - 1 + mbc)*na];
+                        areacoarse[(i + mbc) + (j + mbc)*na] = 
+                            af[0] + af[1] + af[na] + af[na + 1];
+                    }
+                }
+            }
+            clawpatch_vt->fort_average2coarse(&mx,&my,&mbc,&meqn,qcoarse,qfine,
+                                              areacoarse,areafine,&igrid,
+                                              &fclaw_opt->manifold);
+            double *t = qfine;
+            qfine = qcoarse;
+            qcoarse = t;
+            t = areafine;
+            areafine = areacoarse;
+            areacoarse = t;
+        }
+        fclaw2d_clawpatch_layout_view_init(layout,mx,my,mbc,meqn,qfine,&src);
+    }
+
+    const int nx = mx >> levels;
+    const int ny = my >> levels;
+    for(int m = 0; m < meqn; m++)
+    {
+        for(int j = 0; j < ny; j++)
+        {
+            for(int i = 0; i < nx; i++)
+            {
+                a[(oi + i) + (oj + j)*amx + m*amx*amy] = 
+                    src.q[(i + mbc)*src.stride_i + (j + mbc)*src.stride_j + 
+                          m*src.stride_m];
+            }
+        }
+    }
+
+    FCLAW_FREE(qfine);
+    FCLAW_FREE(qcoarse);
+    FCLAW_FREE(areafine);
+    FCLAW_FREE(areacoarse);
+    fclaw2d_clawpatch_soln_view_release(glob,patch,&v,0);
+}
+
+void fclaw2d_clawpatch_output_filter_soln(fclaw2d_global_t* glob,
+                                          const fclaw2d_clawpatch_output_filter_t* filter,
+                                          int blockno, int patchno,
+                                          fclaw2d_clawpatch_view_t* view,
+                                          double* dx, double* dy)
+{
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+    fclaw2d_domain_t *domain = glob->domain;
+    fclaw2d_block_t *block = &domain->blocks[blockno];
+    fclaw2d_patch_t *patch = &block->patches[patchno];
+
+    const int mx = clawpatch_opt->mx;
+    const int my = clawpatch_opt->my;
+    const int meqn = clawpatch_opt->meqn;
+    const int stride = filter->stride;
+    const int levels = fclaw2d_clawpatch_output_filter_levels(filter,domain,
+                                                              blockno,patchno);
+
+    /* The cells of the patch, or of its ancestor on level maxlevel */
+    double *a = FCLAW_ALLOC(double,mx*my*meqn);
+    if (levels > 0)
+    {
+        const int local = block->num_patches_before + patchno;
+        const double n = (double) mx*(1 << filter->maxlevel);
+        for(int k = 0; k < filter->count[local]; k++)
+        {
+            /* The first leaf is in the lower left corner of the ancestor */
+            fclaw2d_patch_t *leaf = patch + k;
+            const int oi = (int) floor((leaf->xlower - patch->xlower)*n + 0.5);
+            const int oj = (int) floor((leaf->ylower - patch->ylower)*n + 0.5);
+            filter_average(glob,leaf,leaf->level - filter->maxlevel,
+                           a,mx,my,oi,oj);
+        }
+    }
+    else
+    {
+        filter_average(glob,patch,0,a,mx,my,0,0);
+    }
+
+    /* Every stride-th cell, from the middle of each group of cells */
+    const int nx = mx/stride;
+    const int ny = my/stride;
+    const int offset = (stride - 1)/2;
+    double *q = FCLAW_ALLOC(double,nx*ny*meqn);
+    fclaw2d_clawpatch_layout_view_init(FCLAW2D_CLAWPATCH_LAYOUT_IJM,
+                                       nx,ny,0,meqn,q,view);
+    for(int m = 0; m < meqn; m++)
+    {
+        for(int j = 0; j < ny; j++)
+        {
+            for(int i = 0; i < nx; i++)
+            {
+                const int is = i*stride + offset;
+                const int js = j*stride + offset;
+                view->q[i*view->stride_i + j*view->stride_j + m*view->stride_m] = 
+                    a[is + js*mx + m*mx*my];
+            }
+        }
+    }
+    *dx *= stride << levels;
+    *dy *= stride << levels;
+
+    FCLAW_FREE(a);
+}
+
+void fclaw2d_clawpatch_output_filter_soln_release(fclaw2d_clawpatch_view_t* view)
+{
+    FCLAW_FREE(view->q);
+    view->q = NULL;
+}
@@ -0,0 +1,159 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FCLAW2D_CLAWPATCH_OUTPUT_FILTER_H
+#define FCLAW2D_CLAWPATCH_OUTPUT_FILTER_H
+
+#include <fclaw2d_clawpatch_layout.h>
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Filters for small preview frames.
+ *
+ * A filtered frame contains only the patches that intersect output-box and 
+ * lie in output-blocks.  Patches finer than output-maxlevel are averaged 
+ * down to that level with the average2coarse kernel and written as one 
+ * patch per family, unless the family is split between ranks.  Only every 
+ * output-stride-th cell is written, so each written patch has mx/stride 
+ * by my/stride cells.  Frames that are a multiple of output-filter-interval 
+ * are written in full.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if 0
+/* Fix syntax highlighting */
+#endif
+
+struct fclaw2d_global;
+struct fclaw2d_domain;
+struct fclaw2d_patch;
+
+/**
+ * @brief The patches and resolution of a filtered frame
+ */
+typedef struct fclaw2d_clawpatch_output_filter
+{
+    int iframe;               /**< the frame the filter was computed for */
+    int domain_revision;      /**< the domain the filter was computed for */
+    int stride;               /**< every stride-th cell is written */
+    int maxlevel;             /**< finer patches are averaged, or -1 */
+    int *index;               /**< for each local patch, its position among 
+                                   the written local patches, or -1 */
+    int *count;               /**< for each written local patch, the number 
+                                   of consecutive local patches averaged into 
+                                   it;  more than one for the first leaf of a 
+                                   family written on level maxlevel */
+    int local_num_patches;    /**< written patches on this rank */
+    int64_t global_num_patches;         /**< written patches on all ranks */
+    int64_t global_num_patches_before;  /**< written patches on lower ranks */
+} fclaw2d_clawpatch_output_filter_t;
+
+/**
+ * @brief Get the filter of a frame
+ *
+ * The filter is kept in the global attributes and only recomputed for a 
+ * new frame or domain.  Collective.
+ *
+ * @param glob the global context
+ * @param iframe the frame index
+ * @return the filter, or NULL if the frame is written in full
+ */
+fclaw2d_clawpatch_output_filter_t*
+fclaw2d_clawpatch_output_filter_get(struct fclaw2d_global* glob, int iframe);
+
+/**
+ * @brief Number of patches written in a frame
+ *
+ * Uses the filter computed by ::fclaw2d_clawpatch_output_filter_get.  
+ * Not collective.
+ *
+ * @param glob the global context
+ * @param iframe the frame index
+ * @return the number of patches in the frame on all ranks
+ */
+int64_t fclaw2d_clawpatch_output_filter_num_patches(struct fclaw2d_global* glob,
+                                                    int iframe);
+
+/**
+ * @brief Position of a patch among the written local patches
+ *
+ * @param filter the filter, or NULL to write all patches
+ * @param domain the domain
+ * @param blockno, patchno the patch
+ * @return the position, or -1 if the patch is not written
+ */
+int fclaw2d_clawpatch_output_filter_index(const fclaw2d_clawpatch_output_filter_t* filter,
+                                          struct fclaw2d_domain* domain,
+                                          int blockno, int patchno);
+
+/**
+ * @brief Number of levels a written patch is coarser than the patch
+ *
+ * The first leaf of a family is written as its ancestor on level maxlevel.  
+ * That patch has the same lower left corner as the leaf.
+ *
+ * @param filter the filter, or NULL to write all patches
+ * @param domain the domain
+ * @param blockno, patchno a written patch
+ * @return the level of the patch minus the level it is written on
+ */
+int fclaw2d_clawpatch_output_filter_levels(const fclaw2d_clawpatch_output_filter_t* filter,
+                                           struct fclaw2d_domain* domain,
+                                           int blockno, int patchno);
+
+/**
+ * @brief The solution of a patch as it is written
+ *
+ * @param[in] glob the global context
+ * @param[in] filter the filter
+ * @param[in] blockno, patchno a written patch
+ * @param[out] view the mx/stride by my/stride written cells in the 
+ *             ::FCLAW2D_CLAWPATCH_LAYOUT_IJM layout without ghost cells.  
+ *             Release it with ::fclaw2d_clawpatch_output_filter_soln_release.
+ * @param[in,out] dx, dy the cell size of the patch, scaled to the cell size 
+ *             of the view
+ */
+void fclaw2d_clawpatch_output_filter_soln(struct fclaw2d_global* glob,
+                                          const fclaw2d_clawpatch_output_filter_t* filter,
+                                          int blockno, int patchno,
+                                          fclaw2d_clawpatch_view_t* view,
+                                          double* dx, double* dy);
+
+/**
+ * @brief Release the view of ::fclaw2d_clawpatch_output_filter_soln
+ */
+void fclaw2d_clawpatch_output_filter_soln_release(fclaw2d_clawpatch_view_t* view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
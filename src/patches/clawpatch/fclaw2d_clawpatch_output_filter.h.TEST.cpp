@@ -0,0 +1,242 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw2d_global.h>
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_clawpatch_options.h>
+#include <fclaw2d_clawpatch_output_filter.h>
+#include <fclaw2d_domain.h>
+#include <fclaw2d_forestclaw.h>
+#include <fclaw2d_options.h>
+#include <fclaw2d_patch.h>
+#include <test.hpp>
+#include <test/test.hpp>
+#include <cstring>
+
+namespace{
+/* The four level one patches of a block, with q = I + 10 J + 100 m in the 
+   interior cells, where (I,J) is the cell index on level one */
+struct FilterPatch {
+	fclaw2d_global_t* glob;
+	fclaw_options_t fopts;
+	fclaw2d_domain_t *domain;
+	fclaw2d_clawpatch_options_t opts;
+	fclaw2d_patch_t* patch;
+
+	FilterPatch(){
+		glob = fclaw2d_global_new();
+
+		fclaw2d_vtables_initialize(glob);
+		fclaw2d_clawpatch_vtable_initialize(glob, 4);
+
+		memset(&fopts, 0, sizeof(fopts));
+		fopts.mi = 1;
+		fopts.mj = 1;
+		fopts.minlevel = 1;
+		fopts.maxlevel = 1;
+		fopts.refratio = 2;
+
+		domain = create_test_domain(sc_MPI_COMM_WORLD,&fopts);
+		fclaw2d_global_store_domain(glob, domain);
+		fclaw2d_options_store(glob, &fopts);
+
+		memset(&opts, 0, sizeof(opts));
+		opts.mx   = 8;
+		opts.my   = 8;
+		opts.mbc  = 2;
+		opts.meqn = 2;
+		opts.output_maxlevel = -1;
+		opts.output_stride = 1;
+		fclaw2d_clawpatch_options_store(glob, &opts);
+
+		fclaw2d_domain_data_new(glob->domain);
+
+		patch = &domain->blocks[0].patches[0];
+		for(int patchno = 0; patchno < domain->blocks[0].num_patches; patchno++)
+		{
+			fclaw2d_patch_t* leaf = &domain->blocks[0].patches[patchno];
+			fclaw2d_build_mode_t build_mode = FCLAW2D_BUILD_FOR_UPDATE;
+			fclaw2d_patch_build(glob, leaf, 0, patchno, &build_mode);
+
+			double *q;
+			int meqn;
+			fclaw2d_clawpatch_soln_data(glob, leaf, &q, &meqn);
+			int mx = opts.mx, my = opts.my, mbc = opts.mbc;
+			int n = (mx + 2*mbc)*(my + 2*mbc);
+			int oi = (int) (leaf->xlower*2*mx + 0.5);
+			int oj = (int) (leaf->ylower*2*my + 0.5);
+			for(int k = 0; k < n*meqn; k++)
+				q[k] = -1;
+			for(int m = 0; m < meqn; m++)
+				for(int j = 0; j < my; j++)
+					for(int i = 0; i < mx; i++)
+						q[(i + mbc) + (j + mbc)*(mx + 2*mbc) + m*n] = 
+							(oi + i) + 10*(oj + j) + 100*m;
+		}
+	}
+	~FilterPatch(){
+		for(int patchno = 0; patchno < domain->blocks[0].num_patches; patchno++)
+			fclaw2d_patch_data_delete(glob, &domain->blocks[0].patches[patchno]);
+		fclaw2d_global_destroy(glob);
+	}
+};
+
+/* The value of cell (i,j,m) of a view */
+double view_value(const fclaw2d_clawpatch_view_t& v, int i, int j, int m)
+{
+	return v.q[i*v.stride_i + j*v.stride_j + m*v.stride_m];
+}
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_filter_get is NULL without filter options")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_clawpatch_options_t* opts = FCLAW_ALLOC_ZERO(fclaw2d_clawpatch_options_t,1);
+	opts->output_maxlevel = -1;
+	opts->output_stride = 1;
+	fclaw2d_clawpatch_options_store(glob, opts);
+
+	for(int iframe = 0; iframe < 4; iframe++)
+	{
+		CHECK(fclaw2d_clawpatch_output_filter_get(glob, iframe) == NULL);
+	}
+
+	fclaw2d_global_destroy(glob);
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_filter_get is NULL for full frames")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_clawpatch_options_t* opts = FCLAW_ALLOC_ZERO(fclaw2d_clawpatch_options_t,1);
+	opts->output_maxlevel = -1;
+	opts->output_stride = 2;
+	opts->output_filter_interval = 5;
+	fclaw2d_clawpatch_options_store(glob, opts);
+
+	CHECK(fclaw2d_clawpatch_output_filter_get(glob, 0) == NULL);
+	CHECK(fclaw2d_clawpatch_output_filter_get(glob, 5) == NULL);
+	CHECK(fclaw2d_clawpatch_output_filter_get(glob, 10) == NULL);
+
+	fclaw2d_global_destroy(glob);
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_filter_index without a filter")
+{
+	fclaw2d_block_t blocks[2];
+	blocks[0].num_patches_before = 0;
+	blocks[1].num_patches_before = 3;
+	fclaw2d_domain_t domain;
+	domain.blocks = blocks;
+
+	CHECK_EQ(fclaw2d_clawpatch_output_filter_index(NULL, &domain, 0, 2), 2);
+	CHECK_EQ(fclaw2d_clawpatch_output_filter_index(NULL, &domain, 1, 1), 4);
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_filter_index with a filter")
+{
+	fclaw2d_block_t blocks[1];
+	blocks[0].num_patches_before = 0;
+	fclaw2d_domain_t domain;
+	domain.blocks = blocks;
+
+	int index[3] = {-1, 0, 1};
+	fclaw2d_clawpatch_output_filter_t filter;
+	filter.index = index;
+
+	CHECK_EQ(fclaw2d_clawpatch_output_filter_index(&filter, &domain, 0, 0), -1);
+	CHECK_EQ(fclaw2d_clawpatch_output_filter_index(&filter, &domain, 0, 2), 1);
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_filter_soln writes a family as one patch")
+{
+	FilterPatch p;
+	p.opts.output_maxlevel = 0;
+
+	fclaw2d_clawpatch_output_filter_t* filter = 
+		fclaw2d_clawpatch_output_filter_get(p.glob, 1);
+	REQUIRE(filter != NULL);
+
+	CHECK_EQ(filter->local_num_patches, 1);
+	CHECK_EQ(filter->global_num_patches, 1);
+	CHECK_EQ(filter->index[0], 0);
+	CHECK_EQ(filter->count[0], 4);
+	for(int patchno = 1; patchno < 4; patchno++)
+	{
+		CHECK_EQ(filter->index[patchno], -1);
+		CHECK_EQ(filter->count[patchno], 0);
+	}
+	CHECK_EQ(fclaw2d_clawpatch_output_filter_levels(filter, p.domain, 0, 0), 1);
+
+	fclaw2d_clawpatch_view_t v;
+	double dx = 0.0625, dy = 0.0625;
+	fclaw2d_clawpatch_output_filter_soln(p.glob, filter, 0, 0, &v, &dx, &dy);
+
+	CHECK_EQ(v.mx, 8);
+	CHECK_EQ(v.my, 8);
+	CHECK_EQ(v.mbc, 0);
+	CHECK_EQ(dx, 0.125);
+	CHECK_EQ(dy, 0.125);
+
+	/* Each coarse cell is the average of a 2x2 group of fine cells */
+	for(int m = 0; m < 2; m++)
+		for(int j = 0; j < 8; j++)
+			for(int i = 0; i < 8; i++)
+				CHECK_EQ(view_value(v, i, j, m), 
+				         doctest::Approx((2*i + 0.5) + 10*(2*j + 0.5) + 100*m));
+
+	fclaw2d_clawpatch_output_filter_soln_release(&v);
+	CHECK(v.q == NULL);
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_filter_soln writes every stride-th cell")
+{
+	FilterPatch p;
+	p.opts.output_stride = 2;
+
+	fclaw2d_clawpatch_output_filter_t* filter = 
+		fclaw2d_clawpatch_output_filter_get(p.glob, 1);
+	REQUIRE(filter != NULL);
+
+	CHECK_EQ(filter->local_num_patches, 4);
+	CHECK_EQ(fclaw2d_clawpatch_output_filter_levels(filter, p.domain, 0, 0), 0);
+
+	fclaw2d_clawpatch_view_t v;
+	double dx = 0.0625, dy = 0.0625;
+	fclaw2d_clawpatch_output_filter_soln(p.glob, filter, 0, 0, &v, &dx, &dy);
+
+	CHECK_EQ(v.mx, 4);
+	CHECK_EQ(v.my, 4);
+	CHECK_EQ(dx, 0.125);
+	CHECK_EQ(dy, 0.125);
+
+	for(int m = 0; m < 2; m++)
+		for(int j = 0; j < 4; j++)
+			for(int i = 0; i < 4; i++)
+				CHECK_EQ(view_value(v, i, j, m), 2*i + 20*j + 100*m);
+
+	fclaw2d_clawpatch_output_filter_soln_release(&v);
+}
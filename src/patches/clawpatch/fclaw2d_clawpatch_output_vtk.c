@@ -39,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_clawpatch_options.h>
 
 #define PATCH_CHILDREN 4
+#define VTK_GEOMETRY_NAME "fclaw2d_vtk_geometry"
 
 #elif REFINE_DIM == 2 && PATCH_DIM == 3
 
@@ -50,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <_fclaw2d_to_fclaw3dx.h>
 
 #define PATCH_CHILDREN 8
+#define VTK_GEOMETRY_NAME "fclaw3dx_vtk_geometry"
 
 #else
 #error "This combination of REFINE_DIM and PATCH_DIM is unsupported"
@@ -58,7 +60,52 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_global.h>
 
 #include <fclaw2d_options.h>
+#include <fclaw2d_output.h>
 #include <fclaw2d_map.h>
+#include <fclaw_async_writer.h>
+#include <fclaw_pointer_map.h>
+
+#include <fclaw2d_clawpatch_output_filter.h>
+
+#if PATCH_DIM == 2
+#include <fclaw2d_clawpatch_output_vtk_amr.h>
+#endif
+
+#ifdef SC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <limits.h>
+
+/* Mesh arrays that do not change between frames */
+enum
+{
+    VTK_POSITION = 0,
+    VTK_CONNECTIVITY,
+    VTK_OFFSETS,
+    VTK_TYPES,
+    VTK_MPIRANK,
+    VTK_BLOCKNO,
+    VTK_PATCHNO,
+    VTK_GEOMETRY_FIELDS
+};
+
+/* The solution follows the mesh arrays */
+#define VTK_MEQN VTK_GEOMETRY_FIELDS
+#define VTK_FIELDS (VTK_GEOMETRY_FIELDS + 1)
+
+/* Mesh arrays of all local patches, kept in glob->attributes with 
+   vtk-cache-geometry and rebuilt when the domain changes */
+typedef struct fclaw2d_vtk_geometry
+{
+    int domain_revision;
+    int mx, my;
+#if PATCH_DIM == 3
+    int mz;
+#endif
+    char *field[VTK_GEOMETRY_FIELDS];
+}
+fclaw2d_vtk_geometry_t;
 
 typedef struct fclaw2d_vtk_state
 {
@@ -83,8 +130,21 @@ typedef struct fclaw2d_vtk_state
     int64_t offset_meqn, psize_meqn;
     int64_t offset_end;
     const char *inttype;
+    int compress;       /* write each patch as one zlib block */
+    int mantissa_bits;  /* mantissa bits kept in the solution */
+    char *zdata[VTK_FIELDS];        /* compressed blocks of the local patches */
+    uint64_t *zsize[VTK_FIELDS];    /* compressed size of each block */
+    int64_t zlocal[VTK_FIELDS];     /* compressed bytes on this rank */
+    int64_t zbefore[VTK_FIELDS];    /* compressed bytes on lower ranks */
+    int filling;        /* write_buffer only advances buf, to fill a cache */
+    fclaw_async_writer_t *writer;   /* stage data instead of writing it */
+    int64_t header_size;            /* bytes before the appended data */
     fclaw2d_vtk_patch_data_t coordinate_cb;
     fclaw2d_vtk_patch_data_t value_cb;
+    const fclaw2d_clawpatch_output_filter_t *filter;  /* or NULL */
+    fclaw2d_patch_callback_t filter_cb;     /* called for written patches */
+    int64_t gnum, gbefore;  /* written patches, on all and on lower ranks */
+    int lnum;               /* written patches on this rank */
     FILE *file;
 #ifdef P4EST_ENABLE_MPIIO
     MPI_File mpifile;
@@ -115,7 +175,8 @@ fclaw2d_vtk_write_header (fclaw2d_domain_t * domain, fclaw2d_vtk_state_t * s)
                                 "version=\"0.1\" "
                                 "byte_order=\"LittleEndian\" "
                                 "header_type=\"UInt64\" "
-                                ">\n") < 0;
+                                "%s>\n", s->compress ?
+                                "compressor=\"vtkZLibDataCompressor\" " : "") < 0;
     retval = retval || fprintf (file, " <UnstructuredGrid>\n") < 0;
     retval = retval || fprintf (file, "  <Piece NumberOfPoints=\"%lld\" "
                                 "NumberOfCells=\"%lld\">\n",
@@ -185,10 +246,23 @@ fclaw2d_vtk_write_header (fclaw2d_domain_t * domain, fclaw2d_vtk_state_t * s)
     retval = retval || fprintf (file, " <AppendedData "
                                 "encoding=\"raw\">\n  _") < 0;
 
+    if (s->writer != NULL || s->compress)
+    {
+        /* data is written at offsets from the end of the header */
+        s->header_size = (int64_t) ftell (file);
+        retval = retval || s->header_size < 0;
+    }
+
 #ifdef P4EST_ENABLE_MPIIO
     /* unconditionally close the file when in MPI I/O mode */
     retval = fclose (file) || retval;
     s->file = NULL;
+#else
+    if (s->writer != NULL)
+    {
+        retval = fclose (file) || retval;
+        s->file = NULL;
+    }
 #endif
 
     return retval ? -1 : 0;
@@ -206,16 +280,155 @@ write_buffer (fclaw2d_vtk_state_t * s, int64_t psize_field)
 #ifndef P4EST_ENABLE_MPIIO
     size_t retvalz;
 
+    if (s->filling)
+    {
+        s->buf += psize_field;
+        return;
+    }
     retvalz = fwrite (s->buf, psize_field, 1, s->file);
     SC_CHECK_ABORT (retvalz == 1, "VTK file write failed");
 #else
+    const int64_t chunk = INT_MAX;
+    int64_t done;
     int mpiret;
     MPI_Status mpistatus;
 
-    mpiret = MPI_File_write (s->mpifile, s->buf, psize_field, MPI_BYTE,
-                             &mpistatus);
-    SC_CHECK_MPI (mpiret);
+    if (s->filling)
+    {
+        s->buf += psize_field;
+        return;
+    }
+    /* in pieces that fit the int count */
+    for (done = 0; done < psize_field; done += chunk)
+    {
+        const int count = (int) SC_MIN (chunk, psize_field - done);
+        mpiret = MPI_File_write (s->mpifile, s->buf + done, count, MPI_BYTE,
+                                 &mpistatus);
+        SC_CHECK_MPI (mpiret);
+    }
+#endif
+}
+
+#if PATCH_DIM == 2
+/* Point coordinates of a patch, with every stride-th point.  A patch written 
+   as its ancestor levels levels coarser covers the ancestor. */
+static void
+vtk_patch_coordinates (fclaw2d_global_t * glob, fclaw2d_patch_t * patch,
+                       int blockno, int stride, int levels, char *a)
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+
+    int mx,my,mbc;
+    double xlower,ylower,dx,dy;
+    fclaw2d_clawpatch_grid_data(glob,patch,&mx,&my,&mbc,
+                                &xlower,&ylower,&dx,&dy);
+    mx /= stride;
+    my /= stride;
+    dx *= stride << levels;
+    dy *= stride << levels;
+
+    /* Enumerate point coordinates in the patch */
+    double *d = (double *) a;
+
+    int i, j;
+    if (fclaw_opt->manifold)
+    {
+        /* Map one row of points at a time */
+        fclaw2d_map_context_t *cont = glob->cont;
+        const int n = mx + 1;
+        double *xc = FCLAW_ALLOC(double,5*n);
+        double *yc = xc + n;
+        double *xpp = yc + n;
+        double *ypp = xpp + n;
+        double *zpp = ypp + n;
+        for (j = 0; j <= my; ++j)
+        {
+            for (i = 0; i <= mx; ++i)
+            {
+                xc[i] = xlower + i * dx;
+                yc[i] = ylower + j * dy;
+            }
+            fclaw2d_map_c2m_batch(cont,blockno,n,xc,yc,xpp,ypp,zpp);
+            for (i = 0; i <= mx; ++i)
+            {
+                *d++ = xpp[i];
+                *d++ = ypp[i];
+                *d++ = zpp[i];
+            }
+        }
+        FCLAW_FREE(xc);
+    }
+    else
+    {
+        for (j = 0; j <= my; ++j)
+        {
+            const double y = ylower + j * dy;
+            for (i = 0; i <= mx; ++i)
+            {
+                const double x = xlower + i * dx;
+                *d++ = x;
+                *d++ = y;
+                *d++ = 0;
+            }
+        }
+    }
+}
+
+/* Cell values of a filtered patch */
+static void
+vtk_filter_values (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
+                   int blockno, int patchno, char *a)
+{
+    fclaw2d_clawpatch_view_t v;
+    double dx = 1, dy = 1;
+    int i, j, k;
+
+    fclaw2d_clawpatch_output_filter_soln (glob, s->filter, blockno, patchno,
+                                          &v, &dx, &dy);
+    FCLAW_ASSERT (v.mx == s->mx && v.my == s->my);
+
+    float *f = (float *) a;
+    for (j = 0; j < s->my; ++j)
+    {
+        for (i = 0; i < s->mx; ++i)
+        {
+            const double *q = v.q + i * v.stride_i + j * v.stride_j;
+            for (k = 0; k < s->meqn; ++k)
+            {
+                *f++ = (float) q[k * v.stride_m];
+            }
+        }
+    }
+    fclaw2d_clawpatch_output_filter_soln_release (&v);
+}
 #endif
+
+/* Iterate over the patches written by the filter */
+static void
+vtk_filter_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
+               int blockno, int patchno, void *user)
+{
+    fclaw2d_global_iterate_t *g = (fclaw2d_global_iterate_t*) user;
+    fclaw2d_vtk_state_t *s = (fclaw2d_vtk_state_t *) g->user;
+
+    if (fclaw2d_clawpatch_output_filter_index (s->filter, domain,
+                                               blockno, patchno) >= 0)
+    {
+        s->filter_cb (domain, patch, blockno, patchno, user);
+    }
+}
+
+static void
+vtk_iterate_patches (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
+                     fclaw2d_patch_callback_t cb)
+{
+    if (s->filter == NULL)
+    {
+        fclaw2d_global_iterate_patches (glob, cb, s);
+        return;
+    }
+    s->filter_cb = cb;
+    fclaw2d_global_iterate_patches (glob, vtk_filter_cb, s);
 }
 
 static void
@@ -225,7 +438,19 @@ write_position_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
     fclaw2d_global_iterate_t *g = (fclaw2d_global_iterate_t*) user;
     fclaw2d_vtk_state_t *s = (fclaw2d_vtk_state_t *) g->user;
 
-    s->coordinate_cb (g->glob, patch, blockno, patchno, s->buf);
+#if PATCH_DIM == 2
+    if (s->filter != NULL)
+    {
+        vtk_patch_coordinates (g->glob, patch, blockno, s->filter->stride,
+                               fclaw2d_clawpatch_output_filter_levels
+                               (s->filter, domain, blockno, patchno),
+                               s->buf);
+    }
+    else
+#endif
+    {
+        s->coordinate_cb (g->glob, patch, blockno, patchno, s->buf);
+    }
     write_buffer (s, s->psize_position);
 }
 
@@ -237,8 +462,9 @@ write_connectivity_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
     fclaw2d_vtk_state_t *s = (fclaw2d_vtk_state_t *) g->user;
     int i, j;
     const int64_t pbefore = s->points_per_patch *
-        (domain->global_num_patches_before +
-         domain->blocks[blockno].num_patches_before + patchno);
+        (s->gbefore +
+         fclaw2d_clawpatch_output_filter_index (s->filter, domain,
+                                                blockno, patchno));
 
     if (s->fits32)
     {
@@ -333,8 +559,9 @@ write_offsets_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
     fclaw2d_vtk_state_t *s = (fclaw2d_vtk_state_t *) g->user;
     int c;
     const int64_t cbefore = s->cells_per_patch *
-        (domain->global_num_patches_before +
-         domain->blocks[blockno].num_patches_before + patchno);
+        (s->gbefore +
+         fclaw2d_clawpatch_output_filter_index (s->filter, domain,
+                                                blockno, patchno));
 
     if (s->fits32)
     {
@@ -440,6 +667,35 @@ write_patchno_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
     write_buffer (s, s->psize_patchno);
 }
 
+void
+fclaw2d_vtk_round_mantissa (float *f, int64_t n, int bits)
+{
+    const uint32_t drop = bits < 23 ? 23 - bits : 1;
+    const uint32_t mask = ~((UINT32_C (1) << drop) - 1);
+    const uint32_t half = UINT32_C (1) << (drop - 1);
+    int64_t i;
+
+    FCLAW_ASSERT (1 <= bits && bits <= 23);
+    if (bits >= 23)
+    {
+        /* nothing to drop */
+        return;
+    }
+
+    for (i = 0; i < n; ++i)
+    {
+        uint32_t u, r;
+        memcpy (&u, &f[i], sizeof (u));
+        if ((u & 0x7f800000) != 0x7f800000)
+        {
+            r = (u + half) & mask;
+            /* do not round up to infinity */
+            u = (r & 0x7f800000) != 0x7f800000 ? r : (u & mask);
+            memcpy (&f[i], &u, sizeof (u));
+        }
+    }
+}
+
 static void
 write_meqn_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
                int blockno, int patchno, void *user)
@@ -448,14 +704,106 @@ write_meqn_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
 
     fclaw2d_vtk_state_t *s = (fclaw2d_vtk_state_t *) g->user;
 
-    s->value_cb (g->glob, patch, blockno, patchno, s->buf);
+#if PATCH_DIM == 2
+    if (s->filter != NULL)
+    {
+        vtk_filter_values (g->glob, s, blockno, patchno, s->buf);
+    }
+    else
+#endif
+    {
+        s->value_cb (g->glob, patch, blockno, patchno, s->buf);
+    }
+    if (s->mantissa_bits < 23)
+    {
+        fclaw2d_vtk_round_mantissa ((float *) s->buf,
+                            s->psize_meqn / (int64_t) sizeof (float),
+                            s->mantissa_bits);
+    }
     write_buffer (s, s->psize_meqn);
 }
 
+/* Callbacks writing one patch of each array, in the order of the fields */
+static const fclaw2d_patch_callback_t vtk_field_cb[VTK_FIELDS] =
+{
+    write_position_cb,
+    write_connectivity_cb,
+    write_offsets_cb,
+    write_types_cb,
+    write_mpirank_cb,
+    write_blockno_cb,
+    write_patchno_cb,
+    write_meqn_cb
+};
+
+static int64_t
+vtk_field_psize (const fclaw2d_vtk_state_t * s, int k)
+{
+    const int64_t psize[VTK_FIELDS] =
+    {
+        s->psize_position,
+        s->psize_connectivity,
+        s->psize_offsets,
+        s->psize_types,
+        s->psize_mpirank,
+        s->psize_blockno,
+        s->psize_patchno,
+        s->psize_meqn
+    };
+    return psize[k];
+}
+
+/**
+ * @brief Write one data array of all local patches
+ *
+ * @param cache NULL to compute the array patch by patch.  Otherwise the 
+ *              array of all local patches is stored in *cache, computed 
+ *              first if *cache is NULL, and written with one call.
+ */
+static void
+fclaw2d_vtk_stage_field (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
+                         int64_t offset_field, int64_t psize_field,
+                         fclaw2d_patch_callback_t cb, char **cache)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    const int64_t lsize = psize_field * s->lnum;
+    int64_t pos = s->header_size + offset_field;
+    char *buf;
+
+    if (domain->mpirank == 0)
+    {
+        /* byte count */
+        const int64_t bcount = psize_field * s->gnum;
+        buf = fclaw_async_writer_buffer (s->writer, s->ndsize);
+        memcpy (buf, &bcount, s->ndsize);
+        fclaw_async_writer_write (s->writer, s->filename, pos, buf, s->ndsize);
+    }
+    pos += s->ndsize + psize_field * s->gbefore;
+
+    buf = fclaw_async_writer_buffer (s->writer, lsize);
+    if (cache != NULL && *cache != NULL)
+    {
+        memcpy (buf, *cache, lsize);
+    }
+    else
+    {
+        s->buf = buf;
+        s->filling = 1;
+        vtk_iterate_patches (glob, s, cb);
+        s->filling = 0;
+        if (cache != NULL && lsize > 0)
+        {
+            *cache = FCLAW_ALLOC (char, lsize);
+            memcpy (*cache, buf, lsize);
+        }
+    }
+    fclaw_async_writer_write (s->writer, s->filename, pos, buf, lsize);
+}
+
 static void
 fclaw2d_vtk_write_field (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
                          int64_t offset_field, int64_t psize_field,
-                         fclaw2d_patch_callback_t cb)
+                         fclaw2d_patch_callback_t cb, char **cache)
 {
     fclaw2d_domain_t *domain = glob->domain;
 
@@ -471,13 +819,18 @@ fclaw2d_vtk_write_field (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
     MPI_Status mpistatus;
 #endif
 
-    s->buf = P4EST_ALLOC (char, psize_field);
+    if (s->writer != NULL)
+    {
+        fclaw2d_vtk_stage_field (glob, s, offset_field, psize_field, cb, cache);
+        return;
+    }
+
 #ifdef P4EST_ENABLE_MPIIO
     mpipos = s->mpibegin + offset_field;
     if (domain->mpirank > 0)
     {
         /* account for byte count */
-        mpipos += s->ndsize + psize_field * domain->global_num_patches_before;
+        mpipos += s->ndsize + psize_field * s->gbefore;
     }
     mpiret = MPI_File_seek (s->mpifile, mpipos, MPI_SEEK_SET);
     SC_CHECK_MPI (mpiret);
@@ -485,7 +838,7 @@ fclaw2d_vtk_write_field (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
     if (domain->mpirank == 0)
     {
         /* write byte count */
-        bcount = psize_field * domain->global_num_patches;
+        bcount = psize_field * s->gnum;
 #if 0
         P4EST_LDEBUGF ("offset %lld psize %lld bcount %d %o %x\n",
                        (long long) offset_field, (long long) psize_field,
@@ -499,8 +852,29 @@ fclaw2d_vtk_write_field (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
         SC_CHECK_MPI (mpiret);
 #endif
     }
-    fclaw2d_global_iterate_patches (glob, cb, s);
-    P4EST_FREE (s->buf);
+    if (cache == NULL)
+    {
+        s->buf = P4EST_ALLOC (char, psize_field);
+        vtk_iterate_patches (glob, s, cb);
+        P4EST_FREE (s->buf);
+    }
+    else
+    {
+        const int64_t lsize = psize_field * s->lnum;
+        if (*cache == NULL && lsize > 0)
+        {
+            *cache = FCLAW_ALLOC (char, lsize);
+            s->buf = *cache;
+            s->filling = 1;
+            vtk_iterate_patches (glob, s, cb);
+            s->filling = 0;
+        }
+        if (lsize > 0)
+        {
+            s->buf = *cache;
+            write_buffer (s, lsize);
+        }
+    }
 
 #ifdef P4EST_ENABLE_MPIIO
 #ifdef P4EST_ENABLE_DEBUG
@@ -508,129 +882,532 @@ fclaw2d_vtk_write_field (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
     SC_CHECK_MPI (mpiret);
     P4EST_ASSERT (mpinew - mpipos ==
                   (domain->mpirank == 0 ? s->ndsize : 0) +
-                  domain->local_num_patches * psize_field);
+                  s->lnum * psize_field);
     P4EST_ASSERT (domain->mpirank < domain->mpisize - 1 ||
                   mpinew - s->mpibegin ==
                   offset_field + s->ndsize +
-                  psize_field * domain->global_num_patches);
+                  psize_field * s->gnum);
 #endif
 #endif
 }
 
-static void
-fclaw2d_vtk_write_data (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s)
+/* Write the header on rank 0.  Collective. */
+static int
+vtk_write_header_all (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s)
 {
-#ifdef P4EST_ENABLE_MPIIO
+    fclaw2d_domain_t *domain = glob->domain;
+
+    int retval, gretval;
     int mpiret;
-    MPI_Offset mpipos;
 
-    /* collectively open the file in append mode and reserve space */
-    mpiret = MPI_File_open (glob->mpicomm, s->filename,
-                            MPI_MODE_RDWR | MPI_MODE_APPEND |
-                            MPI_MODE_UNIQUE_OPEN, MPI_INFO_NULL, &s->mpifile);
-    SC_CHECK_MPI (mpiret);
-    mpiret = MPI_File_get_position (s->mpifile, &s->mpibegin);
-    SC_CHECK_MPI (mpiret);
-    mpipos = s->mpibegin + (MPI_Offset) s->offset_end;
-    mpiret = MPI_File_preallocate (s->mpifile, mpipos);
+    /* write header meta data and check for error */
+    retval = 0;
+    if (domain->mpirank == 0)
+    {
+        retval = fclaw2d_vtk_write_header (glob->domain, s);
+    }
+    mpiret = sc_MPI_Allreduce (&retval, &gretval, 1, sc_MPI_INT, sc_MPI_MIN,
+                               domain->mpicomm);
     SC_CHECK_MPI (mpiret);
-#endif
+    if (gretval < 0)
+    {
+        return -1;
+    }
 
-    /* write meta data fields */
-    fclaw2d_vtk_write_field (glob, s, s->offset_position, s->psize_position,
-                             write_position_cb);
-    fclaw2d_vtk_write_field (glob, s, s->offset_connectivity,
-                             s->psize_connectivity, write_connectivity_cb);
-    fclaw2d_vtk_write_field (glob, s, s->offset_offsets, s->psize_offsets,
-                             write_offsets_cb);
-    fclaw2d_vtk_write_field (glob, s, s->offset_types, s->psize_types,
-                             write_types_cb);
-    fclaw2d_vtk_write_field (glob, s, s->offset_mpirank, s->psize_mpirank,
-                             write_mpirank_cb);
-    fclaw2d_vtk_write_field (glob, s, s->offset_blockno, s->psize_blockno,
-                             write_blockno_cb);
-    fclaw2d_vtk_write_field (glob, s, s->offset_patchno, s->psize_patchno,
-                             write_patchno_cb);
-    fclaw2d_vtk_write_field (glob, s, s->offset_meqn, s->psize_meqn,
-                             write_meqn_cb);
+    if (s->writer != NULL)
+    {
+        long long header_size = (long long) s->header_size;
+        mpiret = sc_MPI_Bcast (&header_size, 1, sc_MPI_LONG_LONG_INT, 0,
+                               domain->mpicomm);
+        SC_CHECK_MPI (mpiret);
+        s->header_size = (int64_t) header_size;
+    }
 
-#ifdef P4EST_ENABLE_MPIIO
-    /* collectively close the file */
-    mpiret = MPI_File_close (&s->mpifile);
-    SC_CHECK_MPI (mpiret);
-#endif
+    return 0;
 }
 
-static int
-fclaw2d_vtk_write_footer (fclaw2d_domain_t * domain, fclaw2d_vtk_state_t * s)
+#ifdef SC_HAVE_ZLIB
+/*  ---------------------------------------------------------------------------
+    Compressed arrays.  Each array is written in the layout of the 
+    vtkZLibDataCompressor with one block per patch : the number of blocks, 
+    the uncompressed block size, the size of a partial last block (zero), 
+    the compressed size of every block and then the blocks themselves.  
+    The offsets of the arrays depend on the compressed sizes, so the header 
+    is written after all arrays are compressed.
+    --------------------------------------------------------------------------- */
+
+static int64_t *
+vtk_field_offset (fclaw2d_vtk_state_t * s, int k)
 {
-    int retval;
-    FILE *file;
+    int64_t *offset[VTK_FIELDS] =
+    {
+        &s->offset_position,
+        &s->offset_connectivity,
+        &s->offset_offsets,
+        &s->offset_types,
+        &s->offset_mpirank,
+        &s->offset_blockno,
+        &s->offset_patchno,
+        &s->offset_meqn
+    };
+    return offset[k];
+}
 
-#ifndef P4EST_ENABLE_MPIIO
-    file = s->file;
-#else
-    /* unconditionally open the file */
-    file = fopen (s->filename, "ab");
-    if (file == NULL)
+int64_t
+fclaw2d_vtk_compress_blocks (const char *raw, int64_t psize, int lnum,
+                             char **zdata_out, uint64_t ** zsize_out)
+{
+    const uLong bound = compressBound ((uLong) psize);
+    char *zdata = FCLAW_ALLOC (char, (size_t) bound * lnum);
+    uint64_t *zsize = FCLAW_ALLOC (uint64_t, lnum);
+    int64_t pos;
+    int p;
+
+    /* blocks are independent of each other */
+#pragma omp parallel for
+    for (p = 0; p < lnum; ++p)
     {
-        return -1;
+        uLongf zlen = bound;
+        int ret = compress2 ((Bytef *) zdata + (size_t) p * bound, &zlen,
+                             (const Bytef *) raw + (size_t) p * psize,
+                             (uLong) psize, Z_BEST_SPEED);
+        SC_CHECK_ABORT (ret == Z_OK, "VTK compression failed");
+        zsize[p] = (uint64_t) zlen;
     }
-    s->file = file;
-#endif
 
-    /* stop writing after first unsuccessful operation */
-    retval = 0;
-    retval = retval || fprintf (file, "\n </AppendedData>\n</VTKFile>\n") < 0;
+    /* close the gaps between blocks */
+    pos = 0;
+    for (p = 0; p < lnum; ++p)
+    {
+        memmove (zdata + pos, zdata + (size_t) p * bound, zsize[p]);
+        pos += zsize[p];
+    }
 
-    /* unconditionally close the file */
-    retval = fclose (file) || retval;
-    s->file = NULL;
+    *zdata_out = zdata;
+    *zsize_out = zsize;
+    return pos;
+}
 
-    return retval ? -1 : 0;
+/* Compress each patch of a local array into its own zlib block */
+static void
+vtk_compress_field (fclaw2d_vtk_state_t * s, int k, const char *raw,
+                    int64_t psize, int lnum)
+{
+    s->zlocal[k] = fclaw2d_vtk_compress_blocks (raw, psize, lnum,
+                                                &s->zdata[k], &s->zsize[k]);
 }
 
-int
-fclaw2d_vtk_write_file (fclaw2d_global_t * glob, const char *basename,
-                        int mx, int my,
-#if PATCH_DIM == 3
-                        int mz,
-#endif
-                        int meqn,
-                        double vtkspace, int vtkwrite,
-                        fclaw2d_vtk_patch_data_t coordinate_cb,
-                        fclaw2d_vtk_patch_data_t value_cb)
+/* Compress all arrays, compute their offsets and write the header.  
+   Collective. */
+static int
+fclaw2d_vtk_compress_data (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
+                           char **cache[])
 {
     fclaw2d_domain_t *domain = glob->domain;
-
-    int retval, gretval;
+    const int lnum = s->lnum;
+    long long zlocal[VTK_FIELDS], *zall;
+    int64_t offset;
     int mpiret;
-    fclaw2d_vtk_state_t ps, *s = &ps;
+    int k, q;
 
-    /* set up VTK internal information */
-    s->mx = mx;
-    s->my = my;
-#if PATCH_DIM == 3
-    s->mz = mz;
-#endif
-    s->meqn = meqn;
-    s->points_per_patch = (mx + 1) * (my + 1);
-    s->cells_per_patch = mx * my;
-#if PATCH_DIM == 3
-    s->points_per_patch *= (mz + 1);
-    s->cells_per_patch *= mz;
-#endif
-    snprintf (s->filename, BUFSIZ, "%s.vtu", basename);
-    s->global_num_points = s->points_per_patch * domain->global_num_patches;
-    s->global_num_cells = s->cells_per_patch * domain->global_num_patches;
+    for (k = 0; k < VTK_FIELDS; ++k)
+    {
+        const int64_t psize = vtk_field_psize (s, k);
+        char *raw = cache[k] != NULL ? *cache[k] : NULL;
+
+        if (raw == NULL && lnum > 0)
+        {
+            raw = FCLAW_ALLOC (char, psize * lnum);
+            s->buf = raw;
+            s->filling = 1;
+            vtk_iterate_patches (glob, s, vtk_field_cb[k]);
+            s->filling = 0;
+            if (cache[k] != NULL)
+            {
+                *cache[k] = raw;
+            }
+        }
+        vtk_compress_field (s, k, raw, psize, lnum);
+        if (cache[k] == NULL)
+        {
+            FCLAW_FREE (raw);
+        }
+        zlocal[k] = (long long) s->zlocal[k];
+    }
+
+    /* compressed bytes of every rank */
+    zall = FCLAW_ALLOC (long long, VTK_FIELDS * domain->mpisize);
+    mpiret = sc_MPI_Allgather (zlocal, VTK_FIELDS, sc_MPI_LONG_LONG_INT,
+                               zall, VTK_FIELDS, sc_MPI_LONG_LONG_INT,
+                               domain->mpicomm);
+    SC_CHECK_MPI (mpiret);
+
+    offset = 0;
+    for (k = 0; k < VTK_FIELDS; ++k)
+    {
+        int64_t before = 0, total = 0;
+        for (q = 0; q < domain->mpisize; ++q)
+        {
+            if (q < domain->mpirank)
+            {
+                before += zall[q * VTK_FIELDS + k];
+            }
+            total += zall[q * VTK_FIELDS + k];
+        }
+        s->zbefore[k] = before;
+        *vtk_field_offset (s, k) = offset;
+        offset += s->ndsize * (3 + s->gnum) + total;
+    }
+    s->offset_end = offset;
+    FCLAW_FREE (zall);
+
+    return vtk_write_header_all (glob, s);
+}
+
+/* Write size bytes at pos after the beginning of the appended data */
+static void
+vtk_write_at (fclaw2d_vtk_state_t * s, int64_t pos, const void *data,
+              int64_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    if (s->writer != NULL)
+    {
+        char *buf = fclaw_async_writer_buffer (s->writer, size);
+        memcpy (buf, data, size);
+        fclaw_async_writer_write (s->writer, s->filename,
+                                  s->header_size + pos, buf, size);
+        return;
+    }
+#ifndef P4EST_ENABLE_MPIIO
+    {
+        size_t retvalz;
+        int retval = fseek (s->file, (long) (s->header_size + pos), SEEK_SET);
+        SC_CHECK_ABORT (retval == 0, "VTK file seek failed");
+        retvalz = fwrite (data, size, 1, s->file);
+        SC_CHECK_ABORT (retvalz == 1, "VTK file write failed");
+    }
+#else
+    {
+        /* in pieces that fit the int count */
+        const int64_t chunk = INT_MAX;
+        int64_t done;
+        int mpiret;
+        MPI_Status mpistatus;
+        for (done = 0; done < size; done += chunk)
+        {
+            const int count = (int) SC_MIN (chunk, size - done);
+            mpiret = MPI_File_write_at (s->mpifile, s->mpibegin + pos + done,
+                                        (char *) data + done, count,
+                                        MPI_BYTE, &mpistatus);
+            SC_CHECK_MPI (mpiret);
+        }
+    }
+#endif
+}
+
+static void
+fclaw2d_vtk_write_compressed_field (fclaw2d_global_t * glob,
+                                    fclaw2d_vtk_state_t * s, int k)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    const int64_t offset = *vtk_field_offset (s, k);
+    const int64_t gnum = s->gnum;
+
+    if (domain->mpirank == 0)
+    {
+        /* number of blocks, block size and size of a partial last block */
+        const uint64_t head[3] =
+            { (uint64_t) gnum, (uint64_t) vtk_field_psize (s, k), 0 };
+        vtk_write_at (s, offset, head, sizeof (head));
+    }
+    vtk_write_at (s, offset + s->ndsize * (3 + s->gbefore),
+                  s->zsize[k], s->ndsize * s->lnum);
+    vtk_write_at (s, offset + s->ndsize * (3 + gnum) + s->zbefore[k],
+                  s->zdata[k], s->zlocal[k]);
+}
+#endif
+
+/**
+ * @brief Write all data arrays
+ *
+ * @param cache the cache argument of ::fclaw2d_vtk_write_field for each of 
+ *              the VTK_FIELDS arrays
+ * @return 0 on success, -1 if the header of a compressed file failed
+ */
+static int
+fclaw2d_vtk_write_data (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
+                        char **cache[])
+{
+#ifdef P4EST_ENABLE_MPIIO
+    int mpiret;
+    MPI_Offset mpipos;
+#endif
+#ifdef SC_HAVE_ZLIB
+    int k;
+
+    if (s->compress)
+    {
+        /* the header follows the compressed sizes */
+        if (fclaw2d_vtk_compress_data (glob, s, cache) < 0)
+        {
+            for (k = 0; k < VTK_FIELDS; ++k)
+            {
+                FCLAW_FREE (s->zdata[k]);
+                FCLAW_FREE (s->zsize[k]);
+            }
+            return -1;
+        }
+    }
+#endif
+
+#ifdef P4EST_ENABLE_MPIIO
+    if (s->writer == NULL)
+    {
+        /* collectively open the file in append mode and reserve space */
+        mpiret = MPI_File_open (glob->mpicomm, s->filename,
+                                MPI_MODE_RDWR | MPI_MODE_APPEND |
+                                MPI_MODE_UNIQUE_OPEN, MPI_INFO_NULL, &s->mpifile);
+        SC_CHECK_MPI (mpiret);
+        mpiret = MPI_File_get_position (s->mpifile, &s->mpibegin);
+        SC_CHECK_MPI (mpiret);
+        mpipos = s->mpibegin + (MPI_Offset) s->offset_end;
+        mpiret = MPI_File_preallocate (s->mpifile, mpipos);
+        SC_CHECK_MPI (mpiret);
+    }
+#endif
+
+#ifdef SC_HAVE_ZLIB
+    if (s->compress)
+    {
+        for (k = 0; k < VTK_FIELDS; ++k)
+        {
+            fclaw2d_vtk_write_compressed_field (glob, s, k);
+            FCLAW_FREE (s->zdata[k]);
+            FCLAW_FREE (s->zsize[k]);
+        }
+#ifndef P4EST_ENABLE_MPIIO
+        if (s->writer == NULL && s->file != NULL)
+        {
+            /* the footer follows the last array */
+            int retval = fseek (s->file, (long) (s->header_size + s->offset_end),
+                                SEEK_SET);
+            SC_CHECK_ABORT (retval == 0, "VTK file seek failed");
+        }
+#endif
+    }
+    else
+#endif
+    {
+        /* write meta data fields */
+        fclaw2d_vtk_write_field (glob, s, s->offset_position, s->psize_position,
+                                 write_position_cb,
+                                 cache[VTK_POSITION]);
+        fclaw2d_vtk_write_field (glob, s, s->offset_connectivity,
+                                 s->psize_connectivity, write_connectivity_cb,
+                                 cache[VTK_CONNECTIVITY]);
+        fclaw2d_vtk_write_field (glob, s, s->offset_offsets, s->psize_offsets,
+                                 write_offsets_cb,
+                                 cache[VTK_OFFSETS]);
+        fclaw2d_vtk_write_field (glob, s, s->offset_types, s->psize_types,
+                                 write_types_cb,
+                                 cache[VTK_TYPES]);
+        fclaw2d_vtk_write_field (glob, s, s->offset_mpirank, s->psize_mpirank,
+                                 write_mpirank_cb,
+                                 cache[VTK_MPIRANK]);
+        fclaw2d_vtk_write_field (glob, s, s->offset_blockno, s->psize_blockno,
+                                 write_blockno_cb,
+                                 cache[VTK_BLOCKNO]);
+        fclaw2d_vtk_write_field (glob, s, s->offset_patchno, s->psize_patchno,
+                                 write_patchno_cb,
+                                 cache[VTK_PATCHNO]);
+        fclaw2d_vtk_write_field (glob, s, s->offset_meqn, s->psize_meqn,
+                                 write_meqn_cb, cache[VTK_MEQN]);
+    }
+
+#ifdef P4EST_ENABLE_MPIIO
+    if (s->writer == NULL)
+    {
+        /* collectively close the file */
+        mpiret = MPI_File_close (&s->mpifile);
+        SC_CHECK_MPI (mpiret);
+    }
+#endif
+
+    return 0;
+}
+
+static int
+fclaw2d_vtk_write_footer (fclaw2d_domain_t * domain, fclaw2d_vtk_state_t * s)
+{
+    int retval;
+    FILE *file;
+
+    if (s->writer != NULL)
+    {
+        static const char footer[] = "\n </AppendedData>\n</VTKFile>\n";
+        char *buf = fclaw_async_writer_buffer (s->writer, strlen (footer));
+        memcpy (buf, footer, strlen (footer));
+        fclaw_async_writer_write (s->writer, s->filename,
+                                  s->header_size + s->offset_end,
+                                  buf, strlen (footer));
+        return 0;
+    }
+
+#ifndef P4EST_ENABLE_MPIIO
+    file = s->file;
+#else
+    /* unconditionally open the file */
+    file = fopen (s->filename, "ab");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    s->file = file;
+#endif
+
+    /* stop writing after first unsuccessful operation */
+    retval = 0;
+    retval = retval || fprintf (file, "\n </AppendedData>\n</VTKFile>\n") < 0;
+
+    /* unconditionally close the file */
+    retval = fclose (file) || retval;
+    s->file = NULL;
+
+    return retval ? -1 : 0;
+}
+
+static void
+vtk_geometry_destroy (void *value)
+{
+    fclaw2d_vtk_geometry_t *geom = (fclaw2d_vtk_geometry_t *) value;
+    int k;
+
+    for (k = 0; k < VTK_GEOMETRY_FIELDS; ++k)
+    {
+        FCLAW_FREE (geom->field[k]);
+    }
+    FCLAW_FREE (geom);
+}
+
+/* Return the cached mesh arrays, emptied if the domain or the patch size 
+   changed since they were computed */
+static fclaw2d_vtk_geometry_t *
+vtk_geometry_get (fclaw2d_global_t * glob, int mx, int my
+#if PATCH_DIM == 3
+                  , int mz
+#endif
+                  )
+{
+    fclaw2d_vtk_geometry_t *geom = (fclaw2d_vtk_geometry_t *)
+        fclaw_pointer_map_get (glob->attributes, VTK_GEOMETRY_NAME);
+    int k;
+
+    if (geom == NULL)
+    {
+        geom = FCLAW_ALLOC_ZERO (fclaw2d_vtk_geometry_t, 1);
+        geom->domain_revision = -1;
+        fclaw_pointer_map_insert (glob->attributes, VTK_GEOMETRY_NAME, geom,
+                                  vtk_geometry_destroy);
+    }
+
+    if (geom->domain_revision != glob->domain_revision
+        || geom->mx != mx || geom->my != my
+#if PATCH_DIM == 3
+        || geom->mz != mz
+#endif
+        )
+    {
+        for (k = 0; k < VTK_GEOMETRY_FIELDS; ++k)
+        {
+            FCLAW_FREE (geom->field[k]);
+            geom->field[k] = NULL;
+        }
+        geom->domain_revision = glob->domain_revision;
+        geom->mx = mx;
+        geom->my = my;
+#if PATCH_DIM == 3
+        geom->mz = mz;
+#endif
+    }
+    return geom;
+}
+
+/* Set up the state and write the header, unless the arrays are compressed.
+   Collective. */
+static int
+vtk_write_begin (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s,
+                 const char *basename,
+                 int mx, int my,
+#if PATCH_DIM == 3
+                 int mz,
+#endif
+                 int meqn,
+                 const fclaw2d_clawpatch_output_filter_t * filter,
+                 fclaw2d_vtk_patch_data_t coordinate_cb,
+                 fclaw2d_vtk_patch_data_t value_cb)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+    int k;
+
+    /* patches written */
+    s->filter = filter;
+    if (filter != NULL)
+    {
+        s->gnum = filter->global_num_patches;
+        s->gbefore = filter->global_num_patches_before;
+        s->lnum = filter->local_num_patches;
+        mx /= filter->stride;
+        my /= filter->stride;
+    }
+    else
+    {
+        s->gnum = domain->global_num_patches;
+        s->gbefore = domain->global_num_patches_before;
+        s->lnum = domain->local_num_patches;
+    }
+
+    /* set up VTK internal information */
+    s->mx = mx;
+    s->my = my;
+#if PATCH_DIM == 3
+    s->mz = mz;
+#endif
+    s->meqn = meqn;
+    s->points_per_patch = (mx + 1) * (my + 1);
+    s->cells_per_patch = mx * my;
+#if PATCH_DIM == 3
+    s->points_per_patch *= (mz + 1);
+    s->cells_per_patch *= mz;
+#endif
+    snprintf (s->filename, BUFSIZ, "%s.vtu", basename);
+    s->global_num_points = s->points_per_patch * s->gnum;
+    s->global_num_cells = s->cells_per_patch * s->gnum;
     s->global_num_connectivity = PATCH_CHILDREN * (s->global_num_cells + 1);
     s->fits32 = s->global_num_points <= INT32_MAX
         && s->global_num_connectivity <= INT32_MAX;
     s->inttype = s->fits32 ? "Int32" : "Int64";
     s->intsize = s->fits32 ? sizeof (int32_t) : sizeof (int64_t);
     s->ndsize = 8;   /* uint64 */
+    s->filling = 0;
+    s->writer = fclaw2d_output_writer (glob);
+    s->header_size = 0;
     s->coordinate_cb = coordinate_cb;
     s->value_cb = value_cb;
+#ifdef SC_HAVE_ZLIB
+    s->compress = clawpatch_opt->vtk_compress;
+#else
+    s->compress = 0;
+#endif
+    s->mantissa_bits = clawpatch_opt->vtk_mantissa_bits;
+    for (k = 0; k < VTK_FIELDS; ++k)
+    {
+        s->zdata[k] = NULL;
+        s->zsize[k] = NULL;
+    }
 
     /* compute data size per patch for the various VTK data arrays */
     s->psize_position = s->points_per_patch * 3 * sizeof (double);
@@ -645,39 +1422,39 @@ fclaw2d_vtk_write_file (fclaw2d_global_t * glob, const char *basename,
     /* compute offsets in bytes after beginning of appended data section */
     s->offset_position = 0;
     s->offset_connectivity = s->ndsize +
-        s->offset_position + s->psize_position * domain->global_num_patches;
+        s->offset_position + s->psize_position * s->gnum;
     s->offset_offsets = s->ndsize +
         s->offset_connectivity +
-        s->psize_connectivity * domain->global_num_patches;
+        s->psize_connectivity * s->gnum;
     s->offset_types = s->ndsize +
-        s->offset_offsets + s->psize_offsets * domain->global_num_patches;
+        s->offset_offsets + s->psize_offsets * s->gnum;
     s->offset_mpirank = s->ndsize +
-        s->offset_types + s->psize_types * domain->global_num_patches;
+        s->offset_types + s->psize_types * s->gnum;
     s->offset_blockno = s->ndsize +
-        s->offset_mpirank + s->psize_mpirank * domain->global_num_patches;
+        s->offset_mpirank + s->psize_mpirank * s->gnum;
     s->offset_patchno = s->ndsize +
-        s->offset_blockno + s->psize_blockno * domain->global_num_patches;
+        s->offset_blockno + s->psize_blockno * s->gnum;
     s->offset_meqn = s->ndsize +
-        s->offset_patchno + s->psize_patchno * domain->global_num_patches;
+        s->offset_patchno + s->psize_patchno * s->gnum;
     s->offset_end = s->ndsize +
-        s->offset_meqn + s->psize_meqn * domain->global_num_patches;
+        s->offset_meqn + s->psize_meqn * s->gnum;
 
-    /* write header meta data and check for error */
-    retval = 0;
-    if (domain->mpirank == 0)
+    if (s->compress)
     {
-        retval = fclaw2d_vtk_write_header (glob->domain, s);
-    }
-    mpiret = sc_MPI_Allreduce (&retval, &gretval, 1, sc_MPI_INT, sc_MPI_MIN,
-                               domain->mpicomm);
-    SC_CHECK_MPI (mpiret);
-    if (gretval < 0)
-    {
-        return -1;
+        /* the offsets and the header follow the compressed sizes */
+        return 0;
     }
+    return vtk_write_header_all (glob, s);
+}
 
-    /* write mesh and numerical data using MPI I/O */
-    fclaw2d_vtk_write_data (glob, s);
+/* Write the footer.  Collective. */
+static int
+vtk_write_end (fclaw2d_global_t * glob, fclaw2d_vtk_state_t * s)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+
+    int retval, gretval;
+    int mpiret;
 
     /* write footer information and check for error */
     retval = 0;
@@ -696,47 +1473,74 @@ fclaw2d_vtk_write_file (fclaw2d_global_t * glob, const char *basename,
     return 0;
 }
 
+static int
+vtk_write_file (fclaw2d_global_t * glob, const char *basename,
+                int mx, int my,
+#if PATCH_DIM == 3
+                int mz,
+#endif
+                int meqn,
+                const fclaw2d_clawpatch_output_filter_t * filter,
+                fclaw2d_vtk_patch_data_t coordinate_cb,
+                fclaw2d_vtk_patch_data_t value_cb,
+                fclaw2d_vtk_geometry_t * geom)
+{
+    fclaw2d_vtk_state_t ps, *s = &ps;
+    char **cache[VTK_FIELDS];
+    int k;
+
+    if (vtk_write_begin (glob, s, basename, mx, my,
+#if PATCH_DIM == 3
+                         mz,
+#endif
+                         meqn, filter, coordinate_cb, value_cb) < 0)
+    {
+        return -1;
+    }
+
+    /* write mesh and numerical data using MPI I/O */
+    for (k = 0; k < VTK_GEOMETRY_FIELDS; ++k)
+    {
+        cache[k] = geom != NULL ? &geom->field[k] : NULL;
+    }
+    cache[VTK_MEQN] = NULL;
+    if (fclaw2d_vtk_write_data (glob, s, cache) < 0)
+    {
+        return -1;
+    }
+
+    return vtk_write_end (glob, s);
+}
+
+int
+fclaw2d_vtk_write_file (fclaw2d_global_t * glob, const char *basename,
+                        int mx, int my,
+#if PATCH_DIM == 3
+                        int mz,
+#endif
+                        int meqn,
+                        double vtkspace, int vtkwrite,
+                        fclaw2d_vtk_patch_data_t coordinate_cb,
+                        fclaw2d_vtk_patch_data_t value_cb)
+{
+    return vtk_write_file (glob, basename, mx, my,
+#if PATCH_DIM == 3
+                           mz,
+#endif
+                           meqn, NULL, coordinate_cb, value_cb, NULL);
+}
+
 static void
 fclaw2d_output_vtk_coordinate_cb (fclaw2d_global_t * glob,
                                   fclaw2d_patch_t * patch,
                                   int blockno, int patchno,
                                   char *a)
 {
-    int mx,my,mbc;
-    double dx,dy,xlower,ylower;
 #if PATCH_DIM == 2
-    fclaw2d_clawpatch_grid_data(glob,patch,&mx,&my,&mbc,
-                                &xlower,&ylower,&dx,&dy);
-
-    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
-
-    /* Enumerate point coordinates in the patch */
-    double *d = (double *) a;
-    int i, j;
-    double xpp,ypp,zpp;
-    for (j = 0; j <= my; ++j)
-    {
-        const double y = ylower + j * dy;
-        for (i = 0; i <= mx; ++i)
-        {
-            const double x = xlower + i * dx;
-            if (fclaw_opt->manifold)
-            {
-                fclaw2d_map_context_t *cont = glob->cont;
-                FCLAW2D_MAP_C2M(&cont,&blockno,&x,&y,&xpp,&ypp,&zpp);
-                *d++ = xpp;
-                *d++ = ypp;
-                *d++ = zpp;
-            }
-            else
-            {
-                *d++ = x;
-                *d++ = y;
-                *d++ = 0;
-            }
-        }
-    }
+    vtk_patch_coordinates (glob, patch, blockno, 1, 0, a);
 #elif PATCH_DIM == 3
+    int mx,my,mbc;
+    double dx,dy,xlower,ylower;
     int mz;
     double zlower, dz;
     fclaw2d_clawpatch_grid_data(glob,patch,&mx,&my,&mz, &mbc,
@@ -866,6 +1670,55 @@ fclaw2d_output_write_vtk_debug (fclaw2d_global_t * glob, const char *basename)
     Public interface
     --------------------------------------------------------------------------- */
 
+/* True if the frame is written as vtkOverlappingAMR */
+static int
+vtk_use_amr (fclaw2d_global_t * glob)
+{
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+
+    if (!clawpatch_opt->vtk_amr)
+    {
+        return 0;
+    }
+#if PATCH_DIM == 2
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    if (!fclaw_opt->manifold)
+    {
+        return 1;
+    }
+#endif
+    fclaw_global_infof ("vtk-amr is only available for 2d patches " \
+                        "without a mapping; writing an unstructured grid\n");
+    return 0;
+}
+
+static fclaw2d_vtk_geometry_t *
+vtk_geometry_option (fclaw2d_global_t * glob)
+{
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+
+    if (!clawpatch_opt->vtk_cache_geometry)
+    {
+        return NULL;
+    }
+    return vtk_geometry_get (glob, clawpatch_opt->mx, clawpatch_opt->my
+#if PATCH_DIM == 3
+                             , clawpatch_opt->mz
+#endif
+                             );
+}
+
+/* The filter of a preview frame, or NULL.  Collective. */
+static const fclaw2d_clawpatch_output_filter_t *
+vtk_filter (fclaw2d_global_t * glob, int iframe)
+{
+#if PATCH_DIM == 2
+    return fclaw2d_clawpatch_output_filter_get (glob, iframe);
+#else
+    return NULL;
+#endif
+}
+
 void fclaw2d_clawpatch_output_vtk (fclaw2d_global_t * glob, int iframe)
 {
     const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
@@ -875,15 +1728,163 @@ void fclaw2d_clawpatch_output_vtk (fclaw2d_global_t * glob, int iframe)
     char basename[BUFSIZ];
     snprintf (basename, BUFSIZ, "%s_frame_%04d", fclaw_opt->prefix, iframe);
 
-    (void) fclaw2d_vtk_write_file (glob, basename,
-                                   clawpatch_opt->mx, clawpatch_opt->my,
+    if (vtk_use_amr (glob))
+    {
+#if PATCH_DIM == 2
+        (void) fclaw2d_clawpatch_output_vtk_amr (glob, basename,
+                                                 clawpatch_opt->mx,
+                                                 clawpatch_opt->my,
+                                                 clawpatch_opt->meqn,
+                                                 fclaw2d_output_vtk_value_cb);
+        return;
+#endif
+    }
+
+    /* the mesh of a filtered frame is not kept */
+    const fclaw2d_clawpatch_output_filter_t *filter = vtk_filter (glob, iframe);
+    (void) vtk_write_file (glob, basename,
+                           clawpatch_opt->mx, clawpatch_opt->my,
 #if PATCH_DIM == 3
-                                   clawpatch_opt->mz,
+                           clawpatch_opt->mz,
 #endif
-                                   clawpatch_opt->meqn,
-                                   fclaw_opt->vtkspace, 0,
-                                   fclaw2d_output_vtk_coordinate_cb,
-                                   fclaw2d_output_vtk_value_cb);
+                           clawpatch_opt->meqn, filter,
+                           fclaw2d_output_vtk_coordinate_cb,
+                           fclaw2d_output_vtk_value_cb,
+                           filter == NULL ? vtk_geometry_option (glob) : NULL);
 }
 
+#if PATCH_DIM == 2
+
+/*  ---------------------------------------------------------------------------
+    Patch by patch output, used by fclaw2d_clawpatch_output_frame
+    --------------------------------------------------------------------------- */
 
+struct fclaw2d_clawpatch_vtk_frame
+{
+    fclaw2d_vtk_state_t s;
+    fclaw2d_vtk_geometry_t *geom;
+    int retval;
+    char *field[VTK_FIELDS];    /* arrays filled patch by patch, or NULL */
+};
+
+fclaw2d_clawpatch_vtk_frame_t *
+fclaw2d_clawpatch_output_vtk_begin (fclaw2d_global_t * glob, int iframe)
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    const fclaw2d_clawpatch_options_t *clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+    int k;
+
+    if (vtk_use_amr (glob))
+    {
+        /* one file per patch */
+        return NULL;
+    }
+
+    char basename[BUFSIZ];
+    snprintf (basename, BUFSIZ, "%s_frame_%04d", fclaw_opt->prefix, iframe);
+
+    fclaw2d_clawpatch_vtk_frame_t *frame =
+        FCLAW_ALLOC_ZERO (fclaw2d_clawpatch_vtk_frame_t, 1);
+    const fclaw2d_clawpatch_output_filter_t *filter = vtk_filter (glob, iframe);
+    frame->geom = filter == NULL ? vtk_geometry_option (glob) : NULL;
+    frame->retval = vtk_write_begin (glob, &frame->s, basename,
+                                     clawpatch_opt->mx, clawpatch_opt->my,
+                                     clawpatch_opt->meqn, filter,
+                                     fclaw2d_output_vtk_coordinate_cb,
+                                     fclaw2d_output_vtk_value_cb);
+    if (frame->retval < 0)
+    {
+        return frame;
+    }
+
+    for (k = 0; k < VTK_FIELDS; ++k)
+    {
+        if (k < VTK_GEOMETRY_FIELDS && frame->geom != NULL
+            && frame->geom->field[k] != NULL)
+        {
+            /* cached from an earlier frame */
+            continue;
+        }
+        frame->field[k] = FCLAW_ALLOC (char, vtk_field_psize (&frame->s, k) *
+                                       frame->s.lnum);
+    }
+    return frame;
+}
+
+void
+fclaw2d_clawpatch_output_vtk_patch (fclaw2d_global_t * glob,
+                                    fclaw2d_clawpatch_vtk_frame_t * frame,
+                                    fclaw2d_patch_t * patch,
+                                    int blockno, int patchno)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    fclaw2d_vtk_state_t *s = &frame->s;
+    fclaw2d_global_iterate_t g;
+    int k;
+
+    const int64_t local =
+        fclaw2d_clawpatch_output_filter_index (s->filter, domain,
+                                               blockno, patchno);
+    if (frame->retval < 0 || local < 0)
+    {
+        return;
+    }
+
+    g.glob = glob;
+    g.user = s;
+
+    s->filling = 1;
+    for (k = 0; k < VTK_FIELDS; ++k)
+    {
+        if (frame->field[k] != NULL)
+        {
+            s->buf = frame->field[k] + local * vtk_field_psize (s, k);
+            vtk_field_cb[k] (domain, patch, blockno, patchno, &g);
+        }
+    }
+    s->filling = 0;
+}
+
+int
+fclaw2d_clawpatch_output_vtk_end (fclaw2d_global_t * glob,
+                                  fclaw2d_clawpatch_vtk_frame_t * frame)
+{
+    int retval = frame->retval;
+    char **cache[VTK_FIELDS];
+    int k;
+
+    if (retval == 0)
+    {
+        for (k = 0; k < VTK_FIELDS; ++k)
+        {
+            if (k < VTK_GEOMETRY_FIELDS && frame->geom != NULL)
+            {
+                /* keep the arrays filled in this frame */
+                if (frame->field[k] != NULL)
+                {
+                    frame->geom->field[k] = frame->field[k];
+                    frame->field[k] = NULL;
+                }
+                cache[k] = &frame->geom->field[k];
+            }
+            else
+            {
+                cache[k] = &frame->field[k];
+            }
+        }
+        retval = fclaw2d_vtk_write_data (glob, &frame->s, cache);
+        if (retval == 0)
+        {
+            retval = vtk_write_end (glob, &frame->s);
+        }
+    }
+
+    for (k = 0; k < VTK_FIELDS; ++k)
+    {
+        FCLAW_FREE (frame->field[k]);
+    }
+    FCLAW_FREE (frame);
+    return retval;
+}
+
+#endif
@@ -0,0 +1,396 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <fclaw_base.h>
+#include <fclaw_pointer_map.h>
+#include <fclaw2d_global.h>
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_clawpatch_options.h>
+#include <fclaw2d_clawpatch_output_vtk.h>
+#include <fclaw2d_domain.h>
+#include <fclaw2d_forestclaw.h>
+#include <fclaw2d_options.h>
+#include <fclaw2d_patch.h>
+#include <test.hpp>
+#include <test/test.hpp>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef SC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace{
+/* Values of both signs over many binades, none of them subnormal */
+std::vector<float> test_values()
+{
+	std::vector<float> v;
+	for(int e = -100; e <= 100; e += 7)
+	{
+		for(int i = 0; i < 64; i++)
+		{
+			float x = std::ldexp(1.0f + i/64.0f + i/8192.0f, e);
+			v.push_back(x);
+			v.push_back(-x);
+		}
+	}
+	v.push_back(1.0f/3.0f);
+	v.push_back(0.1f);
+	v.push_back(3.14159265f);
+	return v;
+}
+
+/* Four level one patches of a unit square, written to files in the
+   working directory */
+struct VtkFrame {
+	fclaw2d_global_t* glob;
+	fclaw_options_t fopts;
+	fclaw2d_domain_t *domain;
+	fclaw2d_clawpatch_options_t opts;
+	std::vector<std::string> files;
+
+	VtkFrame(){
+		glob = fclaw2d_global_new();
+
+		fclaw2d_vtables_initialize(glob);
+		fclaw2d_clawpatch_vtable_initialize(glob, 4);
+
+		memset(&fopts, 0, sizeof(fopts));
+		fopts.mi = 1;
+		fopts.mj = 1;
+		fopts.minlevel = 1;
+		fopts.maxlevel = 1;
+		fopts.refratio = 2;
+		fopts.ax = 0;
+		fopts.bx = 1;
+		fopts.ay = 0;
+		fopts.by = 1;
+		fopts.prefix = "fclaw2d_vtk_test";
+
+		domain = create_test_domain(sc_MPI_COMM_WORLD,&fopts);
+		fclaw2d_global_store_domain(glob, domain);
+		fclaw2d_options_store(glob, &fopts);
+
+		memset(&opts, 0, sizeof(opts));
+		opts.mx   = 4;
+		opts.my   = 4;
+		opts.mbc  = 2;
+		opts.meqn = 2;
+		opts.output_maxlevel = -1;
+		opts.output_stride = 1;
+		opts.vtk_mantissa_bits = 23;
+		fclaw2d_clawpatch_options_store(glob, &opts);
+
+		fclaw2d_domain_data_new(glob->domain);
+
+		for(int i = 0; i < domain->blocks[0].num_patches; i++)
+		{
+			fclaw2d_build_mode_t build_mode = FCLAW2D_BUILD_FOR_UPDATE;
+			fclaw2d_patch_build(glob, &domain->blocks[0].patches[i], 0, i, &build_mode);
+		}
+		set_values(0);
+	}
+	~VtkFrame(){
+		for(int i = 0; i < domain->blocks[0].num_patches; i++)
+		{
+			fclaw2d_patch_data_delete(glob, &domain->blocks[0].patches[i]);
+		}
+		fclaw2d_global_destroy(glob);
+		for(const std::string& name : files)
+		{
+			std::remove(name.c_str());
+		}
+	}
+
+	/* The value of cell (i,j,m) of patch p */
+	static float value(int offset, int p, int i, int j, int m)
+	{
+		return (float) (offset + 1000*p + 100*m + 10*j + i);
+	}
+
+	void set_values(int offset)
+	{
+		for(int p = 0; p < domain->blocks[0].num_patches; p++)
+		{
+			double *q;
+			int meqn;
+			fclaw2d_clawpatch_soln_data(glob, &domain->blocks[0].patches[p], &q, &meqn);
+			int mx = opts.mx, my = opts.my, mbc = opts.mbc;
+			int n = (mx + 2*mbc)*(my + 2*mbc);
+			for(int k = 0; k < n*meqn; k++)
+				q[k] = -1;
+			for(int m = 0; m < meqn; m++)
+				for(int j = 0; j < my; j++)
+					for(int i = 0; i < mx; i++)
+						q[(i + mbc) + (j + mbc)*(mx + 2*mbc) + m*n] = value(offset,p,i,j,m);
+		}
+	}
+
+	/* The file name of a frame, removed at the end of the test */
+	std::string name(int iframe, const char* suffix)
+	{
+		char s[BUFSIZ];
+		snprintf(s, BUFSIZ, "%s_frame_%04d%s", fopts.prefix, iframe, suffix);
+		files.push_back(s);
+		return s;
+	}
+
+	std::string write(int iframe)
+	{
+		fclaw2d_clawpatch_output_vtk(glob, iframe);
+		return read(name(iframe, ".vtu"));
+	}
+
+	/* Write a frame patch by patch, as fclaw2d_clawpatch_output_frame does */
+	std::string write_patches(int iframe)
+	{
+		fclaw2d_clawpatch_vtk_frame_t* frame =
+			fclaw2d_clawpatch_output_vtk_begin(glob, iframe);
+		REQUIRE(frame != NULL);
+		for(int i = 0; i < domain->blocks[0].num_patches; i++)
+		{
+			fclaw2d_clawpatch_output_vtk_patch(glob, frame,
+			                                   &domain->blocks[0].patches[i], 0, i);
+		}
+		CHECK(fclaw2d_clawpatch_output_vtk_end(glob, frame) == 0);
+		return read(name(iframe, ".vtu"));
+	}
+
+	static std::string read(const std::string& filename)
+	{
+		std::ifstream file(filename, std::ios::binary);
+		CHECK(file.good());
+		return std::string(std::istreambuf_iterator<char>(file),
+		                   std::istreambuf_iterator<char>());
+	}
+};
+}
+
+TEST_CASE("fclaw2d_vtk_round_mantissa relative error is at most 2^-(bits+1)")
+{
+	std::vector<float> v = test_values();
+	for(int bits : {1, 2, 4, 8, 10, 16, 22})
+	{
+		std::vector<float> r = v;
+		fclaw2d_vtk_round_mantissa(r.data(), (int64_t) r.size(), bits);
+
+		const double bound = std::ldexp(1.0, -(bits+1));
+		for(size_t i = 0; i < v.size(); i++)
+		{
+			CHECK(std::fabs((double) r[i] - (double) v[i]) <= bound*std::fabs((double) v[i]));
+			CHECK(std::signbit(r[i]) == std::signbit(v[i]));
+
+			/* the dropped bits are zero */
+			uint32_t u;
+			memcpy(&u, &r[i], sizeof(u));
+			CHECK((u & ((UINT32_C(1) << (23 - bits)) - 1)) == 0);
+		}
+	}
+}
+
+TEST_CASE("fclaw2d_vtk_round_mantissa keeps all bits for 23")
+{
+	std::vector<float> v = test_values();
+	std::vector<float> r = v;
+	fclaw2d_vtk_round_mantissa(r.data(), (int64_t) r.size(), 23);
+	CHECK(memcmp(r.data(), v.data(), v.size()*sizeof(float)) == 0);
+}
+
+TEST_CASE("fclaw2d_vtk_round_mantissa passes infinities and NaN through")
+{
+	float v[5] = {std::numeric_limits<float>::infinity(),
+	              -std::numeric_limits<float>::infinity(),
+	              std::numeric_limits<float>::quiet_NaN(),
+	              0.0f,
+	              -0.0f};
+	float r[5];
+	memcpy(r, v, sizeof(v));
+	fclaw2d_vtk_round_mantissa(r, 5, 4);
+
+	CHECK(memcmp(r, v, sizeof(v)) == 0);
+}
+
+TEST_CASE("fclaw2d_vtk_round_mantissa does not round up to infinity")
+{
+	float r[2] = {FLT_MAX, -FLT_MAX};
+	fclaw2d_vtk_round_mantissa(r, 2, 4);
+
+	CHECK(std::isfinite(r[0]));
+	CHECK(std::isfinite(r[1]));
+	CHECK(r[0] <= FLT_MAX);
+	CHECK(r[0] == -r[1]);
+	CHECK(std::fabs(r[0] - FLT_MAX) <= std::ldexp(1.0, -4)*FLT_MAX);
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_vtk vtk-cache-geometry writes the same files")
+{
+	std::vector<int> compress = {0};
+#ifdef SC_HAVE_ZLIB
+	compress.push_back(1);
+#endif
+	for(int c : compress)
+	{
+		VtkFrame f;
+		f.opts.vtk_compress = c;
+
+		f.opts.vtk_cache_geometry = 0;
+		std::string fresh = f.write(0);
+		CHECK(fclaw_pointer_map_get(f.glob->attributes, "fclaw2d_vtk_geometry") == NULL);
+
+		/* the first frame fills the cache, the second one uses it */
+		f.opts.vtk_cache_geometry = 1;
+		CHECK(f.write(1) == fresh);
+		CHECK(fclaw_pointer_map_get(f.glob->attributes, "fclaw2d_vtk_geometry") != NULL);
+
+		f.set_values(7);
+		std::string cached = f.write(2);
+		CHECK(cached != fresh);
+		CHECK(f.write_patches(3) == cached);
+
+		/* a new domain revision recomputes the mesh */
+		f.glob->domain_revision++;
+		CHECK(f.write_patches(4) == cached);
+		CHECK(f.write(5) == cached);
+
+		f.opts.vtk_cache_geometry = 0;
+		CHECK(f.write(6) == cached);
+		CHECK(f.write_patches(7) == cached);
+	}
+}
+
+TEST_CASE("fclaw2d_clawpatch_output_vtk vtk-amr writes an image per patch")
+{
+	VtkFrame f;
+	f.opts.vtk_amr = 1;
+	CHECK(fclaw2d_clawpatch_output_vtk_begin(f.glob, 0) == NULL);
+
+	fclaw2d_clawpatch_output_vtk(f.glob, 0);
+	std::string index = VtkFrame::read(f.name(0, ".vthb"));
+	CHECK(index.find("type=\"vtkOverlappingAMR\"") != std::string::npos);
+	CHECK(index.find("<Block level=\"0\" spacing=\"0.25 0.25 0.25\">\n  </Block>") != std::string::npos);
+	CHECK(index.find("<Block level=\"1\" spacing=\"0.125 0.125 0.125\">") != std::string::npos);
+
+	const int mx = f.opts.mx, my = f.opts.my, meqn = f.opts.meqn;
+	for(int p = 0; p < f.domain->blocks[0].num_patches; p++)
+	{
+		int pmx, pmy, mbc;
+		double xlower, ylower, dx, dy;
+		fclaw2d_clawpatch_grid_data(f.glob, &f.domain->blocks[0].patches[p],
+		                            &pmx, &pmy, &mbc, &xlower, &ylower, &dx, &dy);
+		const int i0 = (int) floor(xlower/dx + 0.5);
+		const int j0 = (int) floor(ylower/dy + 0.5);
+
+		char suffix[BUFSIZ];
+		snprintf(suffix, BUFSIZ, "_%06d.vti", p);
+		std::ostringstream dataset;
+		dataset << "amr_box=\"" << i0 << " " << i0 + mx - 1 << " "
+		        << j0 << " " << j0 + my - 1 << " 0 -1\" "
+		        << "file=\"" << f.fopts.prefix << "_frame_0000" << suffix << "\"/>";
+		CHECK(index.find(dataset.str()) != std::string::npos);
+
+		/* the appended data is the byte count and the cell values */
+		std::string image = VtkFrame::read(f.name(0, suffix));
+		size_t pos = image.find("<AppendedData encoding=\"raw\">\n  _");
+		REQUIRE(pos != std::string::npos);
+		pos = image.find('_', pos) + 1;
+
+		uint64_t bcount;
+		REQUIRE(image.size() >= pos + sizeof(bcount));
+		memcpy(&bcount, image.data() + pos, sizeof(bcount));
+		REQUIRE(bcount == (uint64_t) mx*my*meqn*sizeof(float));
+		REQUIRE(image.size() >= pos + sizeof(bcount) + bcount);
+
+		std::vector<float> v(mx*my*meqn);
+		memcpy(v.data(), image.data() + pos + sizeof(bcount), bcount);
+		for(int j = 0; j < my; j++)
+			for(int i = 0; i < mx; i++)
+				for(int m = 0; m < meqn; m++)
+					CHECK(v[(j*mx + i)*meqn + m] == VtkFrame::value(0,p,i,j,m));
+	}
+}
+
+#ifdef SC_HAVE_ZLIB
+TEST_CASE("fclaw2d_vtk_compress_blocks round trip through the vtkZLibDataCompressor layout")
+{
+	const int lnum = 5;
+	for(int64_t psize : {(int64_t) 4, (int64_t) 1000, (int64_t) 65536})
+	{
+		std::vector<char> raw(psize*lnum);
+		for(size_t i = 0; i < raw.size(); i++)
+		{
+			/* compressible, but different in every block */
+			raw[i] = (char) ((i/7) % 13 + 3*(i/psize));
+		}
+
+		char *zdata;
+		uint64_t *zsize;
+		int64_t total = fclaw2d_vtk_compress_blocks(raw.data(), psize, lnum,
+		                                            &zdata, &zsize);
+
+		/* lay out the array like fclaw2d_vtk_write_compressed_field */
+		const uint64_t head[3] = {(uint64_t) lnum, (uint64_t) psize, 0};
+		std::vector<char> file(sizeof(head) + sizeof(uint64_t)*lnum + total);
+		memcpy(file.data(), head, sizeof(head));
+		memcpy(file.data() + sizeof(head), zsize, sizeof(uint64_t)*lnum);
+		memcpy(file.data() + sizeof(head) + sizeof(uint64_t)*lnum, zdata, total);
+		FCLAW_FREE(zdata);
+		FCLAW_FREE(zsize);
+
+		/* read it back like a VTK reader */
+		uint64_t nblocks, blocksize, lastsize;
+		memcpy(&nblocks, file.data(), sizeof(uint64_t));
+		memcpy(&blocksize, file.data() + 8, sizeof(uint64_t));
+		memcpy(&lastsize, file.data() + 16, sizeof(uint64_t));
+		REQUIRE(nblocks == (uint64_t) lnum);
+		CHECK(blocksize == (uint64_t) psize);
+		CHECK(lastsize == 0);
+
+		std::vector<uint64_t> sizes(nblocks);
+		memcpy(sizes.data(), file.data() + 24, sizeof(uint64_t)*nblocks);
+
+		size_t pos = 24 + sizeof(uint64_t)*nblocks;
+		std::vector<char> out(psize);
+		for(uint64_t b = 0; b < nblocks; b++)
+		{
+			uLongf len = (uLongf) blocksize;
+			int ret = uncompress((Bytef*) out.data(), &len,
+			                     (const Bytef*) file.data() + pos, (uLong) sizes[b]);
+			REQUIRE(ret == Z_OK);
+			CHECK(len == (uLongf) psize);
+			CHECK(memcmp(out.data(), raw.data() + b*psize, psize) == 0);
+			pos += sizes[b];
+		}
+		CHECK(pos == file.size());
+	}
+}
+#endif
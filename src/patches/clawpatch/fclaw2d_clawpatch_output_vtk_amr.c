@@ -0,0 +1,309 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/* vtkOverlappingAMR output : one ImageData file per patch, listed by level
+   in a .vthb file.  Only the origin and spacing of a patch are written, 
+   so the files hold almost nothing but the solution. */
+
+#include <fclaw2d_clawpatch_output_vtk_amr.h>
+
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_global.h>
+#include <fclaw2d_options.h>
+#include <fclaw2d_output.h>
+#include <fclaw_async_writer.h>
+
+#include <math.h>
+#include <string.h>
+
+typedef struct fclaw2d_vtk_amr_state
+{
+    const char *basename;
+    int mx, my, meqn;
+    fclaw2d_vtk_patch_data_t value_cb;
+    double ax, ay;          /* origin of the hierarchy */
+    double dx0, dy0;        /* spacing on level 0 */
+    int *boxes;             /* level, i0, j0 of each local patch */
+    char *buf;
+    fclaw_async_writer_t *writer;   /* stage files instead of writing them */
+    int retval;
+}
+fclaw2d_vtk_amr_state_t;
+
+static int
+vtk_write_patch_image (fclaw2d_vtk_amr_state_t * s, const char *filename,
+                       double xlower, double ylower, double dx, double dy)
+{
+    static const char footer[] = "\n </AppendedData>\n</VTKFile>\n";
+    const uint64_t bcount = (uint64_t) s->mx * s->my * s->meqn * sizeof (float);
+    char header[BUFSIZ];
+    FILE *file;
+    int retval;
+
+    const int hsize =
+        snprintf (header, BUFSIZ,
+                  "<?xml version=\"1.0\"?>\n"
+                  "<VTKFile type=\"ImageData\" version=\"0.1\" "
+                  "byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+                  " <ImageData WholeExtent=\"0 %d 0 %d 0 0\" "
+                  "Origin=\"%.16g %.16g 0\" "
+                  "Spacing=\"%.16g %.16g %.16g\">\n"
+                  "  <Piece Extent=\"0 %d 0 %d 0 0\">\n"
+                  "   <CellData Scalars=\"meqn\">\n"
+                  "    <DataArray type=\"Float32\" Name=\"meqn\" "
+                  "NumberOfComponents=\"%d\" format=\"appended\" "
+                  "offset=\"0\">\n"
+                  "    </DataArray>\n"
+                  "   </CellData>\n"
+                  "  </Piece>\n"
+                  " </ImageData>\n"
+                  " <AppendedData encoding=\"raw\">\n  _",
+                  s->mx, s->my, xlower, ylower, dx, dy, dx,
+                  s->mx, s->my, s->meqn);
+    if (hsize < 0 || hsize >= BUFSIZ)
+    {
+        return -1;
+    }
+
+    if (s->writer != NULL)
+    {
+        /* stage the whole file */
+        const size_t size = hsize + sizeof (bcount) + bcount + strlen (footer);
+        char *buf = fclaw_async_writer_buffer (s->writer, size);
+        char *b = buf;
+        memcpy (b, header, hsize);
+        b += hsize;
+        memcpy (b, &bcount, sizeof (bcount));
+        b += sizeof (bcount);
+        memcpy (b, s->buf, bcount);
+        b += bcount;
+        memcpy (b, footer, strlen (footer));
+        fclaw_async_writer_write (s->writer, filename,
+                                  FCLAW_ASYNC_WRITER_REPLACE, buf, size);
+        return 0;
+    }
+
+    file = fopen (filename, "wb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    /* stop writing after first unsuccessful operation */
+    retval = 0;
+    retval = retval || fwrite (header, hsize, 1, file) != 1;
+    retval = retval || fwrite (&bcount, sizeof (bcount), 1, file) != 1;
+    retval = retval || fwrite (s->buf, bcount, 1, file) != 1;
+    retval = retval || fputs (footer, file) < 0;
+
+    /* unconditionally close the file */
+    retval = fclose (file) || retval;
+
+    return retval ? -1 : 0;
+}
+
+static void
+fclaw2d_vtk_amr_patch_cb (fclaw2d_domain_t * domain, fclaw2d_patch_t * patch,
+                          int blockno, int patchno, void *user)
+{
+    fclaw2d_global_iterate_t *g = (fclaw2d_global_iterate_t*) user;
+    fclaw2d_vtk_amr_state_t *s = (fclaw2d_vtk_amr_state_t *) g->user;
+
+    int mx,my,mbc;
+    double xlower,ylower,dx,dy;
+    fclaw2d_clawpatch_grid_data(g->glob,patch,&mx,&my,&mbc,
+                                &xlower,&ylower,&dx,&dy);
+
+    const int local = domain->blocks[blockno].num_patches_before + patchno;
+    const int64_t gpno = domain->global_num_patches_before + local;
+
+    int *box = &s->boxes[3*local];
+    box[0] = patch->level;
+    box[1] = (int) floor ((xlower - s->ax) / dx + 0.5);
+    box[2] = (int) floor ((ylower - s->ay) / dy + 0.5);
+
+    s->dx0 = SC_MAX (s->dx0, dx * (1 << patch->level));
+    s->dy0 = SC_MAX (s->dy0, dy * (1 << patch->level));
+
+    char filename[BUFSIZ];
+    snprintf (filename, BUFSIZ, "%s_%06lld.vti", s->basename, (long long) gpno);
+
+    s->value_cb (g->glob, patch, blockno, patchno, s->buf);
+    if (s->retval == 0)
+    {
+        s->retval = vtk_write_patch_image (s, filename, xlower, ylower, dx, dy);
+    }
+}
+
+static int
+vtk_write_amr_index (fclaw2d_global_t * glob, fclaw2d_vtk_amr_state_t * s,
+                     const int *boxes)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    FILE *file;
+    int retval;
+    int level, n;
+    int64_t p;
+    char filename[BUFSIZ];
+
+    /* patch files are referenced relative to the index file */
+    const char *base = strrchr (s->basename, '/');
+    base = base != NULL ? base + 1 : s->basename;
+
+    snprintf (filename, BUFSIZ, "%s.vthb", s->basename);
+    file = fopen (filename, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    retval = 0;
+    retval = retval || fprintf (file, "<?xml version=\"1.0\"?>\n") < 0;
+    retval = retval || fprintf (file, "<VTKFile type=\"vtkOverlappingAMR\" "
+                                "version=\"1.1\" "
+                                "byte_order=\"LittleEndian\" "
+                                "header_type=\"UInt64\">\n") < 0;
+    retval = retval || fprintf (file, " <vtkOverlappingAMR "
+                                "origin=\"%.16g %.16g 0\" "
+                                "grid_description=\"XY\">\n",
+                                s->ax, s->ay) < 0;
+    for (level = 0; level <= domain->global_maxlevel; ++level)
+    {
+        const double dx = s->dx0 / (1 << level);
+        const double dy = s->dy0 / (1 << level);
+        retval = retval || fprintf (file, "  <Block level=\"%d\" "
+                                    "spacing=\"%.16g %.16g %.16g\">\n",
+                                    level, dx, dy, dx) < 0;
+        n = 0;
+        for (p = 0; p < domain->global_num_patches; ++p)
+        {
+            const int *box = &boxes[3*p];
+            if (box[0] != level)
+            {
+                continue;
+            }
+            retval = retval || fprintf (file, "   <DataSet index=\"%d\" "
+                                        "amr_box=\"%d %d %d %d 0 -1\" "
+                                        "file=\"%s_%06lld.vti\"/>\n",
+                                        n++, box[1], box[1] + s->mx - 1,
+                                        box[2], box[2] + s->my - 1,
+                                        base, (long long) p) < 0;
+        }
+        retval = retval || fprintf (file, "  </Block>\n") < 0;
+    }
+    retval = retval || fprintf (file, " </vtkOverlappingAMR>\n") < 0;
+    retval = retval || fprintf (file, "</VTKFile>\n") < 0;
+
+    retval = fclose (file) || retval;
+
+    return retval ? -1 : 0;
+}
+
+int
+fclaw2d_clawpatch_output_vtk_amr (fclaw2d_global_t * glob,
+                                  const char *basename,
+                                  int mx, int my, int meqn,
+                                  fclaw2d_vtk_patch_data_t value_cb)
+{
+    fclaw2d_domain_t *domain = glob->domain;
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+
+    int mpiret, gretval;
+    fclaw2d_vtk_amr_state_t ps, *s = &ps;
+    double d0[2], gd0[2];
+
+    s->basename = basename;
+    s->mx = mx;
+    s->my = my;
+    s->meqn = meqn;
+    s->value_cb = value_cb;
+    s->ax = fclaw_opt->ax;
+    s->ay = fclaw_opt->ay;
+    s->dx0 = 0;
+    s->dy0 = 0;
+    s->retval = 0;
+    s->writer = fclaw2d_output_writer (glob);
+    s->boxes = FCLAW_ALLOC (int, 3*domain->local_num_patches);
+    s->buf = FCLAW_ALLOC (char, mx * my * meqn * sizeof (float));
+
+    fclaw2d_global_iterate_patches (glob, fclaw2d_vtk_amr_patch_cb, s);
+    FCLAW_FREE (s->buf);
+
+    /* spacing on level 0 is the same for all patches */
+    d0[0] = s->dx0;
+    d0[1] = s->dy0;
+    mpiret = sc_MPI_Allreduce (d0, gd0, 2, sc_MPI_DOUBLE, sc_MPI_MAX,
+                               domain->mpicomm);
+    SC_CHECK_MPI (mpiret);
+    s->dx0 = gd0[0];
+    s->dy0 = gd0[1];
+
+    /* collect the boxes of all patches in global order on rank 0 */
+    int *boxes = NULL;
+    int *counts = NULL;
+    int *displs = NULL;
+    int count = 3*domain->local_num_patches;
+    if (domain->mpirank == 0)
+    {
+        boxes = FCLAW_ALLOC (int, 3*domain->global_num_patches);
+        counts = FCLAW_ALLOC (int, domain->mpisize);
+        displs = FCLAW_ALLOC (int, domain->mpisize);
+    }
+    mpiret = sc_MPI_Gather (&count, 1, sc_MPI_INT, counts, 1, sc_MPI_INT,
+                            0, domain->mpicomm);
+    SC_CHECK_MPI (mpiret);
+    if (domain->mpirank == 0)
+    {
+        int q;
+        displs[0] = 0;
+        for (q = 1; q < domain->mpisize; ++q)
+        {
+            displs[q] = displs[q-1] + counts[q-1];
+        }
+    }
+    mpiret = sc_MPI_Gatherv (s->boxes, count, sc_MPI_INT,
+                             boxes, counts, displs, sc_MPI_INT,
+                             0, domain->mpicomm);
+    SC_CHECK_MPI (mpiret);
+    FCLAW_FREE (s->boxes);
+
+    if (domain->mpirank == 0)
+    {
+        if (s->retval == 0)
+        {
+            s->retval = vtk_write_amr_index (glob, s, boxes);
+        }
+        FCLAW_FREE (boxes);
+        FCLAW_FREE (counts);
+        FCLAW_FREE (displs);
+    }
+
+    mpiret = sc_MPI_Allreduce (&s->retval, &gretval, 1, sc_MPI_INT, sc_MPI_MIN,
+                               domain->mpicomm);
+    SC_CHECK_MPI (mpiret);
+
+    return gretval < 0 ? -1 : 0;
+}
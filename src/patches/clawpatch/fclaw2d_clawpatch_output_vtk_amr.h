@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2012-2021 Carsten Burstedde, Donna Calhoun, Scott Aiton
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef FCLAW2D_CLAWPATCH_OUTPUT_VTK_AMR_H
+#define FCLAW2D_CLAWPATCH_OUTPUT_VTK_AMR_H
+
+/** 
+ * @file
+ * vtkOverlappingAMR output for 2d patches without a mapping
+ */
+
+#include <fclaw2d_clawpatch_output_vtk.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#if 0
+}                               /* need this because indent is dumb */
+#endif
+#endif
+
+struct fclaw2d_global;
+
+/** 
+ * Write one ImageData (.vti) file per patch and a .vthb index file that 
+ * lists the patches by level.
+ * @param[in] glob the global context
+ * @param[in] basename the base filename
+ * @param[in] mx, my the number of cells in the x and y directions
+ * @param[in] meqn the number of equations
+ * @param[in] value_cb the callback to write a patch's value binary data
+ * @return          0 if successful, negative otherwise.
+ *                  Collective with identical value on all ranks.
+ */
+int fclaw2d_clawpatch_output_vtk_amr (struct fclaw2d_global * glob,
+                                      const char *basename,
+                                      int mx, int my, int meqn,
+                                      fclaw2d_vtk_patch_data_t value_cb);
+
+#ifdef __cplusplus
+#if 0
+{                               /* need this because indent is dumb */
+#endif
+}
+#endif
+
+#endif /* !FCLAW2D_CLAWPATCH_OUTPUT_VTK_AMR_H */
@@ -237,6 +237,8 @@ fclaw2d_clawpatch_pillow_vtable_t* pillow_vt_init()
 }
 #endif
 
+static int vt_slot = -1;
+
 void fclaw2d_clawpatch_pillow_vtable_initialize(fclaw2d_global_t* glob,
                                                 int claw_version)
 {
@@ -268,6 +270,7 @@ void fclaw2d_clawpatch_pillow_vtable_initialize(fclaw2d_global_t* glob,
 
     FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables, PILLOW_VTABLE_NAME) == NULL);
     fclaw_pointer_map_insert(glob->vtables, PILLOW_VTABLE_NAME, pillow_vt, pillow_vt_destroy);
+    vt_slot = fclaw_pointer_map_slot(PILLOW_VTABLE_NAME);
 
 }
 
@@ -277,10 +280,8 @@ void fclaw2d_clawpatch_pillow_vtable_initialize(fclaw2d_global_t* glob,
 
 fclaw2d_clawpatch_pillow_vtable_t* fclaw2d_clawpatch_pillow_vt(fclaw2d_global_t* glob)
 {
-
     fclaw2d_clawpatch_pillow_vtable_t* pillow_vt = (fclaw2d_clawpatch_pillow_vtable_t*) 
-        fclaw_pointer_map_get(glob->vtables, 
-                              PILLOW_VTABLE_NAME);
+        fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 
     FCLAW_ASSERT(pillow_vt != NULL);
     FCLAW_ASSERT(pillow_vt->is_set != 0);
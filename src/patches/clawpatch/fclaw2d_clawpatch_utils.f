@@ -116,6 +116,94 @@ c     # calls to T.
 
       end
 
+c     ---------------------------------------------------------------
+c>    @brief Determines the index map to a same size neighbor's
+c>    coordinate system
+c>
+c>    The map has the form T(i1,j1) = A*(i1,j1) + F = (i2,j2), so it
+c>    can be recovered from three index transforms and then applied
+c>    to every ghost cell, instead of calling the transform for each
+c>    ghost cell.  Within a block, A is the identity.
+c>
+c>    @param[in]  transform_ptr the pointer to the transform data
+c>    @param[in]  corner 1 for a corner neighbor, 0 for a face neighbor
+c>    @param[out] a the 2x2 tranform matrix
+c>    @param[out] f the transform vector
+c     ---------------------------------------------------------------
+      subroutine fclaw2d_clawpatch_build_transform_samesize(
+     &      transform_ptr,corner,a,f)
+      implicit none
+
+      integer*8 transform_ptr
+      integer corner, a(2,2), f(2)
+      integer i1(0:2),j1(0:2),i2(0:2),j2(0:2)
+      integer m
+
+      data i1 /0,1,0/, j1 /0,0,1/
+
+      do m = 0,2
+         if (corner .eq. 0) then
+            call fclaw2d_clawpatch_transform_face(i1(m),j1(m),
+     &            i2(m),j2(m),transform_ptr)
+         else
+            call fclaw2d_clawpatch_transform_corner(i1(m),j1(m),
+     &            i2(m),j2(m),transform_ptr)
+         endif
+      enddo
+
+      f(1) = i2(0)
+      f(2) = j2(0)
+      a(1,1) = i2(1) - f(1)
+      a(2,1) = j2(1) - f(2)
+      a(1,2) = i2(2) - f(1)
+      a(2,2) = j2(2) - f(2)
+
+      end
+
+c     ---------------------------------------------------------------
+c>    @brief Determines the index map from a coarse patch to all
+c>    fine cells of its half-sized neighbor
+c>
+c>    Fine cell m of coarse cell (ic,jc) is A*(ic,jc) + F(:,m).  This
+c>    replaces one call to the half size transform per ghost cell.
+c>
+c>    @param[in]  transform_ptr the pointer to the transform data
+c>    @param[in]  corner 1 for a corner neighbor, 0 for a face neighbor
+c>    @param[out] a the 2x2 tranform matrix
+c>    @param[out] f the transform vector for each of the four fine cells
+c     ---------------------------------------------------------------
+      subroutine fclaw2d_clawpatch_build_transform_children(
+     &      transform_ptr,corner,a,f)
+      implicit none
+
+      integer*8 transform_ptr
+      integer corner, a(2,2), f(2,0:3)
+      integer i1(0:2),j1(0:2),mi(0:3,0:2),mj(0:3,0:2)
+      integer k, m
+
+      data i1 /0,1,0/, j1 /0,0,1/
+
+      do k = 0,2
+         if (corner .eq. 0) then
+            call fclaw2d_clawpatch_transform_face_half(i1(k),j1(k),
+     &            mi(0,k),mj(0,k),transform_ptr)
+         else
+            call fclaw2d_clawpatch_transform_corner_half(i1(k),j1(k),
+     &            mi(0,k),mj(0,k),transform_ptr)
+         endif
+      enddo
+
+      do m = 0,3
+         f(1,m) = mi(m,0)
+         f(2,m) = mj(m,0)
+      enddo
+      a(1,1) = mi(0,1) - f(1,0)
+      a(2,1) = mj(0,1) - f(2,0)
+      a(1,2) = mi(0,2) - f(1,0)
+      a(2,2) = mj(0,2) - f(2,0)
+
+      end
+
 c --------------------------------------------------------------------
 c> @brief checks if the index is in the range given
 c>
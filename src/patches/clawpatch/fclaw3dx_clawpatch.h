@@ -284,6 +284,9 @@ struct fclaw3dx_clawpatch_vtable
 
     /** @} */
 
+    /** The version of clawpack (4 for 4.6, 5 for 5) */
+    int claw_version;
+
     /** @{ @name Diagnostics */
 
     /** Whether or not this vtable is set */
@@ -477,6 +480,43 @@ void fclaw3dx_clawpatch_elliptic_soln_data(struct fclaw2d_global* glob,
                                            double **soln, 
                                            int *mfields);
 
+/**
+ * @brief Get the work array that elliptic solvers iterate on
+ * 
+ * The array has the same layout as the rhs.  It is allocated and set 
+ * to zero the first time it is requested for a patch.
+ * 
+ * @param[in]  glob the global context
+ * @param[in]  this_patch the patch context
+ * @param[out] work the work array
+ * @param[out] mfields the number fields
+ */
+void fclaw3dx_clawpatch_elliptic_work_data(struct fclaw2d_global* glob,
+                                           struct fclaw2d_patch* patch,
+                                           double **work, 
+                                           int *mfields);
+
+/**
+ * @brief Exchange the rhs and the elliptic work array without copying
+ * 
+ * If the work array has not been allocated, it is allocated and set to 
+ * zero, and the rhs is left as is.
+ * 
+ * @param[in]  glob the global context
+ * @param[in]  this_patch the patch context
+ */
+void fclaw3dx_clawpatch_elliptic_swap_rhs(struct fclaw2d_global* glob,
+                                          struct fclaw2d_patch* patch);
+
+/**
+ * @brief Free the elliptic work array
+ * 
+ * @param[in]  glob the global context
+ * @param[in]  this_patch the patch context
+ */
+void fclaw3dx_clawpatch_elliptic_work_delete(struct fclaw2d_global* glob,
+                                             struct fclaw2d_patch* patch);
+
 /**
  * @brief Get the solution data for a patch
  * 
@@ -207,6 +207,7 @@ TEST_CASE("fclaw3dx_clawpatch_vtable_initialize")
     CHECK(clawpatch_vt->fort_compute_error_norm     == NULL);
     CHECK(clawpatch_vt->fort_compute_patch_area     == NULL);
 
+    CHECK(clawpatch_vt->claw_version                == 4);
     CHECK(clawpatch_vt->is_set                      == 1);
 
     fclaw2d_patch_vtable_t * patch_vt = fclaw2d_patch_vt(glob);
@@ -300,11 +301,8 @@ TEST_CASE("fclaw3dx_clawpatch patch_build")
             CHECK_BOX_EMPTY(cp->griddata_last);
             CHECK_BOX_EMPTY(cp->griddata_save);
         }
-        if(fopts.subcycle){
-            CHECK_BOX_DIMENSIONS(cp->griddata_time_interpolated, opts.mbc, opts.mx, opts.my, opts.mz, opts.meqn);
-        }else{
-            CHECK_BOX_EMPTY(cp->griddata_time_interpolated);
-        }
+        /* allocated when it is first used */
+        CHECK_BOX_EMPTY(cp->griddata_time_interpolated);
         if(fopts.compute_error) {
             CHECK_BOX_DIMENSIONS(cp->griderror, opts.mbc, opts.mx, opts.my, opts.mz, opts.meqn);
             CHECK_BOX_DIMENSIONS(cp->exactsolution, opts.mbc, opts.mx, opts.my, opts.mz, opts.meqn);
@@ -535,6 +533,15 @@ TEST_CASE("fclaw3dx_clawpatch_get_registers")
     fclaw3dx_clawpatch_t* cp = fclaw3dx_clawpatch_get_clawpatch(&test_data.domain->blocks[0].patches[0]);
 
     CHECK(fclaw3dx_clawpatch_get_registers(test_data.glob,&test_data.domain->blocks[0].patches[0]) == cp->registers);
+
+    //no flux registers without time sync
+    CHECK(cp->registers->face_mask == 0);
+    for(int k = 0; k < 4; k++)
+    {
+        CHECK(cp->registers->edge_fluxes[k] == nullptr);
+        CHECK(cp->registers->edgelengths[k] != nullptr);
+        CHECK(cp->registers->area[k] != nullptr);
+    }
 }
 
 TEST_CASE("fclaw3dx_clawpatch_get_error")
@@ -573,6 +580,7 @@ TEST_CASE("fclaw3dx_clawpatch_timesync_data")
 
         if(time_interp){
             CHECK(q == cp->griddata_time_interpolated.dataPtr());
+            CHECK_BOX_DIMENSIONS(cp->griddata_time_interpolated, test_data.opts.mbc, test_data.opts.mx, test_data.opts.my, test_data.opts.mz, test_data.opts.meqn);
         } else {
             CHECK(q == cp->griddata.dataPtr());
         }
@@ -793,6 +801,55 @@ TEST_CASE("fclaw3dx_clawpatch setup_timeinterp")
     fclaw2d_patch_setup_timeinterp(test_data.glob, &test_data.domain->blocks[0].patches[0], 
                                    timeinterp_alpha);
 }
+TEST_CASE("fclaw3dx_clawpatch setup_timeinterp with time-interp-ring")
+{
+    SinglePatchDomain test_data;
+    test_data.opts.interp_stencil_width=2;
+    test_data.opts.meqn = 2;
+    test_data.opts.time_interp_ring = 1;
+    test_data.setup();
+
+    fclaw2d_patch_t* patch = &test_data.domain->blocks[0].patches[0];
+    fclaw3dx_clawpatch_t* cp = fclaw3dx_clawpatch_get_clawpatch(patch);
+
+    int mint = 2;
+    CHECK_BOX_EMPTY(cp->griddata_last);
+    CHECK(cp->griddata_last_ring.size() == (size_t) (cp->mx*cp->my*cp->mz
+                     - (cp->mx-2*mint)*(cp->my-2*mint)*cp->mz)*cp->meqn);
+
+    /* Compare with the full storage Fortran kernel */
+    int size = cp->griddata.size();
+    std::vector<double> qlast(size), qinterp(size);
+    for(int i = 0; i < size; i++)
+    {
+        qlast[i] = i;
+        cp->griddata.dataPtr()[i] = i;
+    }
+    fclaw3dx_clawpatch_save_current_step(test_data.glob, patch);
+    double* qsync = fclaw3dx_clawpatch_get_q_timesync(test_data.glob, patch, 1);
+    for(int i = 0; i < size; i++)
+    {
+        cp->griddata.dataPtr()[i] = 2*i + 1;
+        qsync[i] = 0;
+        qinterp[i] = 0;
+    }
+
+    double alpha = 0.90210;
+    fclaw2d_patch_setup_timeinterp(test_data.glob, patch, alpha);
+
+    int psize = cp->griddata_last_ring.size();
+    int ierror;
+    FCLAW3DX_CLAWPATCH46_FORT_TIMEINTERP(&cp->mx, &cp->my, &cp->mz, &cp->mbc, 
+                                         &cp->meqn, &psize,
+                                         cp->griddata.dataPtr(), qlast.data(),
+                                         qinterp.data(), &alpha, &ierror);
+    CHECK(ierror == 0);
+    for(int i = 0; i < size; i++)
+    {
+        CHECK(cp->griddata_time_interpolated.dataPtr()[i] == qinterp[i]);
+    }
+}
+
 namespace{
     fclaw3dx_clawpatch_t* t4r_cp;
     int t4r_tag_patch;
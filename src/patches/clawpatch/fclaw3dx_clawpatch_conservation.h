@@ -71,6 +71,11 @@ struct fclaw3dx_clawpatch_registers
 	double *gp[2];
     /** Fluxes along the top face */
 	double *gm[2];
+
+	/** Faces with flux registers : bit k is set if face k borders a patch
+	    at a different level or in a different block.  For the other faces,
+	    edge_fluxes, fp, fm, gp and gm are NULL. */
+	int face_mask;
 };
 
 /**
@@ -200,6 +205,45 @@ void fclaw3dx_clawpatch_time_sync_new(struct fclaw2d_global* glob,
  */
 void fclaw3dx_clawpatch_time_sync_delete(fclaw3dx_clawpatch_registers_t **registers);
 
+/**
+ * @brief Allocate registers for the faces that need them and free the others
+ * 
+ * The faces are found from the neighbor types of a local patch.  Registers 
+ * of a new face are zero.  Nothing is done for ghost patches, patches 
+ * without neighbor types or if time-sync is not set.
+ * 
+ * @param[in] glob the global context
+ * @param[in] this_patch the patch context
+ * @param[in,out] registers the registers of the patch
+ */
+void fclaw3dx_clawpatch_time_sync_set_faces(struct fclaw2d_global* glob,
+                                            struct fclaw2d_patch* this_patch,
+                                            fclaw3dx_clawpatch_registers_t *registers);
+
+/**
+ * @brief Get the size of the work array for ::fclaw3dx_clawpatch_time_sync_fill_faces
+ * 
+ * @param[in] glob the global context
+ * @return the number of doubles
+ */
+int fclaw3dx_clawpatch_time_sync_work_size(struct fclaw2d_global* glob);
+
+/**
+ * @brief Copy the registers, with faces without registers taken from a work array
+ * 
+ * Routines that visit all four faces can be called with the copy.  Values 
+ * written to the work array are never used.
+ * 
+ * @param[in] glob the global context
+ * @param[in] registers the registers of a patch
+ * @param[in] work array of ::fclaw3dx_clawpatch_time_sync_work_size doubles
+ * @param[out] filled the registers with all faces set
+ */
+void fclaw3dx_clawpatch_time_sync_fill_faces(struct fclaw2d_global* glob,
+                                             const fclaw3dx_clawpatch_registers_t *registers,
+                                             double *work,
+                                             fclaw3dx_clawpatch_registers_t *filled);
+
 /**
  * @brief Inialize the area and edgelength arrays of the registers
  * 
@@ -84,6 +84,31 @@ struct fclaw3dx_clawpatch_options
     int interp_stencil_width; /**< The width of the interpolation stencil */
     int ghost_patch_pack_aux; /**< True if aux equations should be packed */
     int save_aux;             /**< Save the aux array when retaking a time step */
+    int time_interp_ring;     /**< Store only the ring of the last time step
+                                   used for time interpolation */
+
+    /* VTK output */
+    int vtk_amr;              /**< Write vtkOverlappingAMR image data instead of 
+                                   an unstructured grid */
+    int vtk_cache_geometry;   /**< Keep the VTK mesh arrays in memory between 
+                                   frames while the domain is unchanged */
+    int vtk_compress;         /**< Compress VTK data arrays with zlib, one block 
+                                   per patch */
+    int vtk_mantissa_bits;    /**< Mantissa bits kept in the VTK solution; less 
+                                   than 23 rounds the values (lossy) */
+
+    /* Output filters */
+    int output_filter_interval; /**< Frames that are a multiple of this are 
+                                     written in full; 0 filters every frame */
+    const char *output_box_string;  
+    double *output_box;       /**< xlow xhigh ylow yhigh of the patches written */
+    const char *output_blocks_string;
+    int *output_blocks;       /**< Blocks written, or NULL for all blocks */
+    int output_num_blocks;    /**< Length of output_blocks */
+    int output_maxlevel;      /**< Finer patches are averaged down to this 
+                                   level, one patch per family; -1 for no 
+                                   cap */
+    int output_stride;        /**< Write every stride-th cell */
 
     int is_registered; /**< true if options have been registered */
 
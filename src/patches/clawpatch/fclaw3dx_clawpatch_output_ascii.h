@@ -71,6 +71,73 @@ void fclaw3dx_clawpatch_output_ascii(struct fclaw2d_global* glob,int iframe);
 void fclaw3dx_clawpatch_time_header_ascii(struct fclaw2d_global* glob, int iframe);
 
 
+/** A fort.q file that is filled patch by patch */
+typedef struct fclaw3dx_clawpatch_ascii_frame fclaw3dx_clawpatch_ascii_frame_t;
+
+/**
+ * @brief Write a value like the Fortran edit descriptor Ew.d
+ * 
+ * @param s the output, of at least width+1 characters
+ * @param value the value
+ * @param width the field width w
+ * @param digits the number of digits d
+ * @return the number of characters written
+ */
+int fclaw3dx_clawpatch_output_ascii_fortran_e(char *s, double value,
+                                              int width, int digits);
+
+/**
+ * @brief Begin a fort.q file that is filled patch by patch
+ * 
+ * Writes the time header to the prefixed fort.t file, and empties the 
+ * prefixed fort.q file.  Used by ::fclaw2d_clawpatch_output_frame.
+ * 
+ * @param glob the global context
+ * @param iframe the frame index
+ * @return the file, or NULL if the ascii output routines are not the 
+ *         defaults;  use ::fclaw3dx_clawpatch_output_ascii in that case
+ */
+fclaw3dx_clawpatch_ascii_frame_t*
+fclaw3dx_clawpatch_output_ascii_begin(struct fclaw2d_global* glob, int iframe);
+
+/**
+ * @brief Format one local patch
+ * 
+ * Different patches may be formatted by different threads, unless the 
+ * frame is filtered.
+ * 
+ * @param glob the global context
+ * @param frame the file from ::fclaw3dx_clawpatch_output_ascii_begin
+ * @param patch the patch context
+ * @param blockno the block number
+ * @param patchno the patch number
+ */
+void fclaw3dx_clawpatch_output_ascii_patch(struct fclaw2d_global* glob,
+                                           fclaw3dx_clawpatch_ascii_frame_t* frame,
+                                           struct fclaw2d_patch* patch,
+                                           int blockno, int patchno);
+
+/**
+ * @brief Format all local patches, in parallel with OpenMP
+ * 
+ * @param glob the global context
+ * @param frame the file from ::fclaw3dx_clawpatch_output_ascii_begin
+ */
+void fclaw3dx_clawpatch_output_ascii_patches(struct fclaw2d_global* glob,
+                                             fclaw3dx_clawpatch_ascii_frame_t* frame);
+
+/**
+ * @brief Write the formatted patches of all ranks
+ * 
+ * Collective.  Frees the file.
+ * 
+ * @param glob the global context
+ * @param frame the file from ::fclaw3dx_clawpatch_output_ascii_begin
+ */
+void fclaw3dx_clawpatch_output_ascii_end(struct fclaw2d_global* glob,
+                                         fclaw3dx_clawpatch_ascii_frame_t* frame);
+
+
 #ifdef __cplusplus
 }
 #endif
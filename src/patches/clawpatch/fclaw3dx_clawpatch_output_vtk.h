@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Routines for vtk output 
  */
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -93,6 +95,82 @@ fclaw3dx_vtk_write_file (struct fclaw2d_global * glob, const char *basename,
 void fclaw3dx_clawpatch_output_vtk (struct fclaw2d_global* glob, int iframe);
 
 
+/** A vtu file that is filled patch by patch */
+typedef struct fclaw3dx_clawpatch_vtk_frame fclaw3dx_clawpatch_vtk_frame_t;
+
+/**
+ * @brief Begin a vtu file that is filled patch by patch
+ * 
+ * Writes the header.  Collective.  Used by ::fclaw2d_clawpatch_output_frame.
+ * 
+ * @param glob the global context
+ * @param iframe the frame index
+ * @return the file, or NULL if the options ask for vtkOverlappingAMR output;
+ *         use ::fclaw3dx_clawpatch_output_vtk in that case
+ */
+fclaw3dx_clawpatch_vtk_frame_t*
+fclaw3dx_clawpatch_output_vtk_begin (struct fclaw2d_global* glob, int iframe);
+
+/**
+ * @brief Compute the data arrays of one local patch
+ * 
+ * @param glob the global context
+ * @param frame the file from ::fclaw3dx_clawpatch_output_vtk_begin
+ * @param patch the patch context
+ * @param blockno the block number
+ * @param patchno the patch number
+ */
+void fclaw3dx_clawpatch_output_vtk_patch (struct fclaw2d_global* glob,
+                                          fclaw3dx_clawpatch_vtk_frame_t* frame,
+                                          struct fclaw2d_patch* patch,
+                                          int blockno, int patchno);
+
+/**
+ * @brief Write the data of all local patches and the footer
+ * 
+ * Collective.  Every local patch must have been passed to 
+ * ::fclaw3dx_clawpatch_output_vtk_patch.  Frees the file.
+ * 
+ * @param glob the global context
+ * @param frame the file from ::fclaw3dx_clawpatch_output_vtk_begin
+ * @return 0 if successful, negative otherwise
+ */
+int fclaw3dx_clawpatch_output_vtk_end (struct fclaw2d_global* glob,
+                                       fclaw3dx_clawpatch_vtk_frame_t* frame);
+
+
+/**
+ * @brief Round floats to a number of mantissa bits
+ * 
+ * Used for the vtk-mantissa-bits option.  The trailing bits become zero, 
+ * which makes the values compress better.  The relative error is at 
+ * most 2^-(bits+1).  Infinities and NaNs are left alone.
+ * 
+ * @param f the values, rounded in place
+ * @param n the number of values
+ * @param bits the number of mantissa bits to keep, between 1 and 23
+ */
+void fclaw3dx_vtk_round_mantissa (float *f, int64_t n, int bits);
+
+/**
+ * @brief Compress equally sized blocks with zlib
+ * 
+ * Each block becomes one block of the vtkZLibDataCompressor layout.
+ * Only available if ForestClaw is built with zlib (SC_HAVE_ZLIB).
+ * 
+ * @param raw the uncompressed data, lnum blocks of psize bytes
+ * @param psize the uncompressed size of one block
+ * @param lnum the number of blocks
+ * @param zdata the compressed blocks without gaps, allocated with
+ *              FCLAW_ALLOC;  the caller frees it
+ * @param zsize the compressed size of each block, allocated with
+ *              FCLAW_ALLOC;  the caller frees it
+ * @return the total compressed size
+ */
+int64_t fclaw3dx_vtk_compress_blocks (const char *raw, int64_t psize, int lnum,
+                                      char **zdata, uint64_t ** zsize);
+
+
 #ifdef __cplusplus
 #if 0
 {                               /* need this because indent is dumb */
@@ -50,6 +50,7 @@ SUBROUTINE fclaw3dx_clawpatch46_fort_average_face(mx,my,mz,mbc,meqn, &
     INTEGER :: rr2
     PARAMETER(rr2 = 4)
     INTEGER, DIMENSION(0:rr2-1) :: i2, j2
+    INTEGER :: ac(2,2), fc(2,0:rr2-1)
     !! DOUBLE PRECISION :: kc
 
     LOGICAL :: fclaw2d_clawpatch_is_valid_average, skip_this_grid
@@ -58,6 +59,10 @@ SUBROUTINE fclaw3dx_clawpatch46_fort_average_face(mx,my,mz,mbc,meqn, &
     LOGICAL :: is_manifold
 
 
+    !! # Map coarse indices to the fine neighbor once, rather than
+    !! # for every ghost cell.
+    call fclaw3dx_clawpatch_build_transform_children(transform_cptr,0,ac,fc)
+
     is_manifold = manifold .eq. 1
 
     !! # 'iface' is relative to the coarse grid
@@ -83,7 +88,10 @@ SUBROUTINE fclaw3dx_clawpatch46_fort_average_face(mx,my,mz,mbc,meqn, &
                         elseif (iface_coarse .eq. 1) then
                             ic = mx+ibc
                         endif
-                        call fclaw3dx_clawpatch_transform_face_half(ic,jc,i2,j2,transform_cptr)
+                        do m = 0,rr2-1
+                            i2(m) = ac(1,1)*ic + ac(1,2)*jc + fc(1,m)
+                            j2(m) = ac(2,1)*ic + ac(2,2)*jc + fc(2,m)
+                        end do
                         !! # ---------------------------------------------
                         !! # Two 'half-size' neighbors will be passed into
                         !! # this routine.  Only half of the coarse grid ghost
@@ -131,7 +139,10 @@ SUBROUTINE fclaw3dx_clawpatch46_fort_average_face(mx,my,mz,mbc,meqn, &
                             jc = my+jbc
                         endif
 
-                        call fclaw3dx_clawpatch_transform_face_half(ic,jc,i2,j2, transform_cptr)
+                        do m = 0,rr2-1
+                            i2(m) = ac(1,1)*ic + ac(1,2)*jc + fc(1,m)
+                            j2(m) = ac(2,1)*ic + ac(2,2)*jc + fc(2,m)
+                        end do
                         skip_this_grid = .false.
                         do m = 0,r2-1
                             if (.not. fclaw2d_clawpatch_is_valid_average(i2(m),j2(m),mx,my)) then
@@ -190,10 +201,15 @@ subroutine fclaw3dx_clawpatch46_fort_average_corner(mx,my,mz,mbc,meqn, &
     INTEGER :: rr2
     PARAMETER(rr2 = 4)
     INTEGER :: i2(0:rr2-1),j2(0:rr2-1)
+    INTEGER :: ac(2,2), fc(2,0:rr2-1)
 
     INTEGER :: i1,j1,m, k
     DOUBLE PRECISION :: vf_sum
 
+    !! # Map coarse indices to the fine neighbor once, rather than
+    !! # for every ghost cell.
+    call fclaw3dx_clawpatch_build_transform_children(transform_cptr,1,ac,fc)
+
     r2 = refratio*refratio
     if (r2 .ne. rr2) then
         write(6,*) 'average_corner_ghost (claw2d_utils.f) ', & 
@@ -224,7 +240,10 @@ subroutine fclaw3dx_clawpatch46_fort_average_corner(mx,my,mz,mbc,meqn, &
                         j1 = my+jbc
                     endif
 
-                    call fclaw3dx_clawpatch_transform_corner_half(i1,j1,i2,j2, transform_cptr)
+                    do m = 0,rr2-1
+                        i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+                        j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+                    end do
                     if (is_manifold) then
                         sum = 0
                         vf_sum = 0
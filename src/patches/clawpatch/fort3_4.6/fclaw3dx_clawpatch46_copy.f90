@@ -21,9 +21,51 @@ subroutine fclaw3dx_clawpatch46_fort_copy_face(mx,my,mz,mbc, &
 
     integer i,j,ibc,jbc,mq, idir, k
     integer i1,j1, i2, j2
+    integer a(2,2), f(2)
+    logical same_block
 
     idir = iface/2
 
+    !! # Map indices to the neighbor's coordinate system once, rather
+    !! # than for every ghost cell.
+    call fclaw3dx_clawpatch_build_transform_samesize(transform_ptr,0,a,f)
+    same_block = a(1,1) .eq. 1 .and. a(2,2) .eq. 1 .and. & 
+                 a(1,2) .eq. 0 .and. a(2,1) .eq. 0
+
+    if (same_block) then
+        !! # Neighbor is only shifted : copy strips of ghost cells
+        do mq = 1,meqn
+            do k = 1,mz
+                if (iface .eq. 0) then
+                    do j = 1,my
+                        do i = 1-mbc,0
+                            qthis(i,j,k,mq) = qneighbor(i+f(1),j+f(2),k,mq)
+                        end do
+                    end do
+                elseif (iface .eq. 1) then
+                    do j = 1,my
+                        do i = mx+1,mx+mbc
+                            qthis(i,j,k,mq) = qneighbor(i+f(1),j+f(2),k,mq)
+                        end do
+                    end do
+                elseif (iface .eq. 2) then
+                    do j = 1-mbc,0
+                        do i = 1,mx
+                            qthis(i,j,k,mq) = qneighbor(i+f(1),j+f(2),k,mq)
+                        end do
+                    end do
+                else
+                    do j = my+1,my+mbc
+                        do i = 1,mx
+                            qthis(i,j,k,mq) = qneighbor(i+f(1),j+f(2),k,mq)
+                        end do
+                    end do
+                endif
+            end do
+        end do
+        return
+    endif
+
     !! # High side of 'qthis' exchanges with low side of
     !! # 'qneighbor'
     mq_loop : do mq = 1,meqn
@@ -40,7 +82,8 @@ subroutine fclaw3dx_clawpatch46_fort_copy_face(mx,my,mz,mbc, &
                             i1 = mx+ibc
                             j1 = j
                         endif
-                        call fclaw3dx_clawpatch_transform_face(i1,j1,i2,j2,transform_ptr)
+                        i2 = a(1,1)*i1 + a(1,2)*j1 + f(1)
+                        j2 = a(2,1)*i1 + a(2,2)*j1 + f(2)
                         qthis(i1,j1,k,mq) = qneighbor(i2,j2,k,mq)
                     enddo
                 enddo
@@ -56,7 +99,8 @@ subroutine fclaw3dx_clawpatch46_fort_copy_face(mx,my,mz,mbc, &
                            i1 = i
                            j1 = my+jbc
                         endif
-                        call fclaw3dx_clawpatch_transform_face(i1,j1,i2,j2,transform_ptr)
+                        i2 = a(1,1)*i1 + a(1,2)*j1 + f(1)
+                        j2 = a(2,1)*i1 + a(2,2)*j1 + f(2)
                         qthis(i1,j1,k,mq) = qneighbor(i2,j2,k,mq)
                     enddo
                 enddo
@@ -77,6 +121,9 @@ subroutine fclaw3dx_clawpatch46_fort_copy_corner(mx,my,mz,mbc,meqn, &
 
     integer mq, ibc, jbc
     integer i1, j1, i2, j2, k
+    integer a(2,2), f(2)
+
+    call fclaw3dx_clawpatch_build_transform_samesize(transform_ptr,1,a,f)
 
     !! # Do exchanges for all corners
     mq_loop : do mq = 1,meqn
@@ -97,9 +144,8 @@ subroutine fclaw3dx_clawpatch46_fort_copy_corner(mx,my,mz,mbc,meqn, &
                         j1 = my+jbc
                     endif
 
-                    !! # this routine is not yet complete, but the complete one
-                    !! # can now be dropped in.
-                    call fclaw3dx_clawpatch_transform_corner(i1,j1,i2,j2, transform_ptr)
+                    i2 = a(1,1)*i1 + a(1,2)*j1 + f(1)
+                    j2 = a(2,1)*i1 + a(2,2)*j1 + f(2)
                     qthis(i1,j1,k,mq) = qneighbor(i2,j2,k,mq)
                 end do
             end do
@@ -45,6 +45,7 @@ subroutine fclaw3dx_clawpatch46_fort_interpolate_face &
     integer :: rr2
     parameter(rr2 = 4)
     integer :: i2(0:rr2-1),j2(0:rr2-1)
+    integer :: ac(2,2), fc(2,0:rr2-1)
     logical :: fclaw2d_clawpatch_is_valid_interp
     logical :: skip_this_grid
 
@@ -52,6 +53,10 @@ subroutine fclaw3dx_clawpatch46_fort_interpolate_face &
     integer :: ii,jj,dc(2),df(2,0:rr2-1),iff,jff
     double precision :: shiftx(0:rr2-1),shifty(0:rr2-1)
 
+    !! # Map coarse indices to the fine neighbor once, rather than
+    !! # for every ghost cell.
+    call fclaw3dx_clawpatch_build_transform_children(transform_ptr,0,ac,fc)
+
     mth = 5
     r2 = refratio*refratio
     if (r2 .ne. rr2) then
@@ -100,7 +105,10 @@ subroutine fclaw3dx_clawpatch46_fort_interpolate_face &
                     do jc = 1,mx
                         i1 = ic
                         j1 = jc
-                        call fclaw3dx_clawpatch_transform_face_half(i1,j1,i2,j2,transform_ptr)
+                        do m = 0,rr2-1
+                            i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+                            j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+                        end do
                         skip_this_grid = .false.
                         do m = 0,r2-1
                             if (.not. fclaw2d_clawpatch_is_valid_interp(i2(m),j2(m),mx,my,mbc)) then
@@ -145,7 +153,10 @@ subroutine fclaw3dx_clawpatch46_fort_interpolate_face &
                     do ic = 1,mx
                         i1 = ic
                         j1 = jc
-                        call fclaw3dx_clawpatch_transform_face_half(i1,j1,i2,j2, transform_ptr)
+                        do m = 0,rr2-1
+                            i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+                            j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+                        end do
                         !! # ---------------------------------------------
                         !! # Two 'half-size' neighbors will be passed into
                         !! # this routine.  Only half of the coarse grid ghost
@@ -206,11 +217,16 @@ subroutine fclaw3dx_clawpatch46_fort_interpolate_corner &
     integer rr2
     parameter(rr2 = 4)
     integer i2(0:rr2-1),j2(0:rr2-1)
+    integer ac(2,2), fc(2,0:rr2-1)
 
     integer a(2,2), f(2)
     integer ii,jj,iff,jff,dc(2),df(2,0:rr2-1)
     double precision shiftx(0:rr2-1), shifty(0:rr2-1)
 
+    !! # Map coarse indices to the fine neighbor once, rather than
+    !! # for every ghost cell.
+    call fclaw3dx_clawpatch_build_transform_children(transform_ptr,1,ac,fc)
+
     r2 = refratio*refratio
     if (r2 .ne. rr2) then
         write(6,*) 'average_corner_ghost (claw2d_utils.f) ', & 
@@ -265,7 +281,10 @@ subroutine fclaw3dx_clawpatch46_fort_interpolate_corner &
             !! # Interpolate coarse grid corners to fine grid corner ghost cells
             i1 = ic
             j1 = jc
-            call fclaw3dx_clawpatch_transform_corner_half(i1,j1,i2,j2, transform_ptr)
+            do m = 0,rr2-1
+                i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+                j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+            end do
 
             mq_loop : do mq = 1,meqn
                 k_loop : do k = 1,mz
@@ -29,9 +29,50 @@ c--------------------------------------------------------------------
 
       integer i,j,ibc,jbc,mq, idir
       integer i1,j1, i2, j2
+      integer a(2,2), f(2)
+      logical same_block
 
       idir = iface/2
 
+c     # Map indices to the neighbor's coordinate system once, rather
+c     # than for every ghost cell.
+      call fclaw2d_clawpatch_build_transform_samesize(transform_ptr,
+     &      0,a,f)
+      same_block = a(1,1) .eq. 1 .and. a(2,2) .eq. 1 .and.
+     &      a(1,2) .eq. 0 .and. a(2,1) .eq. 0
+
+      if (same_block) then
+c        # Neighbor is only shifted : copy strips of ghost cells
+         do mq = 1,meqn
+            if (iface .eq. 0) then
+               do j = 1,my
+                  do i = 1-mbc,0
+                     qthis(i,j,mq) = qneighbor(i+f(1),j+f(2),mq)
+                  enddo
+               enddo
+            elseif (iface .eq. 1) then
+               do j = 1,my
+                  do i = mx+1,mx+mbc
+                     qthis(i,j,mq) = qneighbor(i+f(1),j+f(2),mq)
+                  enddo
+               enddo
+            elseif (iface .eq. 2) then
+               do j = 1-mbc,0
+                  do i = 1,mx
+                     qthis(i,j,mq) = qneighbor(i+f(1),j+f(2),mq)
+                  enddo
+               enddo
+            else
+               do j = my+1,my+mbc
+                  do i = 1,mx
+                     qthis(i,j,mq) = qneighbor(i+f(1),j+f(2),mq)
+                  enddo
+               enddo
+            endif
+         enddo
+         return
+      endif
+
 c     # High side of 'qthis' exchanges with low side of
 c     # 'qneighbor'
       do mq = 1,meqn
@@ -47,8 +88,8 @@ c                 # x-direction (idir == 0)
                      i1 = mx+ibc
                      j1 = j
                   endif
-                  call fclaw2d_clawpatch_transform_face(i1,j1,i2,j2,
-     &                  transform_ptr)
+                  i2 = a(1,1)*i1 + a(1,2)*j1 + f(1)
+                  j2 = a(2,1)*i1 + a(2,2)*j1 + f(2)
                   qthis(i1,j1,mq) = qneighbor(i2,j2,mq)
                enddo
             enddo
@@ -64,8 +105,8 @@ c                 # y-direction (idir == 1)
                      i1 = i
                      j1 = my+jbc
                   endif
-                  call fclaw2d_clawpatch_transform_face(i1,j1,i2,j2,
-     &                  transform_ptr)
+                  i2 = a(1,1)*i1 + a(1,2)*j1 + f(1)
+                  j2 = a(2,1)*i1 + a(2,2)*j1 + f(2)
                   qthis(i1,j1,mq) = qneighbor(i2,j2,mq)
                enddo
             enddo
@@ -92,6 +133,10 @@ c--------------------------------------------------------------------
 
       integer mq, ibc, jbc
       integer i1, j1, i2, j2
+      integer a(2,2), f(2)
+
+      call fclaw2d_clawpatch_build_transform_samesize(transform_ptr,
+     &      1,a,f)
 
 c     # Do exchanges for all corners
       do mq = 1,meqn
@@ -111,10 +156,8 @@ c     # Do exchanges for all corners
                   j1 = my+jbc
                endif
 
-c              # this routine is not yet complete, but the complete one
-c              # can now be dropped in.
-               call fclaw2d_clawpatch_transform_corner(i1,j1,i2,j2,
-     &               transform_ptr)
+               i2 = a(1,1)*i1 + a(1,2)*j1 + f(1)
+               j2 = a(2,1)*i1 + a(2,2)*j1 + f(2)
                qthis(i1,j1,mq) = qneighbor(i2,j2,mq)
             enddo
          enddo
@@ -49,6 +49,7 @@ c     # This should be refratio*refratio.
       integer rr2
       parameter(rr2 = 4)
       integer i2(0:rr2-1),j2(0:rr2-1)
+      integer ac(2,2), fc(2,0:rr2-1)
       logical fclaw2d_clawpatch_is_valid_interp
       logical skip_this_grid
 
@@ -56,6 +57,11 @@ c     # This should be refratio*refratio.
       integer ii,jj,dc(2),df(2,0:rr2-1),iff,jff
       double precision shiftx(0:rr2-1),shifty(0:rr2-1)
 
+c     # Map coarse indices to the fine neighbor once, rather than
+c     # for every ghost cell.
+      call fclaw2d_clawpatch_build_transform_children(transform_ptr,
+     &      0,ac,fc)
+
       mth = 5
       r2 = refratio*refratio
       if (r2 .ne. rr2) then
@@ -105,8 +111,10 @@ c           # this ensures that we get 'hanging' corners
             do jc = 1,mx
                i1 = ic
                j1 = jc
-               call fclaw2d_clawpatch_transform_face_half(i1,j1,i2,j2,
-     &               transform_ptr)
+               do m = 0,rr2-1
+                  i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+                  j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+               enddo
                skip_this_grid = .false.
                do m = 0,r2-1
                   if (.not. 
@@ -153,8 +161,10 @@ c              // iface_coarse = 3
             do ic = 1,mx
                i1 = ic
                j1 = jc
-               call fclaw2d_clawpatch_transform_face_half(i1,j1,i2,j2,
-     &               transform_ptr)
+               do m = 0,rr2-1
+                  i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+                  j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+               enddo
 c              # ---------------------------------------------
 c              # Two 'half-size' neighbors will be passed into
 c              # this routine.  Only half of the coarse grid ghost
@@ -224,11 +234,17 @@ c     # This should be refratio*refratio.
       integer rr2
       parameter(rr2 = 4)
       integer i2(0:rr2-1),j2(0:rr2-1)
+      integer ac(2,2), fc(2,0:rr2-1)
 
       integer a(2,2), f(2)
       integer ii,jj,iff,jff,dc(2),df(2,0:rr2-1)
       double precision shiftx(0:rr2-1), shifty(0:rr2-1)
 
+c     # Map coarse indices to the fine neighbor once, rather than
+c     # for every ghost cell.
+      call fclaw2d_clawpatch_build_transform_children(transform_ptr,
+     &      1,ac,fc)
+
       r2 = refratio*refratio
       if (r2 .ne. rr2) then
          write(6,*) 'average_corner_ghost (claw2d_utils.f) ',
@@ -283,8 +299,10 @@ c           # Map (0,1) to (-1/4,1/4) (locations of fine grid points)
 c     # Interpolate coarse grid corners to fine grid corner ghost cells
       i1 = ic
       j1 = jc
-      call fclaw2d_clawpatch_transform_corner_half(i1,j1,i2,j2,
-     &      transform_ptr)
+      do m = 0,rr2-1
+         i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+         j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+      enddo
 
       do mq = 1,meqn
          qc = qcoarse(ic,jc,mq)
@@ -42,11 +42,17 @@ c     # This should be refratio*refratio.
       integer rr2
       parameter(rr2 = 4)
       integer i2(0:rr2-1),j2(0:rr2-1)
+      integer ac(2,2), fc(2,0:rr2-1)
       double precision kc
 
       logical fclaw2d_clawpatch_is_valid_average, skip_this_grid
       double precision af_sum, qv(0:rr2-1)
 
+c     # Map coarse indices to the fine neighbor once, rather than
+c     # for every ghost cell.
+      call fclaw2d_clawpatch_build_transform_children(transform_cptr,
+     &      0,ac,fc)
+
       is_manifold = manifold .eq. 1
 
 c     # 'iface' is relative to the coarse grid
@@ -72,9 +78,10 @@ c                 # ibc = 2 corresponds to the second layer
                      ic = mx+ibc
                   endif
 
-                  call 
-     &       fclaw2d_clawpatch_transform_face_half(ic,jc,i2,j2,
-     &                  transform_cptr)
+                  do m = 0,rr2-1
+                     i2(m) = ac(1,1)*ic + ac(1,2)*jc + fc(1,m)
+                     j2(m) = ac(2,1)*ic + ac(2,2)*jc + fc(2,m)
+                  enddo
 c                 # ---------------------------------------------
 c                 # Two 'half-size' neighbors will be passed into
 c                 # this routine.  Only half of the coarse grid ghost
@@ -137,9 +144,10 @@ c           # idir = 1 (faces 2,3)
                      jc = my+jbc
                   endif
 
-                  call 
-     &       fclaw2d_clawpatch_transform_face_half(ic,jc,i2,j2,
-     &                  transform_cptr)
+                  do m = 0,rr2-1
+                     i2(m) = ac(1,1)*ic + ac(1,2)*jc + fc(1,m)
+                     j2(m) = ac(2,1)*ic + ac(2,2)*jc + fc(2,m)
+                  enddo
                   skip_this_grid = .false.
                   do m = 0,r2-1
                      if (.not. 
@@ -209,9 +217,15 @@ c     # This should be refratio*refratio.
       integer rr2
       parameter(rr2 = 4)
       integer i2(0:rr2-1),j2(0:rr2-1)
+      integer ac(2,2), fc(2,0:rr2-1)
 
       double precision af_sum
 
+c     # Map coarse indices to the fine neighbor once, rather than
+c     # for every ghost cell.
+      call fclaw2d_clawpatch_build_transform_children(transform_cptr,
+     &      1,ac,fc)
+
       r2 = refratio*refratio
       if (r2 .ne. rr2) then
          write(6,*) 'average_corner_ghost (claw2d_utils.f) ',
@@ -240,10 +254,10 @@ c           # Average fine grid corners onto coarse grid ghost corners
                j1 = my+jbc
             endif
 
-c           # Again, a fake routine until the real one is
-c           # available (be sure to pass in (i1,j1)
-            call fclaw2d_clawpatch_transform_corner_half(i1,j1,i2,j2,
-     &            transform_cptr)
+            do m = 0,rr2-1
+               i2(m) = ac(1,1)*i1 + ac(1,2)*j1 + fc(1,m)
+               j2(m) = ac(2,1)*i1 + ac(2,2)*j1 + fc(2,m)
+            enddo
             if (is_manifold) then
                do mq = 1,meqn
                   sum = 0
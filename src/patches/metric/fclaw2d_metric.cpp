@@ -62,6 +62,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw2d_global.h>
 #include <fclaw2d_patch.h>  
+#include <fclaw2d_options.h>
+
+#if PATCH_DIM == 2
+#include <fclaw2d_map_query.h>
+
+#include <array>
+#include <cmath>
+#include <list>
+#include <map>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#endif
 
 static
 fclaw2d_metric_patch_t* get_metric_patch(fclaw2d_global_t* glob,
@@ -76,17 +91,401 @@ fclaw2d_metric_patch_t* get_metric_patch(fclaw2d_global_t* glob,
 fclaw2d_metric_patch_t* fclaw2d_metric_patch_new()
 {
     fclaw2d_metric_patch_t *mp = new fclaw2d_metric_patch_t;
+#if PATCH_DIM == 2
+    mp->available = 0;
+    mp->terms = 0;
+    mp->computed = 0;
+    mp->recompute_owner = NULL;
+    mp->shared = NULL;
+    mp->refcount = 0;
+    mp->shared_slot = NULL;
+#endif
     return mp;
 }
 
+#if PATCH_DIM == 2
+static
+void metric_release_shared(fclaw2d_metric_patch_t *mp)
+{
+    fclaw2d_metric_patch_t *sp = mp->shared;
+    if (sp == NULL)
+    {
+        return;
+    }
+    FCLAW_ASSERT(sp->refcount > 0);
+    sp->refcount--;
+    if (sp->refcount == 0)
+    {
+        *sp->shared_slot = NULL;
+        delete sp;
+    }
+    mp->shared = NULL;
+}
+#endif
+
 void fclaw2d_metric_patch_delete(fclaw2d_metric_patch_t **mp)
 {
     FCLAW_ASSERT(mp != NULL);
+#if PATCH_DIM == 2
+    /* Don't leave the vtable pointing at a deleted patch */
+    void **owner = (*mp)->recompute_owner;
+    if (owner != NULL && *owner == (void*) *mp)
+    {
+        *owner = NULL;
+    }
+    metric_release_shared(*mp);
+#endif
     delete *mp;
     *mp = NULL;
 }
 
 
+#if PATCH_DIM == 2
+/* ----------------------------- On-demand metric terms ------------------------------- */
+
+/* Add the terms needed to compute 'terms'.  Surface normals and curvature
+   are computed together by fort_compute_surf_normals.  The area is always 
+   needed. */
+static
+int metric_terms_closure(int terms)
+{
+    if (terms & (FCLAW2D_METRIC_SURF_NORMALS | FCLAW2D_METRIC_CURVATURE))
+    {
+        terms |= FCLAW2D_METRIC_SURF_NORMALS | FCLAW2D_METRIC_CURVATURE | 
+                 FCLAW2D_METRIC_NORMALS | FCLAW2D_METRIC_EDGE_LENGTHS;
+    }
+    if (terms & (FCLAW2D_METRIC_NORMALS | FCLAW2D_METRIC_TANGENTS | 
+                 FCLAW2D_METRIC_EDGE_LENGTHS))
+    {
+        terms |= FCLAW2D_METRIC_MESH;
+    }
+    return terms | FCLAW2D_METRIC_AREA;
+}
+
+/* Terms an updated patch can provide.  Edge lengths are always provided,
+   since they are needed for the conservation registers. */
+static
+int metric_terms_available(fclaw2d_metric_vtable_t *metric_vt)
+{
+    int required = metric_vt->required_terms;
+    if (required == 0)
+    {
+        /* Nothing registered; keep the old behavior */
+        required = FCLAW2D_METRIC_ALL;
+    }
+    return metric_terms_closure(required | FCLAW2D_METRIC_EDGE_LENGTHS);
+}
+
+/* Area and edge lengths are read from neighboring patches and so must 
+   always be stored */
+static
+int metric_terms_recomputed(fclaw2d_metric_vtable_t *metric_vt)
+{
+    return metric_vt->recompute_terms & 
+        ~(FCLAW2D_METRIC_AREA | FCLAW2D_METRIC_EDGE_LENGTHS);
+}
+
+static
+void metric_define_terms(fclaw2d_metric_patch_t *mp, int terms)
+{
+    int mbc = mp->mbc;
+    int ll[2] = {-mbc, -mbc};
+    int ur_p[2] = {mp->mx + mbc + 1, mp->my + mbc + 1};
+    int ur_d[2] = {mp->mx + mbc + 2, mp->my + mbc + 2};
+
+    Box box_p(ll,ur_p,2);
+    Box box_d(ll,ur_d,2);
+
+    if (terms & FCLAW2D_METRIC_AREA)
+    {
+        mp->area.define(box_p,1);
+    }
+    if (terms & FCLAW2D_METRIC_MESH)
+    {
+        mp->xp.define(box_p,1);
+        mp->yp.define(box_p,1);
+        mp->zp.define(box_p,1);
+
+        mp->xd.define(box_d,1);
+        mp->yd.define(box_d,1);
+        mp->zd.define(box_d,1);
+    }
+
+    /* Face centered values */
+    /* DAC : Why didn't I set this up as a cell-centered box? */
+    if (terms & FCLAW2D_METRIC_NORMALS)
+    {
+        mp->xface_normals.define(box_d,3);
+        mp->yface_normals.define(box_d,3);
+    }
+    if (terms & FCLAW2D_METRIC_TANGENTS)
+    {
+        mp->xface_tangents.define(box_d,3);
+        mp->yface_tangents.define(box_d,3);
+    }
+    if (terms & FCLAW2D_METRIC_EDGE_LENGTHS)
+    {
+        /* Store length of left and bottom edge of box */
+        mp->edge_lengths.define(box_d,2);
+    }
+    if (terms & FCLAW2D_METRIC_SURF_NORMALS)
+    {
+        mp->surf_normals.define(box_p,3);
+    }
+    if (terms & FCLAW2D_METRIC_CURVATURE)
+    {
+        mp->curvature.define(box_p,1);
+    }
+}
+
+static
+void metric_release_terms(fclaw2d_metric_patch_t *mp, int terms)
+{
+    /* Defining on an empty box frees the data */
+    Box empty;
+    if (terms & FCLAW2D_METRIC_MESH)
+    {
+        mp->xp.define(empty,0);
+        mp->yp.define(empty,0);
+        mp->zp.define(empty,0);
+
+        mp->xd.define(empty,0);
+        mp->yd.define(empty,0);
+        mp->zd.define(empty,0);
+    }
+    if (terms & FCLAW2D_METRIC_NORMALS)
+    {
+        mp->xface_normals.define(empty,0);
+        mp->yface_normals.define(empty,0);
+    }
+    if (terms & FCLAW2D_METRIC_TANGENTS)
+    {
+        mp->xface_tangents.define(empty,0);
+        mp->yface_tangents.define(empty,0);
+    }
+    if (terms & FCLAW2D_METRIC_SURF_NORMALS)
+    {
+        mp->surf_normals.define(empty,0);
+    }
+    if (terms & FCLAW2D_METRIC_CURVATURE)
+    {
+        mp->curvature.define(empty,0);
+    }
+    mp->terms &= ~terms;
+    mp->computed &= ~terms;
+}
+
+/* Patch holding terms that don't depend on the patch position */
+static
+fclaw2d_metric_patch_t* metric_terms_patch(fclaw2d_metric_patch_t *mp)
+{
+    return mp->shared != NULL ? mp->shared : mp;
+}
+
+/* Under an affine map, the area, edge lengths, normals, tangents and
+   curvature are the same for all patches at a level.  These are stored 
+   once per level in a reference counted patch, including terms that are 
+   otherwise recomputed, and are computed when the first patch at the level
+   is built.  Returns NULL if terms can't be shared.  */
+static
+fclaw2d_metric_patch_t* metric_shared_patch(fclaw2d_global_t *glob,
+                                            fclaw2d_patch_t *patch,
+                                            fclaw2d_metric_patch_t *mp,
+                                            int terms)
+{
+    fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+    if (!metric_vt->share_affine_terms || glob->cont == NULL)
+    {
+        return NULL;
+    }
+    if (!FCLAW2D_MAP_IS_AFFINE(&glob->cont))
+    {
+        return NULL;
+    }
+
+    if (metric_vt->shared_levels == NULL)
+    {
+        const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+        metric_vt->num_shared_levels = fclaw_opt->maxlevel + 1;
+        metric_vt->shared_levels = FCLAW_ALLOC_ZERO(void*,
+                                                    metric_vt->num_shared_levels);
+    }
+    int level = patch->level;
+    if (level >= metric_vt->num_shared_levels)
+    {
+        return NULL;
+    }
+
+    terms = (terms & ~FCLAW2D_METRIC_MESH) | FCLAW2D_METRIC_AREA;
+    fclaw2d_metric_patch_t *sp = 
+        (fclaw2d_metric_patch_t*) metric_vt->shared_levels[level];
+    if (sp == NULL)
+    {
+        sp = fclaw2d_metric_patch_new();
+        sp->mx = mp->mx;
+        sp->my = mp->my;
+        sp->mbc = mp->mbc;
+        sp->blockno = mp->blockno;
+        sp->patchno = mp->patchno;
+        sp->dx = mp->dx;
+        sp->dy = mp->dy;
+        sp->xlower = mp->xlower;
+        sp->ylower = mp->ylower;
+        sp->xupper = mp->xupper;
+        sp->yupper = mp->yupper;
+
+        sp->available = mp->available;
+        sp->terms = terms;
+        metric_define_terms(sp,terms);
+
+        sp->shared_slot = &metric_vt->shared_levels[level];
+        metric_vt->shared_levels[level] = sp;
+    }
+    else if (sp->mx != mp->mx || sp->my != mp->my || sp->mbc != mp->mbc ||
+             sp->dx != mp->dx || sp->dy != mp->dy || sp->terms != terms)
+    {
+        /* Blocks of different sizes */
+        return NULL;
+    }
+    sp->refcount++;
+    return sp;
+}
+
+/* Compute any of 'terms' that have not been computed yet.  Terms that
+   are recomputed on the fly are only held by one patch at a time;  pointers
+   to these terms are valid until the terms of another patch are accessed. 
+
+   Stored terms are computed when a patch is built, so that threaded loops
+   over local patches only compute recomputed terms.  Inside a parallel 
+   region, terms are computed one patch at a time and kept with the patch 
+   until it is redefined, since another thread may still be using the 
+   terms of the patch holding them. */
+static
+void metric_patch_compute_terms_serial(fclaw2d_global_t *glob,
+                                       fclaw2d_patch_t *patch,
+                                       int terms, int keep);
+
+static
+void metric_patch_compute_terms(fclaw2d_global_t *glob,
+                                fclaw2d_patch_t *patch,
+                                int terms)
+{
+#if defined(_OPENMP)
+    if (omp_in_parallel())
+    {
+#pragma omp critical (fclaw2d_metric_compute_terms)
+        metric_patch_compute_terms_serial(glob,patch,terms,1);
+        return;
+    }
+#endif
+    metric_patch_compute_terms_serial(glob,patch,terms,0);
+}
+
+static
+void metric_patch_compute_terms_serial(fclaw2d_global_t *glob,
+                                       fclaw2d_patch_t *patch,
+                                       int terms, int keep)
+{
+    fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+    fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
+    fclaw2d_metric_patch_t* sp = metric_terms_patch(mp);
+
+    /* The area is computed when the patch is built */
+    int computed = (mp->computed & FCLAW2D_METRIC_MESH) | 
+                   (sp->computed & ~FCLAW2D_METRIC_MESH);
+    terms = metric_terms_closure(terms) & mp->available;
+    int missing = terms & ~(computed | FCLAW2D_METRIC_AREA);
+    if (missing == 0)
+    {
+        return;
+    }
+
+    /* compute_basis computes all of the basis terms together */
+    int basis = FCLAW2D_METRIC_ALL & 
+        ~(FCLAW2D_METRIC_MESH | FCLAW2D_METRIC_AREA);
+    if (missing & basis)
+    {
+        missing |= mp->available & basis & ~computed;
+    }
+
+    int recompute = missing & ~(mp->terms | sp->terms);
+    if (recompute != 0)
+    {
+        metric_define_terms(mp,recompute);
+        mp->terms |= recompute;
+    }
+    if (recompute != 0 && !keep)
+    {
+        fclaw2d_metric_patch_t *owner = 
+            (fclaw2d_metric_patch_t*) metric_vt->recompute_owner;
+        if (owner != NULL && owner != mp)
+        {
+            metric_release_terms(owner,metric_terms_recomputed(metric_vt));
+        }
+        mp->recompute_owner = &metric_vt->recompute_owner;
+        metric_vt->recompute_owner = mp;
+    }
+
+    /* Terms are flagged before they are computed, since the compute 
+       routines get their arrays through the access functions below. */
+    int blockno = mp->blockno;
+    int patchno = mp->patchno;
+    if (missing & FCLAW2D_METRIC_MESH)
+    {
+        mp->computed |= FCLAW2D_METRIC_MESH;
+        metric_vt->compute_mesh(glob,patch,blockno,patchno);
+    }
+    if ((missing & basis) != 0 && metric_vt->compute_basis != NULL)
+    {
+        sp->computed |= missing & ~FCLAW2D_METRIC_MESH;
+        metric_vt->compute_basis(glob,patch,blockno,patchno);
+    }
+    mp->computed |= missing & FCLAW2D_METRIC_MESH;
+    sp->computed |= missing & ~FCLAW2D_METRIC_MESH;
+}
+
+/* Patches are built outside of threaded loops over patches */
+static
+void metric_patch_compute_stored(fclaw2d_global_t *glob,
+                                 fclaw2d_patch_t *patch)
+{
+    fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
+    metric_patch_compute_terms(glob,patch,
+                               mp->terms | metric_terms_patch(mp)->terms);
+}
+
+void fclaw2d_metric_require_terms(fclaw2d_global_t *glob, int terms)
+{
+    fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+    metric_vt->required_terms |= terms;
+}
+
+void fclaw2d_metric_recompute_terms(fclaw2d_global_t *glob, int terms)
+{
+    fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+    metric_vt->recompute_terms = terms;
+}
+
+int fclaw2d_metric_patch_has_terms(fclaw2d_global_t *glob,
+                                   fclaw2d_patch_t *patch,
+                                   int terms)
+{
+    fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
+    fclaw2d_metric_patch_t* sp = metric_terms_patch(mp);
+    int computed = (mp->computed & FCLAW2D_METRIC_MESH) | 
+                   (sp->computed & ~FCLAW2D_METRIC_MESH);
+    return (computed & terms) == terms;
+}
+
+int fclaw2d_metric_patch_is_shared(fclaw2d_global_t *glob,
+                                   fclaw2d_patch_t *patch)
+{
+    fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
+    return mp->shared != NULL;
+}
+#endif
+
+
 #if PATCH_DIM == 2
 void fclaw2d_metric_patch_define(fclaw2d_global_t* glob,
                                  fclaw2d_patch_t* patch, 
@@ -122,7 +521,13 @@ void fclaw3d_metric_patch_define(fclaw2d_global_t* glob,
     mp->xupper = xupper;
     mp->yupper = yupper;
 
-#if PATCH_DIM == 3
+#if PATCH_DIM == 2
+    mp->patchno = patchno;
+    mp->available = FCLAW2D_METRIC_AREA;
+    mp->terms = FCLAW2D_METRIC_AREA;
+    mp->computed = 0;
+    metric_release_shared(mp);
+#elif PATCH_DIM == 3
     mp->mz = mz;
     mp->zlower = zlower;
     mp->zupper = zupper;
@@ -225,33 +630,34 @@ void fclaw3d_metric_patch_define(fclaw2d_global_t* glob,
             -----------------------
             Total              : 37
 
-            We should come up with a way to store only what is needed 
+        In 2d, only the terms registered by the solver are stored.
         */
 
+#if PATCH_DIM == 2
+        /* Only store the terms the solver registered (see 
+           fclaw2d_metric_require_terms).  Terms that are recomputed on 
+           the fly are allocated when they are first accessed. */
+        fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+        mp->available = metric_terms_available(metric_vt);
+        int stored = mp->available & ~metric_terms_recomputed(metric_vt);
+
+        /* A shared patch stores all terms, since these are only computed
+           once per level */
+        mp->shared = metric_shared_patch(glob,patch,mp,mp->available);
+        if (mp->shared != NULL)
+        {
+            /* Only the mesh depends on the patch position */
+            mp->area.define(Box(),0);
+            stored &= FCLAW2D_METRIC_MESH;
+        }
+        mp->terms = stored | FCLAW2D_METRIC_AREA;
+        metric_define_terms(mp,stored);
+#elif PATCH_DIM == 3        
         /* Mesh cell centers of physical mesh */
         mp->xp.define(box_p,1);
         mp->yp.define(box_p,1);
         mp->zp.define(box_p,1);
 
-#if PATCH_DIM == 2
-
-        mp->xd.define(box_d,1);
-        mp->yd.define(box_d,1);
-        mp->zd.define(box_d,1);
-
-        mp->surf_normals.define(box_p,3);
-        mp->curvature.define(box_p,1);
-
-        /* Store length of left and bottom edge of box */
-        /* Face centered values */
-        /* DAC : Why didn't I set this up as a cell-centered box? */
-        mp->xface_normals.define(box_d,3);
-        mp->yface_normals.define(box_d,3);
-        mp->xface_tangents.define(box_d,3);
-        mp->yface_tangents.define(box_d,3);
-
-        mp->edge_lengths.define(box_d,2);
-#elif PATCH_DIM == 3        
         /* Store face areas of left, front, bottom edge of box */
         //mp->face_area.define(box_d,3);
 
@@ -355,6 +761,152 @@ void fclaw2d_metric_patch_compute_area (fclaw2d_global_t *glob,
 }
 
 
+#if PATCH_DIM == 2
+/* ------------------------------------ Area cache ------------------------------------ */
+
+/* Areas for general maps are computed by quadrature at the finest level
+   resolution.  Since a patch at a given block, level and position always
+   gets the same areas, these are cached, so that repeated refining and 
+   coarsening over the same region doesn't redo the quadrature.  When the 
+   cache is full, the least recently used areas are dropped.  The cache is 
+   only kept for one domain and map: adapted and partitioned domains share 
+   the attributes of the domain they came from, a new domain does not. */
+
+typedef std::array<int,4> metric_area_key_t;
+typedef std::list<metric_area_key_t> metric_area_lru_t;
+
+typedef struct metric_area_entry
+{
+    std::vector<double> area;
+    /* Position in the usage list */
+    metric_area_lru_t::iterator use;
+} metric_area_entry_t;
+
+typedef struct metric_area_cache
+{
+    std::map<metric_area_key_t,metric_area_entry_t> areas;
+    /* Keys, most recently used first */
+    metric_area_lru_t lru;
+    /* The domain and map the areas were computed for */
+    const void *attributes;
+    const fclaw2d_map_context_t *cont;
+} metric_area_cache_t;
+
+/* The cache of the current domain and map, or NULL */
+static
+metric_area_cache_t* metric_area_cache(fclaw2d_global_t *glob)
+{
+    fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+    metric_area_cache_t *cache = (metric_area_cache_t*) metric_vt->area_cache;
+    if (cache != NULL && 
+        (cache->attributes != glob->domain->attributes || 
+         cache->cont != glob->cont))
+    {
+        fclaw2d_metric_area_cache_clear(glob);
+        cache = NULL;
+    }
+    return cache;
+}
+
+static
+int metric_area_cache_key(fclaw2d_global_t *glob,
+                          fclaw2d_patch_t *patch,
+                          metric_area_key_t& key)
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
+    if (fclaw_opt->metric_area_cache_size <= 0 || mp->shared != NULL)
+    {
+        return 0;
+    }
+    if (glob->cont != NULL && FCLAW2D_MAP_IS_AFFINE(&glob->cont))
+    {
+        /* Affine areas are cheap */
+        return 0;
+    }
+    key[0] = mp->blockno;
+    key[1] = patch->level;
+    key[2] = (int) std::lround(mp->xlower/(mp->mx*mp->dx));
+    key[3] = (int) std::lround(mp->ylower/(mp->my*mp->dy));
+    return 1;
+}
+
+/* Returns true if the area was found in the cache */
+static
+int metric_area_cache_get(fclaw2d_global_t *glob,
+                          fclaw2d_patch_t *patch)
+{
+    metric_area_key_t key;
+    if (!metric_area_cache_key(glob,patch,key))
+    {
+        return 0;
+    }
+    metric_area_cache_t *cache = metric_area_cache(glob);
+    if (cache == NULL)
+    {
+        return 0;
+    }
+    std::map<metric_area_key_t,metric_area_entry_t>::iterator it = 
+        cache->areas.find(key);
+    FArrayBox& area = get_metric_patch(glob, patch)->area;
+    if (it == cache->areas.end() || (int) it->second.area.size() != area.size())
+    {
+        return 0;
+    }
+    area.copyFromMemory(it->second.area.data());
+    cache->lru.splice(cache->lru.begin(),cache->lru,it->second.use);
+    return 1;
+}
+
+static
+void metric_area_cache_put(fclaw2d_global_t *glob,
+                           fclaw2d_patch_t *patch)
+{
+    const fclaw_options_t *fclaw_opt = fclaw2d_get_options(glob);
+    metric_area_key_t key;
+    if (!metric_area_cache_key(glob,patch,key))
+    {
+        return;
+    }
+    metric_area_cache_t *cache = metric_area_cache(glob);
+    if (cache == NULL)
+    {
+        cache = new metric_area_cache_t;
+        cache->attributes = glob->domain->attributes;
+        cache->cont = glob->cont;
+        fclaw2d_metric_vt(glob)->area_cache = cache;
+    }
+    std::map<metric_area_key_t,metric_area_entry_t>::iterator it = 
+        cache->areas.find(key);
+    if (it == cache->areas.end())
+    {
+        while ((int) cache->areas.size() >= fclaw_opt->metric_area_cache_size)
+        {
+            cache->areas.erase(cache->lru.back());
+            cache->lru.pop_back();
+        }
+        it = cache->areas.insert(std::make_pair(key,metric_area_entry_t())).first;
+        cache->lru.push_front(key);
+        it->second.use = cache->lru.begin();
+    }
+    else
+    {
+        cache->lru.splice(cache->lru.begin(),cache->lru,it->second.use);
+    }
+    FArrayBox& area = get_metric_patch(glob, patch)->area;
+    std::vector<double>& v = it->second.area;
+    v.resize(area.size());
+    area.copyToMemory(v.data());
+}
+
+void fclaw2d_metric_area_cache_clear(fclaw2d_global_t *glob)
+{
+    fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+    delete (metric_area_cache_t*) metric_vt->area_cache;
+    metric_vt->area_cache = NULL;
+}
+#endif
+
 void fclaw2d_metric_patch_build(fclaw2d_global_t* glob,
                                 fclaw2d_patch_t* patch,
                                 int blockno,
@@ -363,6 +915,22 @@ void fclaw2d_metric_patch_build(fclaw2d_global_t* glob,
     fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
     FCLAW_ASSERT(metric_vt != NULL);
 
+#if PATCH_DIM == 2
+    /* Compute areas ($$$) from scratch.  These are needed by ghost
+       patches and for averaging, and so are always computed.  Stored 
+       terms are computed here, recomputed terms when they are accessed. */
+    fclaw2d_metric_patch_t* sp = metric_terms_patch(get_metric_patch(glob, patch));
+    if (!(sp->computed & FCLAW2D_METRIC_AREA))
+    {
+        sp->computed |= FCLAW2D_METRIC_AREA;
+        if (!metric_area_cache_get(glob,patch))
+        {
+            metric_vt->compute_area(glob,patch,blockno,patchno);
+            metric_area_cache_put(glob,patch);
+        }
+    }
+    metric_patch_compute_stored(glob,patch);
+#elif PATCH_DIM == 3
     /* Compute (xp,yp,zp) and (xd,yd,zd) */
     metric_vt->compute_mesh(glob,patch,blockno,patchno);
 
@@ -370,13 +938,10 @@ void fclaw2d_metric_patch_build(fclaw2d_global_t* glob,
        Note : These are all computed on finest level 
        mesh and averaged down to coarser meshes.  This is 
        required from geometric consistency */
-#if PATCH_DIM == 2    
-    /* Compute 2d patch areas */
-    metric_vt->compute_area(glob,patch,blockno,patchno);
-#elif PATCH_DIM == 3    
+
     /* Compute 3d volumes and 2d face areas */
     metric_vt->compute_volume(glob,patch,blockno,patchno);
-#endif
+
     if (metric_vt->compute_basis != NULL)
     {
         /* In 2d : Surface normals, tangents, edge lengths, 
@@ -386,6 +951,7 @@ void fclaw2d_metric_patch_build(fclaw2d_global_t* glob,
         */
         metric_vt->compute_basis(glob,patch,blockno,patchno);
     }
+#endif
 }
 
 
@@ -399,6 +965,26 @@ void fclaw2d_metric_patch_build_from_fine(fclaw2d_global_t *glob,
 {
     /* This routine does a complete build using fine grid data to average
        volumes and in 3d, face areas */
+#if PATCH_DIM == 2
+    /* Average areas from finer grids.  Stored terms are computed here, 
+       recomputed terms when they are accessed. */
+    fclaw2d_metric_patch_t* sp = 
+        metric_terms_patch(get_metric_patch(glob, coarse_patch));
+    if (!(sp->computed & FCLAW2D_METRIC_AREA))
+    {
+        /* A cached area also has the ghost cell areas, which would 
+           otherwise be computed from scratch */
+        sp->computed |= FCLAW2D_METRIC_AREA;
+        if (!metric_area_cache_get(glob,coarse_patch))
+        {
+            metric_average_area_from_fine(glob,fine_patches,coarse_patch,
+                                          blockno, coarse_patchno, 
+                                          fine0_patchno);
+            metric_area_cache_put(glob,coarse_patch);
+        }
+    }
+    metric_patch_compute_stored(glob,coarse_patch);
+#elif PATCH_DIM == 3
     fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
 
     /* Compute xd,yd,zd, xp,yp,zp */
@@ -420,6 +1006,7 @@ void fclaw2d_metric_patch_build_from_fine(fclaw2d_global_t *glob,
         */
         metric_vt->compute_basis(glob,coarse_patch,blockno,coarse_patchno);        
     }
+#endif
 }
 
 
@@ -435,13 +1022,19 @@ fclaw2d_metric_vtable_t* metric_vt_new()
 static
 void metric_vt_destroy(void* vt)
 {
+#if PATCH_DIM == 2
+    FCLAW_FREE (((fclaw2d_metric_vtable_t*) vt)->shared_levels);
+    delete (metric_area_cache_t*) ((fclaw2d_metric_vtable_t*) vt)->area_cache;
+#endif
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 fclaw2d_metric_vtable_t* fclaw2d_metric_vt(fclaw2d_global_t* glob)
 {
 	fclaw2d_metric_vtable_t* metric_vt = (fclaw2d_metric_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, METRIC_VTABLE_NAME);
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(metric_vt != NULL);
 	FCLAW_ASSERT(metric_vt->is_set != 0);
 	return metric_vt;
@@ -464,6 +1057,8 @@ void fclaw2d_metric_vtable_initialize(fclaw2d_global_t* glob)
     metric_vt->fort_compute_normals       = &FCLAW2D_METRIC_FORT_COMPUTE_NORMALS;
     metric_vt->fort_compute_tangents      = &FCLAW2D_METRIC_FORT_COMPUTE_TANGENTS;
     metric_vt->fort_compute_surf_normals  = &FCLAW2D_METRIC_FORT_COMPUTE_SURF_NORMALS;
+
+    metric_vt->share_affine_terms = 1;
 #elif PATCH_DIM == 3
     metric_vt->compute_mesh          = fclaw3d_metric_compute_mesh_default;
     metric_vt->compute_volume        = fclaw3d_metric_compute_volume_default;
@@ -480,6 +1075,7 @@ void fclaw2d_metric_vtable_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,METRIC_VTABLE_NAME) == NULL);
 	fclaw_pointer_map_insert(glob->vtables,METRIC_VTABLE_NAME, metric_vt, metric_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot(METRIC_VTABLE_NAME);
 }
 
 
@@ -500,7 +1096,7 @@ double* fclaw2d_metric_patch_get_area(fclaw2d_global_t* glob,
 {
     fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
 #if PATCH_DIM == 2
-    return mp->area.dataPtr();
+    return metric_terms_patch(mp)->area.dataPtr();
 #elif PATCH_DIM == 3
     return mp->volume.dataPtr();
 #endif
@@ -520,11 +1116,16 @@ void fclaw3d_metric_patch_scalar(fclaw2d_global_t* glob,
                                  double **volume, double** faceareas)
 #endif
 {
+#if PATCH_DIM == 2
+    metric_patch_compute_terms(glob,patch,FCLAW2D_METRIC_EDGE_LENGTHS |
+                               FCLAW2D_METRIC_CURVATURE);
+#endif
     fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
 #if PATCH_DIM == 2
-    *area = mp->area.dataPtr();
-    *edgelengths =  mp->edge_lengths.dataPtr();
-    *curvature = mp->curvature.dataPtr();
+    fclaw2d_metric_patch_t* sp = metric_terms_patch(mp);
+    *area = sp->area.dataPtr();
+    *edgelengths =  sp->edge_lengths.dataPtr();
+    *curvature = sp->curvature.dataPtr();
 #elif PATCH_DIM == 3
     *volume = mp->volume.dataPtr();
     *faceareas =  mp->face_area.dataPtr();
@@ -545,13 +1146,19 @@ void fclaw3d_metric_patch_basis(fclaw2d_global_t* glob,
                                 double **xrot, double **yrot, double **zrot)
 #endif
 {
+#if PATCH_DIM == 2
+    metric_patch_compute_terms(glob,patch,FCLAW2D_METRIC_NORMALS | 
+                               FCLAW2D_METRIC_TANGENTS | 
+                               FCLAW2D_METRIC_SURF_NORMALS);
+#endif
     fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
 #if PATCH_DIM == 2
-    *xnormals = mp->xface_normals.dataPtr();
-    *ynormals = mp->yface_normals.dataPtr();
-    *xtangents = mp->xface_tangents.dataPtr();
-    *ytangents = mp->yface_tangents.dataPtr();
-    *surfnormals = mp->surf_normals.dataPtr();
+    fclaw2d_metric_patch_t* sp = metric_terms_patch(mp);
+    *xnormals = sp->xface_normals.dataPtr();
+    *ynormals = sp->yface_normals.dataPtr();
+    *xtangents = sp->xface_tangents.dataPtr();
+    *ytangents = sp->yface_tangents.dataPtr();
+    *surfnormals = sp->surf_normals.dataPtr();
 #elif PATCH_DIM == 3
     *xrot = mp->xrot.dataPtr();
     *yrot = mp->yrot.dataPtr();
@@ -604,6 +1211,9 @@ void fclaw3d_metric_patch_mesh_data(fclaw2d_global_t* glob,
                                     double **volume, double** faceareas)
 #endif
 {
+#if PATCH_DIM == 2
+    metric_patch_compute_terms(glob,patch,FCLAW2D_METRIC_MESH);
+#endif
     fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
     *xp = mp->xp.dataPtr();
     *yp = mp->yp.dataPtr();
@@ -612,7 +1222,7 @@ void fclaw3d_metric_patch_mesh_data(fclaw2d_global_t* glob,
     *yd = mp->yd.dataPtr();
     *zd = mp->zd.dataPtr();
 #if PATCH_DIM == 2
-    *area = mp->area.dataPtr();
+    *area = metric_terms_patch(mp)->area.dataPtr();
 #elif PATCH_DIM == 3
     *volume = mp->volume.dataPtr();
     *faceareas = mp->face_area.dataPtr();
@@ -627,14 +1237,16 @@ void fclaw2d_metric_patch_mesh_data2(fclaw2d_global_t* glob,
                                      double **surfnormals,
                                      double **edgelengths, double **curvature)
 {
-    fclaw2d_metric_patch_t* mp = get_metric_patch(glob, patch);
-    *xnormals    = mp->xface_normals.dataPtr();
-    *ynormals    = mp->yface_normals.dataPtr();
-    *xtangents   = mp->xface_tangents.dataPtr();
-    *ytangents   = mp->yface_tangents.dataPtr();
-    *surfnormals = mp->surf_normals.dataPtr();
-    *curvature   = mp->curvature.dataPtr();
-    *edgelengths = mp->edge_lengths.dataPtr();
+    metric_patch_compute_terms(glob,patch,FCLAW2D_METRIC_ALL & 
+                               ~FCLAW2D_METRIC_MESH);
+    fclaw2d_metric_patch_t* sp = metric_terms_patch(get_metric_patch(glob, patch));
+    *xnormals    = sp->xface_normals.dataPtr();
+    *ynormals    = sp->yface_normals.dataPtr();
+    *xtangents   = sp->xface_tangents.dataPtr();
+    *ytangents   = sp->yface_tangents.dataPtr();
+    *surfnormals = sp->surf_normals.dataPtr();
+    *curvature   = sp->curvature.dataPtr();
+    *edgelengths = sp->edge_lengths.dataPtr();
 }
 #endif
 
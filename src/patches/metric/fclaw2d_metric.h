@@ -47,6 +47,33 @@ typedef struct fclaw2d_metric_vtable fclaw2d_metric_vtable_t;
 struct fclaw2d_global;
 struct fclaw2d_patch;
 
+/**
+ * @brief Bit flags for metric terms.
+ * 
+ * Terms needed to compute a required term are also stored, so that
+ * requiring surface normals also stores the curvature, face normals, edge 
+ * lengths and the mesh.
+ */
+typedef enum
+{
+    /** Cell centers xp,yp,zp and nodes xd,yd,zd */
+    FCLAW2D_METRIC_MESH         = 0x01,
+    /** Cell areas (always stored) */
+    FCLAW2D_METRIC_AREA         = 0x02,
+    /** Face normals */
+    FCLAW2D_METRIC_NORMALS      = 0x04,
+    /** Face tangents */
+    FCLAW2D_METRIC_TANGENTS     = 0x08,
+    /** Edge lengths (always stored) */
+    FCLAW2D_METRIC_EDGE_LENGTHS = 0x10,
+    /** Surface normals at cell centers */
+    FCLAW2D_METRIC_SURF_NORMALS = 0x20,
+    /** Curvature at cell centers */
+    FCLAW2D_METRIC_CURVATURE    = 0x40,
+    /** All metric terms */
+    FCLAW2D_METRIC_ALL          = 0x7f
+} fclaw2d_metric_terms_t;
+
 /* --------------------------- Metric routines (typedefs) ----------------------------- */
 /**
  * @brief Compute the cell center and node coordinates for a patch
@@ -168,6 +195,74 @@ void fclaw2d_metric_patch_compute_area(struct fclaw2d_global *glob,
 									   struct fclaw2d_patch* this_patch,
 									   int blockno, int patchno);
 
+/**
+ * @brief Register metric terms needed by a solver or application
+ * 
+ * Only registered terms, the area and the edge lengths are stored with 
+ * each updated patch.  Stored terms are computed when patches are built.
+ * If no terms are registered, all terms are stored.  Must be called before
+ * patches are built. 
+ * 
+ * @param[in] glob the global context
+ * @param[in] terms a bitwise or of ::fclaw2d_metric_terms_t values
+ */
+void fclaw2d_metric_require_terms(struct fclaw2d_global *glob, int terms);
+
+/**
+ * @brief Set metric terms that are recomputed on the fly instead of stored
+ * 
+ * This trades memory for time and is meant for maps that are cheap to 
+ * evaluate.  Storage for these terms is only held by the most recently 
+ * accessed patch, so pointers to them are only valid until metric terms 
+ * of another patch are accessed.  Inside an OpenMP parallel region, 
+ * terms are computed one patch at a time and kept with the patch until it 
+ * is rebuilt.  Area and edge lengths are read from neighboring patches 
+ * and are always stored.  Must be called before patches are built.
+ * 
+ * @param[in] glob the global context
+ * @param[in] terms a bitwise or of ::fclaw2d_metric_terms_t values
+ */
+void fclaw2d_metric_recompute_terms(struct fclaw2d_global *glob, int terms);
+
+/**
+ * @brief Drop all cached patch areas
+ * 
+ * Areas are cached when fclaw_options.metric_area_cache_size is positive.
+ * The cache is dropped by itself when a new domain or map context is 
+ * stored in glob.  Call this if the map changes without a new context.
+ * 
+ * @param[in] glob the global context
+ */
+void fclaw2d_metric_area_cache_clear(struct fclaw2d_global *glob);
+
+/**
+ * @brief Check if metric terms have been computed for a patch
+ * 
+ * @param[in] glob the global context
+ * @param[in] this_patch the patch context
+ * @param[in] terms a bitwise or of ::fclaw2d_metric_terms_t values
+ * @return int true if all of the terms have been computed
+ */
+int fclaw2d_metric_patch_has_terms(struct fclaw2d_global *glob,
+                                   struct fclaw2d_patch *this_patch,
+                                   int terms);
+
+/**
+ * @brief Check if a patch shares its metric terms with other patches
+ * 
+ * If the map is affine (see ::FCLAW2D_MAP_QUERY_IS_AFFINE), all metric
+ * terms except the mesh coordinates are the same for patches at the same 
+ * level. These are then stored once per level, and shared by all updated 
+ * patches at that level.  Set fclaw2d_metric_vtable.share_affine_terms to 
+ * 0 to store a copy with each patch.
+ * 
+ * @param[in] glob the global context
+ * @param[in] this_patch the patch context
+ * @return int true if the terms are shared
+ */
+int fclaw2d_metric_patch_is_shared(struct fclaw2d_global *glob,
+                                   struct fclaw2d_patch *this_patch);
+
 /* --------------------------------- Access functions --------------------------------- */
 
 /**
@@ -360,6 +455,26 @@ struct fclaw2d_metric_vtable
 	/** Compute the surface normals */
 	fclaw2d_metric_fort_compute_surf_normals_t  fort_compute_surf_normals;
 
+	/** Metric terms registered by solvers (see ::fclaw2d_metric_terms_t).
+	    Zero means all terms */
+	int required_terms;
+	/** Metric terms recomputed on the fly instead of stored */
+	int recompute_terms;
+	/** Metric patch currently holding the recomputed terms */
+	void *recompute_owner;
+
+	/** If true (default), patches at the same level share all terms but 
+	    the mesh when the map is affine */
+	int share_affine_terms;
+	/** Shared metric patches for each level */
+	void **shared_levels;
+	/** Length of shared_levels */
+	int num_shared_levels;
+
+	/** Areas keyed by block, level and patch position, for at most 
+	    fclaw_options.metric_area_cache_size patches */
+	void *area_cache;
+
 	/** True if vtable has been set */
 	int is_set;
 };
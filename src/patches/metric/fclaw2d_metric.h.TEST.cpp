@@ -25,7 +25,181 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw2d_global.h>
 #include <fclaw2d_metric.h>
+#include <fclaw2d_metric.hpp>
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_clawpatch_options.h>
+#include <fclaw2d_domain.h>
+#include <fclaw2d_forestclaw.h>
+#include <fclaw2d_map.h>
+#include <fclaw2d_options.h>
+#include <fclaw2d_patch.h>
 #include <test.hpp>
+#include <test/test.hpp>
+#include <cstring>
+#include <vector>
+
+namespace{
+/* A map that is not affine, so that areas are computed by quadrature */
+void test_c2m(fclaw2d_map_context_t* cont, int blockno,
+              double xc, double yc,
+              double *xp, double *yp, double *zp)
+{
+	*xp = xc*(1 + 0.5*yc);
+	*yp = yc + 0.25*xc*xc;
+	*zp = 0;
+}
+
+int test_query(fclaw2d_map_context_t* cont, int query_identifier)
+{
+	return 0;
+}
+
+int num_compute_area;
+int num_compute_area_ghost;
+
+void test_compute_area(fclaw2d_global_t *glob, fclaw2d_patch_t *patch,
+                       int blockno, int patchno)
+{
+	num_compute_area++;
+	fclaw2d_metric_compute_area_default(glob,patch,blockno,patchno);
+}
+
+void test_compute_area_ghost(fclaw2d_global_t *glob, fclaw2d_patch_t *patch,
+                             int blockno, int patchno)
+{
+	num_compute_area_ghost++;
+	fclaw2d_metric_compute_area_ghost_default(glob,patch,blockno,patchno);
+}
+
+/* Four level one patches on the unit square, with a level zero patch 
+   that can be built from them */
+struct MetricQuad {
+	fclaw2d_global_t* glob;
+	fclaw_options_t fopts;
+	fclaw2d_domain_t *domain;
+	fclaw2d_clawpatch_options_t opts;
+	fclaw2d_map_context_t *cont = NULL;
+	fclaw2d_patch_t coarse;
+
+	MetricQuad(bool mapped){
+		glob = fclaw2d_global_new();
+
+		fclaw2d_vtables_initialize(glob);
+		fclaw2d_clawpatch_vtable_initialize(glob, 4);
+
+		memset(&fopts, 0, sizeof(fopts));
+		fopts.mi = 1;
+		fopts.mj = 1;
+		fopts.minlevel = 1;
+		fopts.maxlevel = 1;
+		fopts.refratio = 2;
+		fopts.manifold = 1;
+
+		domain = create_test_domain(sc_MPI_COMM_WORLD,&fopts);
+		fclaw2d_global_store_domain(glob, domain);
+		fclaw2d_options_store(glob, &fopts);
+		if (mapped)
+		{
+			cont = FCLAW_ALLOC_ZERO(fclaw2d_map_context_t, 1);
+			cont->query = test_query;
+			cont->mapc2m = test_c2m;
+			glob->cont = cont;
+		}
+		else
+		{
+			/* The affine map of the brick */
+			glob->cont = (fclaw2d_map_context_t*)
+				fclaw2d_domain_attribute_access(domain, "fclaw_map_context", NULL);
+		}
+		FCLAW_MAP_SET_CONTEXT(&glob->cont);
+
+		memset(&opts, 0, sizeof(opts));
+		opts.mx   = 8;
+		opts.my   = 8;
+		opts.mbc  = 2;
+		opts.meqn = 1;
+		fclaw2d_clawpatch_options_store(glob, &opts);
+
+		fclaw2d_domain_data_new(glob->domain);
+
+		fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(glob);
+		metric_vt->compute_area = test_compute_area;
+		metric_vt->compute_area_ghost = test_compute_area_ghost;
+		num_compute_area = 0;
+		num_compute_area_ghost = 0;
+
+		memset(&coarse, 0, sizeof(coarse));
+		coarse.xupper = 1;
+		coarse.yupper = 1;
+	}
+	fclaw2d_patch_t* patch(int i){
+		return &domain->blocks[0].patches[i];
+	}
+	void build(){
+		fclaw2d_build_mode_t build_mode = FCLAW2D_BUILD_FOR_UPDATE;
+		for(int i = 0; i < 4; i++)
+			fclaw2d_patch_build(glob, patch(i), 0, i, &build_mode);
+	}
+	void release(){
+		for(int i = 0; i < 4; i++)
+			fclaw2d_patch_data_delete(glob, patch(i));
+	}
+	void build_coarse(){
+		fclaw2d_patch_build_from_fine(glob, patch(0), &coarse, 0, 0, 0,
+		                              FCLAW2D_BUILD_FOR_UPDATE);
+	}
+	void release_coarse(){
+		fclaw2d_patch_data_delete(glob, &coarse);
+	}
+	~MetricQuad(){
+		fclaw2d_map_context_t *none = NULL;
+		FCLAW_MAP_SET_CONTEXT(&none);
+		fclaw2d_global_destroy(glob);
+		if (cont != NULL)
+			fclaw2d_map_destroy(cont);
+	}
+};
+
+/* Number of area values, including ghost cells */
+int area_size(const fclaw2d_clawpatch_options_t& opts)
+{
+	return (opts.mx + 2*opts.mbc + 2)*(opts.my + 2*opts.mbc + 2);
+}
+
+/* Number of node values, including ghost cells */
+int node_size(const fclaw2d_clawpatch_options_t& opts)
+{
+	return (opts.mx + 2*opts.mbc + 3)*(opts.my + 2*opts.mbc + 3);
+}
+
+/* Copies of the area, edge lengths and normals of a patch */
+struct MetricTerms {
+	std::vector<double> area;
+	std::vector<double> edgelengths;
+	std::vector<double> xnormals;
+	std::vector<double> ynormals;
+
+	MetricTerms(MetricQuad& q, int i){
+		double *a, *e, *c, *xn, *yn, *xt, *yt, *sn;
+		fclaw2d_metric_patch_scalar(q.glob, q.patch(i), &a, &e, &c);
+		fclaw2d_metric_patch_vector(q.glob, q.patch(i), &xn, &yn, &xt, &yt, &sn);
+		int n = area_size(q.opts);
+		int nd = node_size(q.opts);
+		area.assign(a, a + n);
+		edgelengths.assign(e, e + 2*nd);
+		xnormals.assign(xn, xn + 3*nd);
+		ynormals.assign(yn, yn + 3*nd);
+	}
+};
+
+/* Terms shared with another patch are only equal up to rounding */
+void check_close(const std::vector<double>& a, const std::vector<double>& b)
+{
+	REQUIRE_EQ(a.size(), b.size());
+	for(size_t k = 0; k < a.size(); k++)
+		CHECK_EQ(a[k], doctest::Approx(b[k]));
+}
+}
 
 TEST_CASE("fclaw2d_metric_vtable_initialize stores two seperate vtables in two seperate globs")
 {
@@ -52,8 +226,266 @@ TEST_CASE("fclaw2d_metric_vtable_initialize sets is_set flag")
 	fclaw2d_global_destroy(glob);
 }
 
+TEST_CASE("fclaw2d_metric_vtable_initialize requires no terms")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_metric_vtable_initialize(glob);
+
+	CHECK_EQ(fclaw2d_metric_vt(glob)->required_terms, 0);
+	CHECK_EQ(fclaw2d_metric_vt(glob)->recompute_terms, 0);
+
+	fclaw2d_global_destroy(glob);
+}
+
+TEST_CASE("fclaw2d_metric_vtable_initialize shares affine terms")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_metric_vtable_initialize(glob);
+
+	CHECK_UNARY(fclaw2d_metric_vt(glob)->share_affine_terms);
+	CHECK_EQ(fclaw2d_metric_vt(glob)->shared_levels, nullptr);
+
+	fclaw2d_global_destroy(glob);
+}
+
+TEST_CASE("fclaw2d_metric_vtable_initialize has no area cache")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_metric_vtable_initialize(glob);
+
+	CHECK_EQ(fclaw2d_metric_vt(glob)->area_cache, nullptr);
+
+	fclaw2d_global_destroy(glob);
+}
+
+TEST_CASE("fclaw2d_metric_require_terms accumulates terms")
+{
+	fclaw2d_global_t* glob = fclaw2d_global_new();
+
+	fclaw2d_metric_vtable_initialize(glob);
+
+	fclaw2d_metric_require_terms(glob, FCLAW2D_METRIC_AREA);
+	fclaw2d_metric_require_terms(glob, FCLAW2D_METRIC_EDGE_LENGTHS);
+	CHECK_EQ(fclaw2d_metric_vt(glob)->required_terms, 
+	         FCLAW2D_METRIC_AREA | FCLAW2D_METRIC_EDGE_LENGTHS);
+
+	fclaw2d_metric_recompute_terms(glob, FCLAW2D_METRIC_MESH);
+	CHECK_EQ(fclaw2d_metric_vt(glob)->recompute_terms, FCLAW2D_METRIC_MESH);
+
+	fclaw2d_global_destroy(glob);
+}
+
+TEST_CASE("fclaw2d_metric area cache is off by default")
+{
+	MetricQuad q(true);
+
+	q.build();
+	q.release();
+	q.build();
+	CHECK_EQ(num_compute_area, 8);
+	CHECK_EQ(fclaw2d_metric_vt(q.glob)->area_cache, nullptr);
+
+	q.release();
+}
+
+TEST_CASE("fclaw2d_metric area cache gives computed areas after refine, coarsen and refine")
+{
+	MetricQuad q(true);
+	q.fopts.metric_area_cache_size = 4096;
+	int n = area_size(q.opts);
+
+	q.build();
+	CHECK_EQ(num_compute_area, 4);
+
+	/* Coarsen : areas are averaged from the fine patches */
+	q.build_coarse();
+	CHECK_EQ(num_compute_area_ghost, 1);
+
+	/* Refine and coarsen again : all areas come from the cache */
+	q.release();
+	q.build();
+	CHECK_EQ(num_compute_area, 4);
+	q.release_coarse();
+	q.build_coarse();
+	CHECK_EQ(num_compute_area_ghost, 1);
+
+	/* Cached areas are the same as freshly computed areas */
+	for(int i = 0; i < 4; i++)
+	{
+		double *area = fclaw2d_metric_patch_get_area(q.glob, q.patch(i));
+		std::vector<double> cached(area, area + n);
+		fclaw2d_metric_compute_area_default(q.glob, q.patch(i), 0, i);
+		for(int k = 0; k < n; k++)
+			CHECK_EQ(area[k], cached[k]);
+	}
+
+	q.release_coarse();
+	q.release();
+}
+
+TEST_CASE("fclaw2d_metric area cache drops the least recently used areas")
+{
+	MetricQuad q(true);
+	q.fopts.metric_area_cache_size = 3;
+
+	/* Patches 1, 2 and 3 stay in the cache */
+	q.build();
+	CHECK_EQ(num_compute_area, 4);
+	q.release();
+
+	fclaw2d_build_mode_t build_mode = FCLAW2D_BUILD_FOR_UPDATE;
+	fclaw2d_patch_build(q.glob, q.patch(3), 0, 3, &build_mode);
+	CHECK_EQ(num_compute_area, 4);
+
+	/* Patch 0 replaces patch 1, the least recently used */
+	fclaw2d_patch_build(q.glob, q.patch(0), 0, 0, &build_mode);
+	CHECK_EQ(num_compute_area, 5);
+	fclaw2d_patch_build(q.glob, q.patch(2), 0, 2, &build_mode);
+	CHECK_EQ(num_compute_area, 5);
+	fclaw2d_patch_build(q.glob, q.patch(1), 0, 1, &build_mode);
+	CHECK_EQ(num_compute_area, 6);
+
+	q.release();
+}
+
 #ifdef FCLAW_ENABLE_DEBUG
 
+TEST_CASE("fclaw2d_metric area cache is dropped for a new map context")
+{
+	MetricQuad q(true);
+	q.fopts.metric_area_cache_size = 4096;
+
+	q.build();
+	q.release();
+	CHECK_EQ(num_compute_area, 4);
+
+	fclaw2d_map_context_t *cont = FCLAW_ALLOC_ZERO(fclaw2d_map_context_t, 1);
+	cont->query = test_query;
+	cont->mapc2m = test_c2m;
+	q.glob->cont = cont;
+
+	q.build();
+	q.release();
+	CHECK_EQ(num_compute_area, 8);
+
+	q.glob->cont = q.cont;
+	fclaw2d_map_destroy(cont);
+}
+
+TEST_CASE("fclaw2d_metric_area_cache_clear drops cached areas")
+{
+	MetricQuad q(true);
+	q.fopts.metric_area_cache_size = 4096;
+
+	q.build();
+	q.release();
+	CHECK_NE(fclaw2d_metric_vt(q.glob)->area_cache, nullptr);
+
+	fclaw2d_metric_area_cache_clear(q.glob);
+	CHECK_EQ(fclaw2d_metric_vt(q.glob)->area_cache, nullptr);
+
+	q.build();
+	q.release();
+	CHECK_EQ(num_compute_area, 8);
+}
+
+TEST_CASE("fclaw2d_metric recomputed terms are the same as stored terms")
+{
+	std::vector<MetricTerms> eager;
+	{
+		MetricQuad q(true);
+		q.build();
+		for(int i = 0; i < 4; i++)
+			eager.push_back(MetricTerms(q, i));
+		q.release();
+	}
+
+	MetricQuad q(true);
+	fclaw2d_metric_recompute_terms(q.glob, FCLAW2D_METRIC_MESH | 
+	                               FCLAW2D_METRIC_NORMALS | 
+	                               FCLAW2D_METRIC_TANGENTS |
+	                               FCLAW2D_METRIC_SURF_NORMALS |
+	                               FCLAW2D_METRIC_CURVATURE);
+	q.build();
+	for(int i = 0; i < 4; i++)
+		CHECK_FALSE(fclaw2d_metric_patch_has_terms(q.glob, q.patch(i), 
+		                                           FCLAW2D_METRIC_NORMALS));
+
+	/* Patches are accessed in turn, and then from threads */
+	for(int pass = 0; pass < 2; pass++)
+	{
+		std::vector<MetricTerms*> lazy(4, NULL);
+#pragma omp parallel for if(pass == 1)
+		for(int i = 0; i < 4; i++)
+			lazy[i] = new MetricTerms(q, i);
+
+		for(int i = 0; i < 4; i++)
+		{
+			CHECK(lazy[i]->area == eager[i].area);
+			CHECK(lazy[i]->edgelengths == eager[i].edgelengths);
+			CHECK(lazy[i]->xnormals == eager[i].xnormals);
+			CHECK(lazy[i]->ynormals == eager[i].ynormals);
+			delete lazy[i];
+		}
+	}
+
+	q.release();
+}
+
+TEST_CASE("fclaw2d_metric affine terms are shared by patches at a level")
+{
+	std::vector<MetricTerms> unshared;
+	{
+		MetricQuad q(false);
+		fclaw2d_metric_vt(q.glob)->share_affine_terms = 0;
+		q.build();
+		for(int i = 0; i < 4; i++)
+		{
+			CHECK_FALSE(fclaw2d_metric_patch_is_shared(q.glob, q.patch(i)));
+			unshared.push_back(MetricTerms(q, i));
+		}
+		q.release();
+	}
+
+	/* Shared patches also hold the terms that are otherwise recomputed */
+	for(int recompute = 0; recompute < 2; recompute++)
+	{
+		MetricQuad q(false);
+		if (recompute)
+			fclaw2d_metric_recompute_terms(q.glob, FCLAW2D_METRIC_MESH | 
+			                               FCLAW2D_METRIC_NORMALS | 
+			                               FCLAW2D_METRIC_TANGENTS);
+		q.build();
+
+		fclaw2d_metric_vtable_t *metric_vt = fclaw2d_metric_vt(q.glob);
+		fclaw2d_metric_patch_t *sp = 
+			fclaw2d_metric_get_metric_patch(q.glob, q.patch(0))->shared;
+		REQUIRE_NE(sp, nullptr);
+		CHECK_EQ(metric_vt->shared_levels[1], (void*) sp);
+		CHECK_EQ(sp->refcount, 4);
+
+		double *area0 = fclaw2d_metric_patch_get_area(q.glob, q.patch(0));
+		for(int i = 0; i < 4; i++)
+		{
+			CHECK_UNARY(fclaw2d_metric_patch_is_shared(q.glob, q.patch(i)));
+			CHECK_EQ(fclaw2d_metric_get_metric_patch(q.glob, q.patch(i))->shared, sp);
+			CHECK_EQ(fclaw2d_metric_patch_get_area(q.glob, q.patch(i)), area0);
+
+			MetricTerms shared(q, i);
+			check_close(shared.area, unshared[i].area);
+			check_close(shared.edgelengths, unshared[i].edgelengths);
+			check_close(shared.xnormals, unshared[i].xnormals);
+			check_close(shared.ynormals, unshared[i].ynormals);
+		}
+
+		q.release();
+		CHECK_EQ(metric_vt->shared_levels[1], nullptr);
+	}
+}
+
 TEST_CASE("fclaw2d_metric_vtable_initialize fails if called twice on a glob")
 {
 	fclaw2d_global_t* glob1 = fclaw2d_global_new();
@@ -45,6 +45,25 @@ struct fclaw2d_metric_patch_t
     int mbc;
     /** The block number */
     int blockno;
+    /** The patch number */
+    int patchno;
+
+    /** Metric terms this patch can provide (see ::fclaw2d_metric_terms_t) */
+    int available;
+    /** Metric terms that currently have storage */
+    int terms;
+    /** Metric terms that have been computed */
+    int computed;
+    /** Vtable slot recording the patch that holds recomputed terms */
+    void **recompute_owner;
+
+    /** Terms shared by all patches at this level, or NULL.  Only the
+        mesh is stored with a patch that shares terms. */
+    fclaw2d_metric_patch_t *shared;
+    /** Number of patches using a shared patch */
+    int refcount;
+    /** Cache slot holding a shared patch */
+    void **shared_slot;
 
     /** The spacing in the x direction */
     double dx;
@@ -85,21 +85,33 @@ void fclaw2d_metric_compute_basis_default(fclaw2d_global_t *glob,
                                     &surfnormals,&edgelengths,
                                     &curvature);
 
-    /* The user could set these to NULL to avoid doing these computations ... */
+    /* The user could set these to NULL to avoid doing these computations ... 
+       Arrays are NULL for terms not registered with 
+       fclaw2d_metric_require_terms. */
 
-    if (metric_vt->fort_compute_normals != NULL)
+    if (metric_vt->fort_compute_normals != NULL && xnormals != NULL)
     {
         metric_vt->fort_compute_normals(&mx,&my,&mbc,xp,yp,zp,xd,yd,zd,
                                         xnormals,ynormals);
     }
 
-    if (metric_vt->fort_compute_tangents != NULL)
+    if (metric_vt->fort_compute_tangents != NULL && xtangents != NULL)
     {
         metric_vt->fort_compute_tangents(&mx,&my,&mbc,xd,yd,zd,xtangents,ytangents,
                                          edgelengths);
     }
+    else if (metric_vt->fort_compute_tangents != NULL && edgelengths != NULL)
+    {
+        /* Tangents are not stored, but edge lengths are computed with them */
+        int size = 3*(mx + 2*mbc + 2)*(my + 2*mbc + 2);
+        double *tangents = FCLAW_ALLOC(double,2*size);
+        metric_vt->fort_compute_tangents(&mx,&my,&mbc,xd,yd,zd,
+                                         tangents,tangents + size,
+                                         edgelengths);
+        FCLAW_FREE(tangents);
+    }
 
-    if (metric_vt->fort_compute_surf_normals != NULL)
+    if (metric_vt->fort_compute_surf_normals != NULL && surfnormals != NULL)
     {
         metric_vt->fort_compute_surf_normals(&mx,&my,&mbc,xnormals,ynormals,edgelengths,
                                              curvature, surfnormals, area);
@@ -23,41 +23,36 @@ subroutine fclaw2d_metric_fort_compute_mesh(mx,my,mbc, &
     double precision yd(-mbc:mx+mbc+2,-mbc:my+mbc+2)
     double precision zd(-mbc:mx+mbc+2,-mbc:my+mbc+2)
 
-    integer i,j
-    double precision dxf,dyf, xc,yc,xd1, yd1,zd1
+    integer i,j, nd, np
+    double precision xcrow(-mbc:mx+mbc+2), ycrow(-mbc:mx+mbc+2)
 
     integer*8 map_context_ptr, fclaw_map_get_context
 
     map_context_ptr = fclaw_map_get_context()
 
     !! # We need both cell centered and node locations to
-    !! # compute the normals at cell edges.
-    dxf = dx/2.d0
-    dyf = dy/2.d0
-    do i = -2*mbc-1,2*(mx+mbc+1)+1
-        do j = -2*mbc-1,2*(my+mbc+1)+1
-            if (abs(mod(i,2)) .ne. abs(mod(j,2))) then
-                cycle
-            endif
-            xc = xlower + (i-1)*dxf
-            yc = ylower + (j-1)*dyf
-
-
-            call fclaw2d_map_c2m(map_context_ptr, & 
-                               blockno,xc,yc,xd1,yd1,zd1)
+    !! # compute the normals at cell edges.  Each row of nodes and
+    !! # each row of cell centers is mapped with a single call.
+    nd = mx + 2*mbc + 3
+    do j = -mbc,my+mbc+2
+        do i = -mbc,mx+mbc+2
+            xcrow(i) = xlower + (i-1)*dx
+            ycrow(i) = ylower + (j-1)*dy
+        end do
+        !! # Physical location of cell vertices
+        call fclaw2d_map_c2m_batch(map_context_ptr, blockno, nd, & 
+                  xcrow, ycrow, xd(-mbc,j), yd(-mbc,j), zd(-mbc,j))
+    end do
 
-            if (abs(mod(i,2)) .eq. 1) then
-                !! # Physical location of cell vertices
-                xd((i-1)/2 + 1, (j-1)/2 + 1) = xd1
-                yd((i-1)/2 + 1, (j-1)/2 + 1) = yd1
-                zd((i-1)/2 + 1, (j-1)/2 + 1) = zd1
-            else
-                !! # Physical locations of cell centers
-                xp(i/2,j/2) = xd1
-                yp(i/2,j/2) = yd1
-                zp(i/2,j/2) = zd1
-            endif
+    np = mx + 2*mbc + 2
+    do j = -mbc,my+mbc+1
+        do i = -mbc,mx+mbc+1
+            xcrow(i) = xlower + (i-0.5d0)*dx
+            ycrow(i) = ylower + (j-0.5d0)*dy
         end do
+        !! # Physical locations of cell centers
+        call fclaw2d_map_c2m_batch(map_context_ptr, blockno, np, & 
+                  xcrow, ycrow, xp(-mbc,j), yp(-mbc,j), zp(-mbc,j))
     end do
 end subroutine fclaw2d_metric_fort_compute_mesh
 
@@ -121,14 +116,15 @@ subroutine fclaw2d_metric_fort_compute_area_general(mx,my,mbc, &
 
     double precision area(-mbc:mx+mbc+1,-mbc:my+mbc+1)
 
-    integer i,j,ii,jj, m, rfactor, icell, jcell
+    integer i,j,ii,jj, m, rfactor, icell, jcell, nq
     double precision sum_area
-    double precision xp1,yp1,zp1
     double precision quad(0:1,0:1,3)
     double precision get_area_approx
+    double precision xcq(0:quadsize,0:quadsize)
+    double precision ycq(0:quadsize,0:quadsize)
 
     double precision dxf, dyf
-    double precision xef, yef, xe,ye
+    double precision xe,ye
     logical is_area_interior
 
     integer*8 cont, fclaw_map_get_context
@@ -138,6 +134,7 @@ subroutine fclaw2d_metric_fort_compute_area_general(mx,my,mbc, &
     rfactor = quadsize
     dxf = dx/rfactor
     dyf = dy/rfactor
+    nq = (rfactor+1)*(rfactor+1)
 
     !! # Primary cells.  Note that we don't do anything special
     !! # in the diagonal cells - so the areas there are less accurate
@@ -151,20 +148,17 @@ subroutine fclaw2d_metric_fort_compute_area_general(mx,my,mbc, &
             xe = xlower + (i-1)*dx
             ye = ylower + (j-1)*dy
 
-            do ii = 0,rfactor
-                do jj = 0,rfactor
-                    xef = xe + ii*dxf
-                    yef = ye + jj*dyf
-
-                    call fclaw2d_map_c2m(cont, & 
-                        blockno,xef,yef,xp1,yp1,zp1)
-
-                    quadstore(ii,jj,1) = xp1
-                    quadstore(ii,jj,2) = yp1
-                    quadstore(ii,jj,3) = zp1
+            do jj = 0,rfactor
+                do ii = 0,rfactor
+                    xcq(ii,jj) = xe + ii*dxf
+                    ycq(ii,jj) = ye + jj*dyf
                 end do
             end do
 
+            !! # Map all quadrature nodes in this cell with one call
+            call fclaw2d_map_c2m_batch(cont, blockno, nq, xcq, ycq, & 
+                 quadstore(0,0,1), quadstore(0,0,2), quadstore(0,0,3))
+
             sum_area = 0.d0
             do ii = 0,rfactor-1
                 do jj = 0,rfactor-1
@@ -213,34 +207,44 @@ subroutine fclaw2d_metric_fort_compute_area_affine(mx,my,mbc,dx,dy, &
 
     double precision area(-mbc:mx+mbc+1,-mbc:my+mbc+1)
 
-    integer i,j, icell, jcell
-    double precision xcorner, ycorner
-    double precision xe,ye, xp1,yp1,zp1
+    integer i,j, icell, jcell, jrow, nd
     double precision quad(0:1,0:1,3)
     double precision get_area_approx
     logical is_area_interior
+    double precision xcrow(-mbc:mx+mbc+2), ycrow(-mbc:mx+mbc+2)
+    double precision xrow(-mbc:mx+mbc+2,0:1)
+    double precision yrow(-mbc:mx+mbc+2,0:1)
+    double precision zrow(-mbc:mx+mbc+2,0:1)
 
     integer*8 map_context_ptr, fclaw_map_get_context
 
     map_context_ptr = fclaw_map_get_context()
 
+    !! # Map the two rows of nodes bounding each row of cells with 
+    !! # one call per row.
+    nd = mx + 2*mbc + 3
     do j = -mbc,my+mbc+1
+        do jcell = 0,1
+            jrow = j + jcell
+            do i = -mbc,mx+mbc+2
+                xcrow(i) = xlower + (i-1)*dx
+                ycrow(i) = ylower + (jrow-1)*dy
+            end do
+            call fclaw2d_map_c2m_batch(map_context_ptr, blockno, nd, & 
+                    xcrow, ycrow, xrow(-mbc,jcell), yrow(-mbc,jcell), & 
+                    zrow(-mbc,jcell))
+        end do
+
         do i = -mbc,mx+mbc+1
             if (is_area_interior(mx,my,i,j) .and. & 
                  ghost_only .eq. 1) then
                 cycle
             endif
-            xe = xlower + (i-1)*dx
-            ye = ylower + (j-1)*dy
             do icell = 0,1
                 do jcell = 0,1
-                    xcorner = xe + icell*dx
-                    ycorner = ye + jcell*dy
-                    call fclaw2d_map_c2m(map_context_ptr, & 
-                        blockno,xcorner,ycorner,xp1,yp1,zp1)
-                    quad(icell,jcell,1) = xp1
-                    quad(icell,jcell,2) = yp1
-                    quad(icell,jcell,3) = zp1
+                    quad(icell,jcell,1) = xrow(i+icell,jcell)
+                    quad(icell,jcell,2) = yrow(i+icell,jcell)
+                    quad(icell,jcell,3) = zrow(i+icell,jcell)
                 end do
             end do
             area(i,j) = get_area_approx(quad)
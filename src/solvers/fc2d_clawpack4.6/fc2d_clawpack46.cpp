@@ -33,18 +33,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_clawpatch_options.h>
 #include <fclaw2d_clawpatch_output_ascii.h> 
 #include <fclaw2d_clawpatch_output_vtk.h>
+#include <fclaw2d_clawpatch_output.h>
 #include <fclaw2d_clawpatch_fort.h>
 
 #include <fclaw2d_clawpatch_conservation.h>
 
 #include <fclaw2d_patch.h>
 #include <fclaw2d_global.h>
+#include <fclaw2d_update_single_step.h>
 #include <fclaw2d_vtable.h>
 #include <fclaw2d_options.h>
 #include <fclaw2d_defs.h>
 
 #include <fclaw_pointer_map.h>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 
 /* --------------------- Clawpack solver functions (required) ------------------------- */
 
@@ -255,14 +261,90 @@ void clawpack46_setaux(fclaw2d_global_t *glob,
 	CLAWPACK46_UNSET_BLOCK();
 }
 
-/* This is called from the single_step callback. and is of type 'flaw_single_step_t' */
+/* Work arrays for one call to CLAWPACK46_STEP2_WRAP.  Sized from the clawpatch 
+   options, so that one set can be reused for all patches in a batch. */
+typedef struct clawpack46_step2_work
+{
+	int mwork;
+	double *work;
+	double *fp;
+	double *fm;
+	double *gp;
+	double *gm;
+
+	/* Used to store fluxes for conservation */
+	double *qvec;
+	double *auxvec_center;
+	double *auxvec_edge;
+	double *flux;
+
+	/* Stand-in registers for faces without registers */
+	double *registers_work;
+} clawpack46_step2_work_t;
+
 static
-double clawpack46_step2(fclaw2d_global_t *glob,
-						fclaw2d_patch_t *patch,
-						int blockno,
-						int patchno,
-						double t,
-						double dt)
+void clawpack46_step2_work_new(fclaw2d_global_t *glob,
+                               clawpack46_step2_work_t *w)
+{
+	const fclaw2d_clawpatch_options_t* clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
+	const fc2d_clawpack46_options_t* clawpack_options = fc2d_clawpack46_get_options(glob);
+
+	int mx = clawpatch_opt->mx;
+	int my = clawpatch_opt->my;
+	int mbc = clawpatch_opt->mbc;
+	int meqn = clawpatch_opt->meqn;
+	int maux = clawpatch_opt->maux;
+	int mwaves = clawpack_options->mwaves;
+	int maxm = fmax(mx,my);
+
+	w->mwork = (maxm+2*mbc)*(12*meqn + (meqn+1)*mwaves + 3*maux + 2);
+	w->work = FCLAW_ALLOC(double,w->mwork);
+
+	int size = meqn*(mx+2*mbc)*(my+2*mbc);
+	w->fp = FCLAW_ALLOC(double,size);
+	w->fm = FCLAW_ALLOC(double,size);
+	w->gp = FCLAW_ALLOC(double,size);
+	w->gm = FCLAW_ALLOC(double,size);
+
+	w->qvec          = FCLAW_ALLOC(double, meqn);
+	w->auxvec_center = FCLAW_ALLOC(double, maux);
+	w->auxvec_edge   = FCLAW_ALLOC(double, maux);
+	w->flux          = FCLAW_ALLOC(double, meqn);     /* f(qr) - f(ql) = amdq+apdq */
+
+	const fclaw_options_t* fclaw_opt = fclaw2d_get_options(glob);
+	w->registers_work = NULL;
+	if (fclaw_opt->time_sync)
+	{
+		int rsize = fclaw2d_clawpatch_time_sync_work_size(glob);
+		w->registers_work = FCLAW_ALLOC(double, rsize);
+	}
+}
+
+static
+void clawpack46_step2_work_destroy(clawpack46_step2_work_t *w)
+{
+	FCLAW_FREE(w->fp);
+	FCLAW_FREE(w->fm);
+	FCLAW_FREE(w->gp);
+	FCLAW_FREE(w->gm);
+	FCLAW_FREE(w->work);
+
+	FCLAW_FREE(w->qvec);
+	FCLAW_FREE(w->auxvec_center);
+	FCLAW_FREE(w->auxvec_edge);
+	FCLAW_FREE(w->flux);
+	FCLAW_FREE(w->registers_work);
+}
+
+/* Update a single patch, using work arrays w */
+static
+double clawpack46_step2_patch(fclaw2d_global_t *glob,
+                              fclaw2d_patch_t *patch,
+                              int blockno,
+                              int patchno,
+                              double t,
+                              double dt,
+                              clawpack46_step2_work_t *w)
 {
 	fc2d_clawpack46_vtable_t*  claw46_vt = fc2d_clawpack46_vt(glob);
 	const fclaw_options_t* fclaw_opt = fclaw2d_get_options(glob);
@@ -308,19 +390,25 @@ double clawpack46_step2(fclaw2d_global_t *glob,
 
 	double cflgrid = 0.0;
 
+	/* Registers are only kept at coarse/fine and block interfaces;  the 
+	   other faces are written to the work array. */
+	fclaw2d_clawpatch_registers_t registers;
 	fclaw2d_clawpatch_registers_t* cr = 
 		  fclaw2d_clawpatch_get_registers(glob,patch);
+	int sync_patch = fclaw_opt->time_sync && cr->face_mask != 0;
+	if (sync_patch)
+	{
+		fclaw2d_clawpatch_time_sync_fill_faces(glob,cr,w->registers_work,
+		                                       &registers);
+		cr = &registers;
+	}
 
 	int* block_corner_count = fclaw2d_patch_block_corner_count(glob,patch);
 
 	/* Evaluate fluxes needed in correction terms */
-	if (fclaw_opt->time_sync && fclaw_opt->flux_correction)
+	if (sync_patch && fclaw_opt->flux_correction)
 	{
 		FCLAW_ASSERT(claw46_vt->fort_rpn2_cons != NULL);
-		double *qvec          = FCLAW_ALLOC(double, meqn);
-		double *auxvec_center = FCLAW_ALLOC(double, maux);
-		double *auxvec_edge   = FCLAW_ALLOC(double, maux);
-		double *flux          = FCLAW_ALLOC(double, meqn);     /* f(qr) - f(ql) = amdq+apdq */
 
 		CLAWPACK46_TIME_SYNC_STORE_FLUX(&mx,&my,&mbc,&meqn,&maux,
 		                                &blockno,&patchno, &dt,
@@ -332,25 +420,10 @@ double clawpack46_step2(fclaw2d_global_t *glob,
 										cr->edge_fluxes[0],cr->edge_fluxes[1],
 										cr->edge_fluxes[2],cr->edge_fluxes[3],
 										claw46_vt->fort_rpn2_cons,
-										qvec,auxvec_center,auxvec_edge,flux);
-
-		FCLAW_FREE(qvec);
-		FCLAW_FREE(auxvec_center);
-		FCLAW_FREE(auxvec_edge);
-		FCLAW_FREE(flux);
+										w->qvec,w->auxvec_center,w->auxvec_edge,
+										w->flux);
 	}
 
-
-
-	int mwork = (maxm+2*mbc)*(12*meqn + (meqn+1)*mwaves + 3*maux + 2);
-	double* work = FCLAW_ALLOC(double,mwork);
-
-	int size = meqn*(mx+2*mbc)*(my+2*mbc);
-	double* fp = FCLAW_ALLOC(double,size);
-	double* fm = FCLAW_ALLOC(double,size);
-	double* gp = FCLAW_ALLOC(double,size);
-	double* gm = FCLAW_ALLOC(double,size);
-
 	int ierror = 0;
 
 	if (claw46_vt->flux2 == NULL)
@@ -364,7 +437,8 @@ double clawpack46_step2(fclaw2d_global_t *glob,
 	CLAWPACK46_STEP2_WRAP(&maxm, &meqn, &maux, &mbc, clawpack_options->method,
 						  clawpack_options->mthlim, &clawpack_options->mcapa,
 						  &mwaves,&mx, &my, qold, aux, &dx, &dy, &dt, &cflgrid,
-						  work, &mwork, &xlower, &ylower, &level,&t, fp, fm, gp, gm,
+						  w->work, &w->mwork, &xlower, &ylower, &level,&t, 
+						  w->fp, w->fm, w->gp, w->gm,
 						  claw46_vt->fort_rpn2, claw46_vt->fort_rpt2,
 						  claw46_vt->fort_rpn2fw, claw46_vt->fort_rpt2fw,
 						  claw46_vt->flux2,
@@ -373,7 +447,7 @@ double clawpack46_step2(fclaw2d_global_t *glob,
 
 	FCLAW_ASSERT(ierror == 0);
 
-	if (fclaw_opt->time_sync && fclaw_opt->fluctuation_correction)
+	if (sync_patch && fclaw_opt->fluctuation_correction)
 	{
 
 		CLAWPACK46_TIME_SYNC_ACCUMULATE_WAVES(&mx,&my,&mbc,&meqn, &dt, &dx, 
@@ -382,23 +456,168 @@ double clawpack46_step2(fclaw2d_global_t *glob,
 		                                      cr->edgelengths[1],
 		                                      cr->edgelengths[2],
 		                                      cr->edgelengths[3],
-		                                      fp,fm,gp,gm,
+		                                      w->fp,w->fm,w->gp,w->gm,
 		                                      cr->fp[0],cr->fp[1],
 		                                      cr->fm[0],cr->fm[1],
 		                                      cr->gp[0],cr->gp[1],
 		                                      cr->gm[0],cr->gm[1]);
 	}		
 
+	return cflgrid;
+}
+
+/* This is called from the single_step callback. and is of type 'flaw_single_step_t' */
+static
+double clawpack46_step2(fclaw2d_global_t *glob,
+						fclaw2d_patch_t *patch,
+						int blockno,
+						int patchno,
+						double t,
+						double dt)
+{
+	clawpack46_step2_work_t w;
+	clawpack46_step2_work_new(glob,&w);
 
-	FCLAW_FREE(fp);
-	FCLAW_FREE(fm);
-	FCLAW_FREE(gp);
-	FCLAW_FREE(gm);
-	FCLAW_FREE(work);
+	double cflgrid = clawpack46_step2_patch(glob,patch,blockno,patchno,t,dt,&w);
 
+	clawpack46_step2_work_destroy(&w);
 	return cflgrid;
 }
 
+/* A patch waiting in the batch buffer */
+typedef struct clawpack46_batch_entry
+{
+	fclaw2d_patch_t *patch;
+	int blockno;
+	int patchno;
+} clawpack46_batch_entry_t;
+
+/* Update n buffered patches (and add source terms).  Work arrays are 
+   allocated once for the batch, one set per thread.  The Riemann solvers 
+   run in the threads;  /comxyt/ and /comblock/ are threadprivate. */
+static
+double clawpack46_step2_batch(fclaw2d_global_t *glob,
+                              clawpack46_batch_entry_t *batch,
+                              int n, double t, double dt)
+{
+	fc2d_clawpack46_vtable_t*  claw46_vt = fc2d_clawpack46_vt(glob);
+	const fc2d_clawpack46_options_t* clawpack_options = fc2d_clawpack46_get_options(glob);
+
+	int nthreads = 1;
+#if defined(_OPENMP)
+	nthreads = (omp_get_max_threads() < n) ? omp_get_max_threads() : n;
+#endif
+	clawpack46_step2_work_t *w = FCLAW_ALLOC(clawpack46_step2_work_t,nthreads);
+	for(int i = 0; i < nthreads; i++)
+	{
+		clawpack46_step2_work_new(glob,&w[i]);
+	}
+
+	/* Set before the threads start, rather than by each of them */
+	if (claw46_vt->flux2 == NULL)
+	{
+		claw46_vt->flux2 = (clawpack_options->use_fwaves != 0) ? &CLAWPACK46_FLUX2FW : 
+		                       &CLAWPACK46_FLUX2;	
+	}
+
+	/* Registers are allocated by the getter;  do this here rather than 
+	   in the threads */
+	const fclaw_options_t* fclaw_opt = fclaw2d_get_options(glob);
+	if (fclaw_opt->time_sync)
+	{
+		for(int i = 0; i < n; i++)
+		{
+			fclaw2d_clawpatch_get_registers(glob,batch[i].patch);
+		}
+	}
+
+	double maxcfl = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) reduction(max:maxcfl)
+#endif
+	for(int i = 0; i < n; i++)
+	{
+		int thread = 0;
+#if defined(_OPENMP)
+		thread = omp_get_thread_num();
+#endif
+		double cflgrid = clawpack46_step2_patch(glob,batch[i].patch,
+		                                        batch[i].blockno,
+		                                        batch[i].patchno,t,dt,&w[thread]);
+		maxcfl = fmax(maxcfl,cflgrid);
+	}
+
+	/* User source terms are not required to be thread safe, so they are 
+	   added outside of the threaded loop. */
+	if (clawpack_options->src_term > 0 && claw46_vt->src2 != NULL)
+	{
+		for(int i = 0; i < n; i++)
+		{
+			claw46_vt->src2(glob,
+			                batch[i].patch,
+			                batch[i].blockno,
+			                batch[i].patchno,t,dt);
+		}
+	}
+
+	for(int i = 0; i < nthreads; i++)
+	{
+		clawpack46_step2_work_destroy(&w[i]);
+	}
+	FCLAW_FREE(w);
+	return maxcfl;
+}
+
+/* Buffer this patch;  update the buffered patches once the buffer is full 
+   or the last patch of the level has been visited.  See cudaclaw_update. */
+static
+double clawpack46_update_buffered(fclaw2d_global_t *glob,
+                                  fclaw2d_patch_t *patch,
+                                  int blockno,
+                                  int patchno,
+                                  double t,
+                                  double dt, 
+                                  fclaw2d_single_step_buffer_data_t *buffer_data)
+{
+	const fc2d_clawpack46_options_t* clawpack_options = fc2d_clawpack46_get_options(glob);
+
+	int patch_buffer_len = clawpack_options->buffer_len;
+	int iter = buffer_data->iter;
+	int total = buffer_data->total_count;
+
+	if (iter == 0)
+	{
+		int size = (total < patch_buffer_len) ? total : patch_buffer_len;
+		buffer_data->user = FCLAW_ALLOC(clawpack46_batch_entry_t,size);
+	}
+
+	clawpack46_batch_entry_t *batch = (clawpack46_batch_entry_t*) buffer_data->user;
+	clawpack46_batch_entry_t *entry = &batch[iter % patch_buffer_len];
+	entry->patch = patch;
+	entry->blockno = blockno;
+	entry->patchno = patchno;
+
+	double maxcfl = 0;
+	if ((iter+1) % patch_buffer_len == 0)
+	{
+		/* (1) We have filled the buffer */
+		maxcfl = clawpack46_step2_batch(glob,batch,patch_buffer_len,t,dt);
+	}
+	else if ((iter+1) == total)
+	{
+		/* (2) We have a partially filled buffer, but are done with all the 
+		   patches that need to be updated. */
+		maxcfl = clawpack46_step2_batch(glob,batch,total % patch_buffer_len,t,dt);
+	}
+
+	if (iter == total-1)
+	{
+		FCLAW_FREE(buffer_data->user);
+		buffer_data->user = NULL;
+	}
+	return maxcfl;
+}
+
 static
 double clawpack46_update(fclaw2d_global_t *glob,
                          fclaw2d_patch_t *patch,
@@ -424,6 +643,19 @@ double clawpack46_update(fclaw2d_global_t *glob,
         fclaw2d_timer_stop_threadsafe(&glob->timers[FCLAW2D_TIMER_ADVANCE_B4STEP2]);               
     }
 
+    fclaw2d_single_step_buffer_data_t *buffer_data = 
+              (fclaw2d_single_step_buffer_data_t*) user;
+    if (clawpack_options->buffer_len > 1 && buffer_data != NULL 
+        && buffer_data->total_count > 0)
+    {
+        /* Source terms are added in the batch */
+        fclaw2d_timer_start_threadsafe(&glob->timers[FCLAW2D_TIMER_ADVANCE_STEP2]);       
+        double maxcfl = clawpack46_update_buffered(glob,patch,blockno,patchno,
+                                                   t,dt,buffer_data);
+        fclaw2d_timer_stop_threadsafe(&glob->timers[FCLAW2D_TIMER_ADVANCE_STEP2]);       
+        return maxcfl;
+    }
+
     fclaw2d_timer_start_threadsafe(&glob->timers[FCLAW2D_TIMER_ADVANCE_STEP2]);       
 
     double maxcfl = clawpack46_step2(glob,
@@ -452,16 +684,20 @@ void clawpack46_output(fclaw2d_global_t *glob, int iframe)
 	const fc2d_clawpack46_options_t* clawpack_options;
 	clawpack_options = fc2d_clawpack46_get_options(glob);
 
+	/* Formats are written in one pass over the patches */
+	int formats = 0;
 	if (clawpack_options->ascii_out != 0)
 	{
-		fclaw2d_clawpatch_output_ascii(glob,iframe);
+		formats |= FCLAW2D_CLAWPATCH_OUTPUT_ASCII;
 	}
 
 	if (clawpack_options->vtk_out != 0)
 	{
-		fclaw2d_clawpatch_output_vtk(glob,iframe);
+		formats |= FCLAW2D_CLAWPATCH_OUTPUT_VTK;
 	}
 
+	fclaw2d_clawpatch_output_frame(glob,iframe,formats);
+
 }
 
 
@@ -480,6 +716,8 @@ void clawpack46_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 void fc2d_clawpack46_solver_initialize(fclaw2d_global_t* glob)
 {
 	fclaw2d_clawpatch_options_t* clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
@@ -510,6 +748,7 @@ void fc2d_clawpack46_solver_initialize(fclaw2d_global_t* glob)
 	patch_vt->setup                          = clawpack46_setaux;  
 	patch_vt->physical_bc                    = clawpack46_bc2;
 	patch_vt->single_step_update             = clawpack46_update;
+	patch_vt->single_step_buffered           = clawopt->buffer_len > 1;
 
 	/* Conservation updates (based on Clawpack updates) */
 	clawpatch_vt->fort_time_sync_f2c         = CLAWPACK46_FORT_TIME_SYNC_F2C;
@@ -535,6 +774,7 @@ void fc2d_clawpack46_solver_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fc2d_clawpack46") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fc2d_clawpack46", claw46_vt, clawpack46_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fc2d_clawpack46");
 }
 
 
@@ -546,7 +786,7 @@ void fc2d_clawpack46_solver_initialize(fclaw2d_global_t* glob)
 fc2d_clawpack46_vtable_t* fc2d_clawpack46_vt(fclaw2d_global_t* glob)
 {
 	fc2d_clawpack46_vtable_t* claw46_vt = (fc2d_clawpack46_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fc2d_clawpack46");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(claw46_vt != NULL);
 	FCLAW_ASSERT(claw46_vt->is_set != 0);
 	return claw46_vt;
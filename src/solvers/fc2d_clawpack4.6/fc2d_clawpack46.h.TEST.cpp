@@ -28,7 +28,141 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fc2d_clawpack46.h>
 #include <fc2d_clawpack46_options.h>
 #include <fclaw2d_forestclaw.h>
+#include <fclaw2d_patch.h>
+#include <fclaw2d_domain.h>
+#include <fclaw2d_clawpatch.h>
+#include <fclaw2d_update_single_step.h>
 #include <test.hpp>
+#include <test/test.hpp>
+#include <cmath>
+#include <vector>
+
+namespace{
+/* Scalar advection with velocity (1,1/2).  Interfaces i = 2-mbc..mx+mbc are 
+   stored from index 1 of arrays that start at 1-mbc. */
+void advection_rpn2(const int* ixy, const int* maxm, const int* meqn,
+                    const int* mwaves, const int* mbc, const int* mx,
+                    double ql[], double qr[], double auxl[], double auxr[],
+                    double wave[], double s[], double amdq[], double apdq[])
+{
+	double u = (*ixy == 1) ? 1.0 : 0.5;
+	for(int k = 1; k < *mx + 2*(*mbc); k++)
+	{
+		wave[k] = ql[k] - qr[k-1];
+		s[k] = u;
+		amdq[k] = 0;
+		apdq[k] = u*wave[k];
+	}
+}
+
+void advection_rpt2(const int* ixy, const int* maxm, const int* meqn,
+                    const int* mwaves, const int* mbc, const int* mx,
+                    double ql[], double qr[],
+                    double aux1[], double aux2[], double aux3[],
+                    const int* imp, double asdq[],
+                    double bmasdq[], double bpasdq[])
+{
+	double v = (*ixy == 1) ? 0.5 : 1.0;
+	for(int k = 1; k < *mx + 2*(*mbc); k++)
+	{
+		bmasdq[k] = 0;
+		bpasdq[k] = v*asdq[k];
+	}
+}
+
+struct AdvectionQuadDomain {
+	fclaw2d_global_t* glob;
+	fclaw_options_t fopts;
+	fclaw2d_domain_t *domain;
+	fclaw2d_clawpatch_options_t opts;
+	fc2d_clawpack46_options_t clawopt;
+	int order[2] = {2, 1};
+	int mthlim[1] = {1};
+
+	AdvectionQuadDomain(){
+		glob = fclaw2d_global_new();
+
+		memset(&fopts, 0, sizeof(fopts));
+		fopts.mi=1;
+		fopts.mj=1;
+		fopts.minlevel=1;
+		fopts.maxlevel=1;
+		fopts.manifold=false;
+		fopts.bx = 1;
+		fopts.by = 1;
+
+		domain = create_test_domain(sc_MPI_COMM_WORLD,&fopts);
+		fclaw2d_global_store_domain(glob, domain);
+		fclaw2d_options_store(glob, &fopts);
+
+		memset(&opts, 0, sizeof(opts));
+		opts.mx   = 8;
+		opts.my   = 8;
+		opts.mbc  = 2;
+		opts.meqn = 1;
+		opts.maux = 0;
+		fclaw2d_clawpatch_options_store(glob, &opts);
+
+		memset(&clawopt, 0, sizeof(clawopt));
+		clawopt.mwaves = 1;
+		clawopt.order = order;
+		clawopt.mthlim = mthlim;
+		clawopt.method[1] = 2;
+		clawopt.method[2] = 1;
+		clawopt.buffer_len = 1;
+		fc2d_clawpack46_options_store(glob, &clawopt);
+
+		fclaw2d_vtables_initialize(glob);
+		fc2d_clawpack46_solver_initialize(glob);
+		fc2d_clawpack46_vt(glob)->fort_rpn2 = advection_rpn2;
+		fc2d_clawpack46_vt(glob)->fort_rpt2 = advection_rpt2;
+
+		fclaw2d_domain_data_new(glob->domain);
+		fclaw2d_build_mode_t build_mode = FCLAW2D_BUILD_FOR_UPDATE;
+		for(int i = 0; i < 4; i++)
+		{
+			fclaw2d_patch_build(glob, &domain->blocks[0].patches[i], 0, i, &build_mode);
+		}
+	}
+	/* A Gaussian, including ghost cells */
+	void initialize(){
+		for(int i = 0; i < 4; i++)
+		{
+			fclaw2d_patch_t* patch = &domain->blocks[0].patches[i];
+			int mx,my,mbc,meqn;
+			double xlower,ylower,dx,dy,*q;
+			fclaw2d_clawpatch_grid_data(glob,patch,&mx,&my,&mbc,
+			                            &xlower,&ylower,&dx,&dy);
+			fclaw2d_clawpatch_soln_data(glob,patch,&q,&meqn);
+			for(int j = 1-mbc; j <= my+mbc; j++)
+			for(int k = 1-mbc; k <= mx+mbc; k++)
+			{
+				double x = xlower + (k-0.5)*dx - 0.4;
+				double y = ylower + (j-0.5)*dy - 0.6;
+				q[(k-1+mbc) + (j-1+mbc)*(mx+2*mbc)] = exp(-20*(x*x + y*y));
+			}
+		}
+	}
+	std::vector<double> solution(){
+		std::vector<double> all;
+		for(int i = 0; i < 4; i++)
+		{
+			int meqn;
+			double *q;
+			fclaw2d_clawpatch_soln_data(glob,&domain->blocks[0].patches[i],&q,&meqn);
+			all.insert(all.end(),q,q + (opts.mx+2*opts.mbc)*(opts.my+2*opts.mbc)*meqn);
+		}
+		return all;
+	}
+	~AdvectionQuadDomain(){
+		for(int i = 0; i < 4; i++)
+		{
+			fclaw2d_patch_data_delete(glob, &domain->blocks[0].patches[i]);
+		}
+		fclaw2d_global_destroy(glob);
+	}
+};
+}
 
 TEST_CASE("fc2d_clawpack46_solver_initialize stores two seperate vtables in two seperate globs")
 {
@@ -71,6 +205,49 @@ TEST_CASE("fc2d_clawpack46_solver_initialize sets is_set flag")
 	fclaw2d_global_destroy(glob);
 }
 
+TEST_CASE("fc2d_clawpack46_solver_initialize sets single_step_buffered from buffer_len")
+{
+	for(int buffer_len : {1, 16})
+	{
+		fclaw2d_global_t* glob = fclaw2d_global_new();
+
+		fc2d_clawpack46_options_t* clawopt = FCLAW_ALLOC_ZERO(fc2d_clawpack46_options_t,1);
+		clawopt->buffer_len = buffer_len;
+
+		fclaw2d_clawpatch_options_store(glob, FCLAW_ALLOC_ZERO(fclaw2d_clawpatch_options_t,1));
+		fc2d_clawpack46_options_store(glob, clawopt);
+
+		fclaw2d_vtables_initialize(glob);
+		fc2d_clawpack46_solver_initialize(glob);
+
+		CHECK_EQ(fclaw2d_patch_vt(glob)->single_step_buffered, buffer_len > 1);
+
+		fclaw2d_global_destroy(glob);
+	}
+}
+
+TEST_CASE("fc2d_clawpack46 batched and per patch steps give the same solution")
+{
+	AdvectionQuadDomain test;
+	fclaw2d_patch_vtable_t* patch_vt = fclaw2d_patch_vt(test.glob);
+
+	test.initialize();
+	double maxcfl = fclaw2d_update_single_step(test.glob, 1, 0.0, 0.02);
+	std::vector<double> q = test.solution();
+
+	/* Three patches in one batch, and the last one flushed on its own */
+	test.clawopt.buffer_len = 3;
+	patch_vt->single_step_buffered = 1;
+
+	test.initialize();
+	double maxcfl_batch = fclaw2d_update_single_step(test.glob, 1, 0.0, 0.02);
+	std::vector<double> q_batch = test.solution();
+
+	CHECK(maxcfl > 0);
+	CHECK_EQ(maxcfl_batch, maxcfl);
+	CHECK(q_batch == q);
+}
+
 #ifdef FCLAW_ENABLE_DEBUG
 
 TEST_CASE("fc2d_clawpack46_vt fails if not intialized")
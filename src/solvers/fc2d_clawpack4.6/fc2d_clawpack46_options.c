@@ -60,6 +60,11 @@ clawpack46_register (fc2d_clawpack46_options_t* clawopt, sc_options_t * opt)
                                  &clawopt->mthbc, 4,
                                  "[clawpack46] Physical boundary condition type [1 1 1 1]");
 
+    sc_options_add_int (opt, 0, "buffer-len", &clawopt->buffer_len, 1,
+                        "[clawpack46] Number of patches updated together in a batch; " \
+                        "batches are threaded with OpenMP, so Riemann solvers " \
+                        "must be thread safe [1]");
+
     sc_options_add_bool (opt, 0, "ascii-out", &clawopt->ascii_out, 0,
                            "Output ASCII formatted data [F]");
 
@@ -95,6 +100,12 @@ clawpack46_check(fc2d_clawpack46_options_t *clawopt)
     clawopt->method[4] = clawopt->src_term;
     clawopt->method[5] = clawopt->mcapa;
 
+    if (clawopt->buffer_len < 1)
+    {
+        fclaw_global_essentialf("clawpack46 error : buffer-len must be at least 1\n");
+        return FCLAW_EXIT_ERROR;
+    }
+
     /* Should also check mthbc, mthlim, etc. */
     return FCLAW_NOEXIT;
 }
@@ -200,10 +211,12 @@ fc2d_clawpack46_options_t*  fc2d_clawpack46_options_register (fclaw_app_t * app,
     return clawopt;
 }
 
+static int options_slot = -1;
+
 fc2d_clawpack46_options_t* fc2d_clawpack46_get_options(fclaw2d_global_t *glob)
 {
 	fc2d_clawpack46_options_t* clawopt = (fc2d_clawpack46_options_t*) 
-	   							fclaw_pointer_map_get(glob->options, "fc2d_clawpack46");
+	   							fclaw_pointer_map_get_slot(glob->options, options_slot);
 	FCLAW_ASSERT(clawopt != NULL);
 	return clawopt;
 }
@@ -212,4 +225,5 @@ void fc2d_clawpack46_options_store (fclaw2d_global_t* glob, fc2d_clawpack46_opti
 {
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->options,"fc2d_clawpack46") == NULL);
 	fclaw_pointer_map_insert(glob->options, "fc2d_clawpack46", clawopt, NULL);
+	options_slot = fclaw_pointer_map_slot("fc2d_clawpack46");
 }
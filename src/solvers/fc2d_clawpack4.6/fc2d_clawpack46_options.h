@@ -57,6 +57,8 @@ struct fc2d_clawpack46_options
     int src_term;
     int use_fwaves;
 
+    int buffer_len;     /* Patches updated together in one batch */
+
     /* Output */
     int ascii_out;
     int vtk_out;
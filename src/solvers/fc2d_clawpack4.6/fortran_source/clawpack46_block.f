@@ -5,6 +5,7 @@
 
       integer blockno_com
       common /comblock/ blockno_com
+c$omp threadprivate(/comblock/)
 
       blockno_com = blockno
       end
@@ -14,6 +15,7 @@
 
       integer blockno_com
       common /comblock/ blockno_com
+c$omp threadprivate(/comblock/)
 
       fc2d_clawpack46_get_block = blockno_com
       return
@@ -24,6 +26,7 @@
 
       integer blockno_com
       common /comblock/ blockno_com
+c$omp threadprivate(/comblock/)
 
       blockno_com = -1
       end
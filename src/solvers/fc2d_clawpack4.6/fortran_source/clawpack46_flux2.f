@@ -81,6 +81,7 @@ c
       double precision dtcom, dxcom, dycom, tcom
       integer icom, jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
 
       integer ilr, mw, jside, m, i
@@ -98,6 +98,7 @@ c
       double precision dtcom,dxcom,dycom,tcom
       integer icom,jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 c
       double precision gupdate, dtdxave
       integer mw,i,jside,m
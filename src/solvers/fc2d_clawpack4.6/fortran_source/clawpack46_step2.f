@@ -40,6 +40,7 @@ c     ==========================================================
       double precision :: dtcom, dxcom, dycom, tcom
       integer :: icom, jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       integer :: i0wave, i0s, i0amdq, i0apdq, i0cqxx, i0bmadq
       integer :: i0bpadq, iused
@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw2d_clawpatch_output_ascii.h>
 #include <fclaw2d_clawpatch_output_vtk.h>
+#include <fclaw2d_clawpatch_output.h>
 #include <fclaw2d_clawpatch_fort.h>
 
 #include <fclaw2d_clawpatch_conservation.h>
@@ -46,6 +47,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_options.h>
 #include <fclaw2d_defs.h>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 
 /* -------------------------- Clawpack solver functions ------------------------------ */
 
@@ -239,6 +244,63 @@ void clawpack5_bc2(fclaw2d_global_t *glob,
 }
 
 
+/* Stand-in registers for faces without registers, one array per thread, 
+   allocated once when the solver is initialized */
+#define CLAWPACK5_REGISTERS_WORK "fc2d_clawpack5_registers_work"
+
+typedef struct clawpack5_registers_work
+{
+    int nthreads;
+    double **work;
+} clawpack5_registers_work_t;
+
+static
+void clawpack5_registers_work_destroy(void *work)
+{
+    clawpack5_registers_work_t *w = (clawpack5_registers_work_t*) work;
+    for(int i = 0; i < w->nthreads; i++)
+    {
+        FCLAW_FREE(w->work[i]);
+    }
+    FCLAW_FREE(w->work);
+    FCLAW_FREE(w);
+}
+
+static
+void clawpack5_registers_work_new(fclaw2d_global_t *glob)
+{
+    clawpack5_registers_work_t *w = FCLAW_ALLOC(clawpack5_registers_work_t,1);
+#if defined(_OPENMP)
+    w->nthreads = omp_get_max_threads();
+#else
+    w->nthreads = 1;
+#endif
+    int rsize = fclaw2d_clawpatch_time_sync_work_size(glob);
+    w->work = FCLAW_ALLOC(double*,w->nthreads);
+    for(int i = 0; i < w->nthreads; i++)
+    {
+        w->work[i] = FCLAW_ALLOC(double,rsize);
+    }
+    fclaw_pointer_map_insert(glob->attributes, CLAWPACK5_REGISTERS_WORK, w,
+                             clawpack5_registers_work_destroy);
+}
+
+/* The work array of the calling thread */
+static
+double* clawpack5_registers_work(fclaw2d_global_t *glob)
+{
+    clawpack5_registers_work_t *w = (clawpack5_registers_work_t*)
+        fclaw_pointer_map_get(glob->attributes, CLAWPACK5_REGISTERS_WORK);
+    FCLAW_ASSERT(w != NULL);
+#if defined(_OPENMP)
+    int thread = omp_get_thread_num();
+#else
+    int thread = 0;
+#endif
+    FCLAW_ASSERT(thread < w->nthreads);
+    return w->work[thread];
+}
+
 /* This is called from the single_step callback. and is of type 'flaw_single_step_t' */
 static
 double clawpack5_step2(fclaw2d_global_t *glob,
@@ -278,12 +340,23 @@ double clawpack5_step2(fclaw2d_global_t *glob,
 
     double cflgrid = 0.0;
 
+    /* Registers are only kept at coarse/fine and block interfaces;  the 
+       other faces are written to a work array. */
+    const fclaw_options_t* fclaw_opt = fclaw2d_get_options(glob);
+    fclaw2d_clawpatch_registers_t registers;
     fclaw2d_clawpatch_registers_t* cr = 
           fclaw2d_clawpatch_get_registers(glob,this_patch);
+    int sync_patch = fclaw_opt->time_sync && cr->face_mask != 0;
+    if (sync_patch)
+    {
+        fclaw2d_clawpatch_time_sync_fill_faces(glob,cr,
+                                               clawpack5_registers_work(glob),
+                                               &registers);
+        cr = &registers;
+    }
 
     /* Evaluate fluxes needed in correction terms */
-    const fclaw_options_t* fclaw_opt = fclaw2d_get_options(glob);
-    if (fclaw_opt->time_sync && fclaw_opt->flux_correction)
+    if (sync_patch && fclaw_opt->flux_correction)
     {
         FCLAW_ASSERT(claw5_vt->fort_rpn2_cons != NULL);
         double *qvec          = FCLAW_ALLOC(double, meqn);
@@ -338,7 +411,7 @@ double clawpack5_step2(fclaw2d_global_t *glob,
 
     FCLAW_ASSERT(ierror == 0);
 
-    if (fclaw_opt->time_sync && fclaw_opt->fluctuation_correction)
+    if (sync_patch && fclaw_opt->fluctuation_correction)
     {
         CLAWPACK5_TIME_SYNC_ACCUMULATE_WAVES(&mx,&my,&mbc,&meqn, &dt, &dx, 
                                               &dy, &this_patch_idx,
@@ -412,16 +485,20 @@ void clawpack5_output(fclaw2d_global_t *glob, int iframe)
     const fc2d_clawpack5_options_t* clawpack_options;
     clawpack_options = fc2d_clawpack5_get_options(glob);
 
+    /* Formats are written in one pass over the patches */
+    int formats = 0;
     if (clawpack_options->ascii_out != 0)
     {
-        fclaw2d_clawpatch_output_ascii(glob,iframe);
+        formats |= FCLAW2D_CLAWPATCH_OUTPUT_ASCII;
     }
 
     if (clawpack_options->vtk_out != 0)
     {
-        fclaw2d_clawpatch_output_vtk(glob,iframe);
+        formats |= FCLAW2D_CLAWPATCH_OUTPUT_VTK;
     }
 
+    fclaw2d_clawpatch_output_frame(glob,iframe,formats);
+
 }
 
 /* ---------------------------------- Virtual table  ------------------------------------- */
@@ -439,6 +516,8 @@ void fc2d_clawpack5_vt_destroy(void* vt)
 }
 
 /* This is called from the user application. */
+static int vt_slot = -1;
+
 void fc2d_clawpack5_solver_initialize(fclaw2d_global_t* glob)
 {
 	fclaw2d_clawpatch_options_t* clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
@@ -475,6 +554,12 @@ void fc2d_clawpack5_solver_initialize(fclaw2d_global_t* glob)
     clawpatch_vt->fort_time_sync_f2c         = CLAWPACK5_FORT_TIME_SYNC_F2C;
     clawpatch_vt->fort_time_sync_samesize    = CLAWPACK5_FORT_TIME_SYNC_SAMESIZE;
 
+    const fclaw_options_t* fclaw_opt = fclaw2d_get_options(glob);
+    if (fclaw_opt->time_sync)
+    {
+        clawpack5_registers_work_new(glob);
+    }
+
 
     claw5_vt->b4step2   = clawpack5_b4step2;
     claw5_vt->src2      = clawpack5_src2;
@@ -495,6 +580,7 @@ void fc2d_clawpack5_solver_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fc2d_clawpack5") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fc2d_clawpack5", claw5_vt, fc2d_clawpack5_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fc2d_clawpack5");
 }
 
 
@@ -506,7 +592,7 @@ void fc2d_clawpack5_solver_initialize(fclaw2d_global_t* glob)
 fc2d_clawpack5_vtable_t* fc2d_clawpack5_vt(fclaw2d_global_t* glob)
 {
     fc2d_clawpack5_vtable_t* claw5_vt = (fc2d_clawpack5_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fc2d_clawpack5");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(claw5_vt != NULL);
 	FCLAW_ASSERT(claw5_vt->is_set != 0);
 	return claw5_vt;
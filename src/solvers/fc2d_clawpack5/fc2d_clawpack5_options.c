@@ -206,10 +206,12 @@ fc2d_clawpack5_options_t*  fc2d_clawpack5_options_register (fclaw_app_t * app,
     return clawopt;
 }
 
+static int options_slot = -1;
+
 fc2d_clawpack5_options_t* fc2d_clawpack5_get_options(fclaw2d_global_t *glob)
 {
 	fc2d_clawpack5_options_t* clawopt = (fc2d_clawpack5_options_t*) 
-	   							fclaw_pointer_map_get(glob->options, "fc2d_clawpack5");
+	   							fclaw_pointer_map_get_slot(glob->options, options_slot);
 	FCLAW_ASSERT(clawopt != NULL);
 	return clawopt;
 }
@@ -218,4 +220,5 @@ void fc2d_clawpack5_options_store (fclaw2d_global_t* glob, fc2d_clawpack5_option
 {
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->options,"fc2d_clawpack5") == NULL);
 	fclaw_pointer_map_insert(glob->options, "fc2d_clawpack5", clawopt, NULL);
+	options_slot = fclaw_pointer_map_slot("fc2d_clawpack5");
 }
@@ -83,6 +83,7 @@ c
       double precision dtcom, dxcom , dycom, tcom
       integer icom, jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       integer mw, i, m
       double precision cfl1d, dtdxave, abs_sign, gupdate
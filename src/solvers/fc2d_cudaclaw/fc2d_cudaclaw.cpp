@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_clawpatch_diagnostics.h>
 #include <fclaw2d_clawpatch_output_ascii.h> 
 #include <fclaw2d_clawpatch_output_vtk.h>
+#include <fclaw2d_clawpatch_output.h>
 #include <fclaw2d_clawpatch_fort.h>
 
 #include "fc2d_cudaclaw_cuda.h"  
@@ -376,16 +377,20 @@ void cudaclaw_output(fclaw2d_global_t *glob, int iframe)
     const fc2d_cudaclaw_options_t* clawpack_options;
     clawpack_options = fc2d_cudaclaw_get_options(glob);
 
+    /* Formats are written in one pass over the patches */
+    int formats = 0;
     if (clawpack_options->ascii_out != 0)
     {
-        fclaw2d_clawpatch_output_ascii(glob,iframe);
+        formats |= FCLAW2D_CLAWPATCH_OUTPUT_ASCII;
     }
 
     if (clawpack_options->vtk_out != 0)
     {
-        fclaw2d_clawpatch_output_vtk(glob,iframe);
+        formats |= FCLAW2D_CLAWPATCH_OUTPUT_VTK;
     }
 
+    fclaw2d_clawpatch_output_frame(glob,iframe,formats);
+
 }
 
 /* ---------------------------------- Virtual table  ---------------------------------- */
@@ -402,6 +407,8 @@ void cudaclaw_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 void fc2d_cudaclaw_solver_initialize(fclaw2d_global_t* glob)
 {
 	fclaw2d_clawpatch_options_t* clawpatch_opt = fclaw2d_clawpatch_get_options(glob);
@@ -437,6 +444,7 @@ void fc2d_cudaclaw_solver_initialize(fclaw2d_global_t* glob)
     patch_vt->setup                          = cudaclaw_setaux; 
     patch_vt->physical_bc                    = cudaclaw_bc2;
     patch_vt->single_step_update             = cudaclaw_update;
+    patch_vt->single_step_buffered           = 1;
 
     /* Set user data */
     patch_vt->create_user_data  = cudaclaw_allocate_fluxes;
@@ -462,6 +470,7 @@ void fc2d_cudaclaw_solver_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fc2d_cudaclaw") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fc2d_cudaclaw", cudaclaw_vt, cudaclaw_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fc2d_cudaclaw");
 }
 
 
@@ -473,7 +482,7 @@ void fc2d_cudaclaw_solver_initialize(fclaw2d_global_t* glob)
 fc2d_cudaclaw_vtable_t* fc2d_cudaclaw_vt(fclaw2d_global_t *glob)
 {
 	fc2d_cudaclaw_vtable_t* cudaclaw_vt = (fc2d_cudaclaw_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fc2d_cudaclaw");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(cudaclaw_vt != NULL);
 	FCLAW_ASSERT(cudaclaw_vt->is_set != 0);
 	return cudaclaw_vt;
@@ -86,6 +86,7 @@ c
       double precision dtcom, dxcom, dycom, tcom
       integer icom, jcom
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 c
       limit = .false.
       do 5 mw=1,mwaves
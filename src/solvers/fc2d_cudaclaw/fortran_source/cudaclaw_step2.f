@@ -48,6 +48,7 @@ c     ==========================================================
       integer m,i,j, ma, ixy
 
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       ierror = 0
 c
@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <fclaw2d_clawpatch_output_ascii.h>
 #include <fclaw2d_clawpatch_output_vtk.h>
+#include <fclaw2d_clawpatch_output.h>
 
 
 #include <fclaw2d_patch.h>
@@ -286,16 +287,20 @@ void cudaclaw5_output(fclaw2d_global_t *glob, int iframe)
     const fc2d_cudaclaw5_options_t* cudaclaw_options;
     cudaclaw_options = fc2d_cudaclaw5_get_options(glob);
 
+    /* Formats are written in one pass over the patches */
+    int formats = 0;
     if (cudaclaw_options->ascii_out != 0)
     {
-        fclaw2d_clawpatch_output_ascii(glob,iframe);
+        formats |= FCLAW2D_CLAWPATCH_OUTPUT_ASCII;
     }
 
     if (cudaclaw_options->vtk_out != 0)
     {
-        fclaw2d_clawpatch_output_vtk(glob,iframe);
+        formats |= FCLAW2D_CLAWPATCH_OUTPUT_VTK;
     }
 
+    fclaw2d_clawpatch_output_frame(glob,iframe,formats);
+
 }
 
 /* ---------------------------------- Virtual table  ------------------------------------- */
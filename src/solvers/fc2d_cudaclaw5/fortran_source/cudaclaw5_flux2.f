@@ -77,6 +77,7 @@ c
 c
       logical limit
       common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 c
       limit = .false.
       do 5 mw=1,mwaves
@@ -64,6 +64,7 @@ SUBROUTINE cudaclaw5_step2(maxm,meqn,maux,mbc,mx,my,qold,aux,dx,dy,dt, &
     integer :: icom,jcom
     real(kind=8) :: dtcom,dxcom,dycom,tcom
     common /comxyt/ dtcom,dxcom,dycom,tcom,icom,jcom
+    !$omp threadprivate(/comxyt/)
 
     ! Store mesh parameters in common block
     dxcom = dx
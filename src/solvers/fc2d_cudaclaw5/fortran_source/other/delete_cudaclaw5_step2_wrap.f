@@ -41,6 +41,7 @@ c     for a Riemann solver.
       double precision dtcom, dxcom,dycom,tcom
       integer icom, jcom
       common/comxyt/dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
       ierror = 0
 
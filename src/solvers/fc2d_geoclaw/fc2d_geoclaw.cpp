@@ -818,10 +818,12 @@ void fc2d_geoclaw_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 fc2d_geoclaw_vtable_t* fc2d_geoclaw_vt(fclaw2d_global_t* glob)
 {
 	fc2d_geoclaw_vtable_t* geoclaw_vt = (fc2d_geoclaw_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fc2d_geoclaw");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(geoclaw_vt != NULL);
 	FCLAW_ASSERT(geoclaw_vt->is_set != 0);
 	return geoclaw_vt;
@@ -906,10 +908,13 @@ void fc2d_geoclaw_solver_initialize(fclaw2d_global_t* glob)
 
     gauges_vt->update_gauge       = geoclaw_gauge_update_default;
     gauges_vt->print_gauge_buffer = geoclaw_print_gauges_default;
+    gauges_vt->pack_gauge_entry   = geoclaw_pack_gauge_default;
+    gauges_vt->record_length      = GEOCLAW_GAUGE_RECORD_LENGTH;
 
     geoclaw_vt->is_set = 1;
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fc2d_geoclaw") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fc2d_geoclaw", geoclaw_vt, fc2d_geoclaw_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fc2d_geoclaw");
 }
 
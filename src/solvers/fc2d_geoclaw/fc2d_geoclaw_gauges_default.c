@@ -304,6 +304,24 @@ void geoclaw_print_gauges_default(fclaw2d_global_t *glob,
     fclose(fp);
 }
 
+void geoclaw_pack_gauge_default(fclaw2d_global_t *glob, 
+                                fclaw_gauge_t *gauge,
+                                void *entry, double *record)
+{
+    /* Same columns as in the gauge files : level time h hu hv eta */
+    geoclaw_user_t *guser = (geoclaw_user_t*) entry;
+
+    double eta = guser->qvar[0] + guser->avar[0];
+    record[0] = guser->level;
+    record[1] = guser->tcurr;
+    record[2] = guser->qvar[0];
+    record[3] = guser->qvar[1];
+    record[4] = guser->qvar[2];
+    record[5] = fabs(eta) < 1e-99 ? 0 : eta;
+
+    FCLAW_FREE(guser);
+}
+
 #ifdef __cplusplus
 #if 0
 {
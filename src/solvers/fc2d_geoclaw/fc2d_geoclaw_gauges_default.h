@@ -63,6 +63,13 @@ void geoclaw_gauge_update_default(struct fclaw2d_global* glob,
 void geoclaw_print_gauges_default(struct fclaw2d_global *glob, 
                                   struct fclaw_gauge *gauge);
 
+/* Number of values in a record of the binary gauge file */
+#define GEOCLAW_GAUGE_RECORD_LENGTH 6
+
+void geoclaw_pack_gauge_default(struct fclaw2d_global *glob, 
+                                struct fclaw_gauge *gauge,
+                                void *entry, double *record);
+
 #ifdef __cplusplus
 #if 0
 {
@@ -230,10 +230,12 @@ fc2d_geoclaw_options_register (fclaw_app_t * app,
     return geo_opt;
 }
 
+static int options_slot = -1;
+
 fc2d_geoclaw_options_t* fc2d_geoclaw_get_options(fclaw2d_global_t *glob)
 {
     fc2d_geoclaw_options_t* geo_opt = (fc2d_geoclaw_options_t*) 
-	   							fclaw_pointer_map_get(glob->options, "fc2d_geoclaw");
+	   							fclaw_pointer_map_get_slot(glob->options, options_slot);
 	FCLAW_ASSERT(geo_opt != NULL);
 	return geo_opt;
 }
@@ -243,6 +245,7 @@ void fc2d_geoclaw_options_store (fclaw2d_global_t* glob,
 {
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->options,"fc2d_geoclaw") == NULL);
 	fclaw_pointer_map_insert(glob->options, "fc2d_geoclaw", geo_opt, NULL);
+	options_slot = fclaw_pointer_map_slot("fc2d_geoclaw");
 }
 
 
@@ -3,6 +3,7 @@
 
       integer blockno, blockno_com
       common /comblock/ blockno_com
+c$omp threadprivate(/comblock/)
 
       blockno_com = blockno
       end
@@ -12,6 +13,7 @@
 
       integer blockno_com
       common /comblock/ blockno_com
+c$omp threadprivate(/comblock/)
 
       fc2d_geoclaw_get_block = blockno_com
       return
@@ -22,6 +24,7 @@
 
       integer blockno, blockno_com
       common /comblock/ blockno_com
+c$omp threadprivate(/comblock/)
 
       blockno_com = -1
       end
@@ -41,6 +41,7 @@ c     for a Riemann solver.
       double precision dtcom, dxcom,dycom,tcom
       integer icom, jcom
       common/comxyt/dtcom,dxcom,dycom,tcom,icom,jcom
+c$omp threadprivate(/comxyt/)
 
 c     This should be set to actual time, in case the user wants it
 c     it for some reason in the Riemann solver.
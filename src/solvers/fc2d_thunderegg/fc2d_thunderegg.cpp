@@ -27,6 +27,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fc2d_thunderegg_options.h"
 #include "fc2d_thunderegg_physical_bc.h"
 #include "fc2d_thunderegg_fort.h"
+#include "fc2d_thunderegg_vector.hpp"
 
 #include <fclaw_pointer_map.h>
 
@@ -35,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fclaw2d_clawpatch.h>
 #include <fclaw2d_clawpatch_output_ascii.h> 
 #include <fclaw2d_clawpatch_output_vtk.h>
+#include <fclaw2d_clawpatch_output.h>
 
 #include <fclaw2d_patch.h>
 #include <fclaw2d_global.h>
@@ -56,6 +58,12 @@ static
 void thunderegg_setup_solver(fclaw2d_global_t *glob)
 {
 	//fc2d_thunderegg_vtable_t*  mg_vt = fc2d_thunderegg_vt(glob);
+	fc2d_thunderegg_options_t *mg_opt = fc2d_thunderegg_get_options(glob);
+
+	/* The last solution was swapped into the rhs.  Move it back to the 
+	   work data to use as the starting guess;  the rhs is set next. */
+	if (mg_opt->warm_start)
+		fc2d_thunderegg_swap_rhs(glob);
 }
 
 
@@ -77,7 +85,6 @@ void thunderegg_rhs(fclaw2d_global_t *glob,
     int mfields;
     double *rhs;
 	fclaw2d_clawpatch_rhs_data(glob,patch,&rhs,&mfields);
-	FCLAW_ASSERT(mfields == 1);
 
 	/* Compute right hand side */
 	mg_vt->fort_rhs(&blockno,&mbc,&mx,&my,&mfields,
@@ -134,15 +141,19 @@ void thunderegg_output(fclaw2d_global_t *glob, int iframe)
 	const fc2d_thunderegg_options_t* mg_options;
 	mg_options = fc2d_thunderegg_get_options(glob);
 
+	/* Formats are written in one pass over the patches */
+	int formats = 0;
 	if (mg_options->ascii_out != 0)
 	{
-		fclaw2d_clawpatch_output_ascii(glob,iframe);
+		formats |= FCLAW2D_CLAWPATCH_OUTPUT_ASCII;
 	}
 
 	if (mg_options->vtk_out != 0)
 	{
-		fclaw2d_clawpatch_output_vtk(glob,iframe);
+		formats |= FCLAW2D_CLAWPATCH_OUTPUT_VTK;
 	}
+
+	fclaw2d_clawpatch_output_frame(glob,iframe,formats);
 }
 
 
@@ -161,6 +172,8 @@ void thunderegg_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 void fc2d_thunderegg_solver_initialize(fclaw2d_global_t* glob)
 {
 	int claw_version = 4; /* solution data is organized as (i,j,m) */
@@ -196,6 +209,7 @@ void fc2d_thunderegg_solver_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fc2d_thunderegg") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fc2d_thunderegg", mg_vt, thunderegg_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fc2d_thunderegg");
 }
 
 
@@ -204,7 +218,7 @@ void fc2d_thunderegg_solver_initialize(fclaw2d_global_t* glob)
 fc2d_thunderegg_vtable_t* fc2d_thunderegg_vt(fclaw2d_global_t* glob)
 {
 	fc2d_thunderegg_vtable_t* thunderegg_vt = (fc2d_thunderegg_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fc2d_thunderegg");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(thunderegg_vt != NULL);
 	FCLAW_ASSERT(thunderegg_vt->is_set != 0);
 	return thunderegg_vt;
@@ -0,0 +1,195 @@
+/*
+  Copyright (c) 2019-2023 Carsten Burstedde, Donna Calhoun, Scott Aiton, Grady Wright
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "fc2d_thunderegg_float_patch_solver.hpp"
+#include "fc2d_thunderegg_stencil.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ThunderEgg;
+
+namespace{
+
+/* Five point stencil in single precision.  Patch arrays are padded with 
+   one layer of ghost cells. */
+struct float_stencil
+{
+    int mx;
+    int my;
+    int stride;     /* mx + 2 */
+    int offset;     /* Index of the first interior cell */
+    float cx;
+    float cy;
+    float c0;
+    float sign[4];  /* Ghost cell sign on the west, east, south and north sides */
+};
+
+/* Set the ghost cells of x from the boundary signs */
+void float_fill_ghosts(const float_stencil& st, float *x)
+{
+    int mx = st.mx;
+    int my = st.my;
+    int s = st.stride;
+    float *xi = x + st.offset;
+    for(int j = 0; j < my; j++){
+        xi[j*s - 1]  = st.sign[0]*xi[j*s];
+        xi[j*s + mx] = st.sign[1]*xi[j*s + mx - 1];
+    }
+    for(int i = 0; i < mx; i++){
+        xi[i - s]    = st.sign[2]*xi[i];
+        xi[my*s + i] = st.sign[3]*xi[(my - 1)*s + i];
+    }
+}
+
+double float_dot(int n, const float *a, const float *b)
+{
+    double sum = 0;
+    for(int k = 0; k < n; k++){
+        sum += a[k]*b[k];
+    }
+    return sum;
+}
+
+/* Conjugate gradients for the (negative definite) patch problem, 
+   starting from x.  The ghost cells of b, r and Ap must be zero. */
+void float_cg(const float_stencil& st, int max_iterations, float tolerance,
+              const float *b, float *x, float *r, float *p, float *Ap)
+{
+    int n = st.stride*(st.my + 2);
+    int o = st.offset;
+    int s = st.stride;
+    double bnorm = std::sqrt(float_dot(n, b, b));
+    if (bnorm == 0){
+        std::fill(x, x + n, 0.0f);
+        return;
+    }
+
+    float_fill_ghosts(st, x);
+    double rr = fc2d_thunderegg_stencil_residual(st.mx, st.my, x + o, s, b + o, s, 
+                                                 r + o, s, st.cx, st.cy, st.c0);
+    std::copy(r, r + n, p);
+
+    for(int it = 0; it < max_iterations; it++){
+        if (std::sqrt(rr) <= tolerance*bnorm)
+            break;
+
+        float_fill_ghosts(st, p);
+        double pAp = fc2d_thunderegg_stencil_apply_dot(st.mx, st.my, p + o, s, Ap + o, s, 
+                                                       p + o, s, st.cx, st.cy, st.c0);
+        float alpha = rr/pAp;
+        for(int k = 0; k < n; k++){
+            x[k] += alpha*p[k];
+            r[k] -= alpha*Ap[k];
+        }
+        double rr_new = float_dot(n, r, r);
+        float beta = rr_new/rr;
+        for(int k = 0; k < n; k++){
+            p[k] = r[k] + beta*p[k];
+        }
+        rr = rr_new;
+    }
+}
+
+}
+
+FloatPatchSolver::FloatPatchSolver(const PatchOperator<2>& op,
+                                   double lambda_in, const int bc_sign_in[],
+                                   int max_iterations_in, double tolerance_in)
+                    : PatchSolver<2>(op.getDomain(), op.getGhostFiller())
+{
+    lambda = lambda_in;
+    for(int m = 0; m < 4; m++){
+        bc_sign[m] = bc_sign_in[m];
+    }
+    max_iterations = max_iterations_in;
+
+    /* Residuals much below the float resolution can't be reached */
+    tolerance = std::max(tolerance_in, 1e-6);
+}
+
+void FloatPatchSolver::solveSinglePatch(const PatchInfo<2>& pinfo,
+                                        const PatchView<const double, 2>& f,
+                                        const PatchView<double, 2>& u) const
+{
+    int mfields = u.getEnd()[2] + 1;
+    int mx = pinfo.ns[0];
+    int my = pinfo.ns[1];
+    double dx2 = pinfo.spacings[0]*pinfo.spacings[0];
+    double dy2 = pinfo.spacings[1]*pinfo.spacings[1];
+
+    /* Interfaces with neighboring patches are homogeneous Dirichlet 
+       conditions for the patch problem */
+    bool has_nbr[4] = {pinfo.hasNbr(Side<2>::west()), pinfo.hasNbr(Side<2>::east()),
+                       pinfo.hasNbr(Side<2>::south()), pinfo.hasNbr(Side<2>::north())};
+    float_stencil st;
+    st.mx = mx;
+    st.my = my;
+    st.stride = mx + 2;
+    st.offset = st.stride + 1;
+    st.cx = 1/dx2;
+    st.cy = 1/dy2;
+    st.c0 = lambda - 2/dx2 - 2/dy2;
+    for(int m = 0; m < 4; m++){
+        st.sign[m] = has_nbr[m] ? -1 : bc_sign[m];
+    }
+
+    int n = st.stride*(my + 2);
+    b.assign(n, 0);
+    x.resize(n);
+    r.assign(n, 0);
+    p.resize(n);
+    Ap.assign(n, 0);
+
+    float *bi = b.data() + st.offset;
+    float *xi = x.data() + st.offset;
+    for(int m = 0; m < mfields; m++){
+        for(int j = 0; j < my; j++){
+            for(int i = 0; i < mx; i++){
+                /* Move interface values to the right hand side in double */
+                double fij = f(i,j,m);
+                if (i == 0 && has_nbr[0])
+                    fij -= (u(-1,j,m) + u(0,j,m))/dx2;
+                if (i == mx-1 && has_nbr[1])
+                    fij -= (u(mx-1,j,m) + u(mx,j,m))/dx2;
+                if (j == 0 && has_nbr[2])
+                    fij -= (u(i,-1,m) + u(i,0,m))/dy2;
+                if (j == my-1 && has_nbr[3])
+                    fij -= (u(i,my-1,m) + u(i,my,m))/dy2;
+                bi[j*st.stride + i] = fij;
+                xi[j*st.stride + i] = u(i,j,m);
+            }
+        }
+
+        float_cg(st, max_iterations, tolerance, b.data(), x.data(), 
+                 r.data(), p.data(), Ap.data());
+
+        for(int j = 0; j < my; j++){
+            for(int i = 0; i < mx; i++){
+                u(i,j,m) = xi[j*st.stride + i];
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+  Copyright (c) 2019-2023 Carsten Burstedde, Donna Calhoun, Scott Aiton, Grady Wright
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FC2D_THUNDEREGG_FLOAT_PATCH_SOLVER_HPP
+#define FC2D_THUNDEREGG_FLOAT_PATCH_SOLVER_HPP
+
+/**
+ * @file 
+ * Single precision patch solver for the constant coefficient five point 
+ * operators
+ */
+
+#include <ThunderEgg.h>
+
+#include <vector>
+
+/**
+ * @brief Patch solver for lambda*u + Laplacian(u) that iterates in single precision
+ * 
+ * Used as the multigrid smoother and coarse solver for the fivepoint and 
+ * heat operators.  Interface values are moved to the right hand side in 
+ * double precision, then each patch is solved with conjugate gradients on 
+ * float copies of the right hand side and the solution.  This halves the 
+ * memory traffic of the smoother, which dominates the preconditioner.
+ */
+class FloatPatchSolver : public ThunderEgg::PatchSolver<2>
+{
+public:
+    /**
+     * @brief Construct a new patch solver
+     * 
+     * @param op the double precision patch operator; supplies the domain and ghost filler
+     * @param lambda the coefficient of u;  0 for the Laplacian
+     * @param bc_sign sign of the ghost cells at the physical boundaries 
+     *                (-1 for Dirichlet, 1 for Neumann) 
+     * @param max_iterations max patch iterations
+     * @param tolerance relative tolerance for the patch iterations
+     */
+    FloatPatchSolver(const ThunderEgg::PatchOperator<2>& op,
+                     double lambda, const int bc_sign[],
+                     int max_iterations, double tolerance);
+
+    FloatPatchSolver* clone() const override{
+        return new FloatPatchSolver(*this);
+    }
+
+    void solveSinglePatch(const ThunderEgg::PatchInfo<2>& pinfo,
+                          const ThunderEgg::PatchView<const double, 2>& f,
+                          const ThunderEgg::PatchView<double, 2>& u) const override;
+
+private:
+    float lambda;
+    float bc_sign[4];
+    int max_iterations;
+    float tolerance;
+
+    /* Work arrays, reused across patches */
+    mutable std::vector<float> b, x, r, p, Ap;
+};
+
+#endif /* !FC2D_THUNDEREGG_FLOAT_PATCH_SOLVER_HPP */
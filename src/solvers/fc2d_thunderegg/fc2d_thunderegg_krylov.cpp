@@ -0,0 +1,485 @@
+/*
+  Copyright (c) 2019-2023 Carsten Burstedde, Donna Calhoun, Scott Aiton, Grady Wright
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "fc2d_thunderegg_krylov.hpp"
+#include "fc2d_thunderegg_options.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ThunderEgg;
+
+namespace{
+
+/* Fields are reduced separately in field block mode, and together 
+   otherwise.  Scalars and sums are stored by group. */
+int num_groups(const Vector<2>& b, bool field_block)
+{
+    return field_block ? b.getNumComponents() : 1;
+}
+
+/* sums[g] = sum of a*b over the interior cells of the local patches, for 
+   the fields of group g */
+void local_dots(const Vector<2>& a, const Vector<2>& b, int ngroups, double *sums)
+{
+    for(int g = 0; g < ngroups; g++)
+        sums[g] = 0;
+
+    for(int patch_idx = 0; patch_idx < a.getNumLocalPatches(); patch_idx++){
+        PatchView<const double, 2> va = a.getPatchView(patch_idx);
+        PatchView<const double, 2> vb = b.getPatchView(patch_idx);
+        auto end = va.getEnd();
+        for(int m = 0; m <= end[2]; m++){
+            double sum = 0;
+            for(int j = 0; j <= end[1]; j++){
+                for(int i = 0; i <= end[0]; i++){
+                    sum += va(i,j,m)*vb(i,j,m);
+                }
+            }
+            sums[ngroups == 1 ? 0 : m] += sum;
+        }
+    }
+}
+
+/* y = c[g]*y + x */
+void scale_then_add(Vector<2>& y, const double *c, const Vector<2>& x, int ngroups)
+{
+    if (ngroups == 1)
+    {
+        y.scaleThenAdd(c[0], x);
+        return;
+    }
+    for(int patch_idx = 0; patch_idx < y.getNumLocalPatches(); patch_idx++){
+        PatchView<double, 2> vy = y.getPatchView(patch_idx);
+        PatchView<const double, 2> vx = x.getPatchView(patch_idx);
+        auto end = vy.getEnd();
+        for(int m = 0; m <= end[2]; m++){
+            for(int j = 0; j <= end[1]; j++){
+                for(int i = 0; i <= end[0]; i++){
+                    vy(i,j,m) = c[m]*vy(i,j,m) + vx(i,j,m);
+                }
+            }
+        }
+    }
+}
+
+/* y = y + c[g]*x */
+void add_scaled(Vector<2>& y, const double *c, const Vector<2>& x, int ngroups)
+{
+    if (ngroups == 1)
+    {
+        y.addScaled(c[0], x);
+        return;
+    }
+    for(int patch_idx = 0; patch_idx < y.getNumLocalPatches(); patch_idx++){
+        PatchView<double, 2> vy = y.getPatchView(patch_idx);
+        PatchView<const double, 2> vx = x.getPatchView(patch_idx);
+        auto end = vy.getEnd();
+        for(int m = 0; m <= end[2]; m++){
+            for(int j = 0; j <= end[1]; j++){
+                for(int i = 0; i <= end[0]; i++){
+                    vy(i,j,m) += c[m]*vx(i,j,m);
+                }
+            }
+        }
+    }
+}
+
+/* y = y + c[g]*x + d[g]*w */
+void add_scaled(Vector<2>& y, const double *c, const Vector<2>& x, 
+                const double *d, const Vector<2>& w, int ngroups)
+{
+    if (ngroups == 1)
+    {
+        y.addScaled(c[0], x, d[0], w);
+        return;
+    }
+    for(int patch_idx = 0; patch_idx < y.getNumLocalPatches(); patch_idx++){
+        PatchView<double, 2> vy = y.getPatchView(patch_idx);
+        PatchView<const double, 2> vx = x.getPatchView(patch_idx);
+        PatchView<const double, 2> vw = w.getPatchView(patch_idx);
+        auto end = vy.getEnd();
+        for(int m = 0; m <= end[2]; m++){
+            for(int j = 0; j <= end[1]; j++){
+                for(int i = 0; i <= end[0]; i++){
+                    vy(i,j,m) += c[m]*vx(i,j,m) + d[m]*vw(i,j,m);
+                }
+            }
+        }
+    }
+}
+
+/* Start global sums of local values;  finished with MPI_Wait */
+void reduce_start(const Vector<2>& x, double *sums, int n, MPI_Request *request)
+{
+    MPI_Iallreduce(MPI_IN_PLACE, sums, n, MPI_DOUBLE, MPI_SUM,
+                   x.getCommunicator().getMPIComm(), request);
+}
+
+/* Norms of the rhs by group.  Returns false if b is zero. A group with a 
+   zero rhs is measured with the absolute residual. */
+bool rhs_norms(const Vector<2>& b, int ngroups, std::vector<double>& bnorm)
+{
+    bnorm.resize(ngroups);
+    local_dots(b, b, ngroups, bnorm.data());
+    MPI_Allreduce(MPI_IN_PLACE, bnorm.data(), ngroups, MPI_DOUBLE, MPI_SUM,
+                  b.getCommunicator().getMPIComm());
+
+    bool nonzero = false;
+    for(int g = 0; g < ngroups; g++)
+    {
+        bnorm[g] = std::sqrt(bnorm[g]);
+        if (bnorm[g] == 0)
+            bnorm[g] = 1;
+        else
+            nonzero = true;
+    }
+    return nonzero;
+}
+
+/* Updates convergence of each group from rr = (r,r).  Returns the largest 
+   relative residual.  Converged groups stay converged;  their scalars are 
+   set to zero by the caller so that their fields are no longer updated. */
+double check_residuals(const double *rr, const std::vector<double>& bnorm,
+                       double tolerance, std::vector<char>& converged)
+{
+    double max_residual = 0;
+    for(size_t g = 0; g < bnorm.size(); g++)
+    {
+        double residual = std::sqrt(rr[g])/bnorm[g];
+        if (residual <= tolerance)
+            converged[g] = 1;
+        max_residual = std::max(max_residual, residual);
+    }
+    return max_residual;
+}
+
+bool all_converged(const std::vector<char>& converged)
+{
+    for(char c : converged)
+        if (!c)
+            return false;
+    return true;
+}
+
+/* u = M r, or u = r without a preconditioner */
+void precondition(const Operator<2>* Mr, const Vector<2>& r, Vector<2>& u)
+{
+    if (Mr != nullptr)
+        Mr->apply(r, u);
+    else
+        u.copy(r);
+}
+
+}
+
+int PipelinedCG::solve(const Operator<2>& A,
+                       Vector<2>& x,
+                       const Vector<2>& b,
+                       const Operator<2>* Mr,
+                       bool output,
+                       std::ostream& os) const
+{
+    int ng = num_groups(b, field_block);
+    std::vector<double> bnorm;
+    if (!rhs_norms(b, ng, bnorm))
+    {
+        x.set(0);
+        return 0;
+    }
+
+    Vector<2> r = b.getZeroClone();
+    Vector<2> u = b.getZeroClone();
+    Vector<2> w = b.getZeroClone();
+    Vector<2> m = b.getZeroClone();
+    Vector<2> n = b.getZeroClone();
+    Vector<2> z = b.getZeroClone();
+    Vector<2> q = b.getZeroClone();
+    Vector<2> s = b.getZeroClone();
+    Vector<2> p = b.getZeroClone();
+
+    /* r = b - A*x, u = M*r, w = A*u */
+    A.apply(x, r);
+    r.scaleThenAdd(-1, b);
+    precondition(Mr, r, u);
+    A.apply(u, w);
+
+    /* (r,u), (w,u) and (r,r) for each group */
+    std::vector<double> sums(3*ng);
+    std::vector<double> gamma_old(ng), alpha(ng), beta(ng), neg_alpha(ng);
+    std::vector<char> converged(ng, 0);
+    int num_its = 0;
+    while (true)
+    {
+        local_dots(r, u, ng, &sums[0]);
+        local_dots(w, u, ng, &sums[ng]);
+        local_dots(r, r, ng, &sums[2*ng]);
+        MPI_Request request;
+        reduce_start(b, sums.data(), 3*ng, &request);
+
+        /* Hide the reduction behind m = M*w, n = A*m */
+        precondition(Mr, w, m);
+        A.apply(m, n);
+
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        double residual = check_residuals(&sums[2*ng], bnorm, tolerance, converged);
+        if (output)
+            os << "Iteration: " << num_its << ", Residual: " << residual << std::endl;
+
+        if (all_converged(converged) || num_its >= max_iterations)
+            break;
+
+        for(int g = 0; g < ng; g++)
+        {
+            double gamma = sums[g];
+            double delta = sums[ng + g];
+            if (converged[g])
+            {
+                alpha[g] = 0;
+                beta[g] = 0;
+            }
+            else if (num_its == 0 || alpha[g] == 0)
+            {
+                beta[g] = 0;
+                alpha[g] = gamma/delta;
+            }
+            else
+            {
+                beta[g] = gamma/gamma_old[g];
+                alpha[g] = gamma/(delta - beta[g]*gamma/alpha[g]);
+            }
+            neg_alpha[g] = -alpha[g];
+            gamma_old[g] = gamma;
+        }
+
+        scale_then_add(z, beta.data(), n, ng);
+        scale_then_add(q, beta.data(), m, ng);
+        scale_then_add(s, beta.data(), w, ng);
+        scale_then_add(p, beta.data(), u, ng);
+
+        add_scaled(x, alpha.data(), p, ng);
+        add_scaled(r, neg_alpha.data(), s, ng);
+        add_scaled(u, neg_alpha.data(), q, ng);
+        add_scaled(w, neg_alpha.data(), z, ng);
+
+        num_its++;
+    }
+    return num_its;
+}
+
+int PipelinedBiCGStab::solve(const Operator<2>& A,
+                             Vector<2>& x,
+                             const Vector<2>& b,
+                             const Operator<2>* Mr,
+                             bool output,
+                             std::ostream& os) const
+{
+    int ng = num_groups(b, field_block);
+    std::vector<double> bnorm;
+    if (!rhs_norms(b, ng, bnorm))
+    {
+        x.set(0);
+        return 0;
+    }
+
+    /* Hats denote preconditioned vectors */
+    Vector<2> r = b.getZeroClone();
+    Vector<2> rhat = b.getZeroClone();
+    Vector<2> w = b.getZeroClone();
+    Vector<2> what = b.getZeroClone();
+    Vector<2> t = b.getZeroClone();
+    Vector<2> phat = b.getZeroClone();
+    Vector<2> s = b.getZeroClone();
+    Vector<2> shat = b.getZeroClone();
+    Vector<2> z = b.getZeroClone();
+    Vector<2> zhat = b.getZeroClone();
+    Vector<2> v = b.getZeroClone();
+    Vector<2> q = b.getZeroClone();
+    Vector<2> qhat = b.getZeroClone();
+    Vector<2> y = b.getZeroClone();
+
+    /* r = b - A*x, rhat = M*r, w = A*rhat, what = M*w, t = A*what */
+    A.apply(x, r);
+    r.scaleThenAdd(-1, b);
+    precondition(Mr, r, rhat);
+    A.apply(rhat, w);
+    precondition(Mr, w, what);
+    A.apply(what, t);
+
+    /* Shadow residual */
+    Vector<2> r0 = b.getZeroClone();
+    r0.copy(r);
+
+    std::vector<double> sums(5*ng);
+    local_dots(r0, r, ng, &sums[0]);
+    local_dots(r0, w, ng, &sums[ng]);
+    local_dots(r, r, ng, &sums[2*ng]);
+    MPI_Request request;
+    reduce_start(b, sums.data(), 3*ng, &request);
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    std::vector<char> converged(ng, 0);
+    double residual = check_residuals(&sums[2*ng], bnorm, tolerance, converged);
+
+    std::vector<double> rho(ng), alpha(ng), beta(ng, 0), omega(ng, 0);
+    std::vector<double> neg_alpha(ng), neg_omega(ng), omega_alpha(ng);
+    for(int g = 0; g < ng; g++)
+    {
+        rho[g] = sums[g];
+        alpha[g] = converged[g] ? 0 : rho[g]/sums[ng + g];
+    }
+
+    int num_its = 0;
+    while (true)
+    {
+        if (output)
+            os << "Iteration: " << num_its << ", Residual: " << residual << std::endl;
+
+        if (all_converged(converged) || num_its >= max_iterations)
+            break;
+
+        for(int g = 0; g < ng; g++)
+        {
+            neg_alpha[g] = -alpha[g];
+            neg_omega[g] = -omega[g];
+        }
+
+        if (num_its == 0)
+        {
+            phat.copy(rhat);
+            s.copy(w);
+            shat.copy(what);
+            z.copy(t);
+        }
+        else
+        {
+            add_scaled(phat, neg_omega.data(), shat, ng);
+            scale_then_add(phat, beta.data(), rhat, ng);
+            add_scaled(s, neg_omega.data(), z, ng);
+            scale_then_add(s, beta.data(), w, ng);
+            add_scaled(shat, neg_omega.data(), zhat, ng);
+            scale_then_add(shat, beta.data(), what, ng);
+            add_scaled(z, neg_omega.data(), v, ng);
+            scale_then_add(z, beta.data(), t, ng);
+        }
+
+        /* q = r - alpha*s, qhat = rhat - alpha*shat, y = w - alpha*z */
+        q.copy(r);
+        add_scaled(q, neg_alpha.data(), s, ng);
+        qhat.copy(rhat);
+        add_scaled(qhat, neg_alpha.data(), shat, ng);
+        y.copy(w);
+        add_scaled(y, neg_alpha.data(), z, ng);
+
+        local_dots(q, y, ng, &sums[0]);
+        local_dots(y, y, ng, &sums[ng]);
+        reduce_start(b, sums.data(), 2*ng, &request);
+
+        /* Hide the reduction behind zhat = M*z, v = A*zhat */
+        precondition(Mr, z, zhat);
+        A.apply(zhat, v);
+
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        for(int g = 0; g < ng; g++)
+        {
+            omega[g] = converged[g] ? 0 : sums[g]/sums[ng + g];
+            neg_omega[g] = -omega[g];
+            omega_alpha[g] = omega[g]*alpha[g];
+        }
+
+        add_scaled(x, alpha.data(), phat, omega.data(), qhat, ng);
+
+        /* r = q - omega*y, rhat = qhat - omega*(what - alpha*zhat), 
+           w = y - omega*(t - alpha*v) */
+        r.copy(q);
+        add_scaled(r, neg_omega.data(), y, ng);
+        rhat.copy(qhat);
+        add_scaled(rhat, neg_omega.data(), what, omega_alpha.data(), zhat, ng);
+        w.copy(y);
+        add_scaled(w, neg_omega.data(), t, omega_alpha.data(), v, ng);
+
+        local_dots(r0, r, ng, &sums[0]);
+        local_dots(r0, w, ng, &sums[ng]);
+        local_dots(r0, s, ng, &sums[2*ng]);
+        local_dots(r0, z, ng, &sums[3*ng]);
+        local_dots(r, r, ng, &sums[4*ng]);
+        reduce_start(b, sums.data(), 5*ng, &request);
+
+        /* Hide the reduction behind what = M*w, t = A*what */
+        precondition(Mr, w, what);
+        A.apply(what, t);
+
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        num_its++;
+        residual = check_residuals(&sums[4*ng], bnorm, tolerance, converged);
+
+        for(int g = 0; g < ng; g++)
+        {
+            if (converged[g])
+            {
+                alpha[g] = 0;
+                beta[g] = 0;
+                continue;
+            }
+            beta[g] = (alpha[g]/omega[g])*(sums[g]/rho[g]);
+            alpha[g] = sums[g]/(sums[ng + g] + beta[g]*sums[2*ng + g] 
+                                - beta[g]*omega[g]*sums[3*ng + g]);
+            rho[g] = sums[g];
+        }
+    }
+    return num_its;
+}
+
+std::unique_ptr<Iterative::Solver<2>>
+fc2d_thunderegg_krylov_solver_new(const fc2d_thunderegg_options_t *mg_opt)
+{
+    switch (mg_opt->krylov_solver)
+    {
+        case PIPELINED_CG:
+        {
+            PipelinedCG *solver = new PipelinedCG();
+            solver->setMaxIterations(mg_opt->max_it);
+            solver->setTolerance(mg_opt->tol);
+            solver->setFieldBlock(mg_opt->field_block);
+            return std::unique_ptr<Iterative::Solver<2>>(solver);
+        }
+        case PIPELINED_BICGSTAB:
+        {
+            PipelinedBiCGStab *solver = new PipelinedBiCGStab();
+            solver->setMaxIterations(mg_opt->max_it);
+            solver->setTolerance(mg_opt->tol);
+            solver->setFieldBlock(mg_opt->field_block);
+            return std::unique_ptr<Iterative::Solver<2>>(solver);
+        }
+        default:
+        {
+            Iterative::BiCGStab<2> *solver = new Iterative::BiCGStab<2>();
+            solver->setMaxIterations(mg_opt->max_it);
+            solver->setTolerance(mg_opt->tol);
+            return std::unique_ptr<Iterative::Solver<2>>(solver);
+        }
+    }
+}
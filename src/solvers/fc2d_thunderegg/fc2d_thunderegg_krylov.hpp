@@ -0,0 +1,125 @@
+/*
+  Copyright (c) 2019-2023 Carsten Burstedde, Donna Calhoun, Scott Aiton, Grady Wright
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FC2D_THUNDEREGG_KRYLOV_HPP
+#define FC2D_THUNDEREGG_KRYLOV_HPP
+
+/**
+ * @file 
+ * Outer Krylov solvers for the ThunderEgg operators
+ */
+
+#include <ThunderEgg.h>
+
+#include <memory>
+
+/* Avoid circular dependencies */
+struct fc2d_thunderegg_options;
+
+/**
+ * @brief Pipelined preconditioned conjugate gradient method
+ * 
+ * Ghysels and Vanroose variant of CG.  The two inner products and the 
+ * residual norm of an iteration are combined into one nonblocking 
+ * reduction, which is overlapped with the preconditioner and the operator 
+ * apply.  Requires a symmetric operator and preconditioner.
+ * 
+ * In field block mode each field of a multi-field vector is solved as its 
+ * own system, with its own step lengths and convergence test.  All fields 
+ * still share one operator apply and one reduction per iteration.  Only 
+ * valid for operators that do not couple the fields.
+ */
+class PipelinedCG : public ThunderEgg::Iterative::Solver<2>
+{
+public:
+    PipelinedCG* clone() const override{
+        return new PipelinedCG(*this);
+    }
+
+    void setMaxIterations(int max_iterations_in) { max_iterations = max_iterations_in; }
+    int getMaxIterations() const { return max_iterations; }
+    void setTolerance(double tolerance_in) { tolerance = tolerance_in; }
+    double getTolerance() const { return tolerance; }
+    void setFieldBlock(bool field_block_in) { field_block = field_block_in; }
+    bool getFieldBlock() const { return field_block; }
+
+    int solve(const ThunderEgg::Operator<2>& A,
+              ThunderEgg::Vector<2>& x,
+              const ThunderEgg::Vector<2>& b,
+              const ThunderEgg::Operator<2>* Mr = nullptr,
+              bool output = false,
+              std::ostream& os = std::cout) const override;
+
+private:
+    int max_iterations = 1000;
+    double tolerance = 1e-12;
+    bool field_block = false;
+};
+
+/**
+ * @brief Pipelined preconditioned BiCGStab method
+ * 
+ * Cools and Vanroose variant of BiCGStab with right preconditioning.  The 
+ * two global reduction phases of each iteration are nonblocking and are 
+ * overlapped with a preconditioner and operator apply each.  Uses about 
+ * twice the vectors of BiCGStab.  See PipelinedCG for field block mode.
+ */
+class PipelinedBiCGStab : public ThunderEgg::Iterative::Solver<2>
+{
+public:
+    PipelinedBiCGStab* clone() const override{
+        return new PipelinedBiCGStab(*this);
+    }
+
+    void setMaxIterations(int max_iterations_in) { max_iterations = max_iterations_in; }
+    int getMaxIterations() const { return max_iterations; }
+    void setTolerance(double tolerance_in) { tolerance = tolerance_in; }
+    double getTolerance() const { return tolerance; }
+    void setFieldBlock(bool field_block_in) { field_block = field_block_in; }
+    bool getFieldBlock() const { return field_block; }
+
+    int solve(const ThunderEgg::Operator<2>& A,
+              ThunderEgg::Vector<2>& x,
+              const ThunderEgg::Vector<2>& b,
+              const ThunderEgg::Operator<2>* Mr = nullptr,
+              bool output = false,
+              std::ostream& os = std::cout) const override;
+
+private:
+    int max_iterations = 1000;
+    double tolerance = 1e-12;
+    bool field_block = false;
+};
+
+/**
+ * @brief Get the outer Krylov solver selected with the krylov-solver option
+ * 
+ * @param mg_opt the thunderegg options
+ * @return the solver, set up with the max-it and tol options
+ */
+std::unique_ptr<ThunderEgg::Iterative::Solver<2>>
+fc2d_thunderegg_krylov_solver_new(const struct fc2d_thunderegg_options *mg_opt);
+
+#endif /* !FC2D_THUNDEREGG_KRYLOV_HPP */
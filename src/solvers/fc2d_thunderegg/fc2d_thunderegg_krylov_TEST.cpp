@@ -0,0 +1,169 @@
+/*
+  Copyright (c) 2019-2023 Carsten Burstedde, Donna Calhoun, Scott Aiton, Grady Wright
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "fc2d_thunderegg_krylov.hpp"
+#include "fc2d_thunderegg_options.h"
+#include <test.hpp>
+#include <test/test.hpp>
+#include <cmath>
+using namespace ThunderEgg;
+
+namespace{
+/* Tridiagonal operator in x on each patch row; diagonal dominant and symmetric */
+class RowOperator : public Operator<2>
+{
+public:
+    RowOperator* clone() const override{
+        return new RowOperator(*this);
+    }
+    void apply(const Vector<2>& x, Vector<2>& b) const override{
+        for(int patch_idx=0; patch_idx < x.getNumLocalPatches(); patch_idx++){
+            PatchView<const double, 2> vx = x.getPatchView(patch_idx);
+            PatchView<double, 2> vb = b.getPatchView(patch_idx);
+            auto end = vx.getEnd();
+            for(int m=0; m<=end[2]; m++)
+            for(int j=0; j<=end[1]; j++)
+            for(int i=0; i<=end[0]; i++){
+                double left = i > 0 ? vx(i-1,j,m) : 0;
+                double right = i < end[0] ? vx(i+1,j,m) : 0;
+                vb(i,j,m) = 4*vx(i,j,m) - left - right;
+            }
+        }
+    }
+};
+}
+
+TEST_CASE("fc2d_thunderegg_krylov_solver_new pipelined solvers converge")
+{
+    for(int krylov_solver : {PIPELINED_CG, PIPELINED_BICGSTAB})
+    for(bool precondition : {false,true})
+    for(int field_block : {0,1})
+    {
+        fc2d_thunderegg_options_t mg_opt;
+        memset(&mg_opt, 0, sizeof(mg_opt));
+        mg_opt.krylov_solver = krylov_solver;
+        mg_opt.max_it = 1000;
+        mg_opt.tol = 1e-12;
+        mg_opt.field_block = field_block;
+
+        Communicator comm(MPI_COMM_WORLD);
+        Vector<2> b(comm,{8,6},2,3,1);
+        for(int patch_idx=0; patch_idx < b.getNumLocalPatches(); patch_idx++){
+            PatchView<double, 2> view = b.getPatchView(patch_idx);
+            for(int m=0; m<2; m++)
+            for(int j=0; j<6; j++)
+            for(int i=0; i<8; i++){
+                view(i,j,m) = 1 + patch_idx + i*j - m;
+            }
+        }
+        Vector<2> x = b.getZeroClone();
+
+        RowOperator A;
+
+        std::unique_ptr<Iterative::Solver<2>> solver = fc2d_thunderegg_krylov_solver_new(&mg_opt);
+        int its;
+        if(precondition){
+            /* Jacobi preconditioner */
+            class Jacobi : public Operator<2>
+            {
+            public:
+                Jacobi* clone() const override{
+                    return new Jacobi(*this);
+                }
+                void apply(const Vector<2>& r, Vector<2>& u) const override{
+                    u.copy(r);
+                    u.scale(0.25);
+                }
+            } M;
+            its = solver->solve(A, x, b, &M);
+        }else{
+            its = solver->solve(A, x, b);
+        }
+        CHECK(its > 0);
+        CHECK(its < mg_opt.max_it);
+
+        Vector<2> r = b.getZeroClone();
+        A.apply(x, r);
+        r.addScaled(-1, b);
+        CHECK(r.twoNorm()/b.twoNorm() < 1e-10);
+    }
+}
+
+TEST_CASE("fc2d_thunderegg_krylov_solver_new field block solves each field to tolerance")
+{
+    for(int krylov_solver : {PIPELINED_CG, PIPELINED_BICGSTAB})
+    {
+        fc2d_thunderegg_options_t mg_opt;
+        memset(&mg_opt, 0, sizeof(mg_opt));
+        mg_opt.krylov_solver = krylov_solver;
+        mg_opt.max_it = 1000;
+        mg_opt.tol = 1e-10;
+        mg_opt.field_block = 1;
+
+        /* Second field is much smaller than the first, third is zero */
+        Communicator comm(MPI_COMM_WORLD);
+        Vector<2> b(comm,{8,6},3,3,1);
+        for(int patch_idx=0; patch_idx < b.getNumLocalPatches(); patch_idx++){
+            PatchView<double, 2> view = b.getPatchView(patch_idx);
+            for(int j=0; j<6; j++)
+            for(int i=0; i<8; i++){
+                view(i,j,0) = 1 + patch_idx + i*j;
+                view(i,j,1) = 1e-8*(2 + i - j);
+                view(i,j,2) = 0;
+            }
+        }
+        Vector<2> x = b.getZeroClone();
+
+        RowOperator A;
+
+        std::unique_ptr<Iterative::Solver<2>> solver = fc2d_thunderegg_krylov_solver_new(&mg_opt);
+        int its = solver->solve(A, x, b);
+        CHECK(its > 0);
+        CHECK(its < mg_opt.max_it);
+
+        Vector<2> r = b.getZeroClone();
+        A.apply(x, r);
+        r.addScaled(-1, b);
+        for(int m=0; m<3; m++){
+            double rr = 0;
+            double bb = 0;
+            for(int patch_idx=0; patch_idx < b.getNumLocalPatches(); patch_idx++){
+                ComponentView<const double, 2> vr = r.getComponentView(m, patch_idx);
+                ComponentView<const double, 2> vb = b.getComponentView(m, patch_idx);
+                for(int j=0; j<6; j++)
+                for(int i=0; i<8; i++){
+                    rr += vr(i,j)*vr(i,j);
+                    bb += vb(i,j)*vb(i,j);
+                }
+            }
+            MPI_Allreduce(MPI_IN_PLACE, &rr, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            MPI_Allreduce(MPI_IN_PLACE, &bb, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            if(bb > 0)
+                CHECK(std::sqrt(rr/bb) < 1e-9);
+            else
+                CHECK(rr == 0);
+        }
+    }
+}
@@ -55,6 +55,9 @@ thunderegg_register (fc2d_thunderegg_options_t* mg_opt, sc_options_t * opt)
     sc_options_add_bool (opt, 0, "mg-prec", &mg_opt->mg_prec, 1,
                            "Use thunderegg preconditioner [T]");
 
+    sc_options_add_bool (opt, 0, "mg-single-precision", &mg_opt->mg_single_precision, 0,
+                           "Smooth in single precision (fivepoint and heat only) [F]");
+
     sc_options_add_int (opt, 0, "max-it", &mg_opt->max_it, 10000,
                            "Max iterations for BiCGStab solver. [10000]");
 
@@ -64,6 +67,9 @@ thunderegg_register (fc2d_thunderegg_options_t* mg_opt, sc_options_t * opt)
     sc_options_add_double (opt, 0, "tol", &mg_opt->tol, 1e-12,
                            "Tolerance for BiCGStab solver. [1e-12]");
 
+    sc_options_add_bool (opt, 0, "warm-start", &mg_opt->warm_start, 0,
+                           "Start BiCGStab from the previous solution [F]");
+
     sc_options_add_int (opt, 0, "pre-sweeps", &mg_opt->pre_sweeps, 1,
                            "Number of sweeps on down cycle [1]");
 
@@ -105,6 +111,19 @@ thunderegg_register (fc2d_thunderegg_options_t* mg_opt, sc_options_t * opt)
     sc_options_add_keyvalue (opt, 0, "patch_solver", &mg_opt->patch_solver,
                              "bicg", kv_s, "Set patch solver type [BICG]");
 
+    /* Set outer Krylov solver.  The pipelined solvers overlap their global
+       reductions with the preconditioner and operator apply */
+    sc_keyvalue_t *kv_k = mg_opt->kv_krylov_solver = sc_keyvalue_new ();
+    sc_keyvalue_set_int (kv_k, "bicgstab", BICGSTAB);
+    sc_keyvalue_set_int (kv_k, "pipelined-cg", PIPELINED_CG);
+    sc_keyvalue_set_int (kv_k, "pipelined-bicgstab", PIPELINED_BICGSTAB);
+    sc_options_add_keyvalue (opt, 0, "krylov-solver", &mg_opt->krylov_solver,
+                             "bicgstab", kv_k, "Set outer Krylov solver type [bicgstab]");
+
+    sc_options_add_bool (opt, 0, "field-block", &mg_opt->field_block, 0,
+                           "Solve each rhs field as its own system, sharing operator " \
+                           "applies and reductions (pipelined solvers only) [F]");
+
     mg_opt->is_registered = 1;
     return NULL;
 }
@@ -122,6 +141,12 @@ thunderegg_postprocess (fc2d_thunderegg_options_t * mg_opt)
 static fclaw_exit_type_t
 thunderegg_check(fc2d_thunderegg_options_t *mg_opt)
 {
+    if (mg_opt->field_block && mg_opt->krylov_solver == BICGSTAB)
+    {
+        fclaw_global_essentialf("thunderegg error : field-block requires " \
+                                "krylov-solver 'pipelined-cg' or 'pipelined-bicgstab'\n");
+        return FCLAW_EXIT_ERROR;
+    }
     return FCLAW_NOEXIT;
 }
 
@@ -135,6 +160,9 @@ void thunderegg_destroy (fc2d_thunderegg_options_t * mg_opt)
 
     FCLAW_ASSERT (mg_opt->kv_patch_solver != NULL);
     sc_keyvalue_destroy (mg_opt->kv_patch_solver);
+
+    FCLAW_ASSERT (mg_opt->kv_krylov_solver != NULL);
+    sc_keyvalue_destroy (mg_opt->kv_krylov_solver);
 }
 
 /* ------------------------------------------------------
@@ -230,10 +258,12 @@ fc2d_thunderegg_options_t*  fc2d_thunderegg_options_register (fclaw_app_t * app,
     return mg_opt;
 }
 
+static int options_slot = -1;
+
 fc2d_thunderegg_options_t* fc2d_thunderegg_get_options(fclaw2d_global_t *glob)
 {
     fc2d_thunderegg_options_t* user = (fc2d_thunderegg_options_t*) 
-                              fclaw_pointer_map_get(glob->options, "fc2d_thunderegg");
+                              fclaw_pointer_map_get_slot(glob->options, options_slot);
     FCLAW_ASSERT(user != NULL);
     return user;
 }
@@ -242,4 +272,5 @@ void fc2d_thunderegg_options_store (fclaw2d_global_t* glob, fc2d_thunderegg_opti
 {
     FCLAW_ASSERT(fclaw_pointer_map_get(glob->options,"fc2d_thunderegg") == NULL);
     fclaw_pointer_map_insert(glob->options, "fc2d_thunderegg", mg_opt, NULL);
+    options_slot = fclaw_pointer_map_slot("fc2d_thunderegg");
 }
@@ -56,6 +56,12 @@ typedef enum {
     USER_SOLVER
 } fc2d_thunderegg_solver_types;
 
+typedef enum {
+    BICGSTAB = 0,        /* ThunderEgg BiCGStab */
+    PIPELINED_CG,        /* Needs a symmetric operator and preconditioner */
+    PIPELINED_BICGSTAB   /* Can be used with any operator */
+} fc2d_thunderegg_krylov_types;
+
 
 struct fc2d_thunderegg_options
 {
@@ -69,8 +75,10 @@ struct fc2d_thunderegg_options
 
     /* bicgstab settings */
     int mg_prec;
+    int mg_single_precision;
     int max_it;
     double tol;
+    int warm_start;
 
     /* thunderegg cycle settings */
     int pre_sweeps;
@@ -91,6 +99,10 @@ struct fc2d_thunderegg_options
     int patch_solver;
     sc_keyvalue_t *kv_patch_solver;
 
+    int krylov_solver;
+    sc_keyvalue_t *kv_krylov_solver;
+    int field_block;     /* Separate Krylov scalars for each rhs field */
+
 
     int is_registered;
 };
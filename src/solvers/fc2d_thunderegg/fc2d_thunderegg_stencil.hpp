@@ -0,0 +1,157 @@
+/*
+  Copyright (c) 2019-2023 Carsten Burstedde, Donna Calhoun, Scott Aiton, Grady Wright
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FC2D_THUNDEREGG_STENCIL_HPP
+#define FC2D_THUNDEREGG_STENCIL_HPP
+
+/**
+ * @file 
+ * Five point stencil kernels on raw patch memory
+ * 
+ * Each kernel works on one field of one patch.  Arrays are passed as a 
+ * pointer to the first interior cell and the stride between rows;  cells 
+ * are contiguous within a row and the ghost cells around the interior 
+ * must be filled.  The inner loops are over contiguous rows with no 
+ * branches, so that the compiler can vectorize them.
+ * 
+ * The constant coefficient operator is 
+ *   f = cx*(u_w + u_e) + cy*(u_s + u_n) + c0*u
+ * with cx = 1/dx^2, cy = 1/dy^2, and c0 = lambda - 2*cx - 2*cy.  
+ * 
+ * The variable coefficient operator is 
+ *   f = cx*(b_e*(u_e - u) - b_w*(u - u_w)) + cy*(b_n*(u_n - u) - b_s*(u - u_s))
+ * with face coefficients b_w = beta + beta_w etc., and cx = 1/(2 dx^2), 
+ * cy = 1/(2 dy^2).
+ */
+
+/**
+ * @brief Apply the constant coefficient operator, f = A u
+ */
+template <typename T>
+inline void fc2d_thunderegg_stencil_apply(int mx, int my, 
+                                          const T *u, int u_stride, 
+                                          T *f, int f_stride,
+                                          T cx, T cy, T c0)
+{
+    for(int j = 0; j < my; j++){
+        const T *uc = u + j*u_stride;
+        const T *us = uc - u_stride;
+        const T *un = uc + u_stride;
+        T *fc = f + j*f_stride;
+        for(int i = 0; i < mx; i++){
+            fc[i] = cx*(uc[i-1] + uc[i+1]) + cy*(us[i] + un[i]) + c0*uc[i];
+        }
+    }
+}
+
+/**
+ * @brief Apply the constant coefficient operator and return the inner 
+ * product of v with the result, f = A u, returns (v, A u)
+ */
+template <typename T>
+inline double fc2d_thunderegg_stencil_apply_dot(int mx, int my, 
+                                                const T *u, int u_stride, 
+                                                T *f, int f_stride,
+                                                const T *v, int v_stride,
+                                                T cx, T cy, T c0)
+{
+    double sum = 0;
+    for(int j = 0; j < my; j++){
+        const T *uc = u + j*u_stride;
+        const T *us = uc - u_stride;
+        const T *un = uc + u_stride;
+        const T *vc = v + j*v_stride;
+        T *fc = f + j*f_stride;
+        T row_sum = 0;
+        for(int i = 0; i < mx; i++){
+            T fij = cx*(uc[i-1] + uc[i+1]) + cy*(us[i] + un[i]) + c0*uc[i];
+            fc[i] = fij;
+            row_sum += vc[i]*fij;
+        }
+        sum += row_sum;
+    }
+    return sum;
+}
+
+/**
+ * @brief Residual of the constant coefficient operator, r = b - A u, 
+ * returns (r, r)
+ */
+template <typename T>
+inline double fc2d_thunderegg_stencil_residual(int mx, int my, 
+                                               const T *u, int u_stride, 
+                                               const T *b, int b_stride,
+                                               T *r, int r_stride,
+                                               T cx, T cy, T c0)
+{
+    double sum = 0;
+    for(int j = 0; j < my; j++){
+        const T *uc = u + j*u_stride;
+        const T *us = uc - u_stride;
+        const T *un = uc + u_stride;
+        const T *bc = b + j*b_stride;
+        T *rc = r + j*r_stride;
+        T row_sum = 0;
+        for(int i = 0; i < mx; i++){
+            T rij = bc[i] - (cx*(uc[i-1] + uc[i+1]) + cy*(us[i] + un[i]) + c0*uc[i]);
+            rc[i] = rij;
+            row_sum += rij*rij;
+        }
+        sum += row_sum;
+    }
+    return sum;
+}
+
+/**
+ * @brief Apply the variable coefficient operator, f = A u
+ * 
+ * beta is a cell centered array with filled ghost cells
+ */
+template <typename T>
+inline void fc2d_thunderegg_stencil_apply_var(int mx, int my, 
+                                              const T *u, int u_stride, 
+                                              const T *beta, int beta_stride,
+                                              T *f, int f_stride,
+                                              T cx, T cy)
+{
+    for(int j = 0; j < my; j++){
+        const T *uc = u + j*u_stride;
+        const T *us = uc - u_stride;
+        const T *un = uc + u_stride;
+        const T *bc = beta + j*beta_stride;
+        const T *bs = bc - beta_stride;
+        const T *bn = bc + beta_stride;
+        T *fc = f + j*f_stride;
+        for(int i = 0; i < mx; i++){
+            T flux_w = (bc[i] + bc[i-1])*(uc[i] - uc[i-1]);
+            T flux_e = (bc[i+1] + bc[i])*(uc[i+1] - uc[i]);
+            T flux_s = (bc[i] + bs[i])*(uc[i] - us[i]);
+            T flux_n = (bn[i] + bc[i])*(un[i] - uc[i]);
+            fc[i] = cx*(flux_e - flux_w) + cy*(flux_n - flux_s);
+        }
+    }
+}
+
+#endif /* !FC2D_THUNDEREGG_STENCIL_HPP */
@@ -0,0 +1,98 @@
+/*
+  Copyright (c) 2019-2023 Carsten Burstedde, Donna Calhoun, Scott Aiton, Grady Wright
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "fc2d_thunderegg_stencil.hpp"
+#include <test.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace{
+/* Padded mx by my array with one layer of ghost cells */
+struct padded
+{
+    int mx, my, stride;
+    std::vector<double> data;
+    padded(int mx, int my, double seed) : mx(mx), my(my), stride(mx+2), data((mx+2)*(my+2))
+    {
+        for(size_t k = 0; k < data.size(); k++)
+            data[k] = std::sin(seed + 0.37*k);
+    }
+    double& operator()(int i, int j) { return data[(j+1)*stride + i + 1]; }
+    double* interior() { return &(*this)(0,0); }
+};
+}
+
+TEST_CASE("fc2d_thunderegg_stencil constant coefficient kernels")
+{
+    int mx = 8, my = 5;
+    double cx = 3, cy = 7, c0 = -2*cx - 2*cy - 0.5;
+    padded u(mx,my,0.1), v(mx,my,0.2), b(mx,my,0.3), f(mx,my,0), r(mx,my,0);
+
+    fc2d_thunderegg_stencil_apply(mx, my, u.interior(), u.stride, 
+                                  f.interior(), f.stride, cx, cy, c0);
+    for(int j = 0; j < my; j++)
+    for(int i = 0; i < mx; i++){
+        double expected = cx*(u(i-1,j) + u(i+1,j)) + cy*(u(i,j-1) + u(i,j+1)) + c0*u(i,j);
+        CHECK(f(i,j) == doctest::Approx(expected));
+    }
+
+    double vf = fc2d_thunderegg_stencil_apply_dot(mx, my, u.interior(), u.stride, 
+                                                  f.interior(), f.stride, 
+                                                  v.interior(), v.stride, cx, cy, c0);
+    double rr = fc2d_thunderegg_stencil_residual(mx, my, u.interior(), u.stride, 
+                                                 b.interior(), b.stride,
+                                                 r.interior(), r.stride, cx, cy, c0);
+    double vf_expected = 0, rr_expected = 0;
+    for(int j = 0; j < my; j++)
+    for(int i = 0; i < mx; i++){
+        vf_expected += v(i,j)*f(i,j);
+        CHECK(r(i,j) == doctest::Approx(b(i,j) - f(i,j)));
+        rr_expected += (b(i,j) - f(i,j))*(b(i,j) - f(i,j));
+    }
+    CHECK(vf == doctest::Approx(vf_expected));
+    CHECK(rr == doctest::Approx(rr_expected));
+}
+
+TEST_CASE("fc2d_thunderegg_stencil variable coefficient kernel")
+{
+    int mx = 6, my = 9;
+    double cx = 0.5, cy = 2;
+    padded u(mx,my,0.4), beta(mx,my,0.5), f(mx,my,0);
+    for(double& bk : beta.data)
+        bk += 2;
+
+    fc2d_thunderegg_stencil_apply_var(mx, my, u.interior(), u.stride, 
+                                      beta.interior(), beta.stride,
+                                      f.interior(), f.stride, cx, cy);
+    for(int j = 0; j < my; j++)
+    for(int i = 0; i < mx; i++){
+        double flux_w = (beta(i,j) + beta(i-1,j))*(u(i,j) - u(i-1,j));
+        double flux_e = (beta(i+1,j) + beta(i,j))*(u(i+1,j) - u(i,j));
+        double flux_s = (beta(i,j) + beta(i,j-1))*(u(i,j) - u(i,j-1));
+        double flux_n = (beta(i,j+1) + beta(i,j))*(u(i,j+1) - u(i,j));
+        CHECK(f(i,j) == doctest::Approx(cx*(flux_e - flux_w) + cy*(flux_n - flux_s)));
+    }
+}
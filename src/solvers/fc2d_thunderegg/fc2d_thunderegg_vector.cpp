@@ -47,6 +47,9 @@ static void get_data(struct fclaw2d_global* glob, fclaw2d_patch_t* patch, fc2d_t
         case STORE_STATE:
           fclaw2d_clawpatch_soln_data(glob, patch, q, meqn);
         break;
+        case ELLIPTIC_WORK:
+          fclaw2d_clawpatch_elliptic_work_data(glob, patch, q, meqn);
+        break;
     }
 }
 ThunderEgg::Vector<2> fc2d_thunderegg_get_vector(struct fclaw2d_global *glob, fc2d_thunderegg_data_choice_t data_choice)
@@ -67,6 +70,9 @@ ThunderEgg::Vector<2> fc2d_thunderegg_get_vector(struct fclaw2d_global *glob, fc
         case STORE_STATE:
           ns[2] = clawpatch_opt->meqn;
         break;
+        case ELLIPTIC_WORK:
+          ns[2] = clawpatch_opt->rhs_fields;
+        break;
     }
     int mbc = clawpatch_opt->mbc;
     std::array<int,3> strides;
@@ -109,4 +115,26 @@ void fc2d_thunderegg_store_vector(struct fclaw2d_global *glob, fc2d_thunderegg_d
             }
         }
     }
-}
\ No newline at end of file
+}
+void fc2d_thunderegg_swap_rhs(struct fclaw2d_global *glob)
+{
+    for(int blockno = 0; blockno < glob->domain->num_blocks; blockno++){
+        fclaw2d_block_t* block = &glob->domain->blocks[blockno];
+        for(int patchno = 0; patchno < block->num_patches; patchno++){
+            fclaw2d_clawpatch_elliptic_swap_rhs(glob, &block->patches[patchno]);
+        }
+    }
+}
+void fc2d_thunderegg_store_solution(struct fclaw2d_global *glob)
+{
+    fc2d_thunderegg_options_t *mg_opt = fc2d_thunderegg_get_options(glob);
+    for(int blockno = 0; blockno < glob->domain->num_blocks; blockno++){
+        fclaw2d_block_t* block = &glob->domain->blocks[blockno];
+        for(int patchno = 0; patchno < block->num_patches; patchno++){
+            fclaw2d_patch_t* patch = &block->patches[patchno];
+            fclaw2d_clawpatch_elliptic_swap_rhs(glob, patch);
+            if (!mg_opt->warm_start)
+                fclaw2d_clawpatch_elliptic_work_delete(glob, patch);
+        }
+    }
+}
@@ -47,6 +47,8 @@ typedef enum fc2d_thunderegg_data_choice
     SOLN,
     /** @brief soln patch data */
     STORE_STATE,
+    /** @brief elliptic work patch data (same layout as rhs) */
+    ELLIPTIC_WORK,
 }  fc2d_thunderegg_data_choice_t;
 
 /**
@@ -67,3 +69,24 @@ ThunderEgg::Vector<2> fc2d_thunderegg_get_vector(struct fclaw2d_global *glob, fc
  */
 void fc2d_thunderegg_store_vector(struct fclaw2d_global *glob, fc2d_thunderegg_data_choice_t data_choice, const ThunderEgg::Vector<2>& vec);
 
+/**
+ * @brief Exchange the rhs with the elliptic work data on every local patch
+ * 
+ * Used with --warm-start to move the previous solution, kept in the rhs, 
+ * back to the work data before the rhs is set.  Patches without work data 
+ * start from zero.
+ * 
+ * @param glob the global context
+ */
+void fc2d_thunderegg_swap_rhs(struct fclaw2d_global *glob);
+
+/**
+ * @brief Hand a solution computed in the elliptic work data to the rhs
+ * 
+ * The rhs and work data are exchanged without copying.  The work data, now 
+ * holding the old rhs, is freed unless --warm-start needs it for the next 
+ * solve.
+ * 
+ * @param glob the global context
+ */
+void fc2d_thunderegg_store_solution(struct fclaw2d_global *glob);
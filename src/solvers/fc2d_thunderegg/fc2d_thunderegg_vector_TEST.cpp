@@ -283,6 +283,81 @@ TEST_CASE("fclaw2d_thunderegg_store_vector")
     }
 
 }
+TEST_CASE("fclaw2d_thunderegg_swap_rhs")
+{
+    for(int mbc  : {1,2})
+    for(int mfields : {1,2})
+    {
+        QuadDomain test_data;
+        test_data.opts.mbc  = mbc;
+        test_data.opts.rhs_fields = mfields;
+        test_data.setup();
+
+        int mx = test_data.opts.mx;
+        int my = test_data.opts.my;
+        int size = (mx+2*mbc)*(my+2*mbc)*mfields;
+
+        //work data starts out as zero, with the layout of the rhs
+        Vector<2> vec = fc2d_thunderegg_get_vector(test_data.glob,ELLIPTIC_WORK);
+        CHECK(vec.getNumLocalPatches() == 4);
+        for(int i=0; i < 4; i++){
+            fclaw2d_patch_t* patch = &test_data.domain->blocks[0].patches[i];
+            double *rhs, *work, *soln;
+            int m;
+            fclaw2d_clawpatch_rhs_data(test_data.glob, patch, &rhs, &m);
+            fclaw2d_clawpatch_elliptic_soln_data(test_data.glob, patch, &soln, &m);
+            fclaw2d_clawpatch_elliptic_work_data(test_data.glob, patch, &work, &m);
+            CHECK(m == mfields);
+            CHECK(&vec.getPatchView(i)(-mbc,-mbc,0) == work);
+            //not the compute-error solution
+            CHECK(work != soln);
+            for(int j=0; j<size; j++){
+                CHECK(work[j] == 0);
+                work[j] = i*size + j;
+                rhs[j] = -1;
+            }
+        }
+
+        //the solution is handed to the rhs without copying
+        fc2d_thunderegg_swap_rhs(test_data.glob);
+
+        for(int i=0; i < 4; i++){
+            fclaw2d_patch_t* patch = &test_data.domain->blocks[0].patches[i];
+            double *rhs, *work;
+            int m;
+            fclaw2d_clawpatch_rhs_data(test_data.glob, patch, &rhs, &m);
+            CHECK(rhs == &vec.getPatchView(i)(-mbc,-mbc,0));
+            fclaw2d_clawpatch_elliptic_work_data(test_data.glob, patch, &work, &m);
+            for(int j=0; j<size; j++){
+                CHECK(rhs[j] == i*size + j);
+                CHECK(work[j] == -1);
+            }
+
+            fclaw2d_clawpatch_elliptic_work_delete(test_data.glob, patch);
+            fclaw2d_clawpatch_t* cp = fclaw2d_clawpatch_get_clawpatch(patch);
+            CHECK(cp->elliptic_work.size() == 0);
+        }
+    }
+}
+TEST_CASE("fclaw2d_thunderegg_swap_rhs without work data")
+{
+    QuadDomain test_data;
+    test_data.setup();
+
+    fclaw2d_patch_t* patch = &test_data.domain->blocks[0].patches[0];
+    double *rhs;
+    int m;
+    fclaw2d_clawpatch_rhs_data(test_data.glob, patch, &rhs, &m);
+
+    //the rhs is kept, and the work data starts from zero
+    fc2d_thunderegg_swap_rhs(test_data.glob);
+
+    double *rhs_after, *work;
+    fclaw2d_clawpatch_rhs_data(test_data.glob, patch, &rhs_after, &m);
+    fclaw2d_clawpatch_elliptic_work_data(test_data.glob, patch, &work, &m);
+    CHECK(rhs_after == rhs);
+    CHECK(work[0] == 0);
+}
 TEST_CASE("fclaw2d_thunderegg_get_vector multiblock")
 {
     for(fc2d_thunderegg_data_choice_t data_choice : {RHS,SOLN,STORE_STATE})
@@ -28,6 +28,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fc2d_thunderegg.h"
 #include "fc2d_thunderegg_options.h"
 #include "fc2d_thunderegg_vector.hpp"
+#include "fc2d_thunderegg_krylov.hpp"
+#include "fc2d_thunderegg_float_patch_solver.hpp"
+#include "fc2d_thunderegg_stencil.hpp"
 
 #include <fclaw2d_elliptic_solver.h>
 
@@ -51,6 +54,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 using namespace std;
 using namespace ThunderEgg;
 
+/* Ghost cell sign at physical boundaries (homogeneous Dirichlet) */
+static const int fivepoint_bc_sign[4] = {-1,-1,-1,-1};
+
 class fivePoint : public PatchOperator<2>
 {
 public:
@@ -191,13 +197,10 @@ void fivePoint::applySinglePatch(const PatchInfo<2>& pinfo,
 #if 1
     /* Five-point Laplacian */
     for(int m = 0; m < mfields; m++)
-        for(int j = 0; j < my; j++)
-            for(int i = 0; i < mx; i++)
-            {
-                double uij = u(i,j,m);
-                f(i,j,m) = (u(i+1,j,m) - 2*uij + u(i-1,j,m))/dx2 + 
-                             (u(i,j+1,m) - 2*uij + u(i,j-1,m))/dy2;
-            }
+        fc2d_thunderegg_stencil_apply(mx, my, 
+                                      &u(0,0,m), u.getStrides()[1],
+                                      &f(0,0,m), f.getStrides()[1],
+                                      1/dx2, 1/dy2, -2/dx2 - 2/dy2);
     
 #else
 
@@ -342,6 +345,12 @@ void fc2d_thunderegg_fivepoint_solve(fclaw2d_global_t *glob)
             exit(0);            
     }
 
+    /* Smooth in single precision instead */
+    if (mg_opt->mg_single_precision)
+        solver = make_shared<FloatPatchSolver>(op, 0, fivepoint_bc_sign,
+                                               mg_opt->patch_iter_max_it,
+                                               mg_opt->patch_iter_tol);
+
     // create gmg preconditioner
     shared_ptr<Operator<2>> M;
 
@@ -401,6 +410,10 @@ void fc2d_thunderegg_fivepoint_solve(fclaw2d_global_t *glob)
                                             "patch solver specified\n");
                     exit(0);            
             }
+            if (mg_opt->mg_single_precision)
+                smoother.reset(new FloatPatchSolver(patch_operator, 0, fivepoint_bc_sign,
+                                                    mg_opt->patch_iter_max_it,
+                                                    mg_opt->patch_iter_tol));
 
 
             //restrictor
@@ -444,6 +457,10 @@ void fc2d_thunderegg_fivepoint_solve(fclaw2d_global_t *glob)
                                         "patch solver specified\n");
                 exit(0);            
         }
+        if (mg_opt->mg_single_precision)
+            smoother.reset(new FloatPatchSolver(patch_operator, 0, fivepoint_bc_sign,
+                                                mg_opt->patch_iter_max_it,
+                                                mg_opt->patch_iter_tol));
 
 
         //interpolator
@@ -454,19 +471,18 @@ void fc2d_thunderegg_fivepoint_solve(fclaw2d_global_t *glob)
         M = builder.getCycle();
     }
 
-    // solve
-    Vector<2> u = f.getZeroClone();
+    // solve in place in the elliptic work data;  this is zero, or the
+    // previous solution with --warm-start
+    Vector<2> u = fc2d_thunderegg_get_vector(glob,ELLIPTIC_WORK);
 
-    Iterative::BiCGStab<2> iter_solver;
-    iter_solver.setMaxIterations(mg_opt->max_it);
-    iter_solver.setTolerance(mg_opt->tol);
+    unique_ptr<Iterative::Solver<2>> iter_solver = fc2d_thunderegg_krylov_solver_new(mg_opt);
     bool prt_output = mg_opt->verbosity_level > 0 && glob->mpirank == 0;
-    int its = iter_solver.solve(op, u, f, M.get(),prt_output);
+    int its = iter_solver->solve(op, u, f, M.get(),prt_output);
 
     fclaw_global_productionf("Iterations: %i\n", its);    
 
-    /* Solution is copied to right hand side */
-    fc2d_thunderegg_store_vector(glob, RHS, u);
+    /* Solution is swapped into the right hand side */
+    fc2d_thunderegg_store_solution(glob);
 
 }
 
@@ -28,6 +28,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fc2d_thunderegg.h"
 #include "fc2d_thunderegg_options.h"
 #include "fc2d_thunderegg_vector.hpp"
+#include "fc2d_thunderegg_krylov.hpp"
+#include "fc2d_thunderegg_float_patch_solver.hpp"
+#include "fc2d_thunderegg_stencil.hpp"
 
 #include <fclaw2d_elliptic_solver.h>
 
@@ -231,15 +234,10 @@ void heat::applySinglePatch(const PatchInfo<2>& pinfo,
 #if 1
     /* Five-point Laplacian */
     for(int m = 0; m < mfields; m++)
-        for(int j = 0; j < my; j++)
-            for(int i = 0; i < mx; i++)
-            {
-                double uij = u(i,j,m);
-                double lap = (u(i+1,j,m) - 2*uij + u(i-1,j,m))/dx2 + 
-                             (u(i,j+1,m) - 2*uij + u(i,j-1,m))/dy2;
-
-                f(i,j,m) = lap + lambda*uij;
-            }
+        fc2d_thunderegg_stencil_apply(mx, my, 
+                                      &u(0,0,m), u.getStrides()[1],
+                                      &f(0,0,m), f.getStrides()[1],
+                                      1/dx2, 1/dy2, lambda - 2/dx2 - 2/dy2);
     
 #else
 
@@ -327,6 +325,20 @@ void heat::modifyRHSForInternalBoundaryConditions(const PatchInfo<2>& pinfo,
 }
  
 
+/* Patch solver used for smoothing and on the coarsest level */
+static
+unique_ptr<PatchSolver<2>> heat_patch_solver(const fc2d_thunderegg_options_t *mg_opt,
+                                             const Iterative::Solver<2>& patch_iterative_solver,
+                                             const heat& op)
+{
+    if (mg_opt->mg_single_precision)
+        return unique_ptr<PatchSolver<2>>(new FloatPatchSolver(op, heat::lambda, op.s,
+                                                               mg_opt->patch_iter_max_it,
+                                                               mg_opt->patch_iter_tol));
+
+    return unique_ptr<PatchSolver<2>>(new Iterative::PatchSolver<2>(patch_iterative_solver, op));
+}
+
 void fc2d_thunderegg_heat_solve(fclaw2d_global_t *glob) 
 {
     // get needed options
@@ -395,7 +407,7 @@ void fc2d_thunderegg_heat_solve(fclaw2d_global_t *glob)
             exit(0);            
     }
 
-    Iterative::PatchSolver<2> solver(*patch_iterative_solver,op);
+    unique_ptr<PatchSolver<2>> solver = heat_patch_solver(mg_opt,*patch_iterative_solver,op);
 
     // create gmg preconditioner
     shared_ptr<Operator<2>> M;
@@ -423,7 +435,7 @@ void fc2d_thunderegg_heat_solve(fclaw2d_global_t *glob)
         GMG::LinearRestrictor<2> restrictor(curr_domain, 
                                             next_domain);
 
-        builder.addFinestLevel(op, solver, restrictor);
+        builder.addFinestLevel(op, *solver, restrictor);
 
         //add intermediate levels
         Domain<2> prev_domain = curr_domain;
@@ -437,7 +449,8 @@ void fc2d_thunderegg_heat_solve(fclaw2d_global_t *glob)
             heat patch_operator(glob,curr_domain, ghost_filler);
 
             //smoother
-            Iterative::PatchSolver<2> smoother(*patch_iterative_solver,patch_operator);
+            unique_ptr<PatchSolver<2>> smoother = heat_patch_solver(mg_opt,*patch_iterative_solver,
+                                                                  patch_operator);
 
             //restrictor
             GMG::LinearRestrictor<2> restrictor(curr_domain, 
@@ -447,7 +460,7 @@ void fc2d_thunderegg_heat_solve(fclaw2d_global_t *glob)
             GMG::DirectInterpolator<2> interpolator(curr_domain, 
                                                     prev_domain);
 
-            builder.addIntermediateLevel(patch_operator, smoother, restrictor, 
+            builder.addIntermediateLevel(patch_operator, *smoother, restrictor, 
                                          interpolator);
 
             prev_domain = curr_domain;
@@ -461,35 +474,29 @@ void fc2d_thunderegg_heat_solve(fclaw2d_global_t *glob)
         heat patch_operator(glob,curr_domain, ghost_filler);
 
         //smoother
-        Iterative::PatchSolver<2> smoother(*patch_iterative_solver,patch_operator);
+        unique_ptr<PatchSolver<2>> smoother = heat_patch_solver(mg_opt,*patch_iterative_solver,
+                                                                patch_operator);
 
         //interpolator
         GMG::DirectInterpolator<2> interpolator(curr_domain, prev_domain);
 
-        builder.addCoarsestLevel(patch_operator, smoother, interpolator);
+        builder.addCoarsestLevel(patch_operator, *smoother, interpolator);
 
         M = builder.getCycle();
     }
 
-    // solve
-
-#if 0   
-    // Set starting conditions
-    Vector<2> u = fc2d_thunderegg_get_vector(glob,SOLN);
-#else
-    Vector<2> u = f.getZeroClone();
-#endif    
+    // solve in place in the elliptic work data;  this is zero, or the
+    // previous solution with --warm-start
+    Vector<2> u = fc2d_thunderegg_get_vector(glob,ELLIPTIC_WORK);
 
 
-    Iterative::BiCGStab<2> iter_solver;
-    iter_solver.setMaxIterations(mg_opt->max_it);
-    iter_solver.setTolerance(mg_opt->tol);
+    unique_ptr<Iterative::Solver<2>> iter_solver = fc2d_thunderegg_krylov_solver_new(mg_opt);
     bool prt_output = mg_opt->verbosity_level > 0 && glob->mpirank == 0;
-    int its = iter_solver.solve(op, u, f, M.get(),prt_output);
+    int its = iter_solver->solve(op, u, f, M.get(),prt_output);
 
     fclaw_global_productionf("Iterations: %i\n", its);    
 
-    /* Solution is copied to right hand side */
-    fc2d_thunderegg_store_vector(glob, RHS, u);
+    /* Solution is swapped into the right hand side */
+    fc2d_thunderegg_store_solution(glob);
 }
 
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fc2d_thunderegg.h"
 #include "fc2d_thunderegg_options.h"
 #include "fc2d_thunderegg_vector.hpp"
+#include "fc2d_thunderegg_krylov.hpp"
 
 #include <fclaw2d_elliptic_solver.h>
 
@@ -280,18 +281,17 @@ void fc2d_thunderegg_starpatch_solve(fclaw2d_global_t *glob)
         M = builder.getCycle();
     }
 
-    // solve
-    Vector<2> u = f.getZeroClone();
+    // solve in place in the elliptic work data;  this is zero, or the
+    // previous solution with --warm-start
+    Vector<2> u = fc2d_thunderegg_get_vector(glob,ELLIPTIC_WORK);
 
-    Iterative::BiCGStab<2> iter_solver;
-    iter_solver.setMaxIterations(mg_opt->max_it);
-    iter_solver.setTolerance(mg_opt->tol);
+    unique_ptr<Iterative::Solver<2>> iter_solver = fc2d_thunderegg_krylov_solver_new(mg_opt);
     bool vl = mg_opt->verbosity_level > 0 && glob->mpirank == 0;
-    int its = iter_solver.solve(op, u, f, M.get(), vl);
+    int its = iter_solver->solve(op, u, f, M.get(), vl);
 
     fclaw_global_productionf("Iterations: %i\n", its);
 
-    // copy solution into rhs
-    fc2d_thunderegg_store_vector(glob, RHS, u);
+    // swap solution into rhs
+    fc2d_thunderegg_store_solution(glob);
 }
 
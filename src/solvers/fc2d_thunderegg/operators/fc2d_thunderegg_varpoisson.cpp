@@ -28,6 +28,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fc2d_thunderegg.h"
 #include "fc2d_thunderegg_options.h"
 #include "fc2d_thunderegg_vector.hpp"
+#include "fc2d_thunderegg_krylov.hpp"
+#include "fc2d_thunderegg_stencil.hpp"
 
 #include <fclaw2d_elliptic_solver.h>
 
@@ -214,23 +216,11 @@ void varpoisson::applySinglePatch(const PatchInfo<2>& pinfo,
     double dx2 = 2*dx*dx;
     double dy2 = 2*dy*dy;
     for(int m = 0; m < mfields; m++)
-        for(int j = 0; j < my; j++)
-            for(int i = 0; i < mx; i++)
-            {
-                double b0 = (b(i,j)   + b(i-1,j));
-                double b1 = (b(i+1,j) + b(i,j));
-                double b2 = (b(i,j)   + b(i,j-1));
-                double b3 = (b(i,j+1) + b(i,j));
-
-                double flux[4];
-                flux[0] = b0*(u(i,j,m) - u(i-1,j,m));
-                flux[1] = b1*(u(i+1,j,m) - u(i,j,m));
-                flux[2] = b2*(u(i,j,m) - u(i,j-1,m));
-                flux[3] = b3*(u(i,j+1,m) - u(i,j,m));
-
-                f(i,j,m) = (flux[1]-flux[0])/dx2 + (flux[3] - flux[2])/dy2;
-
-            }
+        fc2d_thunderegg_stencil_apply_var(mx, my, 
+                                          &u(0,0,m), u.getStrides()[1],
+                                          &b(0,0), b.getStrides()[1],
+                                          &f(0,0,m), f.getStrides()[1],
+                                          1/dx2, 1/dy2);
 #endif
 
 #if 0
@@ -496,18 +486,17 @@ void fc2d_thunderegg_varpoisson_solve(fclaw2d_global_t *glob)
         M = builder.getCycle();
     }
 
-    // solve
-    Vector<2> u = f.getZeroClone();
+    // solve in place in the elliptic work data;  this is zero, or the
+    // previous solution with --warm-start
+    Vector<2> u = fc2d_thunderegg_get_vector(glob,ELLIPTIC_WORK);
 
-    Iterative::BiCGStab<2> iter_solver;
-    iter_solver.setMaxIterations(mg_opt->max_it);
-    iter_solver.setTolerance(mg_opt->tol);
+    unique_ptr<Iterative::Solver<2>> iter_solver = fc2d_thunderegg_krylov_solver_new(mg_opt);
 
     bool vl = mg_opt->verbosity_level > 0 && glob->mpirank == 0;
-    int its = iter_solver.solve(op, u, f, M.get(),vl);
+    int its = iter_solver->solve(op, u, f, M.get(),vl);
 
-    // copy solution into rhs
-    fc2d_thunderegg_store_vector(glob, RHS, u);
+    // swap solution into rhs
+    fc2d_thunderegg_store_solution(glob);
     fclaw_global_productionf("Iterations: %i\n", its);    
 }
 
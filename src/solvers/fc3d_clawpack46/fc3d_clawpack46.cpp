@@ -477,6 +477,8 @@ void clawpack46_vt_destroy(void* vt)
     FCLAW_FREE (vt);
 }
 
+static int vt_slot = -1;
+
 void fc3d_clawpack46_solver_initialize(fclaw2d_global_t* glob)
 {
 	fclaw3dx_clawpatch_options_t* clawpatch_opt = fclaw3dx_clawpatch_get_options(glob);
@@ -536,6 +538,7 @@ void fc3d_clawpack46_solver_initialize(fclaw2d_global_t* glob)
 
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->vtables,"fc3d_clawpack46") == NULL);
 	fclaw_pointer_map_insert(glob->vtables, "fc3d_clawpack46", claw46_vt, clawpack46_vt_destroy);
+	vt_slot = fclaw_pointer_map_slot("fc3d_clawpack46");
 }
 
 
@@ -547,7 +550,7 @@ void fc3d_clawpack46_solver_initialize(fclaw2d_global_t* glob)
 fc3d_clawpack46_vtable_t* fc3d_clawpack46_vt(fclaw2d_global_t* glob)
 {
 	fc3d_clawpack46_vtable_t* claw46_vt = (fc3d_clawpack46_vtable_t*) 
-	   							fclaw_pointer_map_get(glob->vtables, "fc3d_clawpack46");
+	   							fclaw_pointer_map_get_slot(glob->vtables, vt_slot);
 	FCLAW_ASSERT(claw46_vt != NULL);
 	FCLAW_ASSERT(claw46_vt->is_set != 0);
 	return claw46_vt;
@@ -200,10 +200,12 @@ fc3d_clawpack46_options_t*  fc3d_clawpack46_options_register (fclaw_app_t * app,
     return clawopt;
 }
 
+static int options_slot = -1;
+
 fc3d_clawpack46_options_t* fc3d_clawpack46_get_options(fclaw2d_global_t *glob)
 {
     fc3d_clawpack46_options_t* clawopt = (fc3d_clawpack46_options_t*) 
-	   							fclaw_pointer_map_get(glob->options, "fc3d_clawpack46");
+	   							fclaw_pointer_map_get_slot(glob->options, options_slot);
 	FCLAW_ASSERT(clawopt != NULL);
 	return clawopt;
 }
@@ -212,4 +214,5 @@ void fc3d_clawpack46_options_store (fclaw2d_global_t* glob, fc3d_clawpack46_opti
 {
 	FCLAW_ASSERT(fclaw_pointer_map_get(glob->options,"fc3d_clawpack46") == NULL);
 	fclaw_pointer_map_insert(glob->options, "fc3d_clawpack46", clawopt, NULL);
+	options_slot = fclaw_pointer_map_slot("fc3d_clawpack46");
 }
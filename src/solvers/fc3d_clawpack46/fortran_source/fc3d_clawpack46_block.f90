@@ -3,6 +3,7 @@ subroutine fc3d_clawpack46_set_block(blockno)
 
     integer :: blockno, blockno_com
     common /comblock/ blockno_com
+!$omp threadprivate(/comblock/)
 
     blockno_com = blockno
     end subroutine fc3d_clawpack46_set_block
@@ -12,6 +13,7 @@ integer function fc3d_clawpack46_get_block()
 
     integer :: blockno_com
     common /comblock/ blockno_com
+!$omp threadprivate(/comblock/)
 
     fc3d_clawpack46_get_block = blockno_com
     return
@@ -22,6 +24,7 @@ subroutine fc3d_clawpack46_unset_block()
 
     integer :: blockno_com
     common /comblock/ blockno_com
+!$omp threadprivate(/comblock/)
 
     blockno_com = -1
 end subroutine fc3d_clawpack46_unset_block
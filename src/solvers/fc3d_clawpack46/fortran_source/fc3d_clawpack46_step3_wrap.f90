@@ -40,6 +40,7 @@ subroutine clawpack46_step3_wrap(maxm, meqn, maux, mbc, &
     double precision :: dtcom, dxcom,dycom,dzcom, tcom
     integer :: icom, jcom, kcom
     common /comxyt/ dtcom,dxcom,dycom,dzcom, tcom,icom,jcom, kcom
+    !$omp threadprivate(/comxyt/)
 
     ierror = 0
 